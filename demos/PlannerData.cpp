@@ -178,7 +178,8 @@ void readPlannerData(void)
                             distance_combine(boost::bind(&ob::OptimizationObjective::
                                                          combineCosts, &opt, _1, _2)).
                             distance_inf(opt.infiniteCost()).
-                            distance_zero(opt.identityCost()));
+                            distance_zero(opt.identityCost()).
+                            visitor(boost::default_astar_visitor()));
 
         // Extracting the path
         og::PathGeometric path(si);
@@ -0,0 +1,27 @@
+#!/bin/sh
+
+set -e
+
+# create a location to store downloaded data
+mkdir -p /root/repo/_gate_build/pyplusplus
+cd /root/repo/_gate_build/pyplusplus
+
+# get sources
+# gccxml snapshot of 7/21/2014
+/usr/bin/curl --location-trusted https://github.com/gccxml/gccxml/archive/ab651a2aa866351bdd089a4bf1d57f6a9bec2a66.tar.gz | tar xzf -
+/usr/bin/curl --location-trusted https://github.com/gccxml/pygccxml/archive/v1.6.1.tar.gz | tar xzf -
+/usr/bin/curl --location-trusted https://bitbucket.org/ompl/pyplusplus/downloads/pyplusplus-r1247.tgz | tar xzf -
+
+# build & install gccxml
+cd gccxml-ab651a2aa866351bdd089a4bf1d57f6a9bec2a66
+/usr/bin/cmake  .
+/usr/bin/cmake --build .
+sudo /usr/bin/cmake --build . --target install
+
+# build & install pygccxml and Py++
+cd ../pygccxml-1.6.1
+/root/.pyenv/shims/python setup.py build
+sudo /root/.pyenv/shims/python setup.py install 
+cd ../pyplusplus
+/root/.pyenv/shims/python setup.py build
+sudo /root/.pyenv/shims/python setup.py install 
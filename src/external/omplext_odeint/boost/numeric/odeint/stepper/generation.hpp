@@ -1,36 +0,0 @@
-/*
- [auto_generated]
- boost/numeric/odeint/stepper/generation.hpp
-
- [begin_description]
- Forward header for the factory functions. Includes all files from the generation directory.
- [end_description]
-
- Copyright 2009-2011 Karsten Ahnert
- Copyright 2009-2011 Mario Mulansky
-
- Distributed under the Boost Software License, Version 1.0.
- (See accompanying file LICENSE_1_0.txt or
- copy at http://www.boost.org/LICENSE_1_0.txt)
- */
-
-
-#ifndef OMPLEXT_BOOST_NUMERIC_ODEINT_STEPPER_GENERATION_HPP_INCLUDED
-#define OMPLEXT_BOOST_NUMERIC_ODEINT_STEPPER_GENERATION_HPP_INCLUDED
-
-#include <omplext_odeint/boost/numeric/odeint/stepper/generation/make_controlled.hpp>
-#include <omplext_odeint/boost/numeric/odeint/stepper/generation/make_dense_output.hpp>
-
-#include <omplext_odeint/boost/numeric/odeint/stepper/generation/generation_controlled_runge_kutta.hpp>
-#include <omplext_odeint/boost/numeric/odeint/stepper/generation/generation_dense_output_runge_kutta.hpp>
-
-#include <omplext_odeint/boost/numeric/odeint/stepper/generation/generation_runge_kutta_cash_karp54_classic.hpp>
-#include <omplext_odeint/boost/numeric/odeint/stepper/generation/generation_runge_kutta_cash_karp54.hpp>
-#include <omplext_odeint/boost/numeric/odeint/stepper/generation/generation_runge_kutta_dopri5.hpp>
-#include <omplext_odeint/boost/numeric/odeint/stepper/generation/generation_runge_kutta_fehlberg78.hpp>
-
-
-#include <omplext_odeint/boost/numeric/odeint/stepper/generation/generation_rosenbrock4.hpp>
-
-
-#endif // BOOST_NUMERIC_ODEINT_STEPPER_GENERATION_HPP_INCLUDED
@@ -0,0 +1,146 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2015, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_BASE_MAPPED_STATE_STORAGE_
+#define OMPL_BASE_MAPPED_STATE_STORAGE_
+
+#include "ompl/base/StateSpace.h"
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <string>
+
+namespace boost
+{
+    namespace interprocess
+    {
+        class file_mapping;
+        class mapped_region;
+    }
+}
+
+namespace ompl
+{
+    namespace base
+    {
+
+        /// @cond IGNORE
+        /** \brief Forward declaration of ompl::base::MappedStateStorage */
+        OMPL_CLASS_FORWARD(MappedStateStorage);
+        /// @endcond
+
+        /** \brief Keep serialized states in a memory-mapped file
+
+            @par
+            Each state is serialized with StateSpace::serialize() into a
+            record of StateSpace::getSerializationLength() bytes. Records
+            are appended to the file, which doubles in size whenever it is
+            full, and are addressed by the index returned by store(). The
+            operating system decides which pages of the file stay in
+            memory, so a planner can keep far more states around than fit
+            in RAM, as long as only a small part of them is accessed at a
+            time. The state space must support serialization.
+
+            @par
+            The file only lives as long as this object: it is truncated
+            when the storage is created and removed when it is destroyed. */
+        class MappedStateStorage : private boost::noncopyable
+        {
+        public:
+
+            /** \brief Store states of \e space in the file \e filename. If no file name is given, a new file in the
+                temporary directory of the system is used. */
+            MappedStateStorage(const StateSpacePtr &space, const std::string &filename = "");
+
+            ~MappedStateStorage();
+
+            /** \brief Get the state space this class maintains states for */
+            const StateSpacePtr& getStateSpace() const
+            {
+                return space_;
+            }
+
+            /** \brief Get the name of the file the states are stored in */
+            const std::string& getFilename() const
+            {
+                return filename_;
+            }
+
+            /** \brief Append a copy of \e state to the file and return its index */
+            std::size_t store(const State *state);
+
+            /** \brief Copy the state with index \e index (as returned by store()) into \e state */
+            void load(std::size_t index, State *state) const;
+
+            /** \brief Return the number of stored states */
+            std::size_t size() const
+            {
+                return size_;
+            }
+
+            /** \brief Return the current size of the file, in bytes */
+            std::size_t getFileSize() const
+            {
+                return capacity_ * recordLength_;
+            }
+
+        private:
+
+            /** \brief Resize the file so that it can hold \e capacity states and map it again */
+            void map(std::size_t capacity);
+
+            /** \brief The state space the states belong to */
+            StateSpacePtr                                     space_;
+
+            /** \brief The file the states are stored in */
+            std::string                                       filename_;
+
+            /** \brief Number of bytes of a serialized state */
+            std::size_t                                       recordLength_;
+
+            /** \brief Number of stored states */
+            std::size_t                                       size_;
+
+            /** \brief Number of states the file can hold */
+            std::size_t                                       capacity_;
+
+            /** \brief The mapping of the file */
+            boost::scoped_ptr<boost::interprocess::file_mapping>  mapping_;
+
+            /** \brief The mapped view of the whole file */
+            boost::scoped_ptr<boost::interprocess::mapped_region> region_;
+        };
+    }
+}
+
+#endif
@@ -45,6 +45,11 @@
 #include "ompl/base/samplers/InformedStateSampler.h"
 #include <boost/noncopyable.hpp>
 #include <boost/concept_check.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/scoped_array.hpp>
+#include <vector>
+#include <list>
 
 namespace ompl
 {
@@ -76,9 +81,7 @@ namespace ompl
             /** \brief Constructor. The objective must always know the space information it is part of. The cost threshold for objective satisfaction defaults to 0.0. */
             OptimizationObjective(const SpaceInformationPtr &si);
 
-            virtual ~OptimizationObjective()
-            {
-            }
+            virtual ~OptimizationObjective();
 
             /** \brief Get the description of this optimization objective */
             const std::string& getDescription() const;
@@ -122,6 +125,9 @@ namespace ompl
             /** \brief Evaluate a cost map defined on the state space at a state \e s. */
             virtual Cost stateCost(const State *s) const = 0;
 
+            /** \brief Evaluate the cost map at every state in \e states, storing the results in \e costs. Objectives whose state costs come from an external backend (e.g., clearance from a collision checker) can override this to evaluate the whole batch at once. The default implementation calls stateCost() for every state. */
+            virtual void stateCosts(const std::vector<State*> &states, std::vector<Cost> &costs) const;
+
             /** \brief Get the cost that corresponds to the motion segment between \e s1 and \e s2 */
             virtual Cost motionCost(const State *s1, const State *s2) const = 0;
 
@@ -164,10 +170,31 @@ namespace ompl
             /** \brief Defines an admissible estimate on the optimal cost on the motion between states \e s1 and \e s2. An admissible estimate always undervalues the true optimal cost of the motion. Used by some planners to speed up planning. The default implementation of this method returns this objective's identity cost, which is sure to be an admissible heuristic if there are no negative costs. */
             virtual Cost motionCostHeuristic(const State *s1, const State *s2) const;
 
+            /** \brief Returns a lower bound, \e k, on the cost accrued per unit of path length, i.e., motionCost(s1, s2) >= k * SpaceInformation::distance(s1, s2) for every motion. Informed samplers use this to bound the length of paths that can improve a solution. The default implementation returns 0.0, which provides no information. */
+            virtual double getCostPerLengthLowerBound() const;
+
+            /** \brief Enable or disable caching of the state costs of the end points of motions. Motion costs are queried for the same states many times (e.g., during rewiring), so this is worthwhile when stateCost() is expensive. The cache is keyed on the state pointer and each entry keeps a copy of the state, so an entry is only used if the state it was computed for still has the same value. The cache holds at most magic::MAX_STATE_COST_CACHE_SIZE entries and evicts the least recently used ones, so entries of freed states that were never invalidated do not accumulate. It is split into magic::STATE_COST_CACHE_SHARDS shards with a lock each, so planners running in parallel rarely wait for each other. Caching is disabled by default. Disabling it empties the cache. */
+            void setStateCostCaching(bool flag);
+
+            /** \brief Check whether state costs are cached */
+            bool isStateCostCachingEnabled() const;
+
+            /** \brief Remove the cached cost of a state, e.g., before the state is freed. */
+            void invalidateCachedStateCost(const State *s) const;
+
+            /** \brief Remove all the cached state costs */
+            void clearStateCostCache() const;
+
+            /** \brief Get the number of states whose costs are cached */
+            std::size_t getStateCostCacheSize() const;
+
+            /** \brief Returns stateCost(\e s). If state cost caching is enabled, the cost is looked up in, or added to, the cache. Entries are checked against a copy of the state, so a buffer that is reused for different states only hits when it holds the same state again. Call invalidateCachedStateCost() before freeing such a buffer. */
+            Cost cachedStateCost(const State *s) const;
+
             /** \brief Returns this objective's SpaceInformation. Needed for operators in MultiOptimizationObjective */
             const SpaceInformationPtr& getSpaceInformation() const;
 
-            /** \brief Allocate a heuristic-sampling state generator for this cost function, defaults to a basic rejection sampling scheme when the derived class does not provide a better method.*/
+            /** \brief Allocate a heuristic-sampling state generator for this cost function. When the derived class does not provide a better method, defaults to sampling the region bounded by getCostPerLengthLowerBound() (see PathLengthBoundedInfSampler) if the objective and problem support it, and to a basic rejection sampling scheme otherwise.*/
             virtual InformedStateSamplerPtr allocInformedStateSampler(const StateSpace* space, const ProblemDefinitionPtr probDefn, const Cost* bestCost) const;
 
         protected:
@@ -182,6 +209,46 @@ namespace ompl
 
             /** \brief The function used for returning admissible estimates on the optimal cost of the path between a given state and goal */
             CostToGoHeuristic   costToGoFn_;
+
+        private:
+
+            /** \brief An entry of the state cost cache */
+            struct CachedStateCost
+            {
+                /** \brief A copy of the state the cost was computed for */
+                State                                  *state;
+
+                /** \brief The cost of the state */
+                Cost                                    cost;
+
+                /** \brief The position of the entry in the recently used list of its shard */
+                std::list<const State*>::iterator       lruPosition;
+            };
+
+            /** \brief A part of the state cost cache, with its own lock */
+            struct StateCostCacheShard
+            {
+                /** \brief Lock for the entries of this shard */
+                boost::mutex                                          lock;
+
+                /** \brief The cached state costs, keyed on the state pointer */
+                boost::unordered_map<const State*, CachedStateCost>   entries;
+
+                /** \brief The keys of the entries, most recently used first */
+                std::list<const State*>                               lru;
+            };
+
+            /** \brief The shard of the state cost cache that holds the entry of \e s */
+            StateCostCacheShard& stateCostCacheShard(const State *s) const;
+
+            /** \brief Free the copy of the state of the entry at \e it and remove the entry from \e shard (whose lock must be held) */
+            void eraseCachedStateCost(StateCostCacheShard &shard, boost::unordered_map<const State*, CachedStateCost>::iterator it) const;
+
+            /** \brief Whether state costs are cached */
+            bool                                                      cacheStateCosts_;
+
+            /** \brief The shards of the state cost cache, allocated the first time caching is enabled */
+            mutable boost::scoped_array<StateCostCacheShard>          stateCostCache_;
         };
 
         /**
@@ -234,8 +301,21 @@ namespace ompl
               its weight */
             virtual Cost motionCost(const State *s1, const State *s2) const;
 
+            /** If all the weights are nonnegative, the weighted sum
+              of the individual objectives' motion cost heuristics.
+              Otherwise the identity cost. */
+            virtual Cost motionCostHeuristic(const State *s1, const State *s2) const;
+
+            /** If all the weights are nonnegative, the weighted sum
+              of the individual objectives' cost-per-length lower
+              bounds. Otherwise 0.0. */
+            virtual double getCostPerLengthLowerBound() const;
+
         protected:
 
+            /** \brief Whether every component has a nonnegative weight, i.e., whether weighted sums of lower bounds are lower bounds */
+            bool hasNonnegativeWeights() const;
+
             /** \brief Defines a pairing of an objective and its weight */
             struct Component
             {
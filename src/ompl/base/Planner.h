@@ -51,6 +51,7 @@
 #include <boost/concept_check.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/thread/mutex.hpp>
 #include <string>
 #include <map>
 
@@ -228,6 +229,34 @@ namespace ompl
             bool     canReportIntermediateSolutions;
         };
 
+        /** \brief Description of an improvement of the best solution found by an anytime planner,
+            as passed to an ImprovedSolutionCallback. */
+        struct ImprovedSolutionEvent
+        {
+            ImprovedSolutionEvent(const Planner *p, const std::vector<const State*> &s, const Cost &c) :
+                planner(p), states(s), cost(c), timestamp(time::now())
+            {
+            }
+
+            /** \brief The planner that improved its solution */
+            const Planner                   *planner;
+
+            /** \brief The states of the solution, from a start state to a goal state. The
+                states themselves are owned by the planner and are only valid during the callback,
+                so they need to be copied (e.g., into a geometric::PathGeometric) to be kept. */
+            std::vector<const State*>        states;
+
+            /** \brief The cost of the solution */
+            Cost                             cost;
+
+            /** \brief The time at which the solution was found */
+            time::point                      timestamp;
+        };
+
+        /** \brief A function called by anytime planners every time they improve their best solution.
+            It is called from the thread that found the solution, and planning resumes when it returns. */
+        typedef boost::function<void(const ImprovedSolutionEvent&)> ImprovedSolutionCallback;
+
         /** \brief Base class for a planner */
         class Planner : private boost::noncopyable
         {
@@ -305,6 +334,15 @@ namespace ompl
                 will ignore all previous work. */
             virtual void clear();
 
+            /** \brief Clear the data that depends on the start and
+                goal states of the previous query, keeping the
+                query-independent data (e.g., valid samples, a
+                roadmap, a tree rooted at an unchanged start) for
+                subsequent calls to solve(). Planners that cannot
+                reuse any work across queries fall back to clear(),
+                which is the default implementation. */
+            virtual void clearQuery();
+
             /** \brief Get information about the current run of the
                 motion planner. Repeated calls to this function will
                 update \e data (only additions are made). This is
@@ -313,6 +351,20 @@ namespace ompl
                 (without calling clear() in between).  */
             virtual void getPlannerData(PlannerData &data) const;
 
+            /** \brief Get an estimate of the number of bytes used by the
+                datastructures of the planner (motions, states, roadmaps,
+                nearest neighbors structures). Memory owned by the space
+                information or the problem definition is not included.
+                Planners that do not account for their memory return 0.
+                This is cheap enough to be called while the planner is solving. */
+            virtual std::size_t getMemoryUsage() const;
+
+            /** \brief Get the largest memory usage of the planner since the
+                last call to clear(). Only the values observed by
+                recordMemoryUsage() and by calls to this function are taken
+                into account. */
+            std::size_t getPeakMemoryUsage() const;
+
             /** \brief Get the name of the planner */
             const std::string& getName() const;
 
@@ -361,6 +413,20 @@ namespace ompl
                 return plannerProgressProperties_;
             }
 
+            /** \brief Set a function to be called every time the planner improves its best solution.
+                Only anytime planners report improved solutions. This function should not be called
+                while the planner is solving. */
+            void setImprovedSolutionCallback(const ImprovedSolutionCallback &callback)
+            {
+                improvedSolutionCallback_ = callback;
+            }
+
+            /** \brief Get the function called every time the planner improves its best solution */
+            const ImprovedSolutionCallback& getImprovedSolutionCallback() const
+            {
+                return improvedSolutionCallback_;
+            }
+
             /** \brief Print properties of the motion planner */
             virtual void printProperties(std::ostream &out) const;
 
@@ -393,6 +459,29 @@ namespace ompl
                 plannerProgressProperties_[progressPropertyName] = prop;
             }
 
+            /** \brief Add the "memory usage INTEGER" and "peak memory usage INTEGER" progress
+                properties, which report getMemoryUsage() and getPeakMemoryUsage() in bytes */
+            void addMemoryUsageProgressProperties();
+
+            /** \brief Update the peak memory usage with the current value of getMemoryUsage().
+                Planners whose datastructures shrink while solving (e.g., by pruning) call this
+                before releasing memory. */
+            void recordMemoryUsage() const;
+
+            /** \brief Return true if improved solutions need to be reported through notifyImprovedSolution() */
+            bool hasImprovedSolutionCallback() const
+            {
+                return bool(improvedSolutionCallback_);
+            }
+
+            /** \brief Report an improved solution with the states \e states (from a start state to a goal state)
+                and cost \e cost to the callback set by setImprovedSolutionCallback(), if any */
+            void notifyImprovedSolution(const std::vector<const State*> &states, const Cost &cost) const
+            {
+                if (improvedSolutionCallback_)
+                    improvedSolutionCallback_(ImprovedSolutionEvent(this, states, cost));
+            }
+
             /** \brief The space information for which planning is done */
             SpaceInformationPtr       si_;
 
@@ -416,6 +505,23 @@ namespace ompl
 
             /** \brief Flag indicating whether setup() has been called */
             bool                      setup_;
+
+            /** \brief The function called every time the planner improves its best solution */
+            ImprovedSolutionCallback  improvedSolutionCallback_;
+
+        private:
+
+            /** \brief Return getMemoryUsage() as a string, for the "memory usage INTEGER" progress property */
+            std::string getMemoryUsageString() const;
+
+            /** \brief Return getPeakMemoryUsage() as a string, for the "peak memory usage INTEGER" progress property */
+            std::string getPeakMemoryUsageString() const;
+
+            /** \brief The largest memory usage recorded since the last call to clear() */
+            mutable std::size_t       peakMemoryUsage_;
+
+            /** \brief Lock for peakMemoryUsage_, which progress properties update while the planner is solving */
+            mutable boost::mutex      peakMemoryLock_;
         };
 
         /** \brief Definition of a function that can allocate a planner */
@@ -253,6 +253,11 @@ namespace ompl
             unsigned int numStartVertices() const;
             /// \brief Returns the number of goal vertices
             unsigned int numGoalVertices() const;
+            /// \brief Get an estimate of the number of bytes used by this
+            /// structure: the graph, its vertex and edge objects, the lookup
+            /// tables and the states copied by decoupleFromPlanner(). States
+            /// that still belong to the planner are not included.
+            std::size_t getMemoryUsage() const;
 
             /// \}
             /// \name PlannerData vertex lookup
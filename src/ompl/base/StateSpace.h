@@ -304,6 +304,10 @@ namespace ompl
             /** \brief Get the number of chars in the serialization of a state in this space */
             virtual unsigned int getSerializationLength() const;
 
+            /** \brief Get an estimate of the number of bytes used by a state allocated by this space.
+                By default, a state is assumed to store its serialized values next to the State base class. */
+            virtual std::size_t getStateMemoryUsage() const;
+
             /** \brief Write the binary representation of \e state to \e serialization */
             virtual void serialize(void *serialization, const State *state) const;
 
@@ -659,6 +663,8 @@ namespace ompl
 
             virtual unsigned int getSerializationLength() const;
 
+            virtual std::size_t getStateMemoryUsage() const;
+
             virtual void serialize(void *serialization, const State *state) const;
 
             virtual void deserialize(State *state, const void *serialization) const;
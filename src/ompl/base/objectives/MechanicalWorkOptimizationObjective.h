@@ -60,6 +60,12 @@ namespace ompl
             /** \brief Defines motion cost in terms of the mechanical work formulation used for TRRT. */
             virtual Cost motionCost(const State *s1, const State *s2) const;
 
+            /** \brief The weighted path length between \e s1 and \e s2, as the mechanical work itself is never negative. */
+            virtual Cost motionCostHeuristic(const State *s1, const State *s2) const;
+
+            /** \brief Returns the path length weight, as every motion costs at least its weighted length. */
+            virtual double getCostPerLengthLowerBound() const;
+
         protected:
             /** \brief The weighing factor for the path length in the mechanical work objective formulation. */
             double pathLengthWeight_;
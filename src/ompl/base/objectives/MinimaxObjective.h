@@ -56,7 +56,10 @@ namespace ompl
 
             /** \brief Interpolates between \e s1 and \e s2 to check for
                 state costs along the motion between the two
-                states. Assumes all costs are worse than identity */
+                states. Assumes all costs are worse than identity. The
+                costs of the intermediate states are computed with a
+                single call to stateCosts(), and the cost of \e s2 is
+                reused across calls if state cost caching is enabled. */
             virtual Cost motionCost(const State *s1, const State *s2) const;
 
             /** \brief Since we're only concerned about the "worst"
@@ -64,6 +64,9 @@ namespace ompl
                 two states assuming no obstacles. */
             virtual Cost motionCostHeuristic(const State *s1, const State *s2) const;
 
+            /** \brief Every unit of path length costs exactly 1.0. */
+            virtual double getCostPerLengthLowerBound() const;
+
             /** \brief Allocate a state sampler for the path-length objective (i.e., direct ellipsoidal sampling). */
             virtual InformedStateSamplerPtr allocInformedStateSampler(const StateSpace* space, const ProblemDefinitionPtr probDefn, const Cost* bestCost) const;
         };
@@ -82,7 +82,13 @@ namespace ompl
                 by separating the motion into
                 StateSpace::validSegmentCount() segments, using the
                 above formula to compute the cost of each of those
-                segments, and adding them up.
+                segments, and adding them up. The costs of the
+                intermediate states are computed with a single call
+                to stateCosts().
+
+                The costs of \e s1 and \e s2 are reused across calls
+                if state cost caching is enabled (see
+                OptimizationObjective::setStateCostCaching()).
             */
             virtual Cost motionCost(const State *s1, const State *s2) const;
 
@@ -93,6 +99,26 @@ namespace ompl
             */
             bool isMotionCostInterpolationEnabled() const;
 
+            /** \brief Set a lower bound on the value of stateCost()
+                over the entire state space, e.g., the cost of a state
+                with maximum clearance for clearance-weighted
+                lengths. This is not checked, and an incorrect bound
+                makes the heuristics of this objective
+                inadmissible. The default is 0.0, which makes no
+                assumptions about the state costs. */
+            void setStateCostLowerBound(Cost bound);
+
+            /** \brief Get the lower bound on the value of stateCost() */
+            Cost getStateCostLowerBound() const;
+
+            /** \brief The length of the motion between \e s1 and
+                \e s2 weighted by the state cost lower bound. */
+            virtual Cost motionCostHeuristic(const State *s1, const State *s2) const;
+
+            /** \brief Returns the state cost lower bound, as every
+                unit of path length costs at least this much. */
+            virtual double getCostPerLengthLowerBound() const;
+
         protected:
 
             /** \brief If true, then motionCost() will more accurately compute
@@ -104,6 +130,9 @@ namespace ompl
                 the two end points. */
             bool interpolateMotionCost_;
 
+            /** \brief The lower bound on the value of stateCost() */
+            Cost stateCostLowerBound_;
+
             /** \brief Helper method which uses the trapezoidal rule
                 to approximate the integral of the cost between two
                 states of distance \e dist and costs \e c1 and \e
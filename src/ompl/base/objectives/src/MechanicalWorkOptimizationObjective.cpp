@@ -62,3 +62,14 @@ ompl::base::Cost ompl::base::MechanicalWorkOptimizationObjective::motionCost(con
     double positiveCostAccrued = std::max(stateCost(s2).value() - stateCost(s1).value(), 0.0);
     return Cost(positiveCostAccrued + pathLengthWeight_ * si_->distance(s1, s2));
 }
+
+ompl::base::Cost ompl::base::MechanicalWorkOptimizationObjective::motionCostHeuristic(const State *s1,
+                                                                                      const State *s2) const
+{
+    return Cost(pathLengthWeight_ * si_->distance(s1, s2));
+}
+
+double ompl::base::MechanicalWorkOptimizationObjective::getCostPerLengthLowerBound() const
+{
+    return pathLengthWeight_;
+}
@@ -54,19 +54,25 @@ ompl::base::Cost ompl::base::MinimaxObjective::motionCost(const State *s1, const
 
     if (nd > 1)
     {
-        State *test = si_->allocState();
+        // The intermediate states are temporary, so they are
+        // evaluated as one batch rather than cached
+        std::vector<State*> interpolated(nd - 1);
+        std::vector<Cost> interpolatedCosts;
+        si_->allocStates(interpolated);
         for (int j = 1; j < nd; ++j)
+            si_->getStateSpace()->interpolate(s1, s2, (double) j / (double) nd, interpolated[j - 1]);
+        this->stateCosts(interpolated, interpolatedCosts);
+        si_->freeStates(interpolated);
+
+        for (std::size_t j = 0; j < interpolatedCosts.size(); ++j)
         {
-            si_->getStateSpace()->interpolate(s1, s2, (double) j / (double) nd, test);
-            Cost testStateCost = this->stateCost(test);
-            if (this->isCostBetterThan(worstCost, testStateCost))
-                worstCost = testStateCost;
+            if (this->isCostBetterThan(worstCost, interpolatedCosts[j]))
+                worstCost = interpolatedCosts[j];
         }
-        si_->freeState(test);
     }
 
     // Lastly, check s2
-    Cost lastCost = this->stateCost(s2);
+    Cost lastCost = this->cachedStateCost(s2);
     if (this->isCostBetterThan(worstCost, lastCost))
         worstCost = lastCost;
 
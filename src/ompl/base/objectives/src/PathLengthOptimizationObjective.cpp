@@ -61,6 +61,11 @@ ompl::base::Cost ompl::base::PathLengthOptimizationObjective::motionCostHeuristi
     return motionCost(s1, s2);
 }
 
+double ompl::base::PathLengthOptimizationObjective::getCostPerLengthLowerBound() const
+{
+    return 1.0;
+}
+
 ompl::base::InformedStateSamplerPtr ompl::base::PathLengthOptimizationObjective::allocInformedStateSampler(const StateSpace* space, const ProblemDefinitionPtr probDefn, const Cost* bestCost) const
 {
     //return boost::make_shared<DirectPathLengthInformedSampler>(space, probDefn, bestCost);
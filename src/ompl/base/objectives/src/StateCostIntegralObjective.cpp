@@ -40,7 +40,8 @@ ompl::base::StateCostIntegralObjective::
 StateCostIntegralObjective(const SpaceInformationPtr &si,
                            bool enableMotionCostInterpolation) :
     OptimizationObjective(si),
-    interpolateMotionCost_(enableMotionCostInterpolation)
+    interpolateMotionCost_(enableMotionCostInterpolation),
+    stateCostLowerBound_(0.0)
 {
     description_ = "State Cost Integral";
 }
@@ -59,33 +60,40 @@ ompl::base::Cost ompl::base::StateCostIntegralObjective::motionCost(const State
 
         int nd = si_->getStateSpace()->validSegmentCount(s1, s2);
 
-        State *test1 = si_->cloneState(s1);
-        Cost prevStateCost = this->stateCost(test1);
+        std::vector<State*> interpolated;
+        std::vector<Cost> interpolatedCosts;
         if (nd > 1)
         {
-            State *test2 = si_->allocState();
+            interpolated.resize(nd - 1);
+            si_->allocStates(interpolated);
             for (int j = 1; j < nd; ++j)
-            {
-                si_->getStateSpace()->interpolate(s1, s2, (double) j / (double) nd, test2);
-                Cost nextStateCost = this->stateCost(test2);
-                totalCost = Cost(totalCost.value() + this->trapezoid(prevStateCost, nextStateCost,
-                                                                     si_->distance(test1, test2)).value());
-                std::swap(test1, test2);
-                prevStateCost = nextStateCost;
-            }
-            si_->freeState(test2);
+                si_->getStateSpace()->interpolate(s1, s2, (double) j / (double) nd, interpolated[j - 1]);
+
+            // The intermediate states are temporary, so they are
+            // evaluated as one batch rather than cached
+            this->stateCosts(interpolated, interpolatedCosts);
+        }
+
+        const State *prevState = s1;
+        Cost prevStateCost = this->cachedStateCost(s1);
+        for (std::size_t j = 0; j < interpolated.size(); ++j)
+        {
+            totalCost = Cost(totalCost.value() + this->trapezoid(prevStateCost, interpolatedCosts[j],
+                                                                 si_->distance(prevState, interpolated[j])).value());
+            prevState = interpolated[j];
+            prevStateCost = interpolatedCosts[j];
         }
 
         // Lastly, add s2
-        totalCost = Cost(totalCost.value() + this->trapezoid(prevStateCost, this->stateCost(s2),
-                                                             si_->distance(test1, s2)).value());
+        totalCost = Cost(totalCost.value() + this->trapezoid(prevStateCost, this->cachedStateCost(s2),
+                                                             si_->distance(prevState, s2)).value());
 
-        si_->freeState(test1);
+        si_->freeStates(interpolated);
 
         return totalCost;
     }
     else
-        return this->trapezoid(this->stateCost(s1), this->stateCost(s2),
+        return this->trapezoid(this->cachedStateCost(s1), this->cachedStateCost(s2),
                                si_->distance(s1, s2));
 }
 
@@ -93,3 +101,25 @@ bool ompl::base::StateCostIntegralObjective::isMotionCostInterpolationEnabled()
 {
     return interpolateMotionCost_;
 }
+
+void ompl::base::StateCostIntegralObjective::setStateCostLowerBound(Cost bound)
+{
+    stateCostLowerBound_ = bound;
+}
+
+ompl::base::Cost ompl::base::StateCostIntegralObjective::getStateCostLowerBound() const
+{
+    return stateCostLowerBound_;
+}
+
+ompl::base::Cost ompl::base::StateCostIntegralObjective::motionCostHeuristic(const State *s1,
+                                                                             const State *s2) const
+{
+    // The trapezoidal segments sum to at least the bound times the length of the motion
+    return Cost(stateCostLowerBound_.value() * si_->distance(s1, s2));
+}
+
+double ompl::base::StateCostIntegralObjective::getCostPerLengthLowerBound() const
+{
+    return stateCostLowerBound_.value();
+}
@@ -43,6 +43,8 @@
 #include "ompl/base/Cost.h"
 //We use a pointer to the problem definition to access problem and solution data.
 #include "ompl/base/ProblemDefinition.h"
+//Batches of states are passed as vectors
+#include <vector>
 
 namespace ompl
 {
@@ -71,6 +73,15 @@ namespace ompl
             /** \brief Sample uniformly in the subset of the state space whose heuristic solution estimates are between the provided costs. */
             virtual void sampleUniform(State* statePtr, const Cost& minCost, const Cost& maxCost) = 0;
 
+            /** \brief Sample uniformly a batch of states in the subset of the state space whose heuristic solution estimates are less than the current best cost (as defined by the pointer passed at construction). By default just calls sampleUniformBatch(const std::vector<State*>&, Cost) with cost given by the member variable. */
+            virtual void sampleUniformBatch(const std::vector<State*>& statePtrs);
+
+            /** \brief Sample uniformly a batch of states in the subset of the state space whose heuristic solution estimates are less than the provided cost. The states must already be allocated. By default calls sampleUniform(State*, Cost) for each state; deriving classes may be able to generate the batch more efficiently. */
+            virtual void sampleUniformBatch(const std::vector<State*>& statePtrs, const Cost& maxCost);
+
+            /** \brief The fraction of candidate samples that were accepted while generating the most recent batch. This can be used by planners to adapt their batch size. By default returns 1, i.e., samplers that do not track rejections report that every candidate was accepted. */
+            virtual double getAcceptanceRate() const;
+
             /** \brief Whether the sampler can provide a measure of the informed subset */
             virtual bool hasInformedMeasure() const = 0;
 
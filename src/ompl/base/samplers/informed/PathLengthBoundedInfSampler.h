@@ -0,0 +1,110 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2015, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_BASE_SAMPLERS_INFORMED_PATH_LENGTH_BOUNDED_INFORMED_SAMPLER_
+#define OMPL_BASE_SAMPLERS_INFORMED_PATH_LENGTH_BOUNDED_INFORMED_SAMPLER_
+
+//We inherit from InformedStateSampler
+#include "ompl/base/samplers/InformedStateSampler.h"
+//We sample the conservative region with the direct path-length sampler
+#include "ompl/base/samplers/informed/PathLengthDirectInfSampler.h"
+
+namespace ompl
+{
+    namespace base
+    {
+        /** \brief An informed sampler for objectives whose motion costs are bounded from below by a multiple of path length.
+
+        Many objectives that are not path length, e.g., integrals of a (clearance-based) state cost, mechanical work, or weighted sums of these,
+        still accrue at least OptimizationObjective::getCostPerLengthLowerBound() cost per unit of distance travelled.
+        A path that can improve a solution of cost c can therefore be no longer than c divided by this bound, and
+        the set of states it can pass through is contained in the prolate hyperspheroids (PHSs) of that transverse diameter.
+        This sampler draws samples directly from this conservative region with a PathLengthDirectInfSampler and then rejects
+        those whose heuristic estimate of solution cost, calculated from the objective's motionCostHeuristic() and costToGo(), is worse than c.
+        The rejection step only operates on the conservative region and not the entire state space, so the acceptance rate is much higher than that of RejectionInfSampler.
+        The supported problems are those supported by PathLengthDirectInfSampler.
+        Until an initial solution is found, this sampler simply passes-through to a uniform distribution over the entire state space. */
+        class PathLengthBoundedInfSampler : public InformedStateSampler
+        {
+        public:
+            /** \brief Construct a sampler that only generates states with a heuristic solution estimate that is less than the cost of the current solution. Throws if the objective does not provide a positive cost-per-length lower bound or if the problem is not supported by PathLengthDirectInfSampler. */
+            PathLengthBoundedInfSampler(const StateSpace* space, const ProblemDefinitionPtr probDefn, const Cost* bestCost);
+            virtual ~PathLengthBoundedInfSampler()
+            {
+            }
+
+            /** \brief Sample uniformly in the subset of the state space whose heuristic solution estimates are less than the provided cost. */
+            void sampleUniform(State* statePtr, const Cost& maxCost);
+
+            /** \brief Sample uniformly in the subset of the state space whose heuristic solution estimates are between the provided costs. */
+            void sampleUniform(State* statePtr, const Cost& minCost, const Cost& maxCost);
+
+            /** \brief Sample uniformly a batch of states in the subset of the state space whose heuristic solution estimates are less than the provided cost. The batch is drawn from the conservative region at once and only the rejected states are redrawn. */
+            void sampleUniformBatch(const std::vector<State*>& statePtrs, const Cost& maxCost);
+
+            /** \brief The fraction of candidate samples that were accepted while generating the most recent batch, including those rejected by the conservative region. */
+            double getAcceptanceRate() const;
+
+            /** \brief Whether the sampler can provide a measure of the informed subset */
+            bool hasInformedMeasure() const;
+
+            /** \brief The measure of the conservative region defined by the current solution cost. This is an upper bound on the measure of the informed subset. */
+            virtual double getInformedMeasure(const Cost& currentCost) const;
+
+            /** \brief A helper function to calculate the heuristic estimate of the solution cost for a given state. This is the worse of the objective's heuristic and the path-length heuristic scaled by the cost-per-length lower bound. */
+            virtual Cost heuristicSolnCost(const State* statePtr) const;
+
+            /** \brief Set the seed of all the state samplers. */
+            void setLocalSeed(boost::uint32_t localSeed);
+
+        private:
+            //Helper functions:
+            /** \brief The path length that a solution of the given cost can not exceed */
+            Cost maxPathLength(const Cost& maxCost) const;
+
+            //Variables
+            /** \brief The lower bound on the cost accrued per unit of path length */
+            double costPerLength_;
+
+            /** \brief The direct sampler of the conservative region */
+            boost::shared_ptr<PathLengthDirectInfSampler> phsSampler_;
+
+            /** \brief The fraction of candidates accepted in the most recent batch */
+            double acceptanceRate_;
+        };
+    }
+}
+
+
+#endif //OMPL_BASE_SAMPLERS_INFORMED_PATH_LENGTH_BOUNDED_INFORMED_SAMPLER_
@@ -39,6 +39,8 @@
 
 //We inherit from InformedStateSampler
 #include "ompl/base/samplers/InformedStateSampler.h"
+//We store a list of PHSs
+#include <vector>
 
 namespace ompl
 {
@@ -51,7 +53,9 @@ namespace ompl
         Doing so considers all homotopy classes that can provide a better solution while guaranteeing a non-zero probability
         of improving a solution regardless of the size of the planning domain, the number of state dimensions, and how close
         the current solution is to the theoretical minimum.
-        Currently only implemented for problems with a single goal in R^n (i.e., RealVectorStateSpace), SE(2) (i.e., SE2StateSpace), and SE(3) (i.e., SE3StateSpace).
+        Currently only implemented for problems with goals defined as states (i.e., GoalState or GoalStates) in R^n (i.e., RealVectorStateSpace), SE(2) (i.e., SE2StateSpace), and SE(3) (i.e., SE3StateSpace).
+        Problems with multiple start and/or goal states are handled by sampling uniformly from the union of the PHSs defined by every start-goal pair.
+        A PHS is selected with probability proportional to its measure, sampled directly, and the sample is kept only if no PHS earlier in the list also contains it, which removes the bias in the regions where PHSs overlap.
         Until an initial solution is found, this sampler simply passes-through to a uniform distribution over the entire state space.
         @par J D. Gammell, S. S. Srinivasa, T. D. Barfoot, "Informed RRT*: Optimal Sampling-based
         Path Planning Focused via Direct Sampling of an Admissible Ellipsoidal Heuristic."
@@ -61,7 +65,7 @@ namespace ompl
 
         @par TODO
         - Handle compound spaces more gracefully.
-        - Handle other types of goals? */
+        - Handle other types of goals, e.g., GoalRegion? */
         class PathLengthDirectInfSampler : public InformedStateSampler
         {
         public:
@@ -76,10 +80,18 @@ namespace ompl
             /** \brief Sample uniformly in the subset of the state space whose heuristic solution estimates are between the provided costs. */
             void sampleUniform(State* statePtr, const Cost& minCost, const Cost& maxCost);
 
+            /** \brief Sample uniformly a batch of states in the subset of the state space whose heuristic solution estimates are less than the provided cost.
+            When the PHSs are smaller than the state space, candidates are drawn from the unit n-ball all at once, transformed to each PHS with a single matrix-matrix product, and filtered against the bounds of the state space in one vectorized pass.
+            The number of candidates drawn is scaled by the acceptance rate measured on the previous batch. */
+            void sampleUniformBatch(const std::vector<State*>& statePtrs, const Cost& maxCost);
+
+            /** \brief The fraction of candidate samples that were accepted while generating the most recent batch. */
+            double getAcceptanceRate() const;
+
             /** \brief Whether the sampler can provide a measure of the informed subset */
             bool hasInformedMeasure() const;
 
-            /** \brief The measure of the subset of the state space defined by the current solution cost that is being searched. Does not consider problem boundaries but returns the measure of the entire space if no solution has been found. */
+            /** \brief The measure of the subset of the state space defined by the current solution cost that is being searched. Does not consider problem boundaries but returns the measure of the entire space if no solution has been found. For multiple start-goal pairs, this is the sum of the PHS measures and is therefore an upper bound on the measure of their union. */
             virtual double getInformedMeasure(const Cost& currentCost) const;
 
             /** \brief A helper function to calculate the heuristic estimate of the solution cost for the informed subset of a given state. */
@@ -97,6 +109,24 @@ namespace ompl
 
         private:
             //Helper functions:
+            /** \brief Update the transverse diameter of every PHS that can contain a solution of the provided cost, and record them (and their summed measure) as the active PHSs. If the cost is less than the distance between every start-goal pair, the line between the closest pair is used. */
+            void updatePhsDefinitions(const Cost& maxCost);
+
+            /** \brief Select one of the active PHSs with probability proportional to its measure. */
+            unsigned int selectActivePhs();
+
+            /** \brief Get the informed subset of the given state as a vector of reals. */
+            void getInformedVector(const State* statePtr, std::vector<double>* informedVector) const;
+
+            /** \brief Whether the given informed values lie in any of the active PHSs. */
+            bool isInAnyPhs(const double informedValues[]) const;
+
+            /** \brief Whether the given informed values, sampled from the active PHS at the given index, should be kept. They are kept only if they do not also lie in an active PHS with a lower index, so that overlapping regions are not over sampled. */
+            bool keepSample(const double informedValues[], unsigned int phsIdx) const;
+
+            /** \brief Copy the given informed values into the state, sampling the uninformed subspace if there is one. */
+            void setInformedValues(State* statePtr, const std::vector<double>& informedVector);
+
             /** \brief Sample uniformly in the subset of the \e infinite state space whose heuristic solution estimates are less than the provided cost, i.e., ignores the bounds of the state space. */
             void sampleUniformIgnoreBounds(State* statePtr, const Cost& maxCost);
 
@@ -104,8 +134,20 @@ namespace ompl
             void sampleUniformIgnoreBounds(State* statePtr, const Cost& minCost, const Cost& maxCost);
 
             //Variables
-            /** \brief The prolate hyperspheroid description of the sub problem */
-            ompl::ProlateHyperspheroidPtr phsPtr_;
+            /** \brief The prolate hyperspheroid descriptions of the sub problem, one per start-goal pair */
+            std::vector<ompl::ProlateHyperspheroidPtr> listPhsPtrs_;
+
+            /** \brief The subset of the PHSs that can contain a solution of the last cost passed to updatePhsDefinitions */
+            std::vector<ompl::ProlateHyperspheroidPtr> activePhsPtrs_;
+
+            /** \brief The sum of the measures of the active PHSs */
+            double summedMeasure_;
+
+            /** \brief The cost for which the active PHSs were last calculated */
+            double activeCost_;
+
+            /** \brief The fraction of candidate samples accepted during the most recent batch */
+            double acceptanceRate_;
 
             /** \brief The index of the subspace of a compound StateSpace for which we can do informed sampling. Unused if the StateSpace is not compound. */
             unsigned int informedIdx_;
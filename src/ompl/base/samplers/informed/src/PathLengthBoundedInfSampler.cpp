@@ -0,0 +1,166 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2015, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "ompl/base/samplers/informed/PathLengthBoundedInfSampler.h"
+#include "ompl/base/OptimizationObjective.h"
+#include "ompl/util/Exception.h"
+//For std::isfinite
+#include <cmath>
+//For boost::make_shared
+#include "boost/make_shared.hpp"
+
+namespace ompl
+{
+    namespace base
+    {
+        PathLengthBoundedInfSampler::PathLengthBoundedInfSampler(const StateSpace* space, const ProblemDefinitionPtr probDefn, const Cost* bestCost)
+          : InformedStateSampler(space, probDefn, bestCost),
+            costPerLength_(0.0),
+            acceptanceRate_(1.0)
+        {
+            //Get the lower bound on the cost of a unit of path length
+            costPerLength_ = InformedStateSampler::opt_->getCostPerLengthLowerBound();
+
+            //A bound of zero gives no information about the path length
+            if (costPerLength_ <= 0.0 || std::isfinite(costPerLength_) == false)
+            {
+                throw Exception("PathLengthBoundedInfSampler: The optimization objective must provide a positive and finite cost-per-length lower bound.");
+            }
+            //No else
+
+            //Create the direct sampler of the conservative region. This throws if the problem is not supported.
+            phsSampler_ = boost::make_shared<PathLengthDirectInfSampler>(space, probDefn, bestCost);
+
+            //Set it's seed to the same as mine
+            phsSampler_->setLocalSeed( this->getLocalSeed() );
+        }
+
+        void PathLengthBoundedInfSampler::sampleUniform(State* statePtr, const Cost& maxCost)
+        {
+            //Sample from the conservative region as long as the heuristic estimate of solution cost through the sample is worse than maxCost.
+            //If maxCost is not finite, neither is the maximum path length and the first sample is kept.
+            do
+            {
+                phsSampler_->sampleUniform(statePtr, this->maxPathLength(maxCost));
+            }
+            while ( InformedStateSampler::opt_->isCostWorseThan(InformedStateSampler::heuristicSolnCost(statePtr), maxCost) );
+        }
+
+        void PathLengthBoundedInfSampler::sampleUniform(State* statePtr, const Cost& minCost, const Cost& maxCost)
+        {
+            //Sample from the larger cost bound as long as the heuristic estimate of the solution cost through sample is better than the smaller bound.
+            do
+            {
+                this->sampleUniform(statePtr, maxCost);
+            }
+            while ( InformedStateSampler::opt_->isCostBetterThan(this->heuristicSolnCost(statePtr), minCost) );
+        }
+
+        void PathLengthBoundedInfSampler::sampleUniformBatch(const std::vector<State*>& statePtrs, const Cost& maxCost)
+        {
+            //Variables
+            //The maximum length of a better path
+            Cost maxLength = this->maxPathLength(maxCost);
+            //The number of samples drawn from the conservative region
+            unsigned int numDrawn = statePtrs.size();
+
+            //Draw the whole batch from the conservative region at once
+            phsSampler_->sampleUniformBatch(statePtrs, maxLength);
+
+            //Redraw the states that can not improve the solution
+            for (unsigned int i = 0u; i < statePtrs.size(); ++i)
+            {
+                while ( InformedStateSampler::opt_->isCostWorseThan(InformedStateSampler::heuristicSolnCost(statePtrs.at(i)), maxCost) )
+                {
+                    phsSampler_->sampleUniform(statePtrs.at(i), maxLength);
+                    ++numDrawn;
+                }
+            }
+
+            //Combine the acceptance rates of the conservative region and the heuristic test
+            if (numDrawn > 0u)
+            {
+                acceptanceRate_ = phsSampler_->getAcceptanceRate() * static_cast<double>(statePtrs.size()) / static_cast<double>(numDrawn);
+            }
+            //No else, empty batch
+        }
+
+        double PathLengthBoundedInfSampler::getAcceptanceRate() const
+        {
+            return acceptanceRate_;
+        }
+
+        bool PathLengthBoundedInfSampler::hasInformedMeasure() const
+        {
+            return true;
+        }
+
+        double PathLengthBoundedInfSampler::getInformedMeasure(const Cost& currentCost) const
+        {
+            //The measure of the conservative region
+            return phsSampler_->getInformedMeasure(this->maxPathLength(currentCost));
+        }
+
+        Cost PathLengthBoundedInfSampler::heuristicSolnCost(const State* statePtr) const
+        {
+            //Both heuristics are admissible, so the worse of the two is as well
+            Cost objHeuristic = InformedStateSampler::heuristicSolnCost(statePtr);
+            Cost lengthHeuristic = Cost(costPerLength_ * phsSampler_->heuristicSolnCost(statePtr).value());
+
+            if (InformedStateSampler::opt_->isCostWorseThan(lengthHeuristic, objHeuristic))
+            {
+                return lengthHeuristic;
+            }
+            else
+            {
+                return objHeuristic;
+            }
+        }
+
+        void PathLengthBoundedInfSampler::setLocalSeed(boost::uint32_t localSeed)
+        {
+            //Set the seed of my base class, i.e., my rng_ member variable
+            StateSampler::setLocalSeed(localSeed);
+
+            //Set the seed for my member sub-samplers as well:
+            phsSampler_->setLocalSeed( this->getLocalSeed() );
+        }
+
+        Cost PathLengthBoundedInfSampler::maxPathLength(const Cost& maxCost) const
+        {
+            //Every unit of path length costs at least costPerLength_
+            return Cost(maxCost.value() / costPerLength_);
+        }
+    }; //base
+};  //ompl
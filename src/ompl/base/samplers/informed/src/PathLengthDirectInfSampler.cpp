@@ -36,13 +36,22 @@
 
 #include "ompl/base/samplers/informed/PathLengthDirectInfSampler.h"
 #include "ompl/util/Exception.h"
+#include "ompl/util/Console.h"
 #include "ompl/base/OptimizationObjective.h"
 #include "ompl/base/goals/GoalState.h"
+#include "ompl/base/goals/GoalStates.h"
 #include "ompl/base/StateSpace.h"
 #include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/tools/config/MagicConstants.h"
 
 //For strncmp
 #include <string.h>
+//For std::numeric_limits
+#include <limits>
+//For std::copy
+#include <algorithm>
+//For batches of points
+#include <Eigen/Core>
 //For boost::make_shared
 #include "boost/make_shared.hpp"
 
@@ -53,24 +62,22 @@ namespace ompl
         //The direct ellipsoid sampling class for path-length:
         PathLengthDirectInfSampler::PathLengthDirectInfSampler(const StateSpace* space, const ProblemDefinitionPtr probDefn, const Cost* bestCost)
           : InformedStateSampler(space, probDefn, bestCost),
+            summedMeasure_(0.0),
+            activeCost_(std::numeric_limits<double>::infinity()),
+            acceptanceRate_(1.0),
             informedIdx_(0u),
             uninformedIdx_(0u)
         {
             //Variables
-            //The foci of the ellipse as State* s
-            State* startFocusState;
-            State* goalFocusState;
-            //The foci of the ellipse as std::vectors
+            //The foci of the ellipses as State* s
+            std::vector<const State*> startFocusStates;
+            std::vector<const State*> goalFocusStates;
+            //The foci of the ellipses as std::vectors
             std::vector<double> startFocusVector;
             std::vector<double> goalFocusVector;
 
             //Sanity check the problem.
-            if (probDefn_->getStartStateCount() != 1u)
-            {
-                throw Exception("The direct path-length informed sampler currently only supports 1 start state.");
-            }
-
-            if (probDefn_->getGoal()->hasType(GOAL_STATE) == false)
+            if (probDefn_->getGoal()->hasType(GOAL_STATE) == false && probDefn_->getGoal()->hasType(GOAL_STATES) == false)
             {
                 throw Exception("The direct path-length informed sampler currently only supports goals that can be cast to goal states.");
             }
@@ -144,15 +151,34 @@ namespace ompl
             //Set it's seed to the same as mine
             baseSampler_->setLocalSeed( this->getLocalSeed() );
 
+            //Store the full start and goal states
+            for (unsigned int i = 0u; i < probDefn_->getStartStateCount(); ++i)
+            {
+                startFocusStates.push_back(probDefn_->getStartState(i));
+            }
+
+            if (probDefn_->getGoal()->hasType(GOAL_STATE) == true)
+            {
+                goalFocusStates.push_back(probDefn_->getGoal()->as<GoalState>()->getState());
+            }
+            else
+            {
+                for (unsigned int i = 0u; i < probDefn_->getGoal()->as<GoalStates>()->getStateCount(); ++i)
+                {
+                    goalFocusStates.push_back(probDefn_->getGoal()->as<GoalStates>()->getState(i));
+                }
+            }
+
+            if (goalFocusStates.empty() == true)
+            {
+                throw Exception("The direct path-length informed sampler requires at least 1 goal state at construction.");
+            }
+
             //Check if the space is compound
             if (StateSampler::space_->isCompound() == false)
             {
                 //It is not.
 
-                //Store the foci
-                startFocusState = probDefn_->getStartState(0u);
-                goalFocusState = probDefn_->getGoal()->as<GoalState>()->getState();
-
                 //The informed subspace is the full space
                 informedSubSpace_ = StateSampler::space_;
 
@@ -162,9 +188,16 @@ namespace ompl
             }
             else
             {
-                //Store the foci
-                startFocusState = probDefn_->getStartState(0u)->as<CompoundState>()->components[informedIdx_];
-                goalFocusState = probDefn_->getGoal()->as<GoalState>()->getState()->as<CompoundState>()->components[informedIdx_];
+                //The foci are the informed components of the states
+                for (unsigned int i = 0u; i < startFocusStates.size(); ++i)
+                {
+                    startFocusStates.at(i) = startFocusStates.at(i)->as<CompoundState>()->components[informedIdx_];
+                }
+
+                for (unsigned int i = 0u; i < goalFocusStates.size(); ++i)
+                {
+                    goalFocusStates.at(i) = goalFocusStates.at(i)->as<CompoundState>()->components[informedIdx_];
+                }
 
                 //The informed subset is the real vector space. StateSampler::space_ is a raw pointer, so for this variable to be able to hold all of space_, we need to store the raw pointer to the subspace...
                 informedSubSpace_ = StateSampler::space_->as<CompoundStateSpace>()->getSubspace(informedIdx_).get();
@@ -179,12 +212,18 @@ namespace ompl
                 uninformedSubSampler_->setLocalSeed( this->getLocalSeed() );
             }
 
-            //Now extract the foci of the ellipse
-            informedSubSpace_->copyToReals(startFocusVector, startFocusState);
-            informedSubSpace_->copyToReals(goalFocusVector, goalFocusState);
+            //Now create the definition of the PHS for every start-goal pair
+            for (unsigned int i = 0u; i < startFocusStates.size(); ++i)
+            {
+                informedSubSpace_->copyToReals(startFocusVector, startFocusStates.at(i));
+
+                for (unsigned int j = 0u; j < goalFocusStates.size(); ++j)
+                {
+                    informedSubSpace_->copyToReals(goalFocusVector, goalFocusStates.at(j));
 
-            //Create the definition of the PHS
-            phsPtr_ = boost::make_shared<ProlateHyperspheroid>(informedSubSpace_->getDimension(), &startFocusVector[0], &goalFocusVector[0]);
+                    listPhsPtrs_.push_back( boost::make_shared<ProlateHyperspheroid>(informedSubSpace_->getDimension(), &startFocusVector[0], &goalFocusVector[0]) );
+                }
+            }
         }
 
         PathLengthDirectInfSampler::~PathLengthDirectInfSampler()
@@ -203,42 +242,33 @@ namespace ompl
             }
             else //We have a solution
             {
-                //Set the new transverse diameter
-                phsPtr_->setTransverseDiameter(maxCost.value());
+                //Set the new transverse diameters
+                this->updatePhsDefinitions(maxCost);
 
-                //Check whether the problem domain (i.e., StateSpace) or PHS has the smaller measure. Sample the smaller directly and reject from the larger.
-                if (informedSubSpace_->getMeasure() <= phsPtr_->getPhsMeasure())
+                //Check whether the problem domain (i.e., StateSpace) or PHSs have the smaller measure. Sample the smaller directly and reject from the larger.
+                if (informedSubSpace_->getMeasure() <= summedMeasure_)
                 {
-                    //The PHS is larger than the subspace, just sample from the subspace directly.
+                    //The PHSs are larger than the subspace, just sample from the subspace directly.
                     //Variables
                     //The informed subset of the sample as a vector
                     std::vector<double> informedVector(informedSubSpace_->getDimension());
 
-                    //Sample from the state space until the sample is in the PHS
+                    //Sample from the state space until the sample is in a PHS
                     do
                     {
                         //Generate a random sample
                         baseSampler_->sampleUniform(statePtr);
 
-                        //Is there an extra "uninformed" subspace to trim off before comparing to the PHS?
-                        if ( StateSampler::space_->isCompound() == false )
-                        {
-                            //No, space_ == informedSubSpace_
-                            informedSubSpace_->copyToReals(informedVector, statePtr);
-                        }
-                        else
-                        {
-                            //Yes, we need to do some work to extract the subspace
-                            informedSubSpace_->copyToReals(informedVector, statePtr->as<CompoundState>()->components[informedIdx_]);
-                        }
+                        //Extract the informed subspace
+                        this->getInformedVector(statePtr, &informedVector);
                     }
-                    //Check if the informed state is in the PHS
-                    while ( phsPtr_->isInPhs(informedSubSpace_->getDimension(), &informedVector[0]) == false );
+                    //Check if the informed state is in a PHS
+                    while ( this->isInAnyPhs(&informedVector[0]) == false );
                 }
                 else
                 {
-                    //The PHS has a smaller volume than the subspace.
-                    //Sample from within the PHS until the sample is in the state space
+                    //The PHSs have a smaller volume than the subspace.
+                    //Sample from within the PHSs until the sample is in the state space
                     do
                     {
                         this->sampleUniformIgnoreBounds(statePtr, maxCost);
@@ -261,6 +291,135 @@ namespace ompl
 
 
 
+        void PathLengthDirectInfSampler::sampleUniformBatch(const std::vector<State*>& statePtrs, const Cost& maxCost)
+        {
+            //Check if a solution path has been found
+            if (std::isfinite(maxCost.value()) == false)
+            {
+                //We don't have a solution yet, we sample from our basic sampler instead, which accepts every sample...
+                for (unsigned int i = 0u; i < statePtrs.size(); ++i)
+                {
+                    baseSampler_->sampleUniform(statePtrs.at(i));
+                }
+
+                acceptanceRate_ = 1.0;
+            }
+            else //We have a solution
+            {
+                //Variables
+                //The dimension of the informed subspace
+                unsigned int dim = informedSubSpace_->getDimension();
+                //The informed subset of a sample as a vector
+                std::vector<double> informedVector(dim);
+                //The number of states generated so far
+                unsigned int numAccepted = 0u;
+                //The number of candidates examined so far
+                unsigned int numExamined = 0u;
+
+                //Set the new transverse diameters
+                this->updatePhsDefinitions(maxCost);
+
+                //Check whether the problem domain (i.e., StateSpace) or PHSs have the smaller measure. Sample the smaller directly and reject from the larger.
+                if (informedSubSpace_->getMeasure() <= summedMeasure_)
+                {
+                    //The PHSs are larger than the subspace, sample from the subspace directly, one state at a time.
+                    for (numAccepted = 0u; numAccepted < statePtrs.size(); ++numAccepted)
+                    {
+                        do
+                        {
+                            baseSampler_->sampleUniform(statePtrs.at(numAccepted));
+                            this->getInformedVector(statePtrs.at(numAccepted), &informedVector);
+                            ++numExamined;
+                        }
+                        while ( this->isInAnyPhs(&informedVector[0]) == false );
+                    }
+                }
+                else
+                {
+                    //The PHSs have a smaller volume than the subspace, sample them in blocks and reject those outside the bounds.
+                    //Variables
+                    //The bounds of the informed subspace, which is always a RealVectorStateSpace
+                    const RealVectorBounds& bounds = informedSubSpace_->as<RealVectorStateSpace>()->getBounds();
+                    //Eigen views of the bounds
+                    Eigen::Map<const Eigen::VectorXd> lowerBound(&bounds.low[0], dim);
+                    Eigen::Map<const Eigen::VectorXd> upperBound(&bounds.high[0], dim);
+
+                    while (numAccepted < statePtrs.size())
+                    {
+                        //Variables
+                        //The number of candidates to draw, scaled up by the last measured acceptance rate
+                        unsigned int numCandidates = static_cast<unsigned int>(std::ceil(static_cast<double>(statePtrs.size() - numAccepted)/std::max(acceptanceRate_, magic::MIN_BATCH_ACCEPTANCE_RATE)));
+                        //The PHS from which each candidate is drawn
+                        std::vector<unsigned int> candidatePhs(numCandidates);
+                        //The number of candidates drawn from each PHS
+                        std::vector<unsigned int> numPerPhs(activePhsPtrs_.size(), 0u);
+                        //The candidates of each PHS, one per column
+                        std::vector<Eigen::MatrixXd> phsCandidates(activePhsPtrs_.size());
+                        //Whether the candidates of each PHS are within bounds
+                        std::vector<Eigen::Array<bool, 1, Eigen::Dynamic> > phsInBounds(activePhsPtrs_.size());
+                        //The next unused candidate of each PHS
+                        std::vector<unsigned int> nextPerPhs(activePhsPtrs_.size(), 0u);
+
+                        //Assign each candidate to a PHS with probability proportional to its measure
+                        for (unsigned int i = 0u; i < numCandidates; ++i)
+                        {
+                            candidatePhs.at(i) = this->selectActivePhs();
+                            ++numPerPhs.at(candidatePhs.at(i));
+                        }
+
+                        //Draw the candidates of each PHS with one matrix-matrix product and test their bounds in one pass
+                        for (unsigned int i = 0u; i < activePhsPtrs_.size(); ++i)
+                        {
+                            if (numPerPhs.at(i) > 0u)
+                            {
+                                phsCandidates.at(i).resize(dim, numPerPhs.at(i));
+
+                                rng_.uniformProlateHyperspheroid(activePhsPtrs_.at(i), dim, numPerPhs.at(i), phsCandidates.at(i).data());
+
+                                phsInBounds.at(i) = ((phsCandidates.at(i).colwise() - lowerBound).array() >= 0.0).colwise().all() && ((phsCandidates.at(i).colwise() - upperBound).array() <= 0.0).colwise().all();
+                            }
+                            //No else, nothing to draw from this PHS
+                        }
+
+                        //Consider the candidates in the order they were assigned so that stopping early does not bias the batch towards any PHS
+                        for (unsigned int i = 0u; i < numCandidates && numAccepted < statePtrs.size(); ++i)
+                        {
+                            //Variables
+                            //The PHS of this candidate
+                            unsigned int phsIdx = candidatePhs.at(i);
+                            //The column of this candidate
+                            unsigned int colIdx = nextPerPhs.at(phsIdx);
+
+                            ++nextPerPhs.at(phsIdx);
+                            ++numExamined;
+
+                            if (phsInBounds.at(phsIdx)(colIdx) == true && this->keepSample(phsCandidates.at(phsIdx).col(colIdx).data(), phsIdx) == true)
+                            {
+                                std::copy(phsCandidates.at(phsIdx).col(colIdx).data(), phsCandidates.at(phsIdx).col(colIdx).data() + dim, informedVector.begin());
+
+                                this->setInformedValues(statePtrs.at(numAccepted), informedVector);
+
+                                ++numAccepted;
+                            }
+                            //No else, rejected
+                        }
+                    }
+                }
+
+                //Store the measured acceptance rate
+                if (numExamined > 0u)
+                {
+                    acceptanceRate_ = static_cast<double>(numAccepted)/static_cast<double>(numExamined);
+                }
+                //No else, an empty batch tells us nothing
+            }
+        }
+
+        double PathLengthDirectInfSampler::getAcceptanceRate() const
+        {
+            return acceptanceRate_;
+        }
+
         bool PathLengthDirectInfSampler::hasInformedMeasure() const
         {
             return true;
@@ -274,8 +433,21 @@ namespace ompl
             //The measure of the informed set
             double informedMeasure;
 
-            //The informed measure is then the measure of the PHS for the given cost:
-            informedMeasure = phsPtr_->getPhsMeasure(currentCost.value());
+            //Without a solution, the informed set is the entire space
+            if (std::isfinite(currentCost.value()) == false)
+            {
+                return StateSampler::space_->getMeasure();
+            }
+
+            //The informed measure is then the sum of the measures of the PHSs that can contain a solution of the given cost:
+            informedMeasure = 0.0;
+            for (unsigned int i = 0u; i < listPhsPtrs_.size(); ++i)
+            {
+                if (listPhsPtrs_.at(i)->getMinTransverseDiameter() <= currentCost.value())
+                {
+                    informedMeasure = informedMeasure + listPhsPtrs_.at(i)->getPhsMeasure(currentCost.value());
+                }
+            }
 
             //And if the space is compound, further multiplied by the measure of the uniformed subspace
             if ( StateSampler::space_->isCompound() == true )
@@ -306,13 +478,132 @@ namespace ompl
             //Variable
             //The informed subset of the sample as a vector
             std::vector<double> informedVector(informedSubSpace_->getDimension());
+            //The index of the PHS that was sampled
+            unsigned int phsIdx;
 
-            //Set the new transverse diameter
-            phsPtr_->setTransverseDiameter(maxCost.value());
+            //Set the new transverse diameters
+            this->updatePhsDefinitions(maxCost);
 
-            //Sample the ellipse
-            rng_.uniformProlateHyperspheroid(phsPtr_, informedSubSpace_->getDimension(), &informedVector[0]);
+            //Sample the union of the PHSs until the sample is not in an overlapping region that belongs to an earlier PHS
+            do
+            {
+                //Select a PHS with probability proportional to its measure
+                phsIdx = this->selectActivePhs();
+
+                //Sample the ellipse
+                rng_.uniformProlateHyperspheroid(activePhsPtrs_.at(phsIdx), informedSubSpace_->getDimension(), &informedVector[0]);
+            }
+            while ( this->keepSample(&informedVector[0], phsIdx) == false );
 
+            //Copy into the state pointer
+            this->setInformedValues(statePtr, informedVector);
+        }
+
+        void PathLengthDirectInfSampler::sampleUniformIgnoreBounds(State* statePtr, const Cost& minCost, const Cost& maxCost)
+        {
+            //Sample from the larger PHS until the sample does not lie within the smaller PHS.
+            //Since volume in a sphere/spheroid is proportionately concentrated near the surface, this isn't horribly inefficient, though a direct method would be better
+            do
+            {
+                this->sampleUniformIgnoreBounds(statePtr, maxCost);
+            }
+            while ( InformedStateSampler::opt_->isCostBetterThan(this->heuristicSolnCost(statePtr), minCost) );
+        }
+
+
+        Cost PathLengthDirectInfSampler::heuristicSolnCost(const State* statePtr) const
+        {
+            //Variable
+            //The raw data in the state
+            std::vector<double> rawData(informedSubSpace_->getDimension());
+            //The best path length through the state
+            double bestLength = std::numeric_limits<double>::infinity();
+
+            //Get the raw data
+            this->getInformedVector(statePtr, &rawData);
+
+            //Calculate the length through every start-goal pair and return the shortest
+            for (unsigned int i = 0u; i < listPhsPtrs_.size(); ++i)
+            {
+                bestLength = std::min(bestLength, listPhsPtrs_.at(i)->getPathLength(informedSubSpace_->getDimension(), &rawData[0]));
+            }
+
+            return Cost(bestLength);
+        }
+
+        void PathLengthDirectInfSampler::updatePhsDefinitions(const Cost& maxCost)
+        {
+            //Only update if the cost has changed
+            if (maxCost.value() != activeCost_)
+            {
+                //Reset the active set
+                activePhsPtrs_.clear();
+                summedMeasure_ = 0.0;
+
+                //Iterate over the list of PHSs, keeping those that can contain a solution of the given cost. A cost equal to the distance between the foci is the straight line between them.
+                for (unsigned int i = 0u; i < listPhsPtrs_.size(); ++i)
+                {
+                    if (listPhsPtrs_.at(i)->getMinTransverseDiameter() <= maxCost.value())
+                    {
+                        listPhsPtrs_.at(i)->setTransverseDiameter(maxCost.value());
+
+                        activePhsPtrs_.push_back(listPhsPtrs_.at(i));
+
+                        summedMeasure_ = summedMeasure_ + listPhsPtrs_.at(i)->getPhsMeasure();
+                    }
+                    //No else, this start-goal pair cannot provide a better solution
+                }
+
+                //If the cost is less than the distance between every start-goal pair (e.g., through numerical error), fall back to the straight line between the closest pair:
+                if (activePhsPtrs_.empty() == true)
+                {
+                    //Variable
+                    //The index of the closest pair
+                    unsigned int closestIdx = 0u;
+
+                    OMPL_WARN("PathLengthDirectInfSampler: The cost %f is less than the distance between every start-goal pair. Sampling the line between the closest pair.", maxCost.value());
+
+                    for (unsigned int i = 1u; i < listPhsPtrs_.size(); ++i)
+                    {
+                        if (listPhsPtrs_.at(i)->getMinTransverseDiameter() < listPhsPtrs_.at(closestIdx)->getMinTransverseDiameter())
+                        {
+                            closestIdx = i;
+                        }
+                    }
+
+                    listPhsPtrs_.at(closestIdx)->setTransverseDiameter(listPhsPtrs_.at(closestIdx)->getMinTransverseDiameter());
+
+                    activePhsPtrs_.push_back(listPhsPtrs_.at(closestIdx));
+
+                    summedMeasure_ = listPhsPtrs_.at(closestIdx)->getPhsMeasure();
+                }
+
+                //Store the cost
+                activeCost_ = maxCost.value();
+            }
+            //No else, the active set is up to date
+        }
+
+        unsigned int PathLengthDirectInfSampler::selectActivePhs()
+        {
+            //Variables
+            //A random value in [0, summed measure)
+            double randomMeasure = rng_.uniformReal(0.0, summedMeasure_);
+            //The selected PHS
+            unsigned int phsIdx = 0u;
+
+            //Walk the active PHSs until the random value falls within one's measure
+            while (phsIdx + 1u < activePhsPtrs_.size() && randomMeasure > activePhsPtrs_.at(phsIdx)->getPhsMeasure())
+            {
+                randomMeasure = randomMeasure - activePhsPtrs_.at(phsIdx)->getPhsMeasure();
+                ++phsIdx;
+            }
+
+            return phsIdx;
+        }
+
+        void PathLengthDirectInfSampler::setInformedValues(State* statePtr, const std::vector<double>& informedVector)
+        {
             //If there is an extra "uninformed" subspace, we need to add that to the state before converting the raw vector representation into a state....
             if ( StateSampler::space_->isCompound() == false )
             {
@@ -341,36 +632,46 @@ namespace ompl
             }
         }
 
-        void PathLengthDirectInfSampler::sampleUniformIgnoreBounds(State* statePtr, const Cost& minCost, const Cost& maxCost)
+        void PathLengthDirectInfSampler::getInformedVector(const State* statePtr, std::vector<double>* informedVector) const
         {
-            //Sample from the larger PHS until the sample does not lie within the smaller PHS.
-            //Since volume in a sphere/spheroid is proportionately concentrated near the surface, this isn't horribly inefficient, though a direct method would be better
-            do
+            //Is there an extra "uninformed" subspace to trim off?
+            if ( StateSampler::space_->isCompound() == false )
             {
-                this->sampleUniformIgnoreBounds(statePtr, maxCost);
+                //No, space_ == informedSubSpace_
+                informedSubSpace_->copyToReals(*informedVector, statePtr);
+            }
+            else
+            {
+                //Yes, we need to do some work to extract the subspace
+                informedSubSpace_->copyToReals(*informedVector, statePtr->as<CompoundState>()->components[informedIdx_]);
             }
-            while ( InformedStateSampler::opt_->isCostBetterThan(this->heuristicSolnCost(statePtr), minCost) );
         }
 
-
-        Cost PathLengthDirectInfSampler::heuristicSolnCost(const State* statePtr) const
+        bool PathLengthDirectInfSampler::isInAnyPhs(const double informedValues[]) const
         {
-            //Variable
-            //The raw data in the state
-            std::vector<double> rawData(informedSubSpace_->getDimension());
-
-            //Get the raw data
-            if ( StateSampler::space_->isCompound() == false )
+            for (unsigned int i = 0u; i < activePhsPtrs_.size(); ++i)
             {
-                informedSubSpace_->copyToReals(rawData, statePtr);
+                if (activePhsPtrs_.at(i)->isInPhs(informedSubSpace_->getDimension(), informedValues) == true)
+                {
+                    return true;
+                }
             }
-            else
+
+            return false;
+        }
+
+        bool PathLengthDirectInfSampler::keepSample(const double informedValues[], unsigned int phsIdx) const
+        {
+            //The sample is rejected if it also belongs to a PHS earlier in the list, as that PHS already accounts for this region
+            for (unsigned int i = 0u; i < phsIdx; ++i)
             {
-                informedSubSpace_->copyToReals(rawData, statePtr->as<CompoundState>()->components[informedIdx_]);
+                if (activePhsPtrs_.at(i)->isInPhs(informedSubSpace_->getDimension(), informedValues) == true)
+                {
+                    return false;
+                }
             }
 
-            //Calculate and return the length
-            return Cost(phsPtr_->getPathLength(informedSubSpace_->getDimension(), &rawData[0]));
+            return true;
         }
 
     }; //base
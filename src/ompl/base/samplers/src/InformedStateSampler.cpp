@@ -52,7 +52,7 @@ namespace ompl
         {
             //Sanity check the problem.
             //Check that we were given a valid pointer
-            if (bestCostPtr_ == false)
+            if (bestCostPtr_ == NULL)
             {
                 throw Exception ("InformedStateSampler: The cost pointer must be valid at construction.");
             }
@@ -65,15 +65,11 @@ namespace ompl
             }
             //No else
 
-            //Make sure we have at least one start and warn if we have more than one
+            //Make sure we have at least one start
             if (probDefn_->getStartStateCount() == 0u)
             {
                 throw Exception ("InformedStateSampler: At least one start state must be specified at construction.");
             }
-            else if (probDefn_->getStartStateCount() > 1u)
-            {
-                OMPL_WARN("InformedStateSampler: More than 1 start state present. Informed samplers will only use the first.");
-            }
             //No else
 
             //Store the optimization objective for later ease.
@@ -86,6 +82,27 @@ namespace ompl
             this->sampleUniform(statePtr, *bestCostPtr_);
         }
 
+        void InformedStateSampler::sampleUniformBatch(const std::vector<State*>& statePtrs)
+        {
+            //Call sample uniform batch with the current best cost, this function may be redefined in the deriving class
+            this->sampleUniformBatch(statePtrs, *bestCostPtr_);
+        }
+
+        void InformedStateSampler::sampleUniformBatch(const std::vector<State*>& statePtrs, const Cost& maxCost)
+        {
+            //Sample each state individually
+            for (unsigned int i = 0u; i < statePtrs.size(); ++i)
+            {
+                this->sampleUniform(statePtrs.at(i), maxCost);
+            }
+        }
+
+        double InformedStateSampler::getAcceptanceRate() const
+        {
+            //Rejections are not tracked by default
+            return 1.0;
+        }
+
         double InformedStateSampler::getInformedMeasure() const
         {
             //Get the informed measure for the current best solution
@@ -110,8 +127,18 @@ namespace ompl
 
         Cost InformedStateSampler::heuristicSolnCost(const State* statePtr) const
         {
+            //Variable
+            //The best heuristic estimate of the cost-to-come from any of the start states
+            Cost bestCostToCome = opt_->infiniteCost();
+
+            //Find the best cost-to-come from the start states
+            for (unsigned int i = 0u; i < probDefn_->getStartStateCount(); ++i)
+            {
+                bestCostToCome = opt_->minCost(bestCostToCome, opt_->motionCostHeuristic(probDefn_->getStartState(i), statePtr));
+            }
+
             //Combine heuristic estimates of the cost-to-come and cost-to-go from the state.
-            return opt_->combineCosts( opt_->motionCostHeuristic(probDefn_->getStartState(0u), statePtr), opt_->costToGo(statePtr, probDefn_->getGoal().get()) );
+            return opt_->combineCosts( bestCostToCome, opt_->costToGo(statePtr, probDefn_->getGoal().get()) );
         }
     }; //base
 };  //ompl
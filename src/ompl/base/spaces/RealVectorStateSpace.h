@@ -159,6 +159,8 @@ namespace ompl
 
             virtual unsigned int getSerializationLength() const;
 
+            virtual std::size_t getStateMemoryUsage() const;
+
             virtual void serialize(void *serialization, const State *state) const;
 
             virtual void deserialize(State *state, const void *serialization) const;
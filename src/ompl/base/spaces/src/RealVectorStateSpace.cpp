@@ -223,6 +223,11 @@ unsigned int ompl::base::RealVectorStateSpace::getSerializationLength() const
     return stateBytes_;
 }
 
+std::size_t ompl::base::RealVectorStateSpace::getStateMemoryUsage() const
+{
+    return sizeof(StateType) + stateBytes_;
+}
+
 void ompl::base::RealVectorStateSpace::serialize(void *serialization, const State *state) const
 {
     memcpy(serialization, state->as<StateType>()->values, stateBytes_);
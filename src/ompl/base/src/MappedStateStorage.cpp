@@ -0,0 +1,98 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2015, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "ompl/base/MappedStateStorage.h"
+#include "ompl/util/Exception.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <fstream>
+
+/// @cond IGNORE
+namespace
+{
+    // number of states the file is created for
+    const std::size_t INITIAL_CAPACITY = 1024;
+}
+/// @endcond
+
+ompl::base::MappedStateStorage::MappedStateStorage(const StateSpacePtr &space, const std::string &filename) :
+    space_(space), filename_(filename), recordLength_(space->getSerializationLength()), size_(0), capacity_(0)
+{
+    if (recordLength_ == 0)
+        throw Exception("State space '" + space_->getName() + "' does not support serialization");
+    if (filename_.empty())
+        filename_ = (boost::filesystem::temp_directory_path() /
+                     boost::filesystem::unique_path("ompl_states_%%%%-%%%%-%%%%-%%%%")).string();
+
+    std::ofstream out(filename_.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out.good())
+        throw Exception("Unable to create file '" + filename_ + "'");
+    out.close();
+    map(INITIAL_CAPACITY);
+}
+
+ompl::base::MappedStateStorage::~MappedStateStorage()
+{
+    region_.reset();
+    mapping_.reset();
+    boost::system::error_code ec;
+    boost::filesystem::remove(filename_, ec);
+}
+
+void ompl::base::MappedStateStorage::map(std::size_t capacity)
+{
+    // the old view has to be released before the file can be resized
+    region_.reset();
+    mapping_.reset();
+    boost::filesystem::resize_file(filename_, capacity * recordLength_);
+    mapping_.reset(new boost::interprocess::file_mapping(filename_.c_str(), boost::interprocess::read_write));
+    region_.reset(new boost::interprocess::mapped_region(*mapping_, boost::interprocess::read_write));
+    capacity_ = capacity;
+}
+
+std::size_t ompl::base::MappedStateStorage::store(const State *state)
+{
+    if (size_ == capacity_)
+        map(2 * capacity_);
+    space_->serialize(static_cast<char*>(region_->get_address()) + size_ * recordLength_, state);
+    return size_++;
+}
+
+void ompl::base::MappedStateStorage::load(std::size_t index, State *state) const
+{
+    if (index >= size_)
+        throw Exception("There is no stored state with this index");
+    space_->deserialize(state, static_cast<const char*>(region_->get_address()) + index * recordLength_);
+}
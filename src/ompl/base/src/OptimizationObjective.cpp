@@ -40,16 +40,23 @@
 #include "ompl/tools/config/MagicConstants.h"
 #include "ompl/base/goals/GoalRegion.h"
 #include "ompl/base/samplers/informed/RejectionInfSampler.h"
+#include "ompl/base/samplers/informed/PathLengthBoundedInfSampler.h"
 #include <limits>
 //For boost::make_shared
 #include "boost/make_shared.hpp"
 
 ompl::base::OptimizationObjective::OptimizationObjective(const SpaceInformationPtr &si) :
     si_(si),
-    threshold_(0.0)
+    threshold_(0.0),
+    cacheStateCosts_(false)
 {
 }
 
+ompl::base::OptimizationObjective::~OptimizationObjective()
+{
+    clearStateCostCache();
+}
+
 const std::string& ompl::base::OptimizationObjective::getDescription() const
 {
     return description_;
@@ -157,6 +164,124 @@ ompl::base::Cost ompl::base::OptimizationObjective::minCost(Cost c1, Cost c2) co
     }
 }
 
+void ompl::base::OptimizationObjective::stateCosts(const std::vector<State*> &states, std::vector<Cost> &costs) const
+{
+    costs.resize(states.size());
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+        costs[i] = this->stateCost(states[i]);
+}
+
+void ompl::base::OptimizationObjective::setStateCostCaching(bool flag)
+{
+    if (flag && !stateCostCache_)
+        stateCostCache_.reset(new StateCostCacheShard[magic::STATE_COST_CACHE_SHARDS]);
+    cacheStateCosts_ = flag;
+    if (!cacheStateCosts_)
+        clearStateCostCache();
+}
+
+bool ompl::base::OptimizationObjective::isStateCostCachingEnabled() const
+{
+    return cacheStateCosts_;
+}
+
+ompl::base::OptimizationObjective::StateCostCacheShard& ompl::base::OptimizationObjective::stateCostCacheShard(const State *s) const
+{
+    // states are allocated a fixed number of bytes apart, so their
+    // addresses are mixed before picking a shard to use all of them
+    std::size_t h = (reinterpret_cast<std::size_t>(s) >> 3) * 2654435761u;
+    return stateCostCache_[(h >> 16) % magic::STATE_COST_CACHE_SHARDS];
+}
+
+void ompl::base::OptimizationObjective::eraseCachedStateCost(StateCostCacheShard &shard,
+                                                             boost::unordered_map<const State*, CachedStateCost>::iterator it) const
+{
+    si_->freeState(it->second.state);
+    shard.lru.erase(it->second.lruPosition);
+    shard.entries.erase(it);
+}
+
+void ompl::base::OptimizationObjective::invalidateCachedStateCost(const State *s) const
+{
+    if (!stateCostCache_)
+        return;
+    StateCostCacheShard &shard = stateCostCacheShard(s);
+    boost::mutex::scoped_lock slock(shard.lock);
+    boost::unordered_map<const State*, CachedStateCost>::iterator it = shard.entries.find(s);
+    if (it != shard.entries.end())
+        eraseCachedStateCost(shard, it);
+}
+
+void ompl::base::OptimizationObjective::clearStateCostCache() const
+{
+    if (!stateCostCache_)
+        return;
+    for (unsigned int i = 0 ; i < magic::STATE_COST_CACHE_SHARDS ; ++i)
+    {
+        StateCostCacheShard &shard = stateCostCache_[i];
+        boost::mutex::scoped_lock slock(shard.lock);
+        for (boost::unordered_map<const State*, CachedStateCost>::iterator it = shard.entries.begin() ; it != shard.entries.end() ; ++it)
+            si_->freeState(it->second.state);
+        shard.entries.clear();
+        shard.lru.clear();
+    }
+}
+
+std::size_t ompl::base::OptimizationObjective::getStateCostCacheSize() const
+{
+    if (!stateCostCache_)
+        return 0;
+    std::size_t size = 0;
+    for (unsigned int i = 0 ; i < magic::STATE_COST_CACHE_SHARDS ; ++i)
+    {
+        boost::mutex::scoped_lock slock(stateCostCache_[i].lock);
+        size += stateCostCache_[i].entries.size();
+    }
+    return size;
+}
+
+ompl::base::Cost ompl::base::OptimizationObjective::cachedStateCost(const State *s) const
+{
+    if (!cacheStateCosts_)
+        return this->stateCost(s);
+
+    StateCostCacheShard &shard = stateCostCacheShard(s);
+    {
+        boost::mutex::scoped_lock slock(shard.lock);
+        boost::unordered_map<const State*, CachedStateCost>::iterator it = shard.entries.find(s);
+        // The pointer may have been freed and reused for a different state since the entry was added
+        if (it != shard.entries.end() && si_->equalStates(it->second.state, s))
+        {
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruPosition);
+            return it->second.cost;
+        }
+    }
+
+    // Evaluate outside of the lock, as this is the expensive part
+    Cost c = this->stateCost(s);
+
+    boost::mutex::scoped_lock slock(shard.lock);
+    boost::unordered_map<const State*, CachedStateCost>::iterator it = shard.entries.find(s);
+    if (it != shard.entries.end())
+    {
+        si_->copyState(it->second.state, s);
+        it->second.cost = c;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruPosition);
+        return c;
+    }
+
+    if (shard.entries.size() >= magic::MAX_STATE_COST_CACHE_SIZE / magic::STATE_COST_CACHE_SHARDS)
+        eraseCachedStateCost(shard, shard.entries.find(shard.lru.back()));
+
+    shard.lru.push_front(s);
+    CachedStateCost &entry = shard.entries[s];
+    entry.state = si_->cloneState(s);
+    entry.cost = c;
+    entry.lruPosition = shard.lru.begin();
+
+    return c;
+}
+
 ompl::base::Cost ompl::base::OptimizationObjective::combineCosts(Cost c1, Cost c2) const
 {
     return Cost(c1.value() + c2.value());
@@ -242,8 +367,26 @@ const ompl::base::SpaceInformationPtr& ompl::base::OptimizationObjective::getSpa
     return si_;
 }
 
+double ompl::base::OptimizationObjective::getCostPerLengthLowerBound() const
+{
+    return 0.0;
+}
+
 ompl::base::InformedStateSamplerPtr ompl::base::OptimizationObjective::allocInformedStateSampler(const StateSpace* space, const ProblemDefinitionPtr probDefn, const Cost* bestCost) const
 {
+    // If path length bounds the cost, sample the conservative region that it defines
+    if (getCostPerLengthLowerBound() > 0.0)
+    {
+        try
+        {
+            return boost::make_shared<PathLengthBoundedInfSampler>(space, probDefn, bestCost);
+        }
+        catch (Exception &e)
+        {
+            OMPL_DEBUG("%s: Cannot sample the path-length bounded region: %s", description_.c_str(), e.what());
+        }
+    }
+
     OMPL_WARN("%s: No direct informed sampling scheme is defined, defaulting to rejection sampling.", description_.c_str());
     return boost::make_shared<RejectionInfSampler>(space, probDefn, bestCost);
 }
@@ -348,6 +491,53 @@ ompl::base::Cost ompl::base::MultiOptimizationObjective::motionCost(const State
      return c;
 }
 
+bool ompl::base::MultiOptimizationObjective::hasNonnegativeWeights() const
+{
+    for (std::vector<Component>::const_iterator comp = components_.begin();
+         comp != components_.end();
+         ++comp)
+    {
+        if (comp->weight < 0.0)
+            return false;
+    }
+
+    return true;
+}
+
+ompl::base::Cost ompl::base::MultiOptimizationObjective::motionCostHeuristic(const State *s1,
+                                                                             const State *s2) const
+{
+    // A negatively weighted heuristic is no longer a lower bound
+    if (!hasNonnegativeWeights())
+        return this->identityCost();
+
+    Cost c = this->identityCost();
+    for (std::vector<Component>::const_iterator comp = components_.begin();
+         comp != components_.end();
+         ++comp)
+    {
+        c = Cost(c.value() + comp->weight * (comp->objective->motionCostHeuristic(s1, s2).value()));
+    }
+
+    return c;
+}
+
+double ompl::base::MultiOptimizationObjective::getCostPerLengthLowerBound() const
+{
+    if (!hasNonnegativeWeights())
+        return 0.0;
+
+    double k = 0.0;
+    for (std::vector<Component>::const_iterator comp = components_.begin();
+         comp != components_.end();
+         ++comp)
+    {
+        k += comp->weight * comp->objective->getCostPerLengthLowerBound();
+    }
+
+    return k;
+}
+
 ompl::base::OptimizationObjectivePtr ompl::base::operator+(const OptimizationObjectivePtr &a,
                                                            const OptimizationObjectivePtr &b)
 {
@@ -41,7 +41,7 @@
 #include <boost/thread.hpp>
 
 ompl::base::Planner::Planner(const SpaceInformationPtr &si, const std::string &name) :
-    si_(si), pis_(this), name_(name), setup_(false)
+    si_(si), pis_(this), name_(name), setup_(false), peakMemoryUsage_(0)
 {
     if (!si_)
         throw Exception(name_, "Invalid space information instance for planner");
@@ -113,6 +113,13 @@ void ompl::base::Planner::clear()
 {
     pis_.clear();
     pis_.update();
+    boost::mutex::scoped_lock slock(peakMemoryLock_);
+    peakMemoryUsage_ = 0;
+}
+
+void ompl::base::Planner::clearQuery()
+{
+    clear();
 }
 
 void ompl::base::Planner::getPlannerData(PlannerData &data) const
@@ -121,6 +128,44 @@ void ompl::base::Planner::getPlannerData(PlannerData &data) const
         data.properties[it->first] = it->second();
 }
 
+std::size_t ompl::base::Planner::getMemoryUsage() const
+{
+    return 0;
+}
+
+std::size_t ompl::base::Planner::getPeakMemoryUsage() const
+{
+    recordMemoryUsage();
+    boost::mutex::scoped_lock slock(peakMemoryLock_);
+    return peakMemoryUsage_;
+}
+
+void ompl::base::Planner::recordMemoryUsage() const
+{
+    std::size_t usage = getMemoryUsage();
+    boost::mutex::scoped_lock slock(peakMemoryLock_);
+    if (usage > peakMemoryUsage_)
+        peakMemoryUsage_ = usage;
+}
+
+void ompl::base::Planner::addMemoryUsageProgressProperties()
+{
+    addPlannerProgressProperty("memory usage INTEGER",
+                               boost::bind(&Planner::getMemoryUsageString, this));
+    addPlannerProgressProperty("peak memory usage INTEGER",
+                               boost::bind(&Planner::getPeakMemoryUsageString, this));
+}
+
+std::string ompl::base::Planner::getMemoryUsageString() const
+{
+    return boost::lexical_cast<std::string>(getMemoryUsage());
+}
+
+std::string ompl::base::Planner::getPeakMemoryUsageString() const
+{
+    return boost::lexical_cast<std::string>(getPeakMemoryUsage());
+}
+
 ompl::base::PlannerStatus ompl::base::Planner::solve(const PlannerTerminationConditionFn &ptc, double checkInterval)
 {
     return solve(PlannerTerminationCondition(ptc, checkInterval));
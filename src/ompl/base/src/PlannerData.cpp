@@ -44,12 +44,7 @@
 #include <boost/graph/graphviz.hpp>
 #include <boost/graph/graphml.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
-#include <boost/version.hpp>
-#if BOOST_VERSION < 105100
-#warning Boost version >=1.51 is needed for ompl::base::PlannerData::printGraphML
-#else
 #include <boost/property_map/function_property_map.hpp>
-#endif
 
 // This is a convenient macro to cast the void* graph pointer as the
 // Boost.Graph structure from PlannerDataGraph.h
@@ -210,6 +205,27 @@ unsigned int ompl::base::PlannerData::numEdges () const
     return boost::num_edges(*graph_);
 }
 
+std::size_t ompl::base::PlannerData::getMemoryUsage() const
+{
+    // nodes of std::map and std::set hold three pointers and a color besides their value
+    const std::size_t treeNodeBytes = 4 * sizeof(void*);
+
+    // a vertex is a property record with lists of out- and in-edges, the vertex object
+    // itself and its entry in stateIndexMap_
+    const std::size_t vertexBytes = sizeof(PlannerDataVertex*) + sizeof(unsigned int) + 2 * sizeof(std::vector<void*>) +
+        sizeof(PlannerDataVertex) + treeNodeBytes + sizeof(std::pair<const State*, unsigned int>);
+    // an edge is a list node with its end points and properties, an entry in the edge lists
+    // of both end points and the edge object itself
+    const std::size_t edgeBytes = 4 * sizeof(void*) + sizeof(PlannerDataEdge*) + sizeof(Cost) +
+        2 * (sizeof(std::size_t) + sizeof(void*)) + sizeof(PlannerDataEdge);
+
+    std::size_t bytes = numVertices() * vertexBytes + numEdges() * edgeBytes +
+        (startVertexIndices_.capacity() + goalVertexIndices_.capacity()) * sizeof(unsigned int);
+    if (!decoupledStates_.empty())
+        bytes += decoupledStates_.size() * (treeNodeBytes + sizeof(State*) + si_->getStateSpace()->getStateMemoryUsage());
+    return bytes;
+}
+
 const ompl::base::PlannerDataVertex& ompl::base::PlannerData::getVertex (unsigned int index) const
 {
     if (index >= boost::num_vertices(*graph_))
@@ -293,9 +309,6 @@ namespace
 
 void ompl::base::PlannerData::printGraphML (std::ostream& out) const
 {
-#if BOOST_VERSION < 105100
-    OMPL_WARN("Boost version >=1.51 is needed for ompl::base::PlannerData::printGraphML");
-#else
     // For some reason, make_function_property_map can't infer its
     // template arguments corresponding to edgeWeightAsDouble's type
     // signature. So, we have to use this horribly verbose
@@ -322,7 +335,6 @@ void ompl::base::PlannerData::printGraphML (std::ostream& out) const
     dp.property("coords", coordsmap);
 
     boost::write_graphml(out, *graph_, dp);
-#endif
 }
 
 unsigned int ompl::base::PlannerData::vertexIndex (const PlannerDataVertex &v) const
@@ -363,6 +363,11 @@ unsigned int ompl::base::StateSpace::getSerializationLength() const
     return 0;
 }
 
+std::size_t ompl::base::StateSpace::getStateMemoryUsage() const
+{
+    return sizeof(State) + getSerializationLength();
+}
+
 void ompl::base::StateSpace::serialize(void* /*serialization*/, const State* /*state*/) const
 {
 }
@@ -1027,6 +1032,14 @@ unsigned int ompl::base::CompoundStateSpace::getSerializationLength() const
     return l;
 }
 
+std::size_t ompl::base::CompoundStateSpace::getStateMemoryUsage() const
+{
+    std::size_t bytes = sizeof(StateType) + componentCount_ * sizeof(State*);
+    for (unsigned int i = 0 ; i < componentCount_ ; ++i)
+        bytes += components_[i]->getStateMemoryUsage();
+    return bytes;
+}
+
 void ompl::base::CompoundStateSpace::serialize(void *serialization, const State *state) const
 {
     const CompoundState *cstate = static_cast<const CompoundState*>(state);
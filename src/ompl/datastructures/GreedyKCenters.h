@@ -38,6 +38,9 @@
 #define OMPL_DATASTRUCTURES_GREEDY_K_CENTERS_
 
 #include "ompl/util/RandomNumbers.h"
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <algorithm>
 
 namespace ompl
 {
@@ -50,8 +53,10 @@ namespace ompl
     public:
         /** \brief The definition of a distance function */
         typedef boost::function<double(const _T&, const _T&)> DistanceFunction;
+        /** \brief A matrix type for storing distances between points and centers */
+        typedef Eigen::MatrixXd Matrix;
 
-        GreedyKCenters()
+        GreedyKCenters() : numThreads_(1), minParallelSize_(4096)
         {
         }
 
@@ -71,40 +76,70 @@ namespace ompl
             return distFun_;
         }
 
+        /** \brief Set the number of threads used to compute the distances to
+            each center. Threads are only used for at least getMinParallelSize()
+            data points, and the distance function must be thread safe. */
+        void setNumThreads(unsigned int numThreads)
+        {
+            numThreads_ = std::max(numThreads, 1u);
+        }
+
+        /** \brief Get the number of threads used to compute distances */
+        unsigned int getNumThreads() const
+        {
+            return numThreads_;
+        }
+
+        /** \brief Set the minimum number of data points for which the distances
+            are computed in parallel */
+        void setMinParallelSize(std::size_t minParallelSize)
+        {
+            minParallelSize_ = minParallelSize;
+        }
+
+        /** \brief Get the minimum number of data points for which the distances
+            are computed in parallel */
+        std::size_t getMinParallelSize() const
+        {
+            return minParallelSize_;
+        }
+
         /** \brief Greedy algorithm for selecting k centers
             \param data a vector of data points
             \param k the desired number of centers
             \param centers a vector of length k containing the indices into
                 data of the k centers
-            \param dists a 2-dimensional array such that dists[i][j] is the distance
-                between data[i] and data[center[j]]
+            \param dists a matrix such that dists(i,j) is the distance
+                between data[i] and data[center[j]]. It is only resized if it
+                is too small, so it can be reused across calls.
         */
         void kcenters(const std::vector<_T>& data, unsigned int k,
-            std::vector<unsigned int>& centers, std::vector<std::vector<double> >& dists)
+            std::vector<unsigned int>& centers, Matrix& dists)
         {
             // array containing the minimum distance between each data point
             // and the centers computed so far
-            std::vector<double> minDist(data.size(), std::numeric_limits<double>::infinity());
+            minDist_.assign(data.size(), std::numeric_limits<double>::infinity());
 
             centers.clear();
             centers.reserve(k);
-            dists.resize(data.size(), std::vector<double>(k));
+            if (dists.rows() < (int) data.size() || dists.cols() < (int) k)
+                dists.resize(std::max<int>(dists.rows(), data.size()), std::max<int>(dists.cols(), k));
             // first center is picked randomly
             centers.push_back(rng_.uniformInt(0, data.size() - 1));
             for (unsigned i=1; i<k; ++i)
             {
                 unsigned ind;
-                const _T& center = data[centers[i - 1]];
                 double maxDist = -std::numeric_limits<double>::infinity();
+                computeDistances(data, data[centers[i - 1]], dists.col(i - 1).data());
                 for (unsigned j=0; j<data.size(); ++j)
                 {
-                    if ((dists[j][i-1] = distFun_(data[j], center)) < minDist[j])
-                        minDist[j] = dists[j][i - 1];
+                    if (dists(j, i - 1) < minDist_[j])
+                        minDist_[j] = dists(j, i - 1);
                     // the j-th center is the one furthest away from center 0,..,j-1
-                    if (minDist[j] > maxDist)
+                    if (minDist_[j] > maxDist)
                     {
                         ind = j;
-                        maxDist = minDist[j];
+                        maxDist = minDist_[j];
                     }
                 }
                 // no more centers available
@@ -112,18 +147,50 @@ namespace ompl
                 centers.push_back(ind);
             }
 
-            const _T& center = data[centers.back()];
-            unsigned i = centers.size() - 1;
-            for (unsigned j = 0; j < data.size(); ++j)
-                dists[j][i] = distFun_(data[j], center);
+            computeDistances(data, data[centers.back()], dists.col(centers.size() - 1).data());
         }
 
     protected:
+        /** \brief Compute the distances between all data points and center,
+            splitting the work over several threads for large data sets. */
+        void computeDistances(const std::vector<_T>& data, const _T& center, double *dists) const
+        {
+            if (numThreads_ > 1 && data.size() >= minParallelSize_)
+            {
+                std::size_t chunk = (data.size() + numThreads_ - 1) / numThreads_;
+                boost::thread_group threads;
+                for (std::size_t begin = chunk; begin < data.size(); begin += chunk)
+                    threads.create_thread(boost::bind(&GreedyKCenters::computeDistancesRange, this,
+                        boost::cref(data), boost::cref(center), dists, begin, std::min(begin + chunk, data.size())));
+                computeDistancesRange(data, center, dists, 0, chunk);
+                threads.join_all();
+            }
+            else
+                computeDistancesRange(data, center, dists, 0, data.size());
+        }
+
+        /** \brief Compute the distances between data[begin],...,data[end-1] and center */
+        void computeDistancesRange(const std::vector<_T>& data, const _T& center, double *dists,
+            std::size_t begin, std::size_t end) const
+        {
+            for (std::size_t j = begin; j < end; ++j)
+                dists[j] = distFun_(data[j], center);
+        }
+
         /** \brief The used distance function */
-        DistanceFunction distFun_;
+        DistanceFunction    distFun_;
 
         /** Random number generator used to select first center */
-        RNG              rng_;
+        RNG                 rng_;
+
+        /** \brief The number of threads used to compute distances */
+        unsigned int        numThreads_;
+
+        /** \brief The minimum number of data points for which distances are computed in parallel */
+        std::size_t         minParallelSize_;
+
+        /** \brief Scratch space for the minimum distance of each point to the centers, reused across calls */
+        std::vector<double> minDist_;
     };
 }
 
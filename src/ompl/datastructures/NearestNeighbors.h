@@ -94,6 +94,29 @@ namespace ompl
         /** \brief Remove an element from the datastructure */
         virtual bool remove(const _T &data) = 0;
 
+        /** \brief Remove all the elements for which \e predicate returns true and return how many were removed.
+            If more elements are removed than kept, the datastructure is rebuilt once from the remaining
+            elements instead of removing them one at a time. */
+        virtual std::size_t removeIf(const boost::function<bool(const _T&)> &predicate)
+        {
+            std::vector<_T> elements, kept, removed;
+            list(elements);
+            for (typename std::vector<_T>::const_iterator elt = elements.begin() ; elt != elements.end() ; ++elt)
+                if (predicate(*elt))
+                    removed.push_back(*elt);
+                else
+                    kept.push_back(*elt);
+            if (removed.size() > kept.size())
+            {
+                clear();
+                add(kept);
+            }
+            else
+                for (typename std::vector<_T>::const_iterator elt = removed.begin() ; elt != removed.end() ; ++elt)
+                    remove(*elt);
+            return removed.size();
+        }
+
         /** \brief Get the nearest neighbor of a point */
         virtual _T nearest(const _T &data) const = 0;
 
@@ -114,6 +137,15 @@ namespace ompl
         /** \brief Get the number of elements in the datastructure */
         virtual std::size_t size() const = 0;
 
+        /** \brief Get an estimate of the number of bytes used by the datastructure.
+            Memory that the elements point to (e.g., states) is not included. The
+            estimate is cheap to compute, so it can be queried while the
+            datastructure is being used. */
+        virtual std::size_t getMemoryUsage() const
+        {
+            return size() * sizeof(_T);
+        }
+
         /** \brief Get all the elements in the datastructure */
         virtual void list(std::vector<_T> &data) const = 0;
 
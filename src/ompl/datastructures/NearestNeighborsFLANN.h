@@ -218,6 +218,11 @@ namespace ompl
             return index_ ? index_->size() : 0;
         }
 
+        virtual std::size_t getMemoryUsage() const
+        {
+            return data_.capacity() * sizeof(_T) + (index_ ? index_->usedMemory() : 0);
+        }
+
         virtual void list(std::vector<_T> &data) const
         {
             std::size_t sz = size();
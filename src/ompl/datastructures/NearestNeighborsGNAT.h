@@ -43,8 +43,11 @@
 #include "ompl/datastructures/PDF.h"
 #endif
 #include "ompl/util/Exception.h"
-#include <boost/unordered_set.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/atomic.hpp>
 #include <queue>
+#include <list>
 #include <algorithm>
 
 namespace ompl
@@ -98,6 +101,10 @@ namespace ompl
         /// \endcond
 
     public:
+        /// \brief Callback that moves the elements of a leaf out of memory
+        /// (see setLeafSpilling()), or brings them back.
+        typedef boost::function<void(const std::vector<_T>&)> LeafCallback;
+
         NearestNeighborsGNAT(unsigned int degree = 4, unsigned int minDegree = 2,
             unsigned int maxDegree = 6, unsigned int maxNumPtsPerLeaf = 50,
             unsigned int removedCacheSize = 50, bool rebalancing = false
@@ -107,9 +114,11 @@ namespace ompl
             )
             : NearestNeighbors<_T>(), tree_(NULL), degree_(degree),
             minDegree_(std::min(degree,minDegree)), maxDegree_(std::max(maxDegree,degree)),
-            maxNumPtsPerLeaf_(maxNumPtsPerLeaf), size_(0),
+            maxNumPtsPerLeaf_(maxNumPtsPerLeaf), size_(0), numNodes_(0), numLeaves_(0),
             rebuildSize_(rebalancing ? maxNumPtsPerLeaf*degree : std::numeric_limits<std::size_t>::max()),
-            removedCacheSize_(removedCacheSize)
+            removedCacheSize_(removedCacheSize), pruneScale_(1.), maxVisitedLeaves_(0),
+            numQueries_(0), numDistanceEvaluations_(0), maxResidentLeaves_(0),
+            numSpilledLeaves_(0), numLeafLoads_(0)
 #ifdef GNAT_SAMPLER
             , estimatedDimension_(estimatedDimension)
 #endif
@@ -138,7 +147,10 @@ namespace ompl
                 tree_ = NULL;
             }
             size_ = 0;
-            removed_.clear();
+            numNodes_ = numLeaves_ = 0;
+            residentLeaves_.clear();
+            numSpilledLeaves_ = 0;
+            pivotDists_.resize(0, 0);
             if (rebuildSize_ != std::numeric_limits<std::size_t>::max())
                 rebuildSize_ = maxNumPtsPerLeaf_ * degree_;
         }
@@ -148,19 +160,167 @@ namespace ompl
             return true;
         }
 
+        /// \brief Set the approximation factor \e epsilon (0 by default, i.e.,
+        /// exact queries). Subtrees are then only searched if they can contain
+        /// an element that is more than a factor (1 + \e epsilon) closer than
+        /// the current k-th nearest neighbor (or the radius for nearestR()).
+        /// The i-th neighbor returned by nearestK() is thus at most (1 + \e epsilon)
+        /// times further away than the true i-th nearest neighbor, while
+        /// nearestR() may miss elements at distances in (r / (1 + \e epsilon), r].
+        void setApproximationFactor(double epsilon)
+        {
+            if (epsilon < 0.)
+                throw Exception("The approximation factor of a GNAT cannot be negative");
+            pruneScale_ = 1. / (1. + epsilon);
+        }
+
+        /// \brief Get the approximation factor \e epsilon.
+        double getApproximationFactor() const
+        {
+            return 1. / pruneScale_ - 1.;
+        }
+
+        /// \brief Limit the number of leaves visited by a query (0, the
+        /// default, means no limit). Once the limit is reached, nearestK()
+        /// stops as soon as it has found k elements and nearestR() stops
+        /// immediately, so no error bound holds for queries that hit the limit.
+        void setMaxVisitedLeaves(unsigned int maxVisitedLeaves)
+        {
+            maxVisitedLeaves_ = maxVisitedLeaves;
+        }
+
+        /// \brief Get the maximum number of leaves visited by a query (0 means no limit).
+        unsigned int getMaxVisitedLeaves() const
+        {
+            return maxVisitedLeaves_;
+        }
+
+        /// \brief Get the number of nearest(), nearestK() and nearestR() queries
+        /// since construction or the last call to resetQueryStatistics().
+        /// Each query counts its distance evaluations locally and adds them
+        /// to the statistics when it completes, so concurrent queries are
+        /// counted exactly.
+        std::size_t getNumQueries() const
+        {
+            return numQueries_.load(boost::memory_order_relaxed);
+        }
+
+        /// \brief Get the number of distance evaluations performed by the
+        /// queries counted by getNumQueries().
+        std::size_t getNumDistanceEvaluations() const
+        {
+            return numDistanceEvaluations_.load(boost::memory_order_relaxed);
+        }
+
+        /// \brief Get the average number of distance evaluations per query.
+        /// If queries complete concurrently, the average may count the
+        /// distance evaluations of a query that is not counted yet.
+        double getAverageDistanceEvaluations() const
+        {
+            std::size_t numQueries = getNumQueries();
+            return numQueries ? (double) getNumDistanceEvaluations() / (double) numQueries : 0.;
+        }
+
+        /// \brief Reset the query statistics.
+        void resetQueryStatistics()
+        {
+            numQueries_.store(0, boost::memory_order_relaxed);
+            numDistanceEvaluations_.store(0, boost::memory_order_relaxed);
+        }
+
+        /// \brief Set the number of threads used to compute distances when
+        /// splitting large nodes (see GreedyKCenters::setNumThreads()). The
+        /// distance function must be thread safe if more than one is used.
+        void setNumSplitThreads(unsigned int numThreads)
+        {
+            pivotSelector_.setNumThreads(numThreads);
+        }
+
+        /// \brief Get the number of threads used to compute distances when splitting nodes.
+        unsigned int getNumSplitThreads() const
+        {
+            return pivotSelector_.getNumThreads();
+        }
+
+        /// \brief Keep the non-pivot elements of at most \e maxResidentLeaves
+        /// leaves in memory (0, the default, keeps all of them).
+        ///
+        /// The GNAT only stores the elements themselves (typically
+        /// pointers); \e spill is called with the elements of the least
+        /// recently used leaf when a leaf has to be moved out of memory,
+        /// and \e load is called with the same elements before the leaf is
+        /// used again. Pivots and the bounds of all nodes stay in memory,
+        /// so queries and sample() only load the leaves they actually
+        /// visit, and the distance function is never called with spilled
+        /// elements. Leaves are moved out of memory at the end of add()
+        /// and remove(), so the elements returned by a query or by
+        /// sample() stay in memory until the GNAT is modified. list()
+        /// does not load any leaves. Queries update the list of recently
+        /// used leaves under a lock, so the GNAT can still be queried
+        /// from several threads at once; \e load must then be safe to
+        /// call from any of them.
+        void setLeafSpilling(unsigned int maxResidentLeaves, const LeafCallback &spill, const LeafCallback &load)
+        {
+            if (maxResidentLeaves_ && !maxResidentLeaves)
+            {
+                loadLeaves();
+                for (typename std::list<const Node*>::iterator it = residentLeaves_.begin() ; it != residentLeaves_.end() ; ++it)
+                    (*it)->resident_ = false;
+                residentLeaves_.clear();
+            }
+            maxResidentLeaves_ = maxResidentLeaves;
+            spillLeaf_ = spill;
+            loadLeaf_ = load;
+            spillLeaves();
+        }
+
+        /// \brief Get the maximum number of leaves whose elements are kept in memory (0 means no limit).
+        unsigned int getMaxResidentLeaves() const
+        {
+            return maxResidentLeaves_;
+        }
+
+        /// \brief Get the number of leaves whose elements are currently in
+        /// memory and that may be spilled (only counted if leaf spilling is enabled).
+        std::size_t getNumResidentLeaves() const
+        {
+            boost::mutex::scoped_lock slock(leafLock_);
+            return residentLeaves_.size();
+        }
+
+        /// \brief Get the number of leaves whose elements are currently out of memory.
+        std::size_t getNumSpilledLeaves() const
+        {
+            boost::mutex::scoped_lock slock(leafLock_);
+            return numSpilledLeaves_;
+        }
+
+        /// \brief Get the number of times a spilled leaf had to be loaded again.
+        std::size_t getNumLeafLoads() const
+        {
+            boost::mutex::scoped_lock slock(leafLock_);
+            return numLeafLoads_;
+        }
+
+        /// \brief Bring the elements of all spilled leaves back into memory.
+        /// They are spilled again, as needed, the next time the GNAT is modified.
+        void loadLeaves() const
+        {
+            if (maxResidentLeaves_ && tree_)
+                tree_->loadLeaves(*this);
+        }
+
         virtual void add(const _T &data)
         {
             if (tree_)
-            {
-                if (isRemoved(data))
-                    rebuildDataStructure();
                 tree_->add(*this, data);
-            }
             else
             {
                 tree_ = new Node(degree_, maxNumPtsPerLeaf_, data);
                 size_ = 1;
+                numNodes_ = numLeaves_ = 1;
             }
+            spillLeaves();
         }
         virtual void add(const std::vector<_T> &data)
         {
@@ -169,46 +329,83 @@ namespace ompl
             else if (data.size()>0)
             {
                 tree_ = new Node(degree_, maxNumPtsPerLeaf_, data[0]);
+                numNodes_ = numLeaves_ = 1;
 #ifdef GNAT_SAMPLER
                 tree_->subtreeSize_= data.size();
 #endif
                 for (unsigned int i=1; i<data.size(); ++i)
                     tree_->data_.push_back(data[i]);
+                touchLeaf(tree_);
                 if (tree_->needToSplit(*this))
                     tree_->split(*this);
             }
             size_ += data.size();
+            spillLeaves();
         }
         /// \brief Rebuild the internal data structure.
         void rebuildDataStructure()
         {
             std::vector<_T> lst;
+            loadLeaves();
             list(lst);
             clear();
             add(lst);
         }
         /// \brief Remove data from the tree.
-        /// The element won't actually be removed immediately, but just marked
-        /// for removal in the removed_ cache. When the cache is full, the tree
-        /// will be rebuilt and the elements marked for removal will actually
-        /// be removed.
+        /// The element is removed immediately. If it is a pivot, it is
+        /// replaced by a nearby element of the same subtree and the bounds
+        /// of the affected nodes are widened accordingly, so that the rest
+        /// of the tree does not need to be rebuilt.
         virtual bool remove(const _T &data)
         {
             if (!size_) return false;
-            NearQueue nbhQueue;
-            // find data in tree
-            bool isPivot = nearestKInternal(data, 1, nbhQueue);
-            if (*nbhQueue.top().first != data)
+            std::vector<Node*> path;
+            // find the node that stores data
+            if (!tree_->find(*this, data, path))
                 return false;
-            removed_.insert(nbhQueue.top().first);
+#ifdef GNAT_SAMPLER
+            for (unsigned int i=0; i<path.size(); ++i)
+                path[i]->subtreeSize_--;
+#endif
+            Node *node = path.back();
+            if (node->pivot_ == data)
+                removePivot(path);
+            else
+                node->removeData(data);
             size_--;
-            // if we removed a pivot or if the capacity of removed elements
-            // has been reached, we rebuild the entire GNAT
-            if (isPivot || removed_.size()>=removedCacheSize_)
-                rebuildDataStructure();
+            spillLeaves();
             return true;
         }
 
+        /// \brief Remove all elements for which \e predicate returns true.
+        /// Non-pivot elements are filtered out of the nodes in a single pass
+        /// over the tree; pivots are then removed one by one. If more
+        /// elements are removed than kept, the tree is rebuilt once instead.
+        virtual std::size_t removeIf(const boost::function<bool(const _T&)> &predicate)
+        {
+            if (!size_) return 0;
+            // the predicate may need the elements themselves
+            loadLeaves();
+            std::vector<_T> pivots;
+            std::size_t numRemoved = tree_->removeIf(predicate, pivots);
+            size_ -= numRemoved;
+            if (2 * (numRemoved + pivots.size()) > size_ + numRemoved)
+            {
+                std::vector<_T> lst, kept;
+                list(lst);
+                for (unsigned int i=0; i<lst.size(); ++i)
+                    if (!predicate(lst[i]))
+                        kept.push_back(lst[i]);
+                clear();
+                add(kept);
+                return numRemoved + pivots.size();
+            }
+            for (unsigned int i=0; i<pivots.size(); ++i)
+                remove(pivots[i]);
+            spillLeaves();
+            return numRemoved + pivots.size();
+        }
+
         virtual _T nearest(const _T &data) const
         {
             if (size_)
@@ -227,8 +424,10 @@ namespace ompl
             if (k == 0) return;
             if (size_)
             {
+                std::size_t numDistances = 0;
                 NearQueue nbhQueue;
-                nearestKInternal(data, k, nbhQueue);
+                nearestKInternal(data, k, nbhQueue, numDistances);
+                addQueryStatistics(numDistances);
                 postprocessNearest(nbhQueue, nbh);
             }
         }
@@ -239,8 +438,10 @@ namespace ompl
             nbh.clear();
             if (size_)
             {
+                std::size_t numDistances = 0;
                 NearQueue nbhQueue;
-                nearestRInternal(data, radius, nbhQueue);
+                nearestRInternal(data, radius, nbhQueue, numDistances);
+                addQueryStatistics(numDistances);
                 postprocessNearest(nbhQueue, nbh);
             }
         }
@@ -250,6 +451,19 @@ namespace ompl
             return size_;
         }
 
+        /// \brief Estimate the memory used by the tree from its number of
+        /// nodes and leaves, without traversing it. Every node stores a pivot
+        /// and the ranges of its siblings, and every leaf reserves room for
+        /// maxNumPtsPerLeaf_+1 elements.
+        virtual std::size_t getMemoryUsage() const
+        {
+            std::size_t nodeBytes = sizeof(Node) + sizeof(Node*) + 2 * degree_ * sizeof(double);
+            std::size_t leafBytes = std::max(numLeaves_ * (maxNumPtsPerLeaf_ + 1),
+                size_ - std::min(size_, numNodes_)) * sizeof(_T);
+            return numNodes_ * nodeBytes + leafBytes + pivotDists_.size() * sizeof(double)
+                + residentLeaves_.size() * (sizeof(const Node*) + 2 * sizeof(void*));
+        }
+
 #ifdef GNAT_SAMPLER
         /// Sample an element from the GNAT.
         const _T& sample(RNG &rng) const
@@ -273,17 +487,7 @@ namespace ompl
         friend std::ostream& operator<<(std::ostream& out, const NearestNeighborsGNAT<_T>& gnat)
         {
             if (gnat.tree_)
-            {
                 out << *gnat.tree_;
-                if (!gnat.removed_.empty())
-                {
-                    out << "Elements marked for removal:\n";
-                    for (typename boost::unordered_set<const _T*>::const_iterator it = gnat.removed_.begin();
-                        it != gnat.removed_.end(); it++)
-                        out << **it << '\t';
-                    out << std::endl;
-                }
-            }
             return out;
         }
 
@@ -291,88 +495,220 @@ namespace ompl
         void integrityCheck()
         {
             std::vector<_T> lst;
-            boost::unordered_set<const _T*> tmp;
-            // get all elements, including those marked for removal
-            removed_.swap(tmp);
-            list(lst);
-            // check if every element marked for removal is also in the tree
-            for (typename boost::unordered_set<const _T*>::iterator it=tmp.begin(); it!=tmp.end(); it++)
-            {
-                unsigned int i;
-                for (i=0; i<lst.size(); ++i)
-                    if (lst[i]==**it)
-                        break;
-                if (i == lst.size())
-                {
-                    // an element marked for removal is not actually in the tree
-                    std::cout << "***** FAIL!! ******\n" << *this << '\n';
-                    for (unsigned int j=0; j<lst.size(); ++j) std::cout<<lst[j]<<'\t';
-                    std::cout<<std::endl;
-                }
-                assert(i != lst.size());
-            }
-            // restore
-            removed_.swap(tmp);
-            // get elements in the tree with elements marked for removal purged from the list
             list(lst);
             if (lst.size() != size_)
                 std::cout << "#########################################\n" << *this << std::endl;
             assert(lst.size() == size_);
+            // check that every element can be found again through the bounds stored in the tree
+            for (unsigned int i=0; i<lst.size(); ++i)
+            {
+                std::vector<Node*> path;
+                bool found = tree_->find(*this, lst[i], path);
+                if (!found)
+                    std::cout << "***** FAIL!! ******\n" << *this << '\n';
+                assert(found);
+            }
         }
     protected:
         typedef NearestNeighborsGNAT<_T> GNAT;
 
-        /// Return true iff data has been marked for removal.
-        bool isRemoved(const _T& data) const
+        /// \brief Make sure the elements of a leaf are in memory and mark the
+        /// leaf as the most recently used one (if leaf spilling is enabled).
+        /// Queries call this from const methods, so it takes leafLock_.
+        void touchLeaf(const Node *node) const
+        {
+            if (!maxResidentLeaves_)
+                return;
+            boost::mutex::scoped_lock slock(leafLock_);
+            if (node->spilled_)
+            {
+                loadLeaf_(node->data_);
+                node->spilled_ = false;
+                --numSpilledLeaves_;
+                ++numLeafLoads_;
+            }
+            if (node->resident_)
+                residentLeaves_.splice(residentLeaves_.begin(), residentLeaves_, node->lruPosition_);
+            else
+            {
+                residentLeaves_.push_front(node);
+                node->lruPosition_ = residentLeaves_.begin();
+                node->resident_ = true;
+            }
+        }
+
+        /// \brief Stop tracking a node that is deleted or stops being a leaf.
+        void forgetLeaf(const Node *node)
         {
-            return !removed_.empty() && removed_.find(&data) != removed_.end();
+            boost::mutex::scoped_lock slock(leafLock_);
+            if (node->resident_)
+            {
+                residentLeaves_.erase(node->lruPosition_);
+                node->resident_ = false;
+            }
+        }
+
+        /// \brief Spill the least recently used leaves until at most
+        /// maxResidentLeaves_ leaves are in memory.
+        void spillLeaves()
+        {
+            if (!maxResidentLeaves_)
+                return;
+            boost::mutex::scoped_lock slock(leafLock_);
+            while (residentLeaves_.size() > maxResidentLeaves_)
+            {
+                const Node *node = residentLeaves_.back();
+                residentLeaves_.pop_back();
+                node->resident_ = false;
+                if (!node->data_.empty())
+                {
+                    spillLeaf_(node->data_);
+                    node->spilled_ = true;
+                    ++numSpilledLeaves_;
+                }
+            }
+        }
+
+        /// \brief Remove the pivot of the last node in \e path (the other
+        /// nodes in \e path are its ancestors). The closest element of a leaf,
+        /// or the pivot of the closest child of an internal node, takes its
+        /// place, and the radii and ranges of the node are widened by the
+        /// distance between the old and new pivot, which keeps them valid
+        /// bounds by the triangle inequality. A leaf that only stored its
+        /// pivot is removed from its parent.
+        void removePivot(std::vector<Node*>& path)
+        {
+            Node *node = path.back();
+            double dist;
+
+            if (node->children_.empty())
+            {
+                touchLeaf(node);
+                if (node->data_.empty())
+                {
+                    forgetLeaf(node);
+                    if (path.size() > 1)
+                    {
+                        path[path.size() - 2]->removeChild(*this, node);
+                        if (path[path.size() - 2]->children_.empty())
+                            ++numLeaves_;
+                    }
+                    else
+                        tree_ = NULL;
+                    delete node;
+                    --numNodes_;
+                    --numLeaves_;
+                    return;
+                }
+                unsigned int minInd = 0;
+                double minDist = NearestNeighbors<_T>::distFun_(node->pivot_, node->data_[0]);
+                for (unsigned int i=1; i<node->data_.size(); ++i)
+                    if ((dist = NearestNeighbors<_T>::distFun_(node->pivot_, node->data_[i])) < minDist)
+                    {
+                        minDist = dist;
+                        minInd = i;
+                    }
+                node->pivot_ = node->data_[minInd];
+                node->data_[minInd] = node->data_.back();
+                node->data_.pop_back();
+                // the radii of a leaf are cheap to recompute exactly
+                node->minRadius_ = std::numeric_limits<double>::infinity();
+                node->maxRadius_ = -node->minRadius_;
+                for (unsigned int i=0; i<node->data_.size(); ++i)
+                    node->updateRadius(NearestNeighbors<_T>::distFun_(node->pivot_, node->data_[i]));
+                if (node->data_.empty())
+                    node->minRadius_ = node->maxRadius_ = 0.;
+                node->widenRange(minDist);
+            }
+            else
+            {
+                unsigned int minInd = 0;
+                double minDist = NearestNeighbors<_T>::distFun_(node->pivot_, node->children_[0]->pivot_);
+                for (unsigned int i=1; i<node->children_.size(); ++i)
+                    if ((dist = NearestNeighbors<_T>::distFun_(node->pivot_, node->children_[i]->pivot_)) < minDist)
+                    {
+                        minDist = dist;
+                        minInd = i;
+                    }
+                Node *child = node->children_[minInd];
+                _T newPivot = child->pivot_;
+#ifdef GNAT_SAMPLER
+                child->subtreeSize_--;
+#endif
+                path.push_back(child);
+                removePivot(path);
+                path.pop_back();
+                node->pivot_ = newPivot;
+                node->widenRadius(minDist);
+                node->widenRange(minDist);
+            }
+        }
+
+        /// \brief Return the distance between a query and an element, counting
+        /// the evaluation in numDistances.
+        double queryDistance(const _T &data, const _T &element, std::size_t &numDistances) const
+        {
+            ++numDistances;
+            return NearestNeighbors<_T>::distFun_(data, element);
+        }
+
+        /// \brief Add a completed query that evaluated numDistances
+        /// distances to the query statistics. The counters are atomic so
+        /// that concurrent queries do not serialize on them.
+        void addQueryStatistics(std::size_t numDistances) const
+        {
+            numQueries_.fetch_add(1, boost::memory_order_relaxed);
+            numDistanceEvaluations_.fetch_add(numDistances, boost::memory_order_relaxed);
         }
 
         /// \brief Return in nbhQueue the k nearest neighbors of data.
-        /// For k=1, return true if the nearest neighbor is a pivot.
-        /// (which is important during removal; removing pivots is a
-        /// special case).
-        bool nearestKInternal(const _T &data, std::size_t k, NearQueue& nbhQueue) const
+        void nearestKInternal(const _T &data, std::size_t k, NearQueue& nbhQueue, std::size_t &numDistances) const
         {
-            bool isPivot;
             double dist;
             NodeDist nodeDist;
             NodeQueue nodeQueue;
+            unsigned int visitedLeaves = tree_->children_.empty() ? 1 : 0;
 
-            isPivot = tree_->insertNeighborK(nbhQueue, k, tree_->pivot_, data,
-                NearestNeighbors<_T>::distFun_(data, tree_->pivot_));
-            tree_->nearestK(*this, data, k, nbhQueue, nodeQueue, isPivot);
+            tree_->insertNeighborK(nbhQueue, k, tree_->pivot_, data,
+                queryDistance(data, tree_->pivot_, numDistances));
+            tree_->nearestK(*this, data, k, nbhQueue, nodeQueue, numDistances);
             while (nodeQueue.size() > 0)
             {
-                dist = nbhQueue.top().second; // note the difference with nearestRInternal
+                dist = nbhQueue.top().second * pruneScale_; // note the difference with nearestRInternal
                 nodeDist = nodeQueue.top();
                 nodeQueue.pop();
                 if (nbhQueue.size() == k &&
                     (nodeDist.second > nodeDist.first->maxRadius_ + dist ||
-                     nodeDist.second < nodeDist.first->minRadius_ - dist))
+                     nodeDist.second < nodeDist.first->minRadius_ - dist ||
+                     (maxVisitedLeaves_ && visitedLeaves >= maxVisitedLeaves_)))
                     break;
-                nodeDist.first->nearestK(*this, data, k, nbhQueue, nodeQueue, isPivot);
+                if (nodeDist.first->children_.empty())
+                    ++visitedLeaves;
+                nodeDist.first->nearestK(*this, data, k, nbhQueue, nodeQueue, numDistances);
             }
-            return isPivot;
         }
         /// \brief Return in nbhQueue the elements that are within distance radius of data.
-        void nearestRInternal(const _T &data, double radius, NearQueue& nbhQueue) const
+        void nearestRInternal(const _T &data, double radius, NearQueue& nbhQueue, std::size_t &numDistances) const
         {
-            double dist = radius; // note the difference with nearestKInternal
+            double dist = radius * pruneScale_; // note the difference with nearestKInternal
             NodeQueue nodeQueue;
             NodeDist nodeDist;
+            unsigned int visitedLeaves = tree_->children_.empty() ? 1 : 0;
 
             tree_->insertNeighborR(nbhQueue, radius, tree_->pivot_,
-                NearestNeighbors<_T>::distFun_(data, tree_->pivot_));
-            tree_->nearestR(*this, data, radius, nbhQueue, nodeQueue);
+                queryDistance(data, tree_->pivot_, numDistances));
+            tree_->nearestR(*this, data, radius, nbhQueue, nodeQueue, numDistances);
             while (nodeQueue.size() > 0)
             {
                 nodeDist = nodeQueue.top();
                 nodeQueue.pop();
                 if (nodeDist.second > nodeDist.first->maxRadius_ + dist ||
-                    nodeDist.second < nodeDist.first->minRadius_ - dist)
+                    nodeDist.second < nodeDist.first->minRadius_ - dist ||
+                    (maxVisitedLeaves_ && visitedLeaves >= maxVisitedLeaves_))
                     break;
-                nodeDist.first->nearestR(*this, data, radius, nbhQueue, nodeQueue);
+                if (nodeDist.first->children_.empty())
+                    ++visitedLeaves;
+                nodeDist.first->nearestR(*this, data, radius, nbhQueue, nodeQueue, numDistances);
             }
         }
         /// \brief Convert the internal data structure used for storing neighbors
@@ -395,7 +731,7 @@ namespace ompl
                 : degree_(degree), pivot_(pivot),
                 minRadius_(std::numeric_limits<double>::infinity()),
                 maxRadius_(-minRadius_), minRange_(degree, minRadius_),
-                maxRange_(degree, maxRadius_)
+                maxRange_(degree, maxRadius_), resident_(false), spilled_(false)
 #ifdef GNAT_SAMPLER
                 , subtreeSize_(1), activity_(0)
 #endif
@@ -447,13 +783,12 @@ namespace ompl
 #endif
                 if (children_.size()==0)
                 {
+                    gnat.touchLeaf(this);
                     data_.push_back(data);
                     gnat.size_++;
                     if (needToSplit(gnat))
                     {
-                        if (gnat.removed_.size() > 0)
-                            gnat.rebuildDataStructure();
-                        else if (gnat.size_ >= gnat.rebuildSize_)
+                        if (gnat.size_ >= gnat.rebuildSize_)
                         {
                             gnat.rebuildSize_ <<= 1;
                             gnat.rebuildDataStructure();
@@ -491,28 +826,33 @@ namespace ompl
             /// child node.
             void split(GNAT& gnat)
             {
-                std::vector<std::vector<double> > dists;
+                // the distance buffer is shared by all splits; children are
+                // only split at the very end, once this node is done with it
+                typename GreedyKCenters<_T>::Matrix& dists = gnat.pivotDists_;
                 std::vector<unsigned int> pivots;
 
+                gnat.forgetLeaf(this);
                 children_.reserve(degree_);
                 gnat.pivotSelector_.kcenters(data_, degree_, pivots, dists);
                 for(unsigned int i=0; i<pivots.size(); i++)
                     children_.push_back(new Node(degree_, gnat.maxNumPtsPerLeaf_, data_[pivots[i]]));
                 degree_ = pivots.size(); // in case fewer than degree_ pivots were found
+                gnat.numNodes_ += degree_;
+                gnat.numLeaves_ += degree_ - 1;
                 for (unsigned int j=0; j<data_.size(); ++j)
                 {
                     unsigned int k = 0;
                     for (unsigned int i=1; i<degree_; ++i)
-                        if (dists[j][i] < dists[j][k])
+                        if (dists(j, i) < dists(j, k))
                             k = i;
                     Node *child = children_[k];
                     if (j != pivots[k])
                     {
                         child->data_.push_back(data_[j]);
-                        child->updateRadius(dists[j][k]);
+                        child->updateRadius(dists(j, k));
                     }
                     for (unsigned int i=0; i<degree_; ++i)
-                        children_[i]->updateRange(k, dists[j][i]);
+                        children_[i]->updateRange(k, dists(j, i));
                 }
 
                 for (unsigned int i=0; i<degree_; ++i)
@@ -528,6 +868,8 @@ namespace ompl
                     // set subtree size
                     children_[i]->subtreeSize_ = children_[i]->data_.size() + 1;
 #endif
+                    if (!children_[i]->data_.empty())
+                        gnat.touchLeaf(children_[i]);
                 }
                 // this does more than clear(); it also sets capacity to 0 and frees the memory
                 std::vector<_T> tmp;
@@ -557,19 +899,15 @@ namespace ompl
             }
 
             /// \brief Compute the k nearest neighbors of data in the tree.
-            /// For k=1, isPivot is true if the nearest neighbor is a pivot
-            /// (which is important during removal; removing pivots is a
-            /// special case). The nodeQueue, which contains other Nodes
-            /// that need to be checked for nearest neighbors, is updated.
+            /// The nodeQueue, which contains other Nodes that need to be
+            /// checked for nearest neighbors, is updated.
             void nearestK(const GNAT& gnat, const _T &data, std::size_t k,
-                NearQueue& nbh, NodeQueue& nodeQueue, bool &isPivot) const
+                NearQueue& nbh, NodeQueue& nodeQueue, std::size_t &numDistances) const
             {
+                if (!data_.empty())
+                    gnat.touchLeaf(this);
                 for (unsigned int i=0; i<data_.size(); ++i)
-                    if (!gnat.isRemoved(data_[i]))
-                    {
-                        if (insertNeighborK(nbh, k, data_[i], data, gnat.distFun_(data, data_[i])))
-                            isPivot = false;
-                    }
+                    insertNeighborK(nbh, k, data_[i], data, gnat.queryDistance(data, data_[i], numDistances));
                 if (children_.size() > 0)
                 {
                     double dist;
@@ -585,12 +923,11 @@ namespace ompl
                         if (permutation[i] >= 0)
                         {
                             child = children_[permutation[i]];
-                            distToPivot[permutation[i]] = gnat.distFun_(data, child->pivot_);
-                            if (insertNeighborK(nbh, k, child->pivot_, data, distToPivot[permutation[i]]))
-                                isPivot = true;
+                            distToPivot[permutation[i]] = gnat.queryDistance(data, child->pivot_, numDistances);
+                            insertNeighborK(nbh, k, child->pivot_, data, distToPivot[permutation[i]]);
                             if (nbh.size()==k)
                             {
-                                dist = nbh.top().second; // note difference with nearestR
+                                dist = nbh.top().second * gnat.pruneScale_; // note difference with nearestR
                                 for (unsigned int j=0; j<children_.size(); ++j)
                                     if (permutation[j] >=0 && i != j &&
                                         (distToPivot[permutation[i]] - dist > child->maxRange_[permutation[j]] ||
@@ -599,7 +936,7 @@ namespace ompl
                             }
                         }
 
-                    dist = nbh.top().second;
+                    dist = nbh.top().second * gnat.pruneScale_;
                     for (unsigned int i=0; i<children_.size(); ++i)
                         if (permutation[i] >= 0)
                         {
@@ -620,13 +957,15 @@ namespace ompl
             /// \brief Return all elements that are within distance r in nbh.
             /// The nodeQueue, which contains other Nodes that need to
             /// be checked for nearest neighbors, is updated.
-            void nearestR(const GNAT& gnat, const _T &data, double r, NearQueue& nbh, NodeQueue& nodeQueue) const
+            void nearestR(const GNAT& gnat, const _T &data, double r, NearQueue& nbh, NodeQueue& nodeQueue,
+                std::size_t &numDistances) const
             {
-                double dist = r; //note difference with nearestK
+                double dist = r * gnat.pruneScale_; //note difference with nearestK
 
+                if (!data_.empty())
+                    gnat.touchLeaf(this);
                 for (unsigned int i=0; i<data_.size(); ++i)
-                    if (!gnat.isRemoved(data_[i]))
-                        insertNeighborR(nbh, r, data_[i], gnat.distFun_(data, data_[i]));
+                    insertNeighborR(nbh, r, data_[i], gnat.queryDistance(data, data_[i], numDistances));
                 if (children_.size() > 0)
                 {
                     Node *child;
@@ -641,7 +980,7 @@ namespace ompl
                         if (permutation[i] >= 0)
                         {
                             child = children_[permutation[i]];
-                            distToPivot[i] = gnat.distFun_(data, child->pivot_);
+                            distToPivot[i] = gnat.queryDistance(data, child->pivot_, numDistances);
                             insertNeighborR(nbh, r, child->pivot_, distToPivot[i]);
                             for (unsigned int j=0; j<children_.size(); ++j)
                                 if (permutation[j] >=0 && i != j &&
@@ -684,23 +1023,151 @@ namespace ompl
                 }
                 else
                 {
+                    gnat.touchLeaf(this);
                     unsigned int i = rng.uniformInt(0, data_.size());
                     return (i==data_.size()) ? pivot_ : data_[i];
                 }
             }
 #endif
 
+            /// Load the elements of the spilled leaves in the tree rooted at this node.
+            void loadLeaves(const GNAT& gnat) const
+            {
+                if (spilled_)
+                    gnat.touchLeaf(this);
+                for (unsigned int i=0; i<children_.size(); ++i)
+                    children_[i]->loadLeaves(gnat);
+            }
+
             void list(const GNAT& gnat, std::vector<_T> &data) const
             {
-                if (!gnat.isRemoved(pivot_))
-                    data.push_back(pivot_);
+                data.push_back(pivot_);
                 for (unsigned int i=0; i<data_.size(); ++i)
-                    if(!gnat.isRemoved(data_[i]))
-                        data.push_back(data_[i]);
+                    data.push_back(data_[i]);
                 for (unsigned int i=0; i<children_.size(); ++i)
                     children_[i]->list(gnat, data);
             }
 
+            /// \brief Find the node in the tree rooted at this node that stores
+            /// data, either as its pivot or in data_. On success, the nodes
+            /// from this node down to that node are appended to path. Only
+            /// subtrees whose bounds admit an element at distance 0 of data
+            /// are searched.
+            bool find(const GNAT& gnat, const _T &data, std::vector<Node*>& path)
+            {
+                path.push_back(this);
+                if (pivot_ == data)
+                    return true;
+                for (unsigned int i=0; i<data_.size(); ++i)
+                    if (data_[i] == data)
+                        return true;
+                if (children_.size() > 0)
+                {
+                    Node *child;
+                    std::vector<double> distToPivot(children_.size());
+                    std::vector<bool> candidate(children_.size(), true);
+
+                    for (unsigned int i=0; i<children_.size(); ++i)
+                        if (candidate[i])
+                        {
+                            child = children_[i];
+                            if (child->pivot_ == data)
+                            {
+                                path.push_back(child);
+                                return true;
+                            }
+                            distToPivot[i] = gnat.distFun_(data, child->pivot_);
+                            for (unsigned int j=i+1; j<children_.size(); ++j)
+                                if (candidate[j] &&
+                                    (distToPivot[i] > child->maxRange_[j] || distToPivot[i] < child->minRange_[j]))
+                                    candidate[j] = false;
+                        }
+                    for (unsigned int i=0; i<children_.size(); ++i)
+                        if (candidate[i])
+                        {
+                            child = children_[i];
+                            if (distToPivot[i] <= child->maxRadius_ && distToPivot[i] >= child->minRadius_ &&
+                                child->find(gnat, data, path))
+                                return true;
+                        }
+                }
+                path.pop_back();
+                return false;
+            }
+
+            /// Remove a (non-pivot) element from data_.
+            void removeData(const _T &data)
+            {
+                for (unsigned int i=0; i<data_.size(); ++i)
+                    if (data_[i] == data)
+                    {
+                        data_[i] = data_.back();
+                        data_.pop_back();
+                        return;
+                    }
+            }
+
+            /// \brief Remove the non-pivot elements for which predicate
+            /// returns true from the tree rooted at this node and return
+            /// how many were removed. Pivots for which predicate returns
+            /// true are appended to pivots, but not removed.
+            std::size_t removeIf(const boost::function<bool(const _T&)> &predicate, std::vector<_T> &pivots)
+            {
+                std::size_t numRemoved = 0;
+                if (predicate(pivot_))
+                    pivots.push_back(pivot_);
+                for (unsigned int i=0; i<data_.size(); )
+                    if (predicate(data_[i]))
+                    {
+                        data_[i] = data_.back();
+                        data_.pop_back();
+                        ++numRemoved;
+                    }
+                    else
+                        ++i;
+                for (unsigned int i=0; i<children_.size(); ++i)
+                    numRemoved += children_[i]->removeIf(predicate, pivots);
+#ifdef GNAT_SAMPLER
+                subtreeSize_ -= numRemoved;
+#endif
+                return numRemoved;
+            }
+
+            /// \brief Remove a child (which must be a leaf without data
+            /// besides its pivot) and its entries in the ranges of the
+            /// other children. The child itself is not deleted.
+            void removeChild(const GNAT& gnat, Node *child)
+            {
+                unsigned int k = std::find(children_.begin(), children_.end(), child) - children_.begin();
+                children_.erase(children_.begin() + k);
+                for (unsigned int i=0; i<children_.size(); ++i)
+                {
+                    children_[i]->minRange_.erase(children_[i]->minRange_.begin() + k);
+                    children_[i]->maxRange_.erase(children_[i]->maxRange_.begin() + k);
+                }
+                // a node without children is a leaf again
+                degree_ = children_.empty() ? gnat.degree_ : children_.size();
+            }
+
+            /// \brief Widen minRadius_ and maxRadius_ by dist, given that
+            /// the pivot was replaced by an element at distance dist of the old pivot.
+            void widenRadius(double dist)
+            {
+                minRadius_ = std::max(0., minRadius_ - dist);
+                maxRadius_ += dist;
+            }
+
+            /// \brief Widen minRange_ and maxRange_ by dist, given that
+            /// the pivot was replaced by an element at distance dist of the old pivot.
+            void widenRange(double dist)
+            {
+                for (unsigned int i=0; i<minRange_.size(); ++i)
+                {
+                    minRange_[i] = std::max(0., minRange_[i] - dist);
+                    maxRange_[i] += dist;
+                }
+            }
+
             friend std::ostream& operator<<(std::ostream& out, const Node &node)
             {
                 out << "\ndegree:\t" << node.degree_;
@@ -733,7 +1200,7 @@ namespace ompl
             /// Number of child nodes
             unsigned int        degree_;
             /// Data element stored in this Node
-            const _T            pivot_;
+            _T                  pivot_;
             /// Minimum distance between the pivot element and the elements stored in data_
             double              minRadius_;
             /// Maximum distance between the pivot element and the elements stored in data_
@@ -750,6 +1217,12 @@ namespace ompl
             /// \brief The child nodes of this node. By definition, only internal nodes
             /// have child nodes.
             std::vector<Node*>  children_;
+            /// \brief Whether this leaf is in the list of leaves whose elements are in memory
+            mutable bool        resident_;
+            /// \brief Whether the elements in data_ were spilled
+            mutable bool        spilled_;
+            /// \brief Position of this leaf in the list of leaves whose elements are in memory
+            mutable typename std::list<const Node*>::iterator lruPosition_;
 #ifdef GNAT_SAMPLER
             /// Number of elements stored in the subtree rooted at this Node
             unsigned int        subtreeSize_;
@@ -780,17 +1253,44 @@ namespace ompl
         unsigned int                    maxNumPtsPerLeaf_;
         /// \brief Number of elements stored in the tree.
         std::size_t                     size_;
+        /// \brief Number of nodes in the tree.
+        std::size_t                     numNodes_;
+        /// \brief Number of leaves in the tree.
+        std::size_t                     numLeaves_;
         /// \brief If size_ exceeds rebuildSize_, the tree will be rebuilt (and
         /// automatically rebalanced), and rebuildSize_ will be doubled.
         std::size_t                     rebuildSize_;
-        /// \brief Maximum number of removed elements that can be stored in the
-        /// removed_ cache. If the cache is full, the tree will be rebuilt with
-        /// the elements in removed_ actually removed from the tree.
+        /// \brief Maximum number of removed elements that used to be cached before
+        /// rebuilding the tree. Elements are now removed immediately, so this is
+        /// only kept for backwards compatibility.
         std::size_t                     removedCacheSize_;
         /// \brief The data structure used to split data into subtrees.
         GreedyKCenters<_T>              pivotSelector_;
-        /// \brief Cache of removed elements.
-        boost::unordered_set<const _T*> removed_;
+        /// \brief Buffer for the distances computed by pivotSelector_, reused across splits.
+        typename GreedyKCenters<_T>::Matrix pivotDists_;
+        /// \brief 1 / (1 + epsilon), where epsilon is the approximation factor.
+        double                          pruneScale_;
+        /// \brief Maximum number of leaves visited per query (0 means no limit).
+        unsigned int                    maxVisitedLeaves_;
+        /// \brief Number of queries since the last reset of the query statistics.
+        mutable boost::atomic<std::size_t> numQueries_;
+        /// \brief Number of distance evaluations by queries since the last reset of the query statistics.
+        mutable boost::atomic<std::size_t> numDistanceEvaluations_;
+        /// \brief Maximum number of leaves whose elements are kept in memory (0 means no limit).
+        unsigned int                    maxResidentLeaves_;
+        /// \brief Leaves whose elements are in memory, most recently used first.
+        mutable std::list<const Node*>  residentLeaves_;
+        /// \brief Number of leaves whose elements are out of memory.
+        mutable std::size_t             numSpilledLeaves_;
+        /// \brief Number of times a spilled leaf was loaded again.
+        mutable std::size_t             numLeafLoads_;
+        /// \brief Lock guarding the leaf spilling state (residentLeaves_,
+        /// the counters above and the spilled_/resident_ flags of the leaves).
+        mutable boost::mutex            leafLock_;
+        /// \brief Called with the elements of a leaf that is moved out of memory.
+        LeafCallback                    spillLeaf_;
+        /// \brief Called with the elements of a spilled leaf before it is used again.
+        LeafCallback                    loadLeaf_;
 #ifdef GNAT_SAMPLER
         /// \brief Estimated dimension of the local free space.
         double                          estimatedDimension_;
@@ -149,6 +149,11 @@ namespace ompl
             return data_.size();
         }
 
+        virtual std::size_t getMemoryUsage() const
+        {
+            return data_.capacity() * sizeof(_T);
+        }
+
         virtual void list(std::vector<_T> &data) const
         {
             data = data_;
@@ -74,9 +74,7 @@ namespace ompl
             explicit
             SimpleSetup(const base::StateSpacePtr &space);
 
-            virtual ~SimpleSetup()
-            {
-            }
+            virtual ~SimpleSetup();
 
             /** \brief Get the current instance of the space information */
             const base::SpaceInformationPtr& getSpaceInformation() const
@@ -275,6 +273,34 @@ namespace ompl
                 settings, start & goal states are not affected. */
             virtual void clear();
 
+            /** \brief Enable or disable warm starting. When enabled,
+                calls to solve() detect changes of the start states or
+                the goal since the previous call to solve(), including
+                changes made in place to the states of a goal made of
+                states and to the threshold of a goal region, and only
+                clear the query-dependent data of the planner (see
+                base::Planner::clearQuery()). Samples, roadmaps and trees
+                computed for previous queries are then reused. This
+                assumes the environment (the state validity checker and
+                the motion validator) did not change; otherwise,
+                environmentChanged() must be called. */
+            void setWarmStart(bool warmStart)
+            {
+                warmStart_ = warmStart;
+            }
+
+            /** \brief Return true if warm starting is enabled */
+            bool getWarmStart() const
+            {
+                return warmStart_;
+            }
+
+            /** \brief Notify the setup that the environment changed, so
+                that no planning data computed for the previous
+                environment is reused. This clears the planner and the
+                estimates shared by tools::SelfConfig. */
+            void environmentChanged();
+
             /** \brief Print information about the current setup */
             virtual void print(std::ostream &out = std::cout) const;
 
@@ -311,6 +337,35 @@ namespace ompl
 
             /// The status of the last planning request
             base::PlannerStatus           lastStatus_;
+
+            /// Flag indicating whether planning data is reused across queries
+            bool                          warmStart_;
+
+            /// Copies of the start states of the last planning request (used to detect query changes when warm starting)
+            std::vector<base::State*>     lastStartStates_;
+
+            /// The goal of the last planning request (used for warm starting)
+            base::GoalPtr                 lastGoal_;
+
+            /// Copies of the goal states of the last planning request, if its goal was made of states (used for warm starting)
+            std::vector<base::State*>     lastGoalStates_;
+
+            /// The threshold of the goal of the last planning request, if its goal was a region (used for warm starting)
+            double                        lastGoalThreshold_;
+
+        private:
+
+            /// If warm starting, clear the query of the planner if the start or goal changed since the last call to solve()
+            void prepareWarmStart();
+
+            /// Remember the start and goal of the current planning request
+            void storeQuery();
+
+            /// Free the memory of the stored query
+            void freeStoredQuery();
+
+            /// Get the goal states and the goal threshold that define the current goal, if it has them
+            void getGoalSnapshot(std::vector<const base::State*> &states, double &threshold) const;
         };
 
         /** \brief Given a goal specification, decide on a planner for that goal.
@@ -39,15 +39,52 @@
 #include "ompl/geometric/PathSimplifier.h"
 #include "ompl/tools/config/SelfConfig.h"
 #include "ompl/base/objectives/PathLengthOptimizationObjective.h"
+#include "ompl/util/Exception.h"
 
 #include <boost/thread.hpp>
 
+/// @cond IGNORE
+namespace
+{
+    // how long the pipeline stages wait before they check again for new paths
+    const boost::posix_time::milliseconds IDLE_WAIT(1);
+
+    // the number of paths each stage of the pipeline can hold; paths that
+    // arrive while a stage is full are dropped
+    const std::size_t MAX_QUEUED_PATHS = 16;
+
+    // gives a planner back its problem definition when the planning thread
+    // exits, however it exits
+    class ScopedProblemDefinition
+    {
+    public:
+        ScopedProblemDefinition(ompl::base::Planner *planner, const ompl::base::ProblemDefinitionPtr &pdef) :
+            planner_(planner), previous_(planner->getProblemDefinition())
+        {
+            planner_->setProblemDefinition(pdef);
+        }
+
+        ~ScopedProblemDefinition()
+        {
+            planner_->setProblemDefinition(previous_);
+        }
+
+    private:
+        ompl::base::Planner              *planner_;
+        ompl::base::ProblemDefinitionPtr  previous_;
+    };
+}
+/// @endcond
+
 ompl::geometric::AnytimePathShortening::AnytimePathShortening (const ompl::base::SpaceInformationPtr &si) :
     ompl::base::Planner(si, "APS"),
     shortcut_(true),
     hybridize_(true),
     maxHybridPaths_(24),
-    defaultNumPlanners_(std::max(1u, boost::thread::hardware_concurrency()))
+    defaultNumPlanners_(std::max(1u, boost::thread::hardware_concurrency())),
+    numShortcutThreads_(1),
+    plannedPaths_(MAX_QUEUED_PATHS),
+    shortcutPaths_(MAX_QUEUED_PATHS)
 {
     specs_.approximateSolutions = true;
     specs_.multithreaded = true;
@@ -57,6 +94,7 @@ ompl::geometric::AnytimePathShortening::AnytimePathShortening (const ompl::base:
     Planner::declareParam<bool>("hybridize", this, &AnytimePathShortening::setHybridize, &AnytimePathShortening::isHybridizing, "0,1");
     Planner::declareParam<unsigned int>("max_hybrid_paths", this, &AnytimePathShortening::setMaxHybridizationPath, &AnytimePathShortening::maxHybridizationPaths, "0:1:50");
     Planner::declareParam<unsigned int>("num_planners", this, &AnytimePathShortening::setDefaultNumPlanners, &AnytimePathShortening::getDefaultNumPlanners, "0:64");
+    Planner::declareParam<unsigned int>("shortcut_threads", this, &AnytimePathShortening::setNumShortcutThreads, &AnytimePathShortening::getNumShortcutThreads, "1:64");
 
     addPlannerProgressProperty("best cost REAL",
                                boost::bind(&AnytimePathShortening::getBestCost, this));
@@ -97,9 +135,8 @@ void ompl::geometric::AnytimePathShortening::setProblemDefinition(const ompl::ba
 ompl::base::PlannerStatus ompl::geometric::AnytimePathShortening::solve(const ompl::base::PlannerTerminationCondition &ptc)
 {
     base::Goal *goal = pdef_->getGoal().get();
-    std::vector<boost::thread*> threads(planners_.size());
     geometric::PathHybridization phybrid(si_);
-    base::Path *bestSln = NULL;
+    std::vector<base::PathPtr> hybridPaths;
 
     base::OptimizationObjectivePtr opt = pdef_->getOptimizationObjective();
     if (!opt)
@@ -114,56 +151,52 @@ ompl::base::PlannerStatus ompl::geometric::AnytimePathShortening::solve(const om
             OMPL_WARN("The optimization objective is not set for path length.  The specified optimization criteria may not be optimized over.");
     }
 
+    reportedCost_ = opt->infiniteCost();
+
     // Disable output from the motion planners, except for errors
     msg::LogLevel currentLogLevel = msg::getLogLevel();
     msg::setLogLevel(std::max(msg::LOG_ERROR, currentLogLevel));
-    while (!ptc())
+
+    // the pipeline also stops as soon as a good enough solution is found
+    base::PlannerTerminationCondition pipelinePtc = base::plannerOrTerminationCondition(ptc, base::plannerNonTerminatingCondition());
+    boost::thread_group threads;
+    for (std::size_t i = 0 ; i < planners_.size() ; ++i)
+        threads.create_thread(boost::bind(&AnytimePathShortening::threadSolve, this, planners_[i].get(), pipelinePtc));
+    if (shortcut_)
+        for (unsigned int i = 0 ; i < numShortcutThreads_ ; ++i)
+            threads.create_thread(boost::bind(&AnytimePathShortening::threadShortcut, this, pipelinePtc));
+
+    // Hybridize the paths as they come out of the shortcutting stage
+    while (!pipelinePtc())
     {
         // We have found a solution that is good enough
+        base::PathPtr bestSln = pdef_->getSolutionPath();
         if (bestSln && opt->isSatisfied(base::Cost(bestSln->length())))
-            break;
-
-        // Clear any previous planning data for the set of planners
-        clear();
-
-        // Spawn a thread for each planner.  This will shortcut the best path after solving.
-        for (size_t i = 0; i < threads.size(); ++i)
-            threads[i] = new boost::thread(boost::bind(&AnytimePathShortening::threadSolve, this, planners_[i].get(), ptc));
-
-        // Join each thread, and then delete it
-        for (std::size_t i = 0 ; i < threads.size() ; ++i)
         {
-            threads[i]->join();
-            delete threads[i];
-        }
-
-        // Hybridize the set of paths computed.  Add the new hybrid path to the mix.
-        if (hybridize_ && !ptc())
-        {
-            const std::vector<base::PlannerSolution> &paths = pdef_->getSolutions();
-            for (size_t j = 0; j < paths.size() && j < maxHybridPaths_ && !ptc(); ++j)
-                phybrid.recordPath(paths[j].path_, false);
-
-            phybrid.computeHybridPath();
-            const base::PathPtr &hsol = phybrid.getHybridPath();
-            if (hsol)
-            {
-                geometric::PathGeometric *pg = static_cast<geometric::PathGeometric*>(hsol.get());
-                double difference = 0.0;
-                bool approximate = !goal->isSatisfied(pg->getStates().back(), &difference);
-                pdef_->addSolutionPath(hsol, approximate, difference);
-            }
+            pipelinePtc.terminate();
+            break;
         }
 
-        // keep track of the best solution found so far
-        if (pdef_->getSolutionCount() > 0)
-            bestSln = pdef_->getSolutionPath().get();
+        PathGeometric *path;
+        if (shortcutPaths_.pop(path))
+            hybridize(phybrid, hybridPaths, base::PathPtr(path));
+        else
+            boost::this_thread::sleep(IDLE_WAIT);
     }
+    threads.join_all();
+
+    // discard the paths that were still in the pipeline
+    PathGeometric *path;
+    while (plannedPaths_.pop(path))
+        delete path;
+    while (shortcutPaths_.pop(path))
+        delete path;
     msg::setLogLevel(currentLogLevel);
 
+    base::PathPtr bestSln = pdef_->getSolutionPath();
     if (bestSln)
     {
-        if (goal->isSatisfied (static_cast<geometric::PathGeometric*>(bestSln)->getStates().back()))
+        if (goal->isSatisfied (static_cast<geometric::PathGeometric*>(bestSln.get())->getStates().back()))
             return base::PlannerStatus::EXACT_SOLUTION;
         return base::PlannerStatus::APPROXIMATE_SOLUTION;
     }
@@ -172,22 +205,151 @@ ompl::base::PlannerStatus ompl::geometric::AnytimePathShortening::solve(const om
 
 void ompl::geometric::AnytimePathShortening::threadSolve(base::Planner* planner, const base::PlannerTerminationCondition &ptc)
 {
-    // compute a motion plan
-    base::PlannerStatus status = planner->solve(ptc);
+    // the planner reports its solutions to a problem definition of its own,
+    // so that each solution can be traced back to the run that found it
+    base::ProblemDefinitionPtr pdef(new base::ProblemDefinition(si_));
+    for (unsigned int i = 0 ; i < pdef_->getStartStateCount() ; ++i)
+        pdef->addStartState(pdef_->getStartState(i));
+    pdef->setGoal(pdef_->getGoal());
+    pdef->setOptimizationObjective(pdef_->getOptimizationObjective());
+    ScopedProblemDefinition scopedPdef(planner, pdef);
+
+    while (!ptc)
+    {
+        // compute a motion plan from scratch
+        planner->clear();
+        pdef->clearSolutionPaths();
+        planner->solve(ptc);
+        std::vector<base::PlannerSolution> solutions = pdef->getSolutions();
+        if (solutions.empty())
+            break;
+
+        pdef_->addSolutionPath(solutions[0]);
+        reportBestSolution();
+        if (solutions[0].approximate_)
+            continue;
 
-    // Shortcut the best solution found so far
-    if (shortcut_ && status == base::PlannerStatus::EXACT_SOLUTION)
+        // pass a copy on to the next stage of the pipeline
+        const PathGeometric &sln = static_cast<const PathGeometric&>(*solutions[0].path_);
+        if (shortcut_)
+        {
+            // while the shortcutting threads are behind, only queue paths
+            // that are shorter than the best solution found so far
+            base::PathPtr bestSln = pdef_->getSolutionPath();
+            if (!plannedPaths_.empty() && bestSln && bestSln.get() != solutions[0].path_.get() &&
+                bestSln->length() <= sln.length())
+                continue;
+            pushPath(plannedPaths_, new PathGeometric(sln));
+        }
+        else if (hybridize_)
+            pushPath(shortcutPaths_, new PathGeometric(sln));
+    }
+}
+
+void ompl::geometric::AnytimePathShortening::pushPath(boost::lockfree::queue<PathGeometric*> &queue, PathGeometric *path)
+{
+    // bounded_push() never grows the queue beyond the nodes allocated in the constructor
+    if (!queue.bounded_push(path))
+        delete path;
+}
+
+void ompl::geometric::AnytimePathShortening::threadShortcut(const base::PlannerTerminationCondition &ptc)
+{
+    geometric::PathSimplifier ps(si_);
+    while (!ptc)
     {
-        geometric::PathGeometric* sln = static_cast<geometric::PathGeometric*>(pdef_->getSolutionPath().get());
-        geometric::PathGeometric* pathCopy = new geometric::PathGeometric(*sln);
-        geometric::PathSimplifier ps(pdef_->getSpaceInformation());
-        if (ps.shortcutPath(*pathCopy))
+        PathGeometric *path;
+        if (!plannedPaths_.pop(path))
+        {
+            boost::this_thread::sleep(IDLE_WAIT);
+            continue;
+        }
+
+        if (ps.shortcutPath(*path))
         {
             double difference = 0.0;
-            bool approximate = !pdef_->getGoal()->isSatisfied(pathCopy->getStates().back(), &difference);
-            pdef_->addSolutionPath(base::PathPtr(pathCopy), approximate, difference);
+            bool approximate = !pdef_->getGoal()->isSatisfied(path->getStates().back(), &difference);
+            pdef_->addSolutionPath(base::PathPtr(new PathGeometric(*path)), approximate, difference);
+            reportBestSolution();
         }
-        else delete pathCopy;
+        if (hybridize_)
+            pushPath(shortcutPaths_, path);
+        else
+            delete path;
+    }
+}
+
+void ompl::geometric::AnytimePathShortening::hybridize(PathHybridization &phybrid, std::vector<base::PathPtr> &hybridPaths,
+                                                       const base::PathPtr &path)
+{
+    if (maxHybridPaths_ == 0)
+        return;
+
+    if (hybridPaths.size() < maxHybridPaths_)
+    {
+        hybridPaths.push_back(path);
+        phybrid.recordPath(path, false);
+    }
+    else
+    {
+        // replace the longest path
+        std::size_t longest = 0;
+        for (std::size_t i = 1 ; i < hybridPaths.size() ; ++i)
+            if (hybridPaths[i]->length() > hybridPaths[longest]->length())
+                longest = i;
+        if (path->length() >= hybridPaths[longest]->length())
+            return;
+        hybridPaths[longest] = path;
+
+        // The replaced path stays in the hybridization graph, as paths can not be removed from it, so the new path
+        // is only matched against the recorded ones. Once as many paths were replaced as are kept, the graph is
+        // rebuilt from the kept paths, so recording a path costs O(maxHybridPaths_) matches on average.
+        if (phybrid.pathCount() < 2 * maxHybridPaths_)
+            phybrid.recordPath(path, false);
+        else
+        {
+            phybrid.clear();
+            for (std::size_t i = 0 ; i < hybridPaths.size() ; ++i)
+                phybrid.recordPath(hybridPaths[i], false);
+        }
+    }
+    if (phybrid.pathCount() < 2)
+        return;
+
+    phybrid.computeHybridPath();
+    const base::PathPtr &hsol = phybrid.getHybridPath();
+    base::PathPtr bestSln = pdef_->getSolutionPath();
+    if (hsol && (!bestSln || hsol->length() < bestSln->length()))
+    {
+        geometric::PathGeometric *pg = static_cast<geometric::PathGeometric*>(hsol.get());
+        double difference = 0.0;
+        bool approximate = !pdef_->getGoal()->isSatisfied(pg->getStates().back(), &difference);
+        pdef_->addSolutionPath(hsol, approximate, difference, phybrid.getName());
+        reportBestSolution();
+    }
+}
+
+void ompl::geometric::AnytimePathShortening::reportBestSolution()
+{
+    if (!hasImprovedSolutionCallback())
+        return;
+
+    boost::mutex::scoped_lock slock(reportMutex_);
+    base::PathPtr path = pdef_->getSolutionPath();
+    if (!path)
+        return;
+    base::PlannerSolution best(path);
+    if (!pdef_->getSolution(best) || best.approximate_)
+        return;
+
+    const base::OptimizationObjectivePtr &opt = pdef_->getOptimizationObjective();
+    base::Cost cost = best.path_->cost(opt);
+    if (opt->isCostBetterThan(cost, reportedCost_))
+    {
+        reportedCost_ = cost;
+        // the shared path keeps the states alive while they are reported
+        const std::vector<base::State*> &states = static_cast<PathGeometric*>(best.path_.get())->getStates();
+        notifyImprovedSolution(std::vector<const base::State*>(states.begin(), states.end()), cost);
     }
 }
 
@@ -291,6 +453,18 @@ unsigned int ompl::geometric::AnytimePathShortening::getDefaultNumPlanners() con
     return defaultNumPlanners_;
 }
 
+void ompl::geometric::AnytimePathShortening::setNumShortcutThreads(unsigned int numThreads)
+{
+    if (numThreads == 0)
+        throw Exception(getName(), "The number of shortcutting threads must be positive");
+    numShortcutThreads_ = numThreads;
+}
+
+unsigned int ompl::geometric::AnytimePathShortening::getNumShortcutThreads() const
+{
+    return numShortcutThreads_;
+}
+
 std::string ompl::geometric::AnytimePathShortening::getBestCost() const
 {
     base::Cost bestCost(std::numeric_limits<double>::quiet_NaN());
@@ -38,12 +38,17 @@
 #define OMPL_GEOMETRIC_PLANNERS_ANYTIMEOPTIMIZATION_ANYTIMEPATHSHORTENING_
 
 #include "ompl/base/Planner.h"
+#include "ompl/geometric/PathGeometric.h"
+#include <boost/thread/mutex.hpp>
+#include <boost/lockfree/queue.hpp>
 #include <vector>
 
 namespace ompl
 {
     namespace geometric
     {
+        class PathHybridization;
+
         /// @anchor gAPS
         /// @par Short description
         /// Anytime path shortening is a generic wrapper around one or more
@@ -59,6 +64,19 @@ namespace ompl
         /// planners that are not typically viewed as optimal/optimizing
         /// algorithms.
         ///
+        /// The work is organized as a pipeline that runs for the whole call
+        /// to solve(). Each planner thread solves the problem over and over,
+        /// starting from scratch every time, and streams its solution paths
+        /// into a lock-free queue. A pool of shortcutting threads takes the
+        /// paths from that queue, and the thread that called solve() adds
+        /// each shortcut path to the hybridization as soon as it arrives.
+        /// Paths are only matched against the paths already in the
+        /// hybridization, so every improvement is reported as soon as the
+        /// path that enables it is available. The queues between the stages
+        /// hold a bounded number of paths: while the shortcutting threads
+        /// are behind, paths that are not shorter than the best solution are
+        /// not queued, and paths that arrive at a full queue are dropped.
+        ///
         /// @par External documentation
         /// R. Luna, I.A. Şucan, M. Moll, and L.E. Kavraki, Anytime Solution Optimization for Sampling-Based Motion Planning, in <em>Proc. 2013 IEEE Intl. Conf. on Robotics and Automation</em>, pp. 5053-5059, May. 2013. DOI: [ICRA.2013.6631301](http://dx.doi.org/10.1109/ICRA.2013.6631301)<br>
         /// [[PDF]](http://ieeexplore.ieee.org/xpl/articleDetails.jsp?arnumber=6631301)
@@ -143,14 +161,44 @@ namespace ompl
             /// \brief Get default number of planners used if none are specified.
             unsigned int getDefaultNumPlanners() const;
 
+            /// \brief Set the number of threads that shortcut the paths found by the planners.
+            void setNumShortcutThreads(unsigned int numThreads);
+
+            /// \brief Get the number of threads that shortcut the paths found by the planners.
+            unsigned int getNumShortcutThreads() const;
+
             /** \brief Return best cost found so far by algorithm */
             std::string getBestCost() const;
 
         protected:
             /// \brief The function that the planning threads execute when
-            /// solving a motion planning problem.
+            /// solving a motion planning problem. The planner is run repeatedly
+            /// until \e ptc is met, and each exact solution is passed on to the
+            /// shortcutting (or hybridization) stage.
             virtual void threadSolve(base::Planner *planner, const base::PlannerTerminationCondition &ptc);
 
+            /// \brief The function that the shortcutting threads execute: shortcut
+            /// the paths found by the planners and pass them on to the hybridization stage.
+            virtual void threadShortcut(const base::PlannerTerminationCondition &ptc);
+
+            /// \brief Add \e path to the hybridization \e phybrid, which is
+            /// built from the paths in \e hybridPaths, and add the hybrid path
+            /// to the problem definition if it is shorter than the best solution.
+            /// Once maxHybridPaths_ paths are kept, a new path only
+            /// replaces the longest one if it is shorter. It is then
+            /// added to \e phybrid incrementally, and \e phybrid is
+            /// only rebuilt from \e hybridPaths once it holds twice as
+            /// many paths as are kept.
+            void hybridize(PathHybridization &phybrid, std::vector<base::PathPtr> &hybridPaths, const base::PathPtr &path);
+
+            /// \brief Add \e path to \e queue, or delete it if \e queue already
+            /// holds as many paths as it was allocated for.
+            void pushPath(boost::lockfree::queue<PathGeometric*> &queue, PathGeometric *path);
+
+            /// \brief Report the best solution in the problem definition through
+            /// the improved solution callback, if it is exact and better than the last one reported.
+            void reportBestSolution();
+
             /// \brief The list of planners used for solving the problem.
             std::vector<base::PlannerPtr> planners_;
 
@@ -167,6 +215,22 @@ namespace ompl
             /// \brief The number of planners to use if none are specified. This defaults to the number of cores.
             /// This parameter has no effect if planners have already been added.
             unsigned int defaultNumPlanners_;
+
+            /// \brief The number of threads that shortcut paths.
+            unsigned int numShortcutThreads_;
+
+            /// \brief Solution paths found by the planners, waiting to be shortcut
+            /// (bounded; dominated paths are dropped while it is not empty)
+            boost::lockfree::queue<PathGeometric*> plannedPaths_;
+
+            /// \brief Shortcut paths, waiting to be hybridized (bounded)
+            boost::lockfree::queue<PathGeometric*> shortcutPaths_;
+
+            /// \brief The cost of the last solution reported through the improved solution callback
+            base::Cost reportedCost_;
+
+            /// \brief Mutex serializing the reports of improved solutions
+            boost::mutex reportMutex_;
         };
     }
 }
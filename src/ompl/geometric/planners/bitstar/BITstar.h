@@ -101,10 +101,16 @@ namespace ompl
 
             virtual void clear();
 
+            /** \brief Clear the search of the previous query, but keep a random subset (at most one batch) of the states of its samples and vertices, all of which are known to be valid, as the initial samples of the next one. */
+            virtual void clearQuery();
+
             virtual base::PlannerStatus solve(const base::PlannerTerminationCondition& ptc);
 
             virtual void getPlannerData(base::PlannerData& data) const;
 
+            /** \brief Estimate the memory used by the vertex store (the vertices and free samples with their states and nearest-neighbour structures) and the integrated queue. */
+            virtual std::size_t getMemoryUsage() const;
+
             /** \brief Get the next edge to be processed. Causes vertices in the queue to be expanded (if necessary) and therefore effects the run timings of the algorithm, but helpful for some videos and debugging. */
             std::pair<ompl::base::State*, ompl::base::State*> getNextEdgeInQueue();
 
@@ -141,6 +147,15 @@ namespace ompl
             /** \brief Get the number of samplers per batch. */
             unsigned int getSamplesPerBatch() const;
 
+            /** \brief Set the number of threads used to generate and collision check each batch of samples.
+            Each thread uses its own sampler, seeded deterministically from the planner's sampler, so the batch
+            is reproducible for a given seed and number of threads. The state validity checker must be thread safe
+            when using more than one thread. */
+            void setNumSamplingThreads(unsigned int numThreads);
+
+            /** \brief Get the number of threads used to generate each batch of samples. */
+            unsigned int getNumSamplingThreads() const;
+
             /** \brief Enable a k-nearest search for instead of an r-disc search. */
             void setKNearest(bool useKNearest);
 
@@ -259,6 +274,10 @@ namespace ompl
             /** \brief Retrieve the number of nearest neighbour calls (i.e., NearestNeighbors<T>::nearestK(...) or NearestNeighbors<T>::nearestR(...))
             as a planner-progress property. (numNearestNeighbours_) */
             std::string nearestNeighbourProgressProperty() const;
+
+            /** \brief Retrieve the fraction of candidate samples accepted by the informed sampler during the most recent batch
+            as a planner-progress property. (InformedStateSampler::getAcceptanceRate()) */
+            std::string samplerAcceptanceRateProgressProperty() const;
             ///////////////////////////////////////
 
         protected:
@@ -299,9 +318,6 @@ namespace ompl
             /** \brief Checks an edge for collision. A wrapper to SpaceInformation->checkMotion that tracks number of collision checks. */
             bool checkEdge(const vertex_pair_t& edge);
 
-            /** \brief Actually remove a sample from its NN struct: */
-            void dropSample(VertexPtr oldSample);
-
             /** \brief Add an edge from the edge queue to the tree. Will add the state to the vertex queue if it's new to the tree or otherwise replace the parent. */
             void addEdge(const vertex_pair_t& newEdge, const ompl::base::Cost& edgeCost, const bool& removeFromFree, const bool& updateExpansionQueue);
 
@@ -311,6 +327,12 @@ namespace ompl
             /** \brief Add a sample */
             void addSample(const VertexPtr& newSample);
 
+            /** \brief Add a batch of samples with a single insert into the NN struct */
+            void addSamples(const std::vector<VertexPtr>& newSamples);
+
+            /** \brief Sample and collision check a contiguous chunk of a batch. Run by each sampling thread, writes only to its own portion of the validity vector. */
+            void sampleAndCheckChunk(const ompl::base::InformedStateSamplerPtr& chunkSampler, const std::vector<ompl::base::State*>& chunkStates, std::vector<char>* stateValidity, unsigned int chunkStart) const;
+
             /** \brief Add a vertex to the graph */
             void addVertex(const VertexPtr& newVertex, const bool& removeFromFree, const bool& updateExpansionQueue);
             ///////////////////////////////////////////////////////////////////
@@ -419,6 +441,9 @@ namespace ompl
             /** \brief State sampler */
             ompl::base::InformedStateSamplerPtr                      sampler_;
 
+            /** \brief The per-thread state samplers used when sampling a batch in parallel. Allocated as needed. */
+            std::vector<ompl::base::InformedStateSamplerPtr>         threadSamplers_;
+
             /** \brief Optimization objective copied from ProblemDefinition */
             ompl::base::OptimizationObjectivePtr                     opt_;
 
@@ -521,6 +546,9 @@ namespace ompl
             /** \brief The number of samples per batch (param) */
             unsigned int                                             samplesPerBatch_;
 
+            /** \brief The number of threads used to generate a batch (param) */
+            unsigned int                                             numSamplingThreads_;
+
             /** \brief Track edges that have been checked and failed so they never reenter the queue. (param) */
             bool                                                     useFailureTracking_;
 
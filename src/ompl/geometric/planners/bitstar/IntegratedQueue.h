@@ -173,7 +173,7 @@ namespace ompl
             /** \brief Mark the queue as requiring resorting */
             void markVertexUnsorted(const VertexPtr& vertex);
 
-            /** \brief Prune the vertex queue of vertices whose their lower-bound heuristic is greater then the threshold. Descendents of pruned vertices that are not pruned themselves are returned to the set of free states. Returns the number of vertices pruned (either removed completely or moved to the set of free states). */
+            /** \brief Prune the vertex queue of vertices whose their lower-bound heuristic is greater then the threshold. Descendents of pruned vertices that are not pruned themselves are returned to the set of free states. Only the vertices past the threshold in the lower-bound ordering are visited. Returns the number of vertices pruned (either removed completely or moved to the set of free states). */
             std::pair<unsigned int, unsigned int> prune(const vertex_nn_ptr_t& vertexNN, const vertex_nn_ptr_t& freeStateNN);
 
             /** \brief Resort the queue, only reinserting edges/vertices if their lower-bound heuristic is less then the threshold. Descendents of pruned vertices that are not pruned themselves are returned to the set of free states. Requires first marking the queue as unsorted. Returns the number of vertices pruned (either removed completely or moved to the set of free states). */
@@ -206,6 +206,9 @@ namespace ompl
             /** \brief Returns the number of vertices left to expand. This has nontrivial cost, as the token must be moved through the list to count */
             unsigned int numVertices() const;
 
+            /** \brief Returns an estimate of the number of bytes used by the queues and their lookup tables, not including the vertices themselves. Computed from the sizes of the containers, so it is cheap. */
+            std::size_t getMemoryUsage() const;
+
             /** \brief Get the number of edges in the queue pointing to a specific vertex */
             unsigned int numEdgesTo(const VertexPtr& cVertex) const;
 
@@ -308,6 +311,12 @@ namespace ompl
             /** \brief A lookup from vertex to iterator in the vertex queue */
             vid_vertex_queue_iter_umap_t                             vertexIterLookup_;
 
+            /** \brief The vertices in the queue sorted by their lower-bound heuristic. As the lower bound of a vertex depends only on its state, this order never needs to be resorted and lets prune() jump directly to the vertices beyond the threshold. */
+            cost_vertex_multimap_t                                   lowerBoundQueue_;
+
+            /** \brief A lookup from vertex to iterator in the lower-bound queue */
+            vid_vertex_queue_iter_umap_t                             lowerBoundIterLookup_;
+
             /** \brief A unordered map from a vertex to all the edges in the queue emanating from the vertex: */
             vid_edge_queue_iter_umap_t                               outgoingEdges_;
 
@@ -43,10 +43,14 @@
 #include <sstream>
 //For stream manipulations
 #include <iomanip>
+//For std::remove, std::reverse and std::min
+#include <algorithm>
 //For boost make_shared
 #include <boost/make_shared.hpp>
 //For boost::bind
 #include <boost/bind.hpp>
+//For boost::thread_group
+#include <boost/thread.hpp>
 //For pre C++ 11 gamma function
 #include <boost/math/special_functions/gamma.hpp>
 
@@ -72,6 +76,7 @@ namespace ompl
         BITstar::BITstar(const ompl::base::SpaceInformationPtr& si, const std::string& name /*= "BITstar"*/)
             : ompl::base::Planner(si, name),
             sampler_(),
+            threadSamplers_(),
             opt_(),
             startVertex_(),
             goalVertex_(),
@@ -103,6 +108,7 @@ namespace ompl
             useStrictQueueOrdering_(false),
             rewireFactor_(1.1),
             samplesPerBatch_(100u),
+            numSamplingThreads_(1u),
             useFailureTracking_(false),
             useKNearest_(false),
             usePruning_(true),
@@ -124,6 +130,7 @@ namespace ompl
             Planner::declareParam<bool>("use_strict_queue_ordering", this, &BITstar::setStrictQueueOrdering, &BITstar::getStrictQueueOrdering, "0,1");
             Planner::declareParam<double>("rewire_factor", this, &BITstar::setRewireFactor, &BITstar::getRewireFactor, "1.0:0.01:2.0");
             Planner::declareParam<unsigned int>("samples_per_batch", this, &BITstar::setSamplesPerBatch, &BITstar::getSamplesPerBatch, "1u:1u:1000000u");
+            Planner::declareParam<unsigned int>("num_sampling_threads", this, &BITstar::setNumSamplingThreads, &BITstar::getNumSamplingThreads, "1u:1u:64u");
             Planner::declareParam<bool>("use_edge_failure_tracking", this, &BITstar::setUseFailureTracking, &BITstar::getUseFailureTracking, "0,1");
             Planner::declareParam<bool>("use_k_nearest", this, &BITstar::setKNearest, &BITstar::getKNearest, "0,1");
             Planner::declareParam<bool>("use_graph_pruning", this, &BITstar::setPruning, &BITstar::getPruning, "0,1");
@@ -147,6 +154,8 @@ namespace ompl
             addPlannerProgressProperty("state collision checks INTEGER", boost::bind(&BITstar::stateCollisionCheckProgressProperty, this));
             addPlannerProgressProperty("edge collision checks INTEGER", boost::bind(&BITstar::edgeCollisionCheckProgressProperty, this));
             addPlannerProgressProperty("nearest neighbour calls INTEGER", boost::bind(&BITstar::nearestNeighbourProgressProperty, this));
+            addPlannerProgressProperty("sampler acceptance rate DOUBLE", boost::bind(&BITstar::samplerAcceptanceRateProgressProperty, this));
+            addMemoryUsageProgressProperties();
         }
 
 
@@ -164,7 +173,7 @@ namespace ompl
 
             //Do some sanity checks
             //Make sure we have a problem definition
-            if(Planner::pdef_ == false)
+            if(bool(Planner::pdef_) == false)
             {
                 OMPL_ERROR("%s::setup() was called without a problem definition.", Planner::getName().c_str());
                 Planner::setup_ = false;
@@ -261,6 +270,7 @@ namespace ompl
 
             //The various convenience pointers:
             sampler_.reset();
+            threadSamplers_.clear();
             opt_.reset();
             startVertex_.reset();
             goalVertex_.reset();
@@ -330,6 +340,67 @@ namespace ompl
 
 
 
+        void BITstar::clearQuery()
+        {
+            //Without a previous search, there is nothing to keep
+            if (Planner::setup_ == false || bool(freeStateNN_) == false || bool(vertexNN_) == false)
+            {
+                this->clear();
+                return;
+            }
+
+            //Variables
+            //The samples and vertices of the previous search:
+            std::vector<VertexPtr> oldSamples;
+            std::vector<VertexPtr> oldVertices;
+            //The new, unconnected, samples:
+            std::vector<VertexPtr> keptSamples;
+
+            //Get the lists
+            freeStateNN_->list(oldSamples);
+            vertexNN_->list(oldVertices);
+
+            //The old start and goal are specific to the old query and are not kept, which also avoids duplicating the new start or goal if they are unchanged
+            oldSamples.insert(oldSamples.end(), oldVertices.begin(), oldVertices.end());
+            oldSamples.erase(std::remove(oldSamples.begin(), oldSamples.end(), startVertex_), oldSamples.end());
+            oldSamples.erase(std::remove(oldSamples.begin(), oldSamples.end(), goalVertex_), oldSamples.end());
+
+            //The old states are uniformly distributed in the old informed set, which is in general much smaller than the initial informed set of the new query.
+            //The first batch must be exhausted before any new samples are drawn, so keep a uniform random subset of at most one batch.
+            //This keeps the first batch at its usual size without changing the density within the old informed set.
+            ompl::RNG rng;
+            unsigned int numKept = std::min(samplesPerBatch_, static_cast<unsigned int>(oldSamples.size()));
+            for (unsigned int i = 0u; i < numKept; ++i)
+            {
+                //Partial Fisher-Yates shuffle
+                std::swap(oldSamples.at(i), oldSamples.at(rng.uniformInt(i, oldSamples.size() - 1u)));
+
+                //Copy the state into a new sample, as the old vertices carry the connections and costs of the old query
+                keptSamples.push_back( boost::make_shared<Vertex>(Planner::si_, opt_) );
+                Planner::si_->copyState(keptSamples.back()->state(), oldSamples.at(i)->state());
+            }
+            oldSamples.clear();
+            oldVertices.clear();
+
+            //Clear and setup for the new start and goal
+            this->clear();
+            this->setup();
+
+            //Add the kept samples, if that worked
+            if (Planner::setup_ == true)
+            {
+                for (unsigned int i = 0u; i < keptSamples.size(); ++i)
+                {
+                    this->addSample(keptSamples.at(i));
+                }
+
+                //The number of samples has changed
+                this->updateNearestTerms();
+            }
+        }
+
+
+
         ompl::base::PlannerStatus BITstar::solve(const ompl::base::PlannerTerminationCondition& ptc)
         {
             Planner::checkValidity();
@@ -361,6 +432,12 @@ namespace ompl
                 if (intQueue_->isEmpty() == true)
                 {
                     this->newBatch();
+
+                    //If none of the new samples could be connected to the graph, there is still nothing to do. Try again with another batch:
+                    if (intQueue_->isEmpty() == true)
+                    {
+                        continue;
+                    }
                 }
                 //No else, there is existing work to do!
 
@@ -417,6 +494,23 @@ namespace ompl
                                     stopLoop = stopOnSolnChange_;
 
                                     OMPL_INFORM("%s: Found a solution with a cost of %.4f in %u iterations (%u vertices, %u rewirings). Graph currently has %u vertices.", Planner::getName().c_str(), goalVertex_->getCost(), numIterations_, numVertices_, numRewirings_, vertexNN_->size());
+
+                                    //Report the improved solution, if anyone is listening:
+                                    if (Planner::hasImprovedSolutionCallback() == true)
+                                    {
+                                        //Variable
+                                        //The states of the solution, from start->goal:
+                                        std::vector<const ompl::base::State*> solnStates;
+
+                                        //Iterate up the chain from the goal, and then reverse:
+                                        for(VertexPtr vertex = goalVertex_; bool(vertex) == true; vertex = vertex->getParent())
+                                        {
+                                            solnStates.push_back(vertex->state());
+                                        }
+                                        std::reverse(solnStates.begin(), solnStates.end());
+
+                                        Planner::notifyImprovedSolution(solnStates, bestCost_);
+                                    }
                                 }
                                 //No else
 
@@ -550,6 +644,7 @@ namespace ompl
             data.properties["number_of_state_collision_checks INTEGER"] = this->stateCollisionCheckProgressProperty();
             data.properties["number_of_edge_collision_checks INTEGER"] = this->edgeCollisionCheckProgressProperty();
             data.properties["number_of_nearest_neighbour_calls INTEGER"] = this->nearestNeighbourProgressProperty();
+            data.properties["sampler_acceptance_rate DOUBLE"] = this->samplerAcceptanceRateProgressProperty();
         }
 
 
@@ -736,6 +831,9 @@ namespace ompl
             ++numBatches_;
             this->statusMessage(ompl::msg::LOG_DEBUG, "Start new batch.");
 
+            //Resetting the queue and pruning below free memory, so record the peak usage first:
+            Planner::recordMemoryUsage();
+
             //Set the cost sampled to the minimum
             costSampled_ = minCost_;
 
@@ -769,24 +867,97 @@ namespace ompl
                 //Update the sampler counter:
                 numSamples_ = numSamples_ + samplesPerBatch_;
 
-                //Generate samples
+                //Variables
+                //The new vertices
+                std::vector<VertexPtr> newStates(samplesPerBatch_);
+                //Their states, as the sampler generates the whole batch at once
+                std::vector<ompl::base::State*> newRawStates(samplesPerBatch_);
+
+                //Allocate the vertices
                 for (unsigned int i = 0u; i < samplesPerBatch_; ++i)
                 {
-                    //Variable
-                    //The new state:
-                    VertexPtr newState = boost::make_shared<Vertex>(Planner::si_, opt_);
+                    newStates.at(i) = boost::make_shared<Vertex>(Planner::si_, opt_);
+                    newRawStates.at(i) = newStates.at(i)->state();
+                }
 
-                    //Sample:
-                    sampler_->sampleUniform(newState->state());
+                //We're counting density in the total state space, not free space
+                numStateCollisionChecks_ = numStateCollisionChecks_ + samplesPerBatch_;
 
-                    //If the state is collision free, add it to the list of free states
-                    //We're counting density in the total state space, not free space
-                    ++numStateCollisionChecks_;
-                    if (Planner::si_->isValid(newState->state()) == true)
+                if (numSamplingThreads_ <= 1u)
+                {
+                    //Variable:
+                    //The valid new states:
+                    std::vector<VertexPtr> validStates;
+
+                    //Generate samples
+                    sampler_->sampleUniformBatch(newRawStates);
+
+                    for (unsigned int i = 0u; i < samplesPerBatch_; ++i)
                     {
-                        //Add the new state as a sample
-                        this->addSample(newState);
+                        //If the state is collision free, add it to the list of free states
+                        if (Planner::si_->isValid(newStates.at(i)->state()) == true)
+                        {
+                            validStates.push_back(newStates.at(i));
+                        }
                     }
+
+                    //Add the new states as samples
+                    this->addSamples(validStates);
+                }
+                else
+                {
+                    //Variables:
+                    //The validity of each new state. A char instead of a bool as the threads write to it concurrently:
+                    std::vector<char> stateValidity(samplesPerBatch_, 0);
+                    //The valid new states:
+                    std::vector<VertexPtr> validStates;
+                    //The number of states per thread (rounded up):
+                    unsigned int chunkSize;
+                    //The sampling threads
+                    boost::thread_group samplingThreads;
+
+                    //Allocate the per-thread samplers if the number of threads has changed.
+                    //Each is seeded from the planner's sampler (and its thread index), so the batches are reproducible.
+                    if (threadSamplers_.size() != numSamplingThreads_)
+                    {
+                        threadSamplers_.clear();
+                        for (unsigned int i = 0u; i < numSamplingThreads_; ++i)
+                        {
+                            threadSamplers_.push_back(opt_->allocInformedStateSampler(Planner::si_->getStateSpace().get(), Planner::pdef_, &bestCost_));
+                            threadSamplers_.back()->setLocalSeed(sampler_->getLocalSeed() + i + 1u);
+                        }
+                    }
+
+                    //Divide up the batch:
+                    chunkSize = (samplesPerBatch_ + numSamplingThreads_ - 1u)/numSamplingThreads_;
+
+                    //Start the threads:
+                    for (unsigned int i = 0u; i < numSamplingThreads_ && i*chunkSize < samplesPerBatch_; ++i)
+                    {
+                        //Variables:
+                        //The start and end of this chunk:
+                        unsigned int chunkStart = i*chunkSize;
+                        unsigned int chunkEnd = std::min(chunkStart + chunkSize, samplesPerBatch_);
+                        //The states in this chunk. Held by the thread object.
+                        std::vector<ompl::base::State*> chunkStates(newRawStates.begin() + chunkStart, newRawStates.begin() + chunkEnd);
+
+                        samplingThreads.create_thread(boost::bind(&BITstar::sampleAndCheckChunk, this, threadSamplers_.at(i), chunkStates, &stateValidity, chunkStart));
+                    }
+
+                    //And wait for them all:
+                    samplingThreads.join_all();
+
+                    //Gather the valid states in order:
+                    for (unsigned int i = 0u; i < samplesPerBatch_; ++i)
+                    {
+                        if (stateValidity.at(i) != 0)
+                        {
+                            validStates.push_back(newStates.at(i));
+                        }
+                    }
+
+                    //Add the new states as samples in one go:
+                    this->addSamples(validStates);
                 }
 
                 //Mark that we've sampled all cost spaces (This is in preparation for JIT sampling)
@@ -981,24 +1152,9 @@ namespace ompl
         {
             this->statusMessage(ompl::msg::LOG_DEBUG, "Start prune samples.");
 
-            //Variable:
-            //The list of samples:
-            std::vector<VertexPtr> samples;
-
-            //Get the list of samples
-            freeStateNN_->list(samples);
-
-            //Iterate through the list and remove any samples that have a heuristic larger than the bestCost_
-            for (unsigned int i = 0u; i < samples.size(); ++i)
-            {
-                //Check if this state should be pruned:
-                if (intQueue_->samplePruneCondition(samples.at(i)) == true)
-                {
-                    //Yes, remove it
-                    this->dropSample(samples.at(i));
-                }
-                //No else, keep.
-            }
+            //Remove any samples that have a heuristic larger than the bestCost_ in one pass.
+            //This is much cheaper than removing them one at a time, and the NN struct rebuilds itself (at most once) if most of the samples are dropped.
+            numFreeStatesPruned_ = numFreeStatesPruned_ + freeStateNN_->removeIf(boost::bind(&IntegratedQueue::samplePruneCondition, intQueue_.get(), _1));
 
             this->statusMessage(ompl::msg::LOG_DEBUG, "End prune samples.");
         }
@@ -1013,17 +1169,6 @@ namespace ompl
 
 
 
-        void BITstar::dropSample(VertexPtr oldSample)
-        {
-            //Update the counter:
-            ++numFreeStatesPruned_;
-
-            //Remove from the list of samples
-            freeStateNN_->remove(oldSample);
-        }
-
-
-
         void BITstar::addEdge(const vertex_pair_t& newEdge, const ompl::base::Cost& edgeCost, const bool& removeFromFree, const bool& updateExpansionQueue)
         {
             //If the vertex is currently in the tree, we need to rewire
@@ -1083,6 +1228,37 @@ namespace ompl
 
 
 
+        void BITstar::addSamples(const std::vector<VertexPtr>& newSamples)
+        {
+            //Mark as new
+            for (unsigned int i = 0u; i < newSamples.size(); ++i)
+            {
+                newSamples.at(i)->markNew();
+            }
+
+            //Add to the NN structure in one call:
+            freeStateNN_->add(newSamples);
+        }
+
+
+
+        void BITstar::sampleAndCheckChunk(const ompl::base::InformedStateSamplerPtr& chunkSampler, const std::vector<ompl::base::State*>& chunkStates, std::vector<char>* stateValidity, unsigned int chunkStart) const
+        {
+            //Generate the samples
+            chunkSampler->sampleUniformBatch(chunkStates);
+
+            //And check them:
+            for (unsigned int i = 0u; i < chunkStates.size(); ++i)
+            {
+                if (Planner::si_->isValid(chunkStates.at(i)) == true)
+                {
+                    stateValidity->at(chunkStart + i) = 1;
+                }
+            }
+        }
+
+
+
         void BITstar::addVertex(const VertexPtr& newVertex, const bool& removeFromFree, const bool& updateExpansionQueue)
         {
             //Make sure it's connected first, so that the queue gets updated properly. This is a day of debugging I'll never get back
@@ -1542,6 +1718,25 @@ namespace ompl
 
 
 
+        void BITstar::setNumSamplingThreads(unsigned int numThreads)
+        {
+            if (numThreads == 0u)
+            {
+                throw ompl::Exception("BIT* requires at least one sampling thread.");
+            }
+
+            numSamplingThreads_ = numThreads;
+        }
+
+
+
+        unsigned int BITstar::getNumSamplingThreads() const
+        {
+            return numSamplingThreads_;
+        }
+
+
+
         void BITstar::setKNearest(bool useKNearest)
         {
             //Check if the flag has changed
@@ -1668,6 +1863,43 @@ namespace ompl
 
 
 
+        std::size_t BITstar::getMemoryUsage() const
+        {
+            //Variables:
+            //The size of a vertex: The object, the reference count of its shared pointer and its state:
+            std::size_t vertexBytes;
+            //The number of bytes used:
+            std::size_t bytes;
+
+            vertexBytes = sizeof(Vertex) + 3u*sizeof(void*) + Planner::si_->getStateSpace()->getStateMemoryUsage();
+            bytes = 0u;
+
+            //The free samples:
+            if (bool(freeStateNN_) == true)
+            {
+                bytes = bytes + freeStateNN_->size()*vertexBytes + freeStateNN_->getMemoryUsage();
+            }
+            //No else, not allocated
+
+            //The vertices, each of which but the root is also referenced by its parent:
+            if (bool(vertexNN_) == true)
+            {
+                bytes = bytes + vertexNN_->size()*(vertexBytes + sizeof(Vertex::vertex_weak_ptr_t)) + vertexNN_->getMemoryUsage();
+            }
+            //No else, not allocated
+
+            //The queue:
+            if (bool(intQueue_) == true)
+            {
+                bytes = bytes + intQueue_->getMemoryUsage();
+            }
+            //No else, not allocated
+
+            return bytes;
+        }
+
+
+
         std::string BITstar::bestCostProgressProperty() const
         {
             return boost::lexical_cast<std::string>(this->bestCost().value());
@@ -1783,5 +2015,18 @@ namespace ompl
         {
             return boost::lexical_cast<std::string>(numNearestNeighbours_);
         }
+
+        std::string BITstar::samplerAcceptanceRateProgressProperty() const
+        {
+            //The sampler only exists once we're setup
+            if (bool(sampler_) == true)
+            {
+                return boost::lexical_cast<std::string>(sampler_->getAcceptanceRate());
+            }
+            else
+            {
+                return boost::lexical_cast<std::string>(1.0);
+            }
+        }
     }//geometric
 }//ompl
@@ -63,6 +63,8 @@ namespace ompl
                 vertexToExpand_( vertexQueue_.begin() ),
                 edgeQueue_( boost::bind(&IntegratedQueue::edgeQueueComparison, this, _1, _2) ), //This tells the edgeQueue_ to use the edgeQueueComparison for sorting
                 vertexIterLookup_(),
+                lowerBoundQueue_( boost::bind(&IntegratedQueue::vertexQueueComparison, this, _1, _2) ), //The lower-bound queue uses the same comparison, just on a different key
+                lowerBoundIterLookup_(),
                 outgoingEdges_(),
                 incomingEdges_(),
                 resortVertices_(),
@@ -407,61 +409,42 @@ namespace ompl
             {
                 throw ompl::Exception("Prune cannot be called on an unsorted queue.");
             }
-            //The vertex expansion queue is sorted on an estimated solution cost considering the *current* cost-to-come of the vertices, while we prune by considering the best-case cost-to-come.
-            //This means that the value of the vertices in the queue are an upper-bounding estimate of the value we will use to prune them.
-            //Therefore, we can start our pruning at the goal vertex and iterate forward through the queue from there.
+            //The lower-bound queue is sorted on the best-case solution cost through each vertex, which is exactly the value we prune on and does not change as the graph is rewired.
+            //This means that every vertex that needs pruning lies after the threshold in that queue and we never need to look at the vertices in front of it.
 
             //Variables:
             //The number of vertices and samples pruned:
             std::pair<unsigned int, unsigned int> numPruned;
-            //The iterator into the lookup helper:
-            vid_vertex_queue_iter_umap_t::iterator lookupIter;
-            //The iterator into the queue:
-            vertex_queue_iter_t queueIter;
+            //The vertices with a lower bound past the threshold:
+            std::vector<VertexPtr> pruneVertices;
 
             //Initialize the counters:
             numPruned = std::make_pair(0u, 0u);
 
-            //Get the iterator to the queue to the goal.
-            lookupIter = vertexIterLookup_.find(goalVertex_->getId());
-
-            //Check that it was found
-            if (lookupIter == vertexIterLookup_.end())
+            //Copy out all the vertices after the threshold. They are copied as pruning a branch erases entries from the lower-bound queue:
+            for (vertex_queue_iter_t lbIter = lowerBoundQueue_.upper_bound(costThreshold_); lbIter != lowerBoundQueue_.end(); ++lbIter)
             {
-                //Complain
-                throw ompl::Exception("The goal vertex is not in the queue?");
+                pruneVertices.push_back(lbIter->second);
             }
 
-            //Get the iterator to the goal vertex in the queue:
-            queueIter = lookupIter->second;
-
-            //Move to the one after:
-            ++queueIter;
-
-            //Iterate through to the end of the queue
-            while (queueIter != vertexQueue_.end())
+            //Iterate through the vertices to prune:
+            for (unsigned int i = 0u; i < pruneVertices.size(); ++i)
             {
-                //Check if it should be pruned (value) or has lost its parent.
-                if (this->vertexPruneCondition(queueIter->second) == true)
+                //Make sure it has not already been pruned or returned to the set of samples as part of a branch pruned earlier in this loop:
+                if (pruneVertices.at(i)->isPruned() == false && pruneVertices.at(i)->isConnected() == true)
                 {
-                    //The vertex should be pruned.
-                    //Variables
-                    //An iter to the vertex to prune:
-                    vertex_queue_iter_t pruneIter;
-
-                    //Copy the iterator to prune:
-                    pruneIter = queueIter;
-
-                    //Move the queue iterator back one so we can step to the next *valid* vertex after pruning:
-                    --queueIter;
+                    //Variable:
+                    //The number pruned by this branch:
+                    std::pair<unsigned int, unsigned int> branchNumPruned;
 
                     //Prune the branch:
-                    numPruned = this->pruneBranch(pruneIter->second, vertexNN, freeStateNN);
-                }
-                //No else, skip this vertex.
+                    branchNumPruned = this->pruneBranch(pruneVertices.at(i), vertexNN, freeStateNN);
 
-                //Iterate forward to the next value in the queue
-                ++queueIter;
+                    //Update the counter:
+                    numPruned.first = numPruned.first + branchNumPruned.first;
+                    numPruned.second = numPruned.second + branchNumPruned.second;
+                }
+                //No else, this vertex was a descendant of a branch that was already pruned.
             }
 
             //Return the number of vertices and samples pruned.
@@ -514,8 +497,16 @@ namespace ompl
                                 if (this->vertexPruneCondition(vIter->second) == true)
                                 {
                                     //The vertex should just be pruned and forgotten about.
+                                    //Variable:
+                                    //The number pruned by this branch:
+                                    std::pair<unsigned int, unsigned int> branchNumPruned;
+
                                     //Prune the branch:
-                                    numPruned = this->pruneBranch(vIter->second, vertexNN, freeStateNN);
+                                    branchNumPruned = this->pruneBranch(vIter->second, vertexNN, freeStateNN);
+
+                                    //Update the counter:
+                                    numPruned.first = numPruned.first + branchNumPruned.first;
+                                    numPruned.second = numPruned.second + branchNumPruned.second;
                                 }
                                 else
                                 {
@@ -598,6 +589,10 @@ namespace ompl
             //The lookups:
             vertexIterLookup_.clear();
             outgoingEdges_.clear();
+
+            //The lower-bound queue:
+            lowerBoundQueue_.clear();
+            lowerBoundIterLookup_.clear();
             incomingEdges_.clear();
 
             //The resort list:
@@ -681,6 +676,51 @@ namespace ompl
 
 
 
+        std::size_t IntegratedQueue::getMemoryUsage() const
+        {
+            //Variables:
+            //The size of a node of a multimap, which stores 3 pointers and a colour besides its value:
+            std::size_t treeNodeBytes;
+            //The size of a node of an unordered map, which stores a pointer to the next node besides its value:
+            std::size_t hashNodeBytes;
+            //The number of entries in the edge lookup lists:
+            std::size_t numLookupEdges;
+            //The number of bytes used:
+            std::size_t bytes;
+
+            treeNodeBytes = 4u*sizeof(void*);
+            hashNodeBytes = sizeof(void*);
+
+            //Every edge in the queue is also in the lookup list of its source and/or target, if used:
+            numLookupEdges = 0u;
+            if (outgoingLookupTables_ == true)
+            {
+                numLookupEdges = numLookupEdges + edgeQueue_.size();
+            }
+            if (incomingLookupTables_ == true)
+            {
+                numLookupEdges = numLookupEdges + edgeQueue_.size();
+            }
+
+            //The vertex queues and their lookups:
+            bytes = (vertexQueue_.size() + lowerBoundQueue_.size())*(treeNodeBytes + sizeof(ompl::base::Cost) + sizeof(VertexPtr));
+            bytes = bytes + (vertexIterLookup_.size() + lowerBoundIterLookup_.size())*(hashNodeBytes + sizeof(Vertex::id_t) + sizeof(vertex_queue_iter_t));
+            bytes = bytes + (vertexIterLookup_.bucket_count() + lowerBoundIterLookup_.bucket_count())*sizeof(void*);
+
+            //The edge queue and its lookups:
+            bytes = bytes + edgeQueue_.size()*(treeNodeBytes + sizeof(cost_pair_t) + sizeof(vertex_pair_t));
+            bytes = bytes + (outgoingEdges_.size() + incomingEdges_.size())*(hashNodeBytes + sizeof(Vertex::id_t) + sizeof(edge_queue_iter_list_t));
+            bytes = bytes + (outgoingEdges_.bucket_count() + incomingEdges_.bucket_count())*sizeof(void*);
+            bytes = bytes + numLookupEdges*(2u*sizeof(void*) + sizeof(edge_queue_iter_t));
+
+            //The vertices waiting to be resorted:
+            bytes = bytes + resortVertices_.size()*(2u*sizeof(void*) + sizeof(VertexPtr));
+
+            return bytes;
+        }
+
+
+
         unsigned int IntegratedQueue::numEdgesTo(const VertexPtr& cVertex) const
         {
             //Variables:
@@ -1164,6 +1204,12 @@ namespace ompl
             //Store the iterator in the lookup. This will create insert if necessary and otherwise lookup
             vertexIterLookup_[newVertex->getId()] = vertexIter;
 
+            //Insert into the lower-bound queue if not already there. A vertex being reinserted keeps its entry, as its lower bound cannot have changed:
+            if (lowerBoundIterLookup_.count(newVertex->getId()) == 0u)
+            {
+                lowerBoundIterLookup_[newVertex->getId()] = lowerBoundQueue_.insert( std::make_pair(lowerBoundHeuristicVertexFunc_(newVertex), newVertex) );
+            }
+
             //Check if we are in front of the token and expand if so:
             if (vertexQueue_.size() == 1u)
             {
@@ -1294,8 +1340,20 @@ namespace ompl
                 //Remove from lookups map as requested
                 if (removeLookups == true)
                 {
+                    //Variable:
+                    //The iterator into the lower-bound lookup:
+                    vid_vertex_queue_iter_umap_t::iterator lbLookupIter;
+
                     vertexIterLookup_.erase(lookupIter);
                     this->removeEdgesFrom(oldVertex);
+
+                    //Remove myself from the lower-bound queue:
+                    lbLookupIter = lowerBoundIterLookup_.find(oldVertex->getId());
+                    if (lbLookupIter != lowerBoundIterLookup_.end())
+                    {
+                        lowerBoundQueue_.erase(lbLookupIter->second);
+                        lowerBoundIterLookup_.erase(lbLookupIter);
+                    }
                 }
 
                 //Check if I have been given permission to change sets:
@@ -43,7 +43,9 @@
 #include "ompl/tools/config/SelfConfig.h"
 
 #include <boost/thread.hpp>
+#include <boost/unordered_set.hpp>
 
+#include <string>
 #include <vector>
 
 namespace ompl
@@ -155,6 +157,42 @@ namespace ompl
                 return numThreads_;
             }
 
+            /** \brief Enable or disable deterministic execution. In
+                deterministic mode every planner instance draws the seeds
+                of the random number generators it creates from a stream
+                derived from a seed of CForest and the index of the
+                instance. The instances synchronize every few termination
+                checks; solutions found since the previous
+                synchronization are shared then, in the order of the
+                instance indices, and the termination condition is
+                checked. Calling solve() on planners seeded identically
+                (see setLocalSeed()) then produces the same searches,
+                independent of how the threads are scheduled, as long as
+                the planner instances themselves only use random number
+                generators they create during solve(). */
+            void setDeterministic(bool deterministic)
+            {
+                deterministic_ = deterministic;
+            }
+
+            /** \brief Check whether deterministic execution is enabled */
+            bool getDeterministic() const
+            {
+                return deterministic_;
+            }
+
+            /** \brief Set the seed from which the random streams of the planner instances are derived in deterministic mode */
+            void setLocalSeed(boost::uint32_t localSeed)
+            {
+                rng_.setLocalSeed(localSeed);
+            }
+
+            /** \brief Get the seed from which the random streams of the planner instances are derived in deterministic mode */
+            boost::uint32_t getLocalSeed() const
+            {
+                return rng_.getLocalSeed();
+            }
+
             /** \brief Get best cost among all the planners. */
             std::string getBestCost() const;
 
@@ -172,11 +210,42 @@ namespace ompl
             /** \brief Callback to be called everytime a new, better solution is found by a planner. */
             void newSolutionFound(const base::Planner *planner, const std::vector<const base::State *> &states, const base::Cost cost);
 
+            /** \brief Share a solution found by \e planner with the other planners, if it improves the best cost.
+                Only the states whose values were not shared before are passed on. */
+            void shareSolution(const base::Planner *planner, const std::vector<const base::State *> &states,
+                               const base::Cost cost);
+
+            /** \brief Identify \e state by its serialized value, so that states freed and allocated again at the
+                same address are told apart, and copies of a state are not shared twice. If the state space does
+                not support serialization, the address of \e state is used instead. */
+            std::string stateKey(const base::State *state) const;
+
+            /** \brief Callback to be called everytime a planner improves its solution, to report the improvements of the best solution among all planners. */
+            void improvedSolutionFound(const base::ImprovedSolutionEvent &event);
+
         protected:
 
+            /** \brief The state of the synchronization of the planner instances in deterministic mode */
+            struct SyncInfo;
+
             /** \brief Manages the call to solve() for each individual planner. */
             void solve(base::Planner *planner, const base::PlannerTerminationCondition &ptc);
 
+            /** \brief Manages the call to solve() for the planner with index \e index in deterministic mode. */
+            void solveDeterministic(std::size_t index, boost::uint32_t seed, SyncInfo *sync);
+
+            /** \brief The termination condition of the planner with index \e index in deterministic mode. Every
+                few calls, this waits for the other planners, and the last planner to arrive shares the pending
+                solutions and checks the termination condition of solve(). */
+            bool synchronize(std::size_t index, SyncInfo *sync);
+
+            /** \brief Complete a synchronization: share the pending solutions, check the termination condition of
+                solve() and release the waiting planners. This is called with the lock of \e sync held. */
+            void finishSynchronization(SyncInfo *sync);
+
+            /** \brief Share the solutions reported since the previous synchronization, in planner order */
+            void sharePendingSolutions(SyncInfo *sync);
+
             /** \brief Optimization objective taken into account when planning. */
             base::OptimizationObjectivePtr               opt_;
 
@@ -186,19 +255,22 @@ namespace ompl
             /** \brief The set of sampler allocated by the planners */
             std::vector<base::StateSamplerPtr>           samplers_;
 
-            /** \brief Stores the states already shared to check if a specific state has been shared. */
-            boost::unordered_set<const base::State *>    statesShared_;
+            /** \brief Stores the keys (see stateKey()) of the states already shared to check if a specific state has been shared. */
+            boost::unordered_set<std::string>            statesShared_;
 
             /** \brief Cost of the best path found so far among planners. */
             base::Cost                                   bestCost_;
 
+            /** \brief Cost of the best path reported through the improved solution callback. */
+            base::Cost                                   reportedCost_;
+
             /** \brief Number of paths shared among threads. */
             unsigned int                                 numPathsShared_;
 
             /** \brief Number of states shared among threads. */
             unsigned int                                 numStatesShared_;
 
-            /** \brief Mutex to control the access to the newSolutionFound() method. */
+            /** \brief Mutex to control the access to the newSolutionFound() and improvedSolutionFound() methods. */
             boost::mutex                                 newSolutionFoundMutex_;
 
             /** \brief Mutex to control the access to samplers_ */
@@ -209,6 +281,15 @@ namespace ompl
 
             /** \brief Default number of threads to use when no planner instances are specified by the user */
             unsigned int                                 numThreads_;
+
+            /** \brief Flag indicating whether deterministic execution is enabled */
+            bool                                         deterministic_;
+
+            /** \brief The random number generator that seeds the planner instances in deterministic mode */
+            RNG                                          rng_;
+
+            /** \brief The synchronization state while solve() runs in deterministic mode (NULL otherwise) */
+            SyncInfo                                    *sync_;
         };
     }
 }
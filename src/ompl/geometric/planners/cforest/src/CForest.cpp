@@ -37,6 +37,59 @@
 #include "ompl/geometric/planners/cforest/CForest.h"
 #include "ompl/geometric/planners/rrt/RRTstar.h"
 #include "ompl/base/objectives/PathLengthOptimizationObjective.h"
+#include <limits>
+
+namespace ompl
+{
+    namespace magic
+    {
+        /** \brief The number of termination checks each planner
+            instance performs between two synchronizations in
+            deterministic mode */
+        static const unsigned int CFOREST_SYNCHRONIZATION_PERIOD = 100;
+    }
+}
+
+struct ompl::geometric::CForest::SyncInfo
+{
+    /** \brief A solution reported by a planner instance and not shared yet */
+    struct PendingSolution
+    {
+        /** \brief Copies of the states of the solution, as the planner may free them before they are shared */
+        std::vector<const base::State*> values;
+
+        base::Cost                      cost;
+    };
+
+    SyncInfo(std::size_t planners, const base::PlannerTerminationCondition &ptc) :
+        ptc(ptc), checks(planners, 0), pending(planners), active(planners), arrived(0), round(0), stop(false)
+    {
+    }
+
+    /** \brief The termination condition passed to solve() */
+    base::PlannerTerminationCondition            ptc;
+
+    /** \brief The number of termination checks of each planner */
+    std::vector<unsigned int>                    checks;
+
+    /** \brief The solutions reported by each planner since the previous synchronization */
+    std::vector<std::vector<PendingSolution> >   pending;
+
+    boost::mutex                                 lock;
+    boost::condition_variable                    condition;
+
+    /** \brief The number of planners still running */
+    std::size_t                                  active;
+
+    /** \brief The number of planners waiting for the current synchronization */
+    std::size_t                                  arrived;
+
+    /** \brief The number of completed synchronizations */
+    unsigned int                                 round;
+
+    /** \brief The value of the termination condition at the last synchronization */
+    bool                                         stop;
+};
 
 ompl::geometric::CForest::CForest(const base::SpaceInformationPtr &si) : base::Planner(si, "CForest")
 {
@@ -46,10 +99,13 @@ ompl::geometric::CForest::CForest(const base::SpaceInformationPtr &si) : base::P
     numPathsShared_ = 0;
     numStatesShared_ = 0;
     prune_ = true;
+    deterministic_ = false;
+    sync_ = NULL;
 
     numThreads_ = std::max(boost::thread::hardware_concurrency(), 2u);
     Planner::declareParam<bool>("prune", this, &CForest::setPrune, &CForest::getPrune, "0,1");
     Planner::declareParam<unsigned int>("num_threads", this, &CForest::setNumThreads, &CForest::getNumThreads, "0:64");
+    Planner::declareParam<bool>("deterministic", this, &CForest::setDeterministic, &CForest::getDeterministic, "0,1");
 
     addPlannerProgressProperty("best cost REAL",
                                boost::bind(&CForest::getBestCost, this));
@@ -125,6 +181,7 @@ void ompl::geometric::CForest::clear()
     bestCost_ = base::Cost(std::numeric_limits<double>::quiet_NaN());
     numPathsShared_ = 0;
     numStatesShared_ = 0;
+    statesShared_.clear();
 
     std::vector<base::StateSamplerPtr> samplers;
     samplers.reserve(samplers_.size());
@@ -174,10 +231,33 @@ ompl::base::PlannerStatus ompl::geometric::CForest::solve(const base::PlannerTer
 
     pdef_->setIntermediateSolutionCallback(boost::bind(&CForest::newSolutionFound, this, _1, _2, _3));
     bestCost_ = opt_->infiniteCost();
+    reportedCost_ = opt_->infiniteCost();
+
+    // improvements of the individual planners are filtered to report only the improvements of the best solution
+    std::vector<base::ImprovedSolutionCallback> prevImprovedSolutionCallbacks(planners_.size());
+    if (hasImprovedSolutionCallback())
+        for (std::size_t i = 0 ; i < planners_.size() ; ++i)
+        {
+            prevImprovedSolutionCallbacks[i] = planners_[i]->getImprovedSolutionCallback();
+            planners_[i]->setImprovedSolutionCallback(boost::bind(&CForest::improvedSolutionFound, this, _1));
+        }
+
+    // in deterministic mode, the planners derive their random streams from this seed and synchronize periodically
+    SyncInfo sync(planners_.size(), ptc);
+    boost::uint32_t seed = 0;
+    if (deterministic_)
+    {
+        seed = rng_.uniformInt(1, std::numeric_limits<int>::max());
+        OMPL_DEBUG("%s: Deterministic execution with seed %u", getName().c_str(), seed);
+        sync_ = &sync;
+    }
 
     // run each planner in its own thread, with the same ptc.
     for (std::size_t i = 0 ; i < threads.size() ; ++i)
-        threads[i] = new boost::thread(boost::bind(&CForest::solve, this, planners_[i].get(), ptc));
+        if (deterministic_)
+            threads[i] = new boost::thread(boost::bind(&CForest::solveDeterministic, this, i, seed, &sync));
+        else
+            threads[i] = new boost::thread(boost::bind(&CForest::solve, this, planners_[i].get(), ptc));
 
     for (std::size_t i = 0 ; i < threads.size() ; ++i)
     {
@@ -185,8 +265,18 @@ ompl::base::PlannerStatus ompl::geometric::CForest::solve(const base::PlannerTer
         delete threads[i];
     }
 
-    // restore callback
+    if (deterministic_)
+    {
+        // account for the solutions found after the last synchronization
+        sharePendingSolutions(&sync);
+        sync_ = NULL;
+    }
+
+    // restore callbacks
     getProblemDefinition()->setIntermediateSolutionCallback(prevSolutionCallback);
+    if (hasImprovedSolutionCallback())
+        for (std::size_t i = 0 ; i < planners_.size() ; ++i)
+            planners_[i]->setImprovedSolutionCallback(prevImprovedSolutionCallbacks[i]);
     OMPL_INFORM("Solution found in %f seconds", time::seconds(time::now() - start));
     return base::PlannerStatus(pdef_->hasSolution(), pdef_->hasApproximateSolution());
 }
@@ -207,6 +297,40 @@ std::string ompl::geometric::CForest::getNumStatesShared() const
 }
 
 void ompl::geometric::CForest::newSolutionFound(const base::Planner *planner, const std::vector<const base::State *> &states, const base::Cost cost)
+{
+    if (!sync_)
+    {
+        shareSolution(planner, states, cost);
+        return;
+    }
+
+    // in deterministic mode, the solution is shared at the next synchronization
+    std::size_t index = 0;
+    while (planners_[index].get() != planner)
+        ++index;
+
+    SyncInfo::PendingSolution solution;
+    solution.values.reserve(states.size());
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+        solution.values.push_back(si_->cloneState(states[i]));
+    solution.cost = cost;
+
+    boost::mutex::scoped_lock slock(sync_->lock);
+    sync_->pending[index].push_back(solution);
+}
+
+std::string ompl::geometric::CForest::stateKey(const base::State *state) const
+{
+    const base::StateSpacePtr &space = si_->getStateSpace();
+    if (space->getSerializationLength() == 0)
+        return std::string(reinterpret_cast<const char*>(&state), sizeof(state));
+    std::string key(space->getSerializationLength(), '\0');
+    space->serialize(&key[0], state);
+    return key;
+}
+
+void ompl::geometric::CForest::shareSolution(const base::Planner *planner, const std::vector<const base::State *> &states,
+                                             const base::Cost cost)
 {
     bool change = false;
     std::vector<const base::State *> statesToShare;
@@ -219,12 +343,11 @@ void ompl::geometric::CForest::newSolutionFound(const base::Planner *planner, co
 
         // Filtering the states to add only those not already added.
         statesToShare.reserve(states.size());
-        for (std::vector<const base::State *>::const_iterator st = states.begin(); st != states.end(); ++st)
+        for (std::size_t i = 0 ; i < states.size() ; ++i)
         {
-            if (statesShared_.find(*st) == statesShared_.end())
+            if (statesShared_.insert(stateKey(states[i])).second)
             {
-                statesShared_.insert(*st);
-                statesToShare.push_back(*st);
+                statesToShare.push_back(states[i]);
                 ++numStatesShared_;
             }
         }
@@ -243,6 +366,16 @@ void ompl::geometric::CForest::newSolutionFound(const base::Planner *planner, co
     }
 }
 
+void ompl::geometric::CForest::improvedSolutionFound(const base::ImprovedSolutionEvent &event)
+{
+    boost::mutex::scoped_lock slock(newSolutionFoundMutex_);
+    if (opt_->isCostBetterThan(event.cost, reportedCost_))
+    {
+        reportedCost_ = event.cost;
+        notifyImprovedSolution(event.states, event.cost);
+    }
+}
+
 void ompl::geometric::CForest::solve(base::Planner *planner, const base::PlannerTerminationCondition &ptc)
 {
     OMPL_DEBUG("Starting %s", planner->getName().c_str());
@@ -253,3 +386,60 @@ void ompl::geometric::CForest::solve(base::Planner *planner, const base::Planner
         OMPL_DEBUG("Solution found by %s in %lf seconds", planner->getName().c_str(), duration);
     }
 }
+
+void ompl::geometric::CForest::solveDeterministic(std::size_t index, boost::uint32_t seed, SyncInfo *sync)
+{
+    {
+        // the random number generators the planner creates are seeded from (seed, index) only
+        RNG::ScopedSeed scope(seed, index);
+        solve(planners_[index].get(), base::PlannerTerminationCondition(boost::bind(&CForest::synchronize, this, index, sync)));
+    }
+
+    // the remaining planners no longer wait for this one
+    boost::mutex::scoped_lock slock(sync->lock);
+    --sync->active;
+    if (sync->active > 0 && sync->arrived == sync->active)
+        finishSynchronization(sync);
+}
+
+bool ompl::geometric::CForest::synchronize(std::size_t index, SyncInfo *sync)
+{
+    // stop only changes while all running planners wait below
+    if (++sync->checks[index] % magic::CFOREST_SYNCHRONIZATION_PERIOD != 0)
+        return sync->stop;
+
+    boost::mutex::scoped_lock slock(sync->lock);
+    if (++sync->arrived == sync->active)
+        finishSynchronization(sync);
+    else
+    {
+        const unsigned int round = sync->round;
+        while (round == sync->round)
+            sync->condition.wait(slock);
+    }
+    return sync->stop;
+}
+
+void ompl::geometric::CForest::finishSynchronization(SyncInfo *sync)
+{
+    sharePendingSolutions(sync);
+    sync->stop = sync->ptc();
+    sync->arrived = 0;
+    ++sync->round;
+    sync->condition.notify_all();
+}
+
+void ompl::geometric::CForest::sharePendingSolutions(SyncInfo *sync)
+{
+    for (std::size_t i = 0 ; i < sync->pending.size() ; ++i)
+    {
+        for (std::size_t j = 0 ; j < sync->pending[i].size() ; ++j)
+        {
+            SyncInfo::PendingSolution &solution = sync->pending[i][j];
+            shareSolution(planners_[i].get(), solution.values, solution.cost);
+            for (std::size_t k = 0 ; k < solution.values.size() ; ++k)
+                si_->freeState(const_cast<base::State*>(solution.values[k]));
+        }
+        sync->pending[i].clear();
+    }
+}
@@ -0,0 +1,209 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2015, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_GEOMETRIC_PLANNERS_PRM_COMPACT_ROADMAP_
+#define OMPL_GEOMETRIC_PLANNERS_PRM_COMPACT_ROADMAP_
+
+#include "ompl/geometric/planners/prm/SPARStwo.h"
+#include "ompl/geometric/PathGeometric.h"
+#include "ompl/base/OptimizationObjective.h"
+#include "ompl/datastructures/NearestNeighbors.h"
+#include <boost/scoped_ptr.hpp>
+#include <vector>
+
+namespace ompl
+{
+    namespace geometric
+    {
+
+        /** \brief A frozen, read-only copy of a sparse roadmap, laid out for answering queries.
+
+            @par
+            The states of the roadmap are copied once and indexed by a
+            nearest neighbors structure, and the edges are stored in
+            compressed sparse row form (offsets, targets, weights). The
+            connected components of the roadmap and the roadmap costs from
+            a few landmark vertices are computed once, at construction. The
+            landmark costs give the lower bounds on roadmap costs used as
+            A* heuristic (triangle inequality), so queries do not evaluate
+            the state space distance during the graph search.
+
+            @par
+            Edge weights and the links of the start and goal states to the
+            roadmap are all motion costs of the optimization objective.
+            Costs are added along paths, so the objective is expected to
+            be additive (e.g., path length).
+
+            @par
+            A query connects the start and goal states to the visible
+            roadmap vertices within the connection radius and searches the
+            roadmap for the cheapest path between them. All the data needed
+            by a query is local to the call, so solve() can be called from
+            multiple threads at the same time without locking. The state
+            validity checker and motion validator of the space information
+            must be thread-safe, as for all multi-threaded planners.
+
+            @par
+            Instances are usually obtained from a finished roadmap with
+            SPARStwo::getCompactRoadmap(). */
+        class CompactRoadmap
+        {
+        public:
+
+            /** \brief Copy the vertices and edges of \e graph (a SPARStwo roadmap). Edges and query links are
+                weighted by the motion costs of \e opt (path length if \e opt is not set). Query states are connected
+                to the roadmap vertices within \e connectionRadius. \e numLandmarks vertices are used for computing
+                the A* heuristic. */
+            CompactRoadmap(const base::SpaceInformationPtr &si, const base::OptimizationObjectivePtr &opt,
+                           const SPARStwo::Graph &graph, double connectionRadius, unsigned int numLandmarks = 4);
+
+            ~CompactRoadmap();
+
+            /** \brief Compute the cheapest path from \e start to \e goal through the roadmap and store it in \e path.
+                Return false if either state cannot be connected to the roadmap or if they connect to different
+                connected components. This function is thread-safe. */
+            bool solve(const base::State *start, const base::State *goal, PathGeometric &path) const;
+
+            /** \brief Get the space information the roadmap was built for */
+            const base::SpaceInformationPtr& getSpaceInformation() const
+            {
+                return si_;
+            }
+
+            /** \brief Get the optimization objective that weights the roadmap */
+            const base::OptimizationObjectivePtr& getOptimizationObjective() const
+            {
+                return opt_;
+            }
+
+            /** \brief Get the number of vertices in the roadmap */
+            std::size_t numVertices() const
+            {
+                return states_.size();
+            }
+
+            /** \brief Get the number of (undirected) edges in the roadmap */
+            std::size_t numEdges() const
+            {
+                return edgeTargets_.size() / 2;
+            }
+
+            /** \brief Get the number of connected components of the roadmap */
+            unsigned int numComponents() const
+            {
+                return numComponents_;
+            }
+
+            /** \brief Get the number of landmarks used for the A* heuristic */
+            unsigned int getNumLandmarks() const
+            {
+                return landmarks_.size();
+            }
+
+            /** \brief Get the radius within which query states are connected to the roadmap */
+            double getConnectionRadius() const
+            {
+                return connectionRadius_;
+            }
+
+            /** \brief Copy the state of vertex \e v to \e state */
+            void getState(std::size_t v, base::State *state) const;
+
+            /** \brief Get the approximate number of bytes used by the roadmap */
+            std::size_t getMemoryUsage() const;
+
+        private:
+
+            /** \brief A roadmap state along with its vertex index */
+            typedef std::pair<const base::State*, unsigned int> IndexedState;
+
+            /** \brief Distance between the states of two indexed states, for the nearest neighbors structure */
+            double distance(const IndexedState &a, const IndexedState &b) const
+            {
+                return si_->distance(a.first, b.first);
+            }
+
+            /** \brief Find the roadmap vertices visible from \e st (\e toState is true) or from which \e st is visible
+                (\e toState is false), within the connection radius, along with the cost of the connecting motions */
+            void connect(const base::State *st, bool toState, std::vector< std::pair<unsigned int, double> > &links) const;
+
+            /** \brief Compute roadmap costs from \e source to all the vertices */
+            void shortestDistances(unsigned int source, double *dist) const;
+
+            /** \brief Select the landmarks and compute their distances to all the vertices */
+            void computeLandmarks(unsigned int numLandmarks);
+
+            /** \brief Lower bound on the roadmap cost between \e u and \e v, computed from the landmarks */
+            double landmarkBound(unsigned int u, unsigned int v) const;
+
+            /** \brief The space information the roadmap was built for */
+            base::SpaceInformationPtr       si_;
+
+            /** \brief The objective whose motion costs weight the edges and the query links */
+            base::OptimizationObjectivePtr  opt_;
+
+            /** \brief The radius within which query states are connected to the roadmap */
+            double                          connectionRadius_;
+
+            /** \brief The states of the vertices */
+            std::vector<base::State*>       states_;
+
+            /** \brief Nearest neighbors structure over the states of the vertices */
+            boost::scoped_ptr< NearestNeighbors<IndexedState> > nn_;
+
+            /** \brief The edges of vertex v are edgeTargets_[edgeOffsets_[v] ... edgeOffsets_[v + 1] - 1] */
+            std::vector<unsigned int>       edgeOffsets_;
+
+            /** \brief The target vertices of the edges (each edge is stored in both directions) */
+            std::vector<unsigned int>       edgeTargets_;
+
+            /** \brief The costs of the edges, aligned with edgeTargets_ */
+            std::vector<double>             edgeWeights_;
+
+            /** \brief The connected component of each vertex */
+            std::vector<unsigned int>       components_;
+
+            /** \brief The number of connected components */
+            unsigned int                    numComponents_;
+
+            /** \brief The landmark vertices */
+            std::vector<unsigned int>       landmarks_;
+
+            /** \brief The roadmap costs from the landmarks to all the vertices, one row per landmark */
+            std::vector<double>             landmarkDistances_;
+        };
+    }
+}
+
+#endif
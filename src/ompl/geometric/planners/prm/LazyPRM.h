@@ -231,7 +231,7 @@ namespace ompl
                 Subsequent calls to solve() will reuse the previously computed roadmap,
                 but will clear the set of input states constructed by the previous call to solve().
                 This enables multi-query functionality for LazyPRM. */
-            void clearQuery();
+            virtual void clearQuery();
 
             virtual base::PlannerStatus solve(const base::PlannerTerminationCondition &ptc);
 
@@ -170,6 +170,28 @@ namespace ompl
              */
             void setMaxNearestNeighbors(unsigned int k);
 
+            /** \brief Enable or disable deterministic execution. By
+                default, solve() looks for a solution in a separate
+                thread while the roadmap is built, and alternates between
+                growing and expanding the roadmap in time slices, so the
+                roadmap at the moment a solution is found depends on
+                timing. In deterministic mode, the roadmap is grown and
+                expanded for fixed numbers of iterations, and goal states
+                are added and the solution is checked for between these
+                steps, in the calling thread. Planners whose random
+                number generators are seeded identically (see
+                RNG::setSeed()) then build the same roadmap. */
+            void setDeterministic(bool deterministic)
+            {
+                deterministic_ = deterministic;
+            }
+
+            /** \brief Check whether deterministic execution is enabled */
+            bool getDeterministic() const
+            {
+                return deterministic_;
+            }
+
             /** \brief Set the function that can reject a milestone connection.
 
              \par The given function is called immediately before a connection
@@ -190,6 +212,10 @@ namespace ompl
 
             virtual void getPlannerData(base::PlannerData &data) const;
 
+            /** \brief Estimate the memory used by the roadmap: the graph with
+                its states and the nearest neighbors datastructure */
+            virtual std::size_t getMemoryUsage() const;
+
             /** \brief While the termination condition allows, this function will construct the roadmap (using growRoadmap() and expandRoadmap(),
                 maintaining a 2:1 ratio for growing/expansion of roadmap) */
             void constructRoadmap(const base::PlannerTerminationCondition &ptc);
@@ -233,7 +259,7 @@ namespace ompl
                 Subsequent calls to solve() will reuse the previously computed roadmap,
                 but will clear the set of input states constructed by the previous call to solve().
                 This enables multi-query functionality for PRM. */
-            void clearQuery();
+            virtual void clearQuery();
 
             virtual void clear();
 
@@ -300,6 +326,20 @@ namespace ompl
             /** Thread that checks for solution */
             void checkForSolution(const base::PlannerTerminationCondition &ptc, base::PathPtr &solution);
 
+            /** \brief Add a goal milestone if a new goal state is available and check for a solution. This is one
+                step of checkForSolution(). */
+            bool checkForSolutionOnce(base::PathPtr &solution);
+
+            /** \brief Build the roadmap and check for a solution in turns, in the calling thread, until \e ptc
+                is true or a solution is found. This is how solve() proceeds in deterministic mode. */
+            void constructRoadmapDeterministic(const base::PlannerTerminationCondition &ptc, base::PathPtr &solution);
+
+            /** \brief Check whether the iteration count reached \e limit */
+            bool iterationLimitReached(unsigned long int limit) const
+            {
+                return iterations_ >= limit;
+            }
+
             /** \brief Check if there exists a solution, i.e., there exists a pair of milestones such that the first is in \e start and the second is in \e goal, and the two milestones are in the same connected component. If a solution is found, it is constructed in the \e solution argument. */
             bool maybeConstructSolution(const std::vector<Vertex> &starts, const std::vector<Vertex> &goals, base::PathPtr &solution);
 
@@ -394,6 +434,9 @@ namespace ompl
             /** \brief A flag indicating that a solution has been added during solve() */
             bool                                                   addedNewSolution_;
 
+            /** \brief Flag indicating whether deterministic execution is enabled */
+            bool                                                   deterministic_;
+
             /** \brief Mutex to guard access to the Graph member (g_) */
             mutable boost::mutex                                   graphMutex_;
 
@@ -229,7 +229,7 @@ namespace ompl
                 Subsequent calls to solve() will reuse the previously computed roadmap,
                 but will clear the set of input states constructed by the previous call to solve().
                 This enables multi-query functionality for PRM. */
-            void clearQuery();
+            virtual void clearQuery();
 
             virtual void clear();
 
@@ -321,6 +321,18 @@ namespace ompl
                 return stretchFactor_;
             }
 
+            /** \brief Set the number of threads used by constructRoadmap(). With more than one thread, candidate
+                samples and the motions to their dense and sparse neighborhoods are computed concurrently, while
+                additions to the graphs are still made by a single thread, in a fixed order. The default is 1,
+                i.e., fully serial construction. */
+            void setNumThreads(unsigned int numThreads);
+
+            /** \brief Get the number of threads used by constructRoadmap() */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
             virtual void setup();
 
             /** \brief Retrieve the underlying dense graph structure.  This is built as a PRM* and asymptotically approximates best paths through the space. */
@@ -370,9 +382,41 @@ namespace ompl
 
         protected:
 
+            /** \brief A motion check to be evaluated by the parallel front-end of constructRoadmap() */
+            struct MotionCheck
+            {
+                MotionCheck(const base::State *from, const base::State *to) : s1(from), s2(to), valid(false)
+                {
+                }
+
+                const base::State *s1;
+                const base::State *s2;
+                bool               valid;
+            };
+
+            /** \brief Results of the motion checks computed ahead of time, indexed by the pair of states */
+            typedef boost::unordered_map< std::pair<const base::State*, const base::State*>, bool,
+                                          boost::hash< std::pair<const base::State*, const base::State*> > > MotionCache;
+
             /** \brief Attempt to add a single sample to the roadmap. */
             DenseVertex addSample(base::State *workState, const base::PlannerTerminationCondition &ptc);
 
+            /** \brief Try to add the milestone \e q, already in the dense graph, to the spanner */
+            void checkAddSample(DenseVertex q, std::vector<SparseVertex> &graphNeighborhood, std::vector<SparseVertex> &visibleNeighborhood,
+                                std::vector<DenseVertex> &interfaceNeighborhood);
+
+            /** \brief Construct the roadmap with numThreads_ threads */
+            void constructRoadmapParallel(const base::PlannerTerminationCondition &ptc);
+
+            /** \brief Sample valid states for the candidates assigned to thread \e tid */
+            void sampleCandidates(unsigned int tid, const base::PlannerTerminationCondition &ptc);
+
+            /** \brief Evaluate the part of motionChecks_ assigned to thread \e tid */
+            void evaluateMotionChecks(unsigned int tid);
+
+            /** \brief Check the motion from \e s1 to \e s2, reusing the result computed by the parallel front-end when available */
+            bool checkMotion(const base::State *s1, const base::State *s2) const;
+
             /** \brief Check that the query vertex is initialized (used for internal nearest neighbor searches) */
             void checkQueryStateInitialization();
 
@@ -568,6 +612,24 @@ namespace ompl
             /** \brief Mutex to guard access to the graphs */
             mutable boost::mutex                                                graphMutex_;
 
+            /** \brief Number of threads used by constructRoadmap() */
+            unsigned int                                                        numThreads_;
+
+            /** \brief The valid state samplers used by the threads of the parallel front-end (the first one is sampler_) */
+            std::vector<base::ValidStateSamplerPtr>                             threadSamplers_;
+
+            /** \brief The candidate states of the current round of parallel construction */
+            std::vector<base::State*>                                           candidates_;
+
+            /** \brief Flags indicating whether sampling succeeded for each of candidates_ */
+            std::vector<char>                                                   candidateValid_;
+
+            /** \brief The motion checks of the current round of parallel construction */
+            std::vector<MotionCheck>                                            motionChecks_;
+
+            /** \brief The results of motionChecks_, looked up while committing candidates */
+            MotionCache                                                         motionCache_;
+
             /** \brief Objective cost function for PRM graph edges */
             base::OptimizationObjectivePtr                                      opt_;
 
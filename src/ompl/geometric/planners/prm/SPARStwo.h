@@ -61,6 +61,14 @@ namespace ompl
     namespace geometric
     {
 
+        /// @cond IGNORE
+        /** \brief Forward declaration of ompl::geometric::CompactRoadmap */
+        OMPL_CLASS_FORWARD(CompactRoadmap);
+        /// @endcond
+
+        /** \class ompl::geometric::CompactRoadmapPtr
+            \brief A boost shared pointer wrapper for ompl::geometric::CompactRoadmap */
+
         /**
            @anchor gSPARStwo
            @par Short description
@@ -294,6 +302,18 @@ namespace ompl
                 return stretchFactor_;
             }
 
+            /** \brief Set the number of threads used by constructRoadmap(). With more than one thread, candidate
+                samples, their visible neighborhoods and the samples used to detect interfaces are computed
+                concurrently, while additions to the roadmap are still made by a single thread, in a fixed order.
+                The default is 1, i.e., fully serial construction. */
+            void setNumThreads(unsigned int numThreads);
+
+            /** \brief Get the number of threads used by constructRoadmap() */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
             /** \brief While the termination condition permits, construct the spanner graph */
             void constructRoadmap(const base::PlannerTerminationCondition &ptc);
 
@@ -319,7 +339,7 @@ namespace ompl
                 Subsequent calls to solve() will reuse the previously computed roadmap,
                 but will clear the set of input states constructed by the previous call to solve().
                 This enables multi-query functionality for PRM. */
-            void clearQuery();
+            virtual void clearQuery();
 
             virtual void clear();
 
@@ -340,6 +360,11 @@ namespace ompl
                 return g_;
             }
 
+            /** \brief Produce a frozen, compact copy of the roadmap constructed so far, for answering
+                (possibly concurrent) queries without the interface data kept for construction.
+                \e numLandmarks vertices are used for the A* heuristic of the queries. */
+            CompactRoadmapPtr getCompactRoadmap(unsigned int numLandmarks = 4) const;
+
             /** \brief Get the number of vertices in the sparse roadmap. */
             unsigned int milestoneCount() const
             {
@@ -364,6 +389,68 @@ namespace ompl
 
         protected:
 
+            /** \brief A sample generated by the parallel front-end of constructRoadmap(), along with the
+                states and motion checks evaluated for it ahead of its insertion in the roadmap */
+            struct Candidate
+            {
+                /** \brief The sampled state */
+                base::State                *state;
+
+                /** \brief Flag indicating whether sampling succeeded */
+                bool                        valid;
+
+                /** \brief The range of motion checks (in motionChecks_) from \e state to its graph neighborhood */
+                std::size_t                 firstCheck, lastCheck;
+
+                /** \brief Flag indicating whether \e nearSamples were generated */
+                bool                        nearSampled;
+
+                /** \brief Samples close to \e state, used for detecting interfaces */
+                std::vector<base::State*>   nearSamples;
+            };
+
+            /** \brief A motion check to be evaluated by the parallel front-end of constructRoadmap() */
+            struct MotionCheck
+            {
+                MotionCheck(const base::State *from, const base::State *to) : s1(from), s2(to), valid(false)
+                {
+                }
+
+                const base::State *s1;
+                const base::State *s2;
+                bool               valid;
+            };
+
+            /** \brief Results of the motion checks computed ahead of time, indexed by the pair of states */
+            typedef boost::unordered_map< std::pair<const base::State*, const base::State*>, bool,
+                                          boost::hash< std::pair<const base::State*, const base::State*> > > MotionCache;
+
+            /** \brief Construct the spanner with numThreads_ threads */
+            void constructRoadmapParallel(const base::PlannerTerminationCondition &ptc);
+
+            /** \brief Sample the candidates assigned to thread \e tid */
+            void sampleCandidates(unsigned int tid, const base::PlannerTerminationCondition &ptc);
+
+            /** \brief Evaluate the motion checks of the candidates assigned to thread \e tid, then generate
+                the samples used for detecting interfaces for the candidates that see the graph */
+            void checkCandidates(unsigned int tid, const base::PlannerTerminationCondition &ptc);
+
+            /** \brief Evaluate the part of motionChecks_ starting at \e first assigned to thread \e tid */
+            void evaluateMotionChecks(unsigned int tid, std::size_t first);
+
+            /** \brief Run \e work(tid) for tid = 0 ... numThreads_ - 1, each in its own thread */
+            void runThreads(const boost::function<void(unsigned int)> &work) const;
+
+            /** \brief Check the motion from \e s1 to \e s2, reusing the result computed by the parallel front-end when available */
+            bool checkMotion(const base::State *s1, const base::State *s2) const;
+
+            /** \brief Try to add the sample \e qNew (with neighborhoods already computed) to the spanner for coverage,
+                connectivity, interface or path quality. If \e nearSamples is set, it is used instead of sampling
+                around \e qNew when detecting interfaces. */
+            void checkAddSample(base::State *qNew, base::State *workState, std::vector<Vertex> &graphNeighborhood,
+                                std::vector<Vertex> &visibleNeighborhood, const base::PlannerTerminationCondition &ptc,
+                                const std::vector<base::State*> *nearSamples = NULL);
+
             /** \brief Free all the memory allocated by the planner */
             void freeMemory();
 
@@ -396,7 +483,8 @@ namespace ompl
 
             /** \brief Finds representatives of samples near qNew_ which are not his representative */
             void findCloseRepresentatives(base::State *workArea, const base::State *qNew, Vertex qRep,
-                                          std::map<Vertex, base::State*> &closeRepresentatives, const base::PlannerTerminationCondition &ptc);
+                                          std::map<Vertex, base::State*> &closeRepresentatives, const base::PlannerTerminationCondition &ptc,
+                                          const std::vector<base::State*> *nearSamples = NULL);
 
             /** \brief High-level method which updates pair point information for repV_ with neighbor r */
             void updatePairPoints(Vertex rep, const base::State *q, Vertex r, const base::State *s);
@@ -523,6 +611,21 @@ namespace ompl
             /** \brief Mutex to guard access to the Graph member (g_) */
             mutable boost::mutex                                                graphMutex_;
 
+            /** \brief Number of threads used by constructRoadmap() */
+            unsigned int                                                        numThreads_;
+
+            /** \brief The valid state samplers used by the threads of the parallel front-end (the first one is sampler_) */
+            std::vector<base::ValidStateSamplerPtr>                             threadSamplers_;
+
+            /** \brief The candidates of the current round of parallel construction */
+            std::vector<Candidate>                                              candidates_;
+
+            /** \brief The motion checks of the current round of parallel construction */
+            std::vector<MotionCheck>                                            motionChecks_;
+
+            /** \brief The results of motionChecks_, looked up while committing candidates */
+            MotionCache                                                         motionCache_;
+
             /** \brief Objective cost function for PRM graph edges */
             base::OptimizationObjectivePtr                                      opt_;
 
@@ -0,0 +1,328 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2015, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "ompl/geometric/planners/prm/CompactRoadmap.h"
+#include "ompl/base/objectives/PathLengthOptimizationObjective.h"
+#include "ompl/tools/config/SelfConfig.h"
+#include "ompl/util/Exception.h"
+#include <boost/foreach.hpp>
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#define foreach BOOST_FOREACH
+
+namespace
+{
+    typedef std::pair<double, unsigned int> QueueElement;
+    typedef std::priority_queue<QueueElement, std::vector<QueueElement>, std::greater<QueueElement> > MinQueue;
+}
+
+ompl::geometric::CompactRoadmap::CompactRoadmap(const base::SpaceInformationPtr &si, const base::OptimizationObjectivePtr &opt,
+                                                const SPARStwo::Graph &graph, double connectionRadius, unsigned int numLandmarks) :
+    si_(si), opt_(opt), connectionRadius_(connectionRadius), numComponents_(0)
+{
+    typedef boost::graph_traits<SPARStwo::Graph>::vertex_descriptor Vertex;
+    typedef boost::graph_traits<SPARStwo::Graph>::edge_descriptor Edge;
+
+    if (!opt_)
+        opt_.reset(new base::PathLengthOptimizationObjective(si_));
+
+    // Number the vertices that hold a state (SPARStwo keeps a vertex without one for its queries)
+    const unsigned int nullIndex = std::numeric_limits<unsigned int>::max();
+    std::vector<unsigned int> index(boost::num_vertices(graph), nullIndex);
+    unsigned int n = 0;
+    foreach (Vertex v, boost::vertices(graph))
+        if (boost::get(SPARStwo::vertex_state_t(), graph, v))
+            index[v] = n++;
+
+    states_.resize(n);
+    std::vector<IndexedState> indexed(n);
+    foreach (Vertex v, boost::vertices(graph))
+        if (index[v] != nullIndex)
+        {
+            states_[index[v]] = si_->cloneState(boost::get(SPARStwo::vertex_state_t(), graph, v));
+            indexed[index[v]] = IndexedState(states_[index[v]], index[v]);
+        }
+    nn_.reset(tools::SelfConfig::getDefaultNearestNeighbors<IndexedState>(si_->getStateSpace()));
+    nn_->setDistanceFunction(boost::bind(&CompactRoadmap::distance, this, _1, _2));
+    nn_->add(indexed);
+
+    // Count the edges of each vertex, then fill them in
+    edgeOffsets_.assign(n + 1, 0);
+    foreach (Edge e, boost::edges(graph))
+    {
+        unsigned int s = index[boost::source(e, graph)], t = index[boost::target(e, graph)];
+        if (s == nullIndex || t == nullIndex)
+            continue;
+        ++edgeOffsets_[s + 1];
+        ++edgeOffsets_[t + 1];
+    }
+    for (unsigned int i = 0 ; i < n ; ++i)
+        edgeOffsets_[i + 1] += edgeOffsets_[i];
+
+    edgeTargets_.resize(edgeOffsets_[n]);
+    edgeWeights_.resize(edgeOffsets_[n]);
+    std::vector<unsigned int> next(edgeOffsets_.begin(), edgeOffsets_.end() - 1);
+    foreach (Edge e, boost::edges(graph))
+    {
+        unsigned int s = index[boost::source(e, graph)], t = index[boost::target(e, graph)];
+        if (s == nullIndex || t == nullIndex)
+            continue;
+        edgeTargets_[next[s]] = t;
+        edgeWeights_[next[s]++] = opt_->motionCost(states_[s], states_[t]).value();
+        edgeTargets_[next[t]] = s;
+        edgeWeights_[next[t]++] = opt_->motionCost(states_[t], states_[s]).value();
+    }
+
+    // Label the connected components
+    components_.assign(n, nullIndex);
+    std::vector<unsigned int> stack;
+    for (unsigned int i = 0 ; i < n ; ++i)
+        if (components_[i] == nullIndex)
+        {
+            components_[i] = numComponents_;
+            stack.push_back(i);
+            while (!stack.empty())
+            {
+                unsigned int v = stack.back();
+                stack.pop_back();
+                for (unsigned int j = edgeOffsets_[v] ; j < edgeOffsets_[v + 1] ; ++j)
+                    if (components_[edgeTargets_[j]] == nullIndex)
+                    {
+                        components_[edgeTargets_[j]] = numComponents_;
+                        stack.push_back(edgeTargets_[j]);
+                    }
+            }
+            ++numComponents_;
+        }
+
+    computeLandmarks(numLandmarks);
+}
+
+ompl::geometric::CompactRoadmap::~CompactRoadmap()
+{
+    si_->freeStates(states_);
+}
+
+void ompl::geometric::CompactRoadmap::getState(std::size_t v, base::State *state) const
+{
+    if (v >= numVertices())
+        throw Exception("CompactRoadmap", "Vertex index out of range");
+    si_->copyState(state, states_[v]);
+}
+
+std::size_t ompl::geometric::CompactRoadmap::getMemoryUsage() const
+{
+    return sizeof(*this) +
+        states_.size() * (sizeof(base::State*) + sizeof(IndexedState) + si_->getStateSpace()->getStateMemoryUsage()) +
+        (edgeOffsets_.capacity() + edgeTargets_.capacity() + components_.capacity() + landmarks_.capacity()) * sizeof(unsigned int) +
+        (edgeWeights_.capacity() + landmarkDistances_.capacity()) * sizeof(double);
+}
+
+void ompl::geometric::CompactRoadmap::shortestDistances(unsigned int source, double *dist) const
+{
+    const std::size_t n = numVertices();
+    std::fill(dist, dist + n, std::numeric_limits<double>::infinity());
+    dist[source] = 0.0;
+    MinQueue queue;
+    queue.push(QueueElement(0.0, source));
+    while (!queue.empty())
+    {
+        QueueElement top = queue.top();
+        queue.pop();
+        if (top.first > dist[top.second])
+            continue;
+        for (unsigned int j = edgeOffsets_[top.second] ; j < edgeOffsets_[top.second + 1] ; ++j)
+        {
+            double d = top.first + edgeWeights_[j];
+            if (d < dist[edgeTargets_[j]])
+            {
+                dist[edgeTargets_[j]] = d;
+                queue.push(QueueElement(d, edgeTargets_[j]));
+            }
+        }
+    }
+}
+
+void ompl::geometric::CompactRoadmap::computeLandmarks(unsigned int numLandmarks)
+{
+    const std::size_t n = numVertices();
+    landmarks_.clear();
+    landmarkDistances_.clear();
+    if (n == 0)
+        return;
+    numLandmarks = std::min<std::size_t>(numLandmarks, n);
+    landmarkDistances_.resize(numLandmarks * n);
+
+    // Farthest-first selection: each new landmark is the vertex farthest from the landmarks chosen so
+    // far. Unreachable vertices count as infinitely far, so every component gets a landmark early on.
+    std::vector<double> closest(n, std::numeric_limits<double>::infinity());
+    unsigned int next = 0;
+    for (unsigned int l = 0 ; l < numLandmarks ; ++l)
+    {
+        landmarks_.push_back(next);
+        double *dist = &landmarkDistances_[l * n];
+        shortestDistances(next, dist);
+        for (std::size_t v = 0 ; v < n ; ++v)
+        {
+            closest[v] = std::min(closest[v], dist[v]);
+            if (closest[v] > closest[next])
+                next = v;
+        }
+    }
+}
+
+double ompl::geometric::CompactRoadmap::landmarkBound(unsigned int u, unsigned int v) const
+{
+    const std::size_t n = numVertices();
+    double bound = 0.0;
+    for (std::size_t l = 0 ; l < landmarks_.size() ; ++l)
+    {
+        const double *dist = &landmarkDistances_[l * n];
+        // landmarks in other components do not bound anything
+        if (dist[u] != std::numeric_limits<double>::infinity() && dist[v] != std::numeric_limits<double>::infinity())
+            bound = std::max(bound, fabs(dist[u] - dist[v]));
+    }
+    return bound;
+}
+
+void ompl::geometric::CompactRoadmap::connect(const base::State *st, bool toState,
+                                              std::vector< std::pair<unsigned int, double> > &links) const
+{
+    links.clear();
+    if (states_.empty())
+        return;
+    std::vector<IndexedState> nbh;
+    nn_->nearestR(IndexedState(st, std::numeric_limits<unsigned int>::max()), connectionRadius_, nbh);
+    for (std::size_t i = 0 ; i < nbh.size() ; ++i)
+    {
+        const base::State *v = nbh[i].first;
+        if (toState ? si_->checkMotion(v, st) : si_->checkMotion(st, v))
+            links.push_back(std::make_pair(nbh[i].second, (toState ? opt_->motionCost(v, st) : opt_->motionCost(st, v)).value()));
+    }
+}
+
+bool ompl::geometric::CompactRoadmap::solve(const base::State *start, const base::State *goal, PathGeometric &path) const
+{
+    const std::size_t n = numVertices();
+
+    std::vector< std::pair<unsigned int, double> > startLinks, goalLinks;
+    connect(start, false, startLinks);
+    connect(goal, true, goalLinks);
+
+    // Only search if the start and goal see a common component
+    bool sameComponent = false;
+    for (std::size_t i = 0 ; i < startLinks.size() && !sameComponent ; ++i)
+        for (std::size_t j = 0 ; j < goalLinks.size() && !sameComponent ; ++j)
+            sameComponent = components_[startLinks[i].first] == components_[goalLinks[j].first];
+    if (!sameComponent)
+        return false;
+
+    // A* from the start to a virtual goal vertex (index n) connected to the vertices that see the goal
+    const double inf = std::numeric_limits<double>::infinity();
+    const unsigned int none = std::numeric_limits<unsigned int>::max();
+    std::vector<double> costToCome(n + 1, inf);
+    std::vector<double> costToGoal(n, inf);
+    std::vector<unsigned int> parent(n + 1, none);
+    for (std::size_t j = 0 ; j < goalLinks.size() ; ++j)
+        costToGoal[goalLinks[j].first] = goalLinks[j].second;
+
+    MinQueue queue;
+    for (std::size_t i = 0 ; i < startLinks.size() ; ++i)
+    {
+        unsigned int v = startLinks[i].first;
+        if (startLinks[i].second < costToCome[v])
+        {
+            costToCome[v] = startLinks[i].second;
+            double h = inf;
+            for (std::size_t j = 0 ; j < goalLinks.size() ; ++j)
+                h = std::min(h, landmarkBound(v, goalLinks[j].first) + goalLinks[j].second);
+            queue.push(QueueElement(costToCome[v] + h, v));
+        }
+    }
+
+    std::vector<char> closed(n + 1, 0);
+    while (!queue.empty())
+    {
+        unsigned int v = queue.top().second;
+        queue.pop();
+        if (v == n)
+            break;
+        if (closed[v])
+            continue;
+        closed[v] = 1;
+
+        if (costToGoal[v] != inf && costToCome[v] + costToGoal[v] < costToCome[n])
+        {
+            costToCome[n] = costToCome[v] + costToGoal[v];
+            parent[n] = v;
+            queue.push(QueueElement(costToCome[n], (unsigned int)n));
+        }
+
+        for (unsigned int j = edgeOffsets_[v] ; j < edgeOffsets_[v + 1] ; ++j)
+        {
+            unsigned int w = edgeTargets_[j];
+            double c = costToCome[v] + edgeWeights_[j];
+            if (!closed[w] && c < costToCome[w])
+            {
+                costToCome[w] = c;
+                parent[w] = v;
+                double h = inf;
+                for (std::size_t k = 0 ; k < goalLinks.size() ; ++k)
+                    h = std::min(h, landmarkBound(w, goalLinks[k].first) + goalLinks[k].second);
+                queue.push(QueueElement(c + h, w));
+            }
+        }
+    }
+
+    bool solved = parent[n] != none;
+    if (solved)
+    {
+        std::vector<unsigned int> vertices;
+        for (unsigned int v = parent[n] ; v != none ; v = parent[v])
+            vertices.push_back(v);
+
+        path = PathGeometric(si_);
+        path.append(start);
+        for (std::size_t i = vertices.size() ; i > 0 ; --i)
+            path.append(states_[vertices[i - 1]]);
+        path.append(goal);
+    }
+
+    return solved;
+}
@@ -64,6 +64,11 @@ namespace ompl
         /** \brief The time in seconds for a single roadmap building operation (dt)*/
         static const double ROADMAP_BUILD_TIME = 0.2;
 
+        /** \brief The number of iterations of a single roadmap
+            building operation in deterministic mode (the counterpart
+            of ROADMAP_BUILD_TIME) */
+        static const unsigned int ROADMAP_BUILD_ITERATIONS = 50;
+
         /** \brief The number of nearest neighbors to consider by
             default in the construction of the PRM roadmap */
         static const unsigned int DEFAULT_NEAREST_NEIGHBORS = 10;
@@ -81,6 +86,7 @@ ompl::geometric::PRM::PRM(const base::SpaceInformationPtr &si, bool starStrategy
                   boost::get(boost::vertex_predecessor, g_)),
     userSetConnectionStrategy_(false),
     addedNewSolution_(false),
+    deterministic_(false),
     iterations_(0),
     bestCost_(std::numeric_limits<double>::quiet_NaN())
 {
@@ -89,6 +95,7 @@ ompl::geometric::PRM::PRM(const base::SpaceInformationPtr &si, bool starStrategy
     specs_.optimizingPaths = true;
 
     Planner::declareParam<unsigned int>("max_nearest_neighbors", this, &PRM::setMaxNearestNeighbors, std::string("8:1000"));
+    Planner::declareParam<bool>("deterministic", this, &PRM::setDeterministic, &PRM::getDeterministic, "0,1");
 
     addPlannerProgressProperty("iterations INTEGER",
                                boost::bind(&PRM::getIterationCount, this));
@@ -98,6 +105,7 @@ ompl::geometric::PRM::PRM(const base::SpaceInformationPtr &si, bool starStrategy
                                boost::bind(&PRM::getMilestoneCountString, this));
     addPlannerProgressProperty("edge count INTEGER",
                                boost::bind(&PRM::getEdgeCountString, this));
+    addMemoryUsageProgressProperties();
 }
 
 ompl::geometric::PRM::~PRM()
@@ -319,25 +327,61 @@ void ompl::geometric::PRM::growRoadmap(const base::PlannerTerminationCondition &
 void ompl::geometric::PRM::checkForSolution(const base::PlannerTerminationCondition &ptc,
                                             base::PathPtr &solution)
 {
-    base::GoalSampleableRegion *goal = static_cast<base::GoalSampleableRegion*>(pdef_->getGoal().get());
     while (!ptc && !addedNewSolution_)
     {
-        // Check for any new goal states
-        if (goal->maxSampleCount() > goalM_.size())
-        {
-            const base::State *st = pis_.nextGoal();
-            if (st)
-                goalM_.push_back(addMilestone(si_->cloneState(st)));
-        }
-
-        // Check for a solution
-        addedNewSolution_ = maybeConstructSolution(startM_, goalM_, solution);
+        addedNewSolution_ = checkForSolutionOnce(solution);
         // Sleep for 1ms
         if (!addedNewSolution_)
             boost::this_thread::sleep(boost::posix_time::milliseconds(1));
     }
 }
 
+bool ompl::geometric::PRM::checkForSolutionOnce(base::PathPtr &solution)
+{
+    base::GoalSampleableRegion *goal = static_cast<base::GoalSampleableRegion*>(pdef_->getGoal().get());
+
+    // Check for any new goal states
+    if (goal->maxSampleCount() > goalM_.size())
+    {
+        const base::State *st = pis_.nextGoal();
+        if (st)
+            goalM_.push_back(addMilestone(si_->cloneState(st)));
+    }
+
+    // Check for a solution
+    return maybeConstructSolution(startM_, goalM_, solution);
+}
+
+void ompl::geometric::PRM::constructRoadmapDeterministic(const base::PlannerTerminationCondition &ptc, base::PathPtr &solution)
+{
+    if (!sampler_)
+        sampler_ = si_->allocValidStateSampler();
+    if (!simpleSampler_)
+        simpleSampler_ = si_->allocStateSampler();
+
+    std::vector<base::State*> xstates(magic::MAX_RANDOM_BOUNCE_STEPS);
+    si_->allocStates(xstates);
+    bool grow = true;
+
+    bestCost_ = opt_->infiniteCost();
+    while (ptc == false && !addedNewSolution_)
+    {
+        // the same 2:1 ratio for growing/expansion of roadmap as constructRoadmap(), counted in iterations
+        const unsigned long int limit = iterations_ + (grow ? 2 : 1) * magic::ROADMAP_BUILD_ITERATIONS;
+        const base::PlannerTerminationCondition slice = base::plannerOrTerminationCondition(ptc,
+            base::PlannerTerminationCondition(boost::bind(&PRM::iterationLimitReached, this, limit)));
+        if (grow)
+            growRoadmap(slice, xstates[0]);
+        else
+            expandRoadmap(slice, xstates);
+        grow = !grow;
+
+        addedNewSolution_ = checkForSolutionOnce(solution);
+    }
+
+    si_->freeStates(xstates);
+}
+
 bool ompl::geometric::PRM::maybeConstructSolution(const std::vector<Vertex> &starts, const std::vector<Vertex> &goals, base::PathPtr &solution)
 {
     base::Goal *g = pdef_->getGoal().get();
@@ -427,19 +471,26 @@ ompl::base::PlannerStatus ompl::geometric::PRM::solve(const base::PlannerTermina
     unsigned long int nrStartStates = boost::num_vertices(g_);
     OMPL_INFORM("%s: Starting planning with %lu states already in datastructure", getName().c_str(), nrStartStates);
 
-    // Reset addedNewSolution_ member and create solution checking thread
+    // Reset addedNewSolution_ member
     addedNewSolution_ = false;
     base::PathPtr sol;
-    boost::thread slnThread(boost::bind(&PRM::checkForSolution, this, ptc, boost::ref(sol)));
 
-    // construct new planner termination condition that fires when the given ptc is true, or a solution is found
-    base::PlannerTerminationCondition ptcOrSolutionFound =
-        base::plannerOrTerminationCondition(ptc, base::PlannerTerminationCondition(boost::bind(&PRM::addedNewSolution, this)));
+    if (deterministic_)
+        constructRoadmapDeterministic(ptc, sol);
+    else
+    {
+        // create solution checking thread
+        boost::thread slnThread(boost::bind(&PRM::checkForSolution, this, ptc, boost::ref(sol)));
 
-    constructRoadmap(ptcOrSolutionFound);
+        // construct new planner termination condition that fires when the given ptc is true, or a solution is found
+        base::PlannerTerminationCondition ptcOrSolutionFound =
+            base::plannerOrTerminationCondition(ptc, base::PlannerTerminationCondition(boost::bind(&PRM::addedNewSolution, this)));
 
-    // Ensure slnThread is ceased before exiting solve
-    slnThread.join();
+        constructRoadmap(ptcOrSolutionFound);
+
+        // Ensure slnThread is ceased before exiting solve
+        slnThread.join();
+    }
 
     OMPL_INFORM("%s: Created %u states", getName().c_str(), boost::num_vertices(g_) - nrStartStates);
 
@@ -593,6 +644,22 @@ void ompl::geometric::PRM::getPlannerData(base::PlannerData &data) const
     }
 }
 
+std::size_t ompl::geometric::PRM::getMemoryUsage() const
+{
+    // a vertex stores its properties, its state and the list of its incident edges;
+    // an edge is a list node with its end points and weight, plus an entry in the
+    // lists of both its end points
+    const std::size_t vertexBytes = sizeof(std::vector<void*>) + sizeof(base::State*) + 4 * sizeof(unsigned long int) +
+        si_->getStateSpace()->getStateMemoryUsage();
+    const std::size_t edgeBytes = 4 * sizeof(void*) + sizeof(base::Cost) + 2 * (sizeof(Vertex) + sizeof(void*));
+
+    std::size_t bytes = milestoneCount() * vertexBytes + edgeCount() * edgeBytes +
+        (startM_.capacity() + goalM_.capacity()) * sizeof(Vertex);
+    if (nn_)
+        bytes += nn_->getMemoryUsage();
+    return bytes;
+}
+
 ompl::base::Cost ompl::geometric::PRM::costHeuristic(Vertex u, Vertex v) const
 {
     return opt_->motionCostHeuristic(stateProperty_[u], stateProperty_[v]);
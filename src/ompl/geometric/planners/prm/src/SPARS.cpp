@@ -71,6 +71,7 @@ ompl::geometric::SPARS::SPARS(const base::SpaceInformationPtr &si) :
     sparseDeltaFraction_(.25),
     denseDelta_(0.),
     sparseDelta_(0.),
+    numThreads_(1),
     iterations_(0),
     bestCost_(std::numeric_limits<double>::quiet_NaN())
 {
@@ -86,6 +87,7 @@ ompl::geometric::SPARS::SPARS(const base::SpaceInformationPtr &si) :
     Planner::declareParam<double>("sparse_delta_fraction", this, &SPARS::setSparseDeltaFraction, &SPARS::getSparseDeltaFraction, "0.0:0.01:1.0");
     Planner::declareParam<double>("dense_delta_fraction", this, &SPARS::setDenseDeltaFraction, &SPARS::getDenseDeltaFraction, "0.0:0.0001:0.1");
     Planner::declareParam<unsigned int>("max_failures", this, &SPARS::setMaxFailures, &SPARS::getMaxFailures, "100:10:3000");
+    Planner::declareParam<unsigned int>("num_threads", this, &SPARS::setNumThreads, &SPARS::getNumThreads, "1:1:64");
 
     addPlannerProgressProperty("iterations INTEGER",
                                boost::bind(&SPARS::getIterationCount, this));
@@ -136,6 +138,13 @@ void ompl::geometric::SPARS::setup()
     }
 }
 
+void ompl::geometric::SPARS::setNumThreads(unsigned int numThreads)
+{
+    if (numThreads == 0)
+        throw Exception(name_, "The number of threads must be at least 1");
+    numThreads_ = numThreads;
+}
+
 void ompl::geometric::SPARS::setProblemDefinition(const base::ProblemDefinitionPtr &pdef)
 {
     Planner::setProblemDefinition(pdef);
@@ -159,6 +168,7 @@ void ompl::geometric::SPARS::clear()
     Planner::clear();
     sampler_.reset();
     simpleSampler_.reset();
+    threadSamplers_.clear();
     freeMemory();
     if (nn_)
         nn_->clear();
@@ -398,6 +408,13 @@ void ompl::geometric::SPARS::constructRoadmap(const base::PlannerTerminationCond
     if (!simpleSampler_)
         simpleSampler_ = si_->allocStateSampler();
 
+    bestCost_ = opt_->infiniteCost();
+    if (numThreads_ > 1)
+    {
+        constructRoadmapParallel(ptc);
+        return;
+    }
+
     base::State *workState = si_->allocState();
 
     /* The whole neighborhood set which has been most recently computed */
@@ -409,7 +426,6 @@ void ompl::geometric::SPARS::constructRoadmap(const base::PlannerTerminationCond
     /* Storage for the interface neighborhood, populated by getInterfaceNeighborhood() */
     std::vector<DenseVertex> interfaceNeighborhood;
 
-    bestCost_ = opt_->infiniteCost();
     while (ptc == false)
     {
         iterations_++;
@@ -419,33 +435,149 @@ void ompl::geometric::SPARS::constructRoadmap(const base::PlannerTerminationCond
         if (q == boost::graph_traits<DenseGraph>::null_vertex())
             continue;
 
-        //Now that we've added to D, try adding to S
-        //Start by figuring out who our neighbors are
-        getSparseNeighbors(workState, graphNeighborhood);
-        filterVisibleNeighbors(workState, graphNeighborhood, visibleNeighborhood);
-        //Check for addition for Coverage
-        if( !checkAddCoverage(workState, graphNeighborhood))
-            //If not for Coverage, then Connectivity
-            if( !checkAddConnectivity(workState, graphNeighborhood))
-                //Check for the existence of an interface
-                if( !checkAddInterface(graphNeighborhood, visibleNeighborhood, q))
+        checkAddSample(q, graphNeighborhood, visibleNeighborhood, interfaceNeighborhood);
+    }
+
+    si_->freeState(workState);
+}
+
+void ompl::geometric::SPARS::checkAddSample(DenseVertex q, std::vector<SparseVertex> &graphNeighborhood, std::vector<SparseVertex> &visibleNeighborhood,
+                                            std::vector<DenseVertex> &interfaceNeighborhood)
+{
+    base::State *qState = stateProperty_[q];
+
+    //Now that we've added to D, try adding to S
+    //Start by figuring out who our neighbors are
+    getSparseNeighbors(qState, graphNeighborhood);
+    filterVisibleNeighbors(qState, graphNeighborhood, visibleNeighborhood);
+    //Check for addition for Coverage
+    if( !checkAddCoverage(qState, graphNeighborhood))
+        //If not for Coverage, then Connectivity
+        if( !checkAddConnectivity(qState, graphNeighborhood))
+            //Check for the existence of an interface
+            if( !checkAddInterface(graphNeighborhood, visibleNeighborhood, q))
+            {
+                // Then check to see if it's on an interface
+                getInterfaceNeighborhood(q, interfaceNeighborhood);
+                if (interfaceNeighborhood.size() > 0)
                 {
-                    // Then check to see if it's on an interface
-                    getInterfaceNeighborhood(q, interfaceNeighborhood);
-                    if (interfaceNeighborhood.size() > 0)
-                    {
-                        //Check for addition for spanner prop
-                        if (!checkAddPath(q, interfaceNeighborhood))
-                            //All of the tests have failed.  Report failure for the sample
-                            ++consecutiveFailures_;
-                    }
-                    else
-                        //There's no interface here, so drop it
+                    //Check for addition for spanner prop
+                    if (!checkAddPath(q, interfaceNeighborhood))
+                        //All of the tests have failed.  Report failure for the sample
                         ++consecutiveFailures_;
                 }
+                else
+                    //There's no interface here, so drop it
+                    ++consecutiveFailures_;
+            }
+}
+
+void ompl::geometric::SPARS::constructRoadmapParallel(const base::PlannerTerminationCondition &ptc)
+{
+    // The first thread shares sampler_ with the serial code path
+    if (threadSamplers_.empty())
+        threadSamplers_.push_back(sampler_);
+    while (threadSamplers_.size() < numThreads_)
+        threadSamplers_.push_back(si_->allocValidStateSampler());
+
+    candidates_.resize(numThreads_ * magic::SPARSE_ROADMAP_CANDIDATES_PER_THREAD);
+    candidateValid_.resize(candidates_.size());
+    for (std::size_t i = 0 ; i < candidates_.size() ; ++i)
+        candidates_[i] = si_->allocState();
+
+    std::vector<SparseVertex> graphNeighborhood;
+    std::vector<SparseVertex> visibleNeighborhood;
+    std::vector<DenseVertex> interfaceNeighborhood;
+
+    while (ptc == false)
+    {
+        // Sample all the candidates of this round concurrently
+        boost::thread_group threads;
+        for (unsigned int i = 1 ; i < numThreads_ ; ++i)
+            threads.create_thread(boost::bind(&SPARS::sampleCandidates, this, i, boost::cref(ptc)));
+        sampleCandidates(0, ptc);
+        threads.join_all();
+
+        // Collect the motions to the dense and sparse neighborhoods of the candidates, as the graphs are now
+        motionChecks_.clear();
+        for (std::size_t i = 0 ; i < candidates_.size() ; ++i)
+            if (candidateValid_[i])
+            {
+                stateProperty_[queryVertex_] = candidates_[i];
+                const std::vector<DenseVertex> &neighbors = connectionStrategy_(queryVertex_);
+                foreach (DenseVertex n, neighbors)
+                    motionChecks_.push_back(MotionCheck(candidates_[i], stateProperty_[n]));
+
+                getSparseNeighbors(candidates_[i], graphNeighborhood);
+                foreach (SparseVertex n, graphNeighborhood)
+                    motionChecks_.push_back(MotionCheck(candidates_[i], sparseStateProperty_[n]));
+            }
+        stateProperty_[queryVertex_] = NULL;
+
+        // Check these motions concurrently
+        for (unsigned int i = 1 ; i < numThreads_ ; ++i)
+            threads.create_thread(boost::bind(&SPARS::evaluateMotionChecks, this, i));
+        evaluateMotionChecks(0);
+        threads.join_all();
+
+        foreach (const MotionCheck &mc, motionChecks_)
+            motionCache_[std::make_pair(mc.s1, mc.s2)] = mc.valid;
+
+        // Add the candidates to the graphs one at a time, in order. Checks involving vertices
+        // added earlier in this round are not in the cache and are computed here.
+        for (std::size_t i = 0 ; i < candidates_.size() && ptc == false ; ++i)
+        {
+            iterations_++;
+            if (!candidateValid_[i])
+                continue;
+
+            // the dense graph takes ownership of the state
+            DenseVertex q = addMilestone(candidates_[i]);
+            candidates_[i] = si_->allocState();
+            checkAddSample(q, graphNeighborhood, visibleNeighborhood, interfaceNeighborhood);
+        }
+        motionCache_.clear();
     }
 
-    si_->freeState(workState);
+    for (std::size_t i = 0 ; i < candidates_.size() ; ++i)
+        si_->freeState(candidates_[i]);
+    candidates_.clear();
+    candidateValid_.clear();
+    motionChecks_.clear();
+}
+
+void ompl::geometric::SPARS::sampleCandidates(unsigned int tid, const base::PlannerTerminationCondition &ptc)
+{
+    const std::size_t first = tid * magic::SPARSE_ROADMAP_CANDIDATES_PER_THREAD;
+    for (std::size_t i = first ; i < first + magic::SPARSE_ROADMAP_CANDIDATES_PER_THREAD ; ++i)
+    {
+        // search for a valid state, as addSample() does
+        bool found = false;
+        while (!found && ptc == false)
+        {
+            unsigned int attempts = 0;
+            do
+            {
+                found = threadSamplers_[tid]->sample(candidates_[i]);
+                attempts++;
+            } while (attempts < magic::FIND_VALID_STATE_ATTEMPTS_WITHOUT_TERMINATION_CHECK && !found);
+        }
+        candidateValid_[i] = found;
+    }
+}
+
+void ompl::geometric::SPARS::evaluateMotionChecks(unsigned int tid)
+{
+    for (std::size_t i = tid ; i < motionChecks_.size() ; i += numThreads_)
+        motionChecks_[i].valid = si_->checkMotion(motionChecks_[i].s1, motionChecks_[i].s2);
+}
+
+bool ompl::geometric::SPARS::checkMotion(const base::State *s1, const base::State *s2) const
+{
+    MotionCache::const_iterator it = motionCache_.find(std::make_pair(s1, s2));
+    if (it != motionCache_.end())
+        return it->second;
+    return si_->checkMotion(s1, s2);
 }
 
 ompl::geometric::SPARS::DenseVertex ompl::geometric::SPARS::addMilestone(base::State *state)
@@ -459,7 +591,7 @@ ompl::geometric::SPARS::DenseVertex ompl::geometric::SPARS::addMilestone(base::S
     const std::vector<DenseVertex>& neighbors = connectionStrategy_(m);
 
     foreach (DenseVertex n, neighbors)
-        if (si_->checkMotion(stateProperty_[m], stateProperty_[n]))
+        if (checkMotion(stateProperty_[m], stateProperty_[n]))
         {
             const double weight = distanceFunction(m, n);
             const DenseGraph::edge_property_type properties(weight);
@@ -527,7 +659,7 @@ bool ompl::geometric::SPARS::checkAddCoverage(const base::State *lastState, cons
     //For each of these neighbors,
     foreach (SparseVertex n, neigh)
         //If path between is free
-        if (si_->checkMotion( lastState, sparseStateProperty_[n]))
+        if (checkMotion( lastState, sparseStateProperty_[n]))
             //Abort out and return false
             return false;
     //No free paths means we add for coverage
@@ -545,7 +677,7 @@ bool ompl::geometric::SPARS::checkAddConnectivity( const base::State *lastState,
             //If they are in different components
             if (!sameComponent(neigh[i], neigh[j]))
                 //If the paths between are collision free
-                if( si_->checkMotion( lastState, sparseStateProperty_[neigh[i]] ) && si_->checkMotion( lastState, sparseStateProperty_[neigh[j]] ) )
+                if( checkMotion( lastState, sparseStateProperty_[neigh[i]] ) && checkMotion( lastState, sparseStateProperty_[neigh[j]] ) )
                 {
                     links.push_back( neigh[i] );
                     links.push_back( neigh[j] );
@@ -748,7 +880,7 @@ void ompl::geometric::SPARS::filterVisibleNeighbors(base::State *inState, const
     visibleNeighborhood.clear();
     //Now that we got the neighbors from the NN, we must remove any we can't see
     for (std::size_t i = 0; i < graphNeighborhood.size(); ++i)
-        if (si_->checkMotion(inState, sparseStateProperty_[graphNeighborhood[i]]))
+        if (checkMotion(inState, sparseStateProperty_[graphNeighborhood[i]]))
             visibleNeighborhood.push_back(graphNeighborhood[i]);
 }
 
@@ -845,7 +977,7 @@ void ompl::geometric::SPARS::calculateRepresentative(DenseVertex q)
 
     //For each neighbor
     for (std::size_t i = 0; i < graphNeighborhood.size(); ++i)
-        if (si_->checkMotion(stateProperty_[q], sparseStateProperty_[graphNeighborhood[i]]))
+        if (checkMotion(stateProperty_[q], sparseStateProperty_[graphNeighborhood[i]]))
         {
             //update the representative
             representativesProperty_[q] = graphNeighborhood[i];
@@ -35,10 +35,12 @@
 /* Author: Andrew Dobson */
 
 #include "ompl/geometric/planners/prm/SPARStwo.h"
+#include "ompl/geometric/planners/prm/CompactRoadmap.h"
 #include "ompl/geometric/planners/prm/ConnectionStrategy.h"
 #include "ompl/base/goals/GoalSampleableRegion.h"
 #include "ompl/base/objectives/PathLengthOptimizationObjective.h"
 #include "ompl/tools/config/SelfConfig.h"
+#include "ompl/tools/config/MagicConstants.h"
 #include <boost/lambda/bind.hpp>
 #include <boost/graph/astar_search.hpp>
 #include <boost/graph/incremental_components.hpp>
@@ -67,6 +69,7 @@ ompl::geometric::SPARStwo::SPARStwo(const base::SpaceInformationPtr &si) :
     consecutiveFailures_(0),
     sparseDelta_(0.),
     denseDelta_(0.),
+    numThreads_(1),
     iterations_(0),
     bestCost_(std::numeric_limits<double>::quiet_NaN())
 {
@@ -81,6 +84,7 @@ ompl::geometric::SPARStwo::SPARStwo(const base::SpaceInformationPtr &si) :
     Planner::declareParam<double>("sparse_delta_fraction", this, &SPARStwo::setSparseDeltaFraction, &SPARStwo::getSparseDeltaFraction, "0.0:0.01:1.0");
     Planner::declareParam<double>("dense_delta_fraction", this, &SPARStwo::setDenseDeltaFraction, &SPARStwo::getDenseDeltaFraction, "0.0:0.0001:0.1");
     Planner::declareParam<unsigned int>("max_failures", this, &SPARStwo::setMaxFailures, &SPARStwo::getMaxFailures, "100:10:3000");
+    Planner::declareParam<unsigned int>("num_threads", this, &SPARStwo::setNumThreads, &SPARStwo::getNumThreads, "1:1:64");
 
     addPlannerProgressProperty("iterations INTEGER",
                                boost::bind(&SPARStwo::getIterationCount, this));
@@ -126,6 +130,13 @@ void ompl::geometric::SPARStwo::setup()
     }
 }
 
+void ompl::geometric::SPARStwo::setNumThreads(unsigned int numThreads)
+{
+    if (numThreads == 0)
+        throw Exception(name_, "The number of threads must be at least 1");
+    numThreads_ = numThreads;
+}
+
 void ompl::geometric::SPARStwo::setProblemDefinition(const base::ProblemDefinitionPtr &pdef)
 {
     Planner::setProblemDefinition(pdef);
@@ -156,6 +167,7 @@ void ompl::geometric::SPARStwo::freeMemory()
     Planner::clear();
     sampler_.reset();
     simpleSampler_.reset();
+    threadSamplers_.clear();
 
     foreach (Vertex v, boost::vertices(g_))
     {
@@ -247,6 +259,13 @@ void ompl::geometric::SPARStwo::constructRoadmap(const base::PlannerTerminationC
     if (!simpleSampler_)
         simpleSampler_ = si_->allocStateSampler();
 
+    bestCost_ = opt_->infiniteCost();
+    if (numThreads_ > 1)
+    {
+        constructRoadmapParallel(ptc);
+        return;
+    }
+
     base::State *qNew = si_->allocState();
     base::State *workState = si_->allocState();
 
@@ -255,7 +274,6 @@ void ompl::geometric::SPARStwo::constructRoadmap(const base::PlannerTerminationC
     /* The visible neighborhood set which has been most recently computed */
     std::vector<Vertex> visibleNeighborhood;
 
-    bestCost_ = opt_->infiniteCost();
     while (ptc == false)
     {
         ++iterations_;
@@ -266,31 +284,193 @@ void ompl::geometric::SPARStwo::constructRoadmap(const base::PlannerTerminationC
             continue;
 
         findGraphNeighbors(qNew, graphNeighborhood, visibleNeighborhood);
+        checkAddSample(qNew, workState, graphNeighborhood, visibleNeighborhood, ptc);
+    }
+    si_->freeState(workState);
+    si_->freeState(qNew);
+}
+
+void ompl::geometric::SPARStwo::constructRoadmapParallel(const base::PlannerTerminationCondition &ptc)
+{
+    // The first thread shares sampler_ with the serial code path
+    if (threadSamplers_.empty())
+        threadSamplers_.push_back(sampler_);
+    while (threadSamplers_.size() < numThreads_)
+        threadSamplers_.push_back(si_->allocValidStateSampler());
+
+    candidates_.resize(numThreads_ * magic::SPARSE_ROADMAP_CANDIDATES_PER_THREAD);
+    for (std::size_t i = 0 ; i < candidates_.size() ; ++i)
+        candidates_[i].state = si_->allocState();
+
+    base::State *workState = si_->allocState();
+    std::vector<Vertex> graphNeighborhood;
+    std::vector<Vertex> visibleNeighborhood;
+
+    while (ptc == false)
+    {
+        // Sample all the candidates of this round concurrently
+        runThreads(boost::bind(&SPARStwo::sampleCandidates, this, _1, boost::cref(ptc)));
+
+        // Collect the motion checks to the graph neighborhoods, as the graph is now
+        motionChecks_.clear();
+        for (std::size_t i = 0 ; i < candidates_.size() ; ++i)
+        {
+            Candidate &c = candidates_[i];
+            c.firstCheck = motionChecks_.size();
+            if (c.valid)
+            {
+                stateProperty_[queryVertex_] = c.state;
+                nn_->nearestR(queryVertex_, sparseDelta_, graphNeighborhood);
+                foreach (Vertex v, graphNeighborhood)
+                    motionChecks_.push_back(MotionCheck(c.state, stateProperty_[v]));
+            }
+            c.lastCheck = motionChecks_.size();
+        }
+        stateProperty_[queryVertex_] = NULL;
+
+        // Check these motions concurrently, and sample around the candidates that see the graph
+        runThreads(boost::bind(&SPARStwo::checkCandidates, this, _1, boost::cref(ptc)));
+
+        // Collect the motion checks from the near samples to their graph neighborhoods
+        std::size_t firstNearCheck = motionChecks_.size();
+        for (std::size_t i = 0 ; i < candidates_.size() ; ++i)
+            foreach (base::State *st, candidates_[i].nearSamples)
+            {
+                stateProperty_[queryVertex_] = st;
+                nn_->nearestR(queryVertex_, sparseDelta_, graphNeighborhood);
+                foreach (Vertex v, graphNeighborhood)
+                    motionChecks_.push_back(MotionCheck(st, stateProperty_[v]));
+            }
+        stateProperty_[queryVertex_] = NULL;
+        runThreads(boost::bind(&SPARStwo::evaluateMotionChecks, this, _1, firstNearCheck));
+
+        foreach (const MotionCheck &mc, motionChecks_)
+            motionCache_[std::make_pair(mc.s1, mc.s2)] = mc.valid;
+
+        // Add the candidates to the roadmap one at a time, in order. Checks involving vertices
+        // added earlier in this round are not in the cache and are computed here.
+        for (std::size_t i = 0 ; i < candidates_.size() && ptc == false ; ++i)
+        {
+            Candidate &c = candidates_[i];
+            ++iterations_;
+            ++consecutiveFailures_;
+            if (!c.valid)
+                continue;
+
+            findGraphNeighbors(c.state, graphNeighborhood, visibleNeighborhood);
+            checkAddSample(c.state, workState, graphNeighborhood, visibleNeighborhood, ptc, c.nearSampled ? &c.nearSamples : NULL);
+        }
+
+        motionCache_.clear();
+        for (std::size_t i = 0 ; i < candidates_.size() ; ++i)
+        {
+            foreach (base::State *st, candidates_[i].nearSamples)
+                si_->freeState(st);
+            candidates_[i].nearSamples.clear();
+        }
+    }
+
+    for (std::size_t i = 0 ; i < candidates_.size() ; ++i)
+        si_->freeState(candidates_[i].state);
+    candidates_.clear();
+    motionChecks_.clear();
+    si_->freeState(workState);
+}
+
+void ompl::geometric::SPARStwo::sampleCandidates(unsigned int tid, const base::PlannerTerminationCondition &ptc)
+{
+    const std::size_t first = tid * magic::SPARSE_ROADMAP_CANDIDATES_PER_THREAD;
+    for (std::size_t i = first ; i < first + magic::SPARSE_ROADMAP_CANDIDATES_PER_THREAD ; ++i)
+    {
+        Candidate &c = candidates_[i];
+        c.valid = ptc == false && threadSamplers_[tid]->sample(c.state);
+        c.nearSampled = false;
+    }
+}
+
+void ompl::geometric::SPARStwo::checkCandidates(unsigned int tid, const base::PlannerTerminationCondition &ptc)
+{
+    const std::size_t first = tid * magic::SPARSE_ROADMAP_CANDIDATES_PER_THREAD;
+    for (std::size_t i = first ; i < first + magic::SPARSE_ROADMAP_CANDIDATES_PER_THREAD ; ++i)
+    {
+        Candidate &c = candidates_[i];
+        bool seesGraph = false;
+        for (std::size_t j = c.firstCheck ; j < c.lastCheck ; ++j)
+        {
+            MotionCheck &mc = motionChecks_[j];
+            mc.valid = si_->checkMotion(mc.s1, mc.s2);
+            seesGraph = seesGraph || mc.valid;
+        }
+
+        // Only candidates that see the graph can be used to detect interfaces; the samples
+        // drawn around them do not depend on the graph, so they can be computed here
+        if (!seesGraph)
+            continue;
+        c.nearSampled = true;
+        for (unsigned int k = 0 ; k < nearSamplePoints_ && ptc == false ; ++k)
+        {
+            base::State *st = si_->allocState();
+            do
+            {
+                threadSamplers_[tid]->sampleNear(st, c.state, denseDelta_);
+            } while ((!si_->isValid(st) || si_->distance(c.state, st) > denseDelta_ || !si_->checkMotion(c.state, st)) && ptc == false);
+
+            if (ptc == true)
+                si_->freeState(st);
+            else
+                c.nearSamples.push_back(st);
+        }
+    }
+}
+
+void ompl::geometric::SPARStwo::evaluateMotionChecks(unsigned int tid, std::size_t first)
+{
+    for (std::size_t i = first + tid ; i < motionChecks_.size() ; i += numThreads_)
+        motionChecks_[i].valid = si_->checkMotion(motionChecks_[i].s1, motionChecks_[i].s2);
+}
+
+void ompl::geometric::SPARStwo::runThreads(const boost::function<void(unsigned int)> &work) const
+{
+    boost::thread_group threads;
+    for (unsigned int i = 1 ; i < numThreads_ ; ++i)
+        threads.create_thread(boost::bind(work, i));
+    work(0);
+    threads.join_all();
+}
 
-        if (!checkAddCoverage(qNew, visibleNeighborhood))
-            if (!checkAddConnectivity(qNew, visibleNeighborhood))
-                if (!checkAddInterface(qNew, graphNeighborhood, visibleNeighborhood))
+bool ompl::geometric::SPARStwo::checkMotion(const base::State *s1, const base::State *s2) const
+{
+    MotionCache::const_iterator it = motionCache_.find(std::make_pair(s1, s2));
+    if (it != motionCache_.end())
+        return it->second;
+    return si_->checkMotion(s1, s2);
+}
+
+void ompl::geometric::SPARStwo::checkAddSample(base::State *qNew, base::State *workState, std::vector<Vertex> &graphNeighborhood,
+                                               std::vector<Vertex> &visibleNeighborhood, const base::PlannerTerminationCondition &ptc,
+                                               const std::vector<base::State*> *nearSamples)
+{
+    if (!checkAddCoverage(qNew, visibleNeighborhood))
+        if (!checkAddConnectivity(qNew, visibleNeighborhood))
+            if (!checkAddInterface(qNew, graphNeighborhood, visibleNeighborhood))
+            {
+                if (visibleNeighborhood.size() > 0)
                 {
-                    if (visibleNeighborhood.size() > 0)
+                    std::map<Vertex, base::State*> closeRepresentatives;
+                    findCloseRepresentatives(workState, qNew, visibleNeighborhood[0], closeRepresentatives, ptc, nearSamples);
+                    for (std::map<Vertex, base::State*>::iterator it = closeRepresentatives.begin(); it != closeRepresentatives.end(); ++it)
                     {
-                        std::map<Vertex, base::State*> closeRepresentatives;
-                        findCloseRepresentatives(workState, qNew, visibleNeighborhood[0], closeRepresentatives, ptc);
-                        for (std::map<Vertex, base::State*>::iterator it = closeRepresentatives.begin(); it != closeRepresentatives.end(); ++it)
-                        {
-                            updatePairPoints(visibleNeighborhood[0], qNew, it->first, it->second);
-                            updatePairPoints(it->first, it->second, visibleNeighborhood[0], qNew);
-                        }
-                        checkAddPath(visibleNeighborhood[0]);
-                        for (std::map<Vertex, base::State*>::iterator it = closeRepresentatives.begin(); it != closeRepresentatives.end(); ++it)
-                        {
-                            checkAddPath(it->first);
-                            si_->freeState(it->second);
-                        }
+                        updatePairPoints(visibleNeighborhood[0], qNew, it->first, it->second);
+                        updatePairPoints(it->first, it->second, visibleNeighborhood[0], qNew);
+                    }
+                    checkAddPath(visibleNeighborhood[0]);
+                    for (std::map<Vertex, base::State*>::iterator it = closeRepresentatives.begin(); it != closeRepresentatives.end(); ++it)
+                    {
+                        checkAddPath(it->first);
+                        si_->freeState(it->second);
                     }
                 }
-    }
-    si_->freeState(workState);
-    si_->freeState(qNew);
+            }
 }
 
 void ompl::geometric::SPARStwo::checkQueryStateInitialization()
@@ -566,7 +746,7 @@ void ompl::geometric::SPARStwo::findGraphNeighbors(base::State *st, std::vector<
 
     //Now that we got the neighbors from the NN, we must remove any we can't see
     for (std::size_t i = 0; i < graphNeighborhood.size() ; ++i )
-        if (si_->checkMotion(st, stateProperty_[graphNeighborhood[i]]))
+        if (checkMotion(st, stateProperty_[graphNeighborhood[i]]))
             visibleNeighborhood.push_back(graphNeighborhood[i]);
 }
 
@@ -594,7 +774,7 @@ ompl::geometric::SPARStwo::Vertex ompl::geometric::SPARStwo::findGraphRepresenta
     Vertex result = boost::graph_traits<Graph>::null_vertex();
 
     for (std::size_t i = 0 ; i< nbh.size() ; ++i)
-        if (si_->checkMotion(st, stateProperty_[nbh[i]]))
+        if (checkMotion(st, stateProperty_[nbh[i]]))
         {
             result = nbh[i];
             break;
@@ -604,7 +784,8 @@ ompl::geometric::SPARStwo::Vertex ompl::geometric::SPARStwo::findGraphRepresenta
 
 void ompl::geometric::SPARStwo::findCloseRepresentatives(base::State *workArea, const base::State *qNew, const Vertex qRep,
                                                          std::map<Vertex, base::State*> &closeRepresentatives,
-                                                         const base::PlannerTerminationCondition &ptc)
+                                                         const base::PlannerTerminationCondition &ptc,
+                                                         const std::vector<base::State*> *nearSamples)
 {
     for (std::map<Vertex, base::State*>::iterator it = closeRepresentatives.begin(); it != closeRepresentatives.end(); ++it)
         si_->freeState(it->second);
@@ -613,17 +794,28 @@ void ompl::geometric::SPARStwo::findCloseRepresentatives(base::State *workArea,
     // Then, begin searching the space around him
     for (unsigned int i = 0 ; i < nearSamplePoints_ ; ++i)
     {
-        do
+        base::State *sample = workArea;
+        if (nearSamples)
+        {
+            // the samples were drawn ahead of time; fewer than requested means we ran out of time
+            if (i >= nearSamples->size())
+                break;
+            sample = (*nearSamples)[i];
+        }
+        else
         {
-            sampler_->sampleNear(workArea, qNew, denseDelta_);
-        } while ((!si_->isValid(workArea) || si_->distance(qNew, workArea) > denseDelta_ || !si_->checkMotion(qNew, workArea)) && ptc == false);
+            do
+            {
+                sampler_->sampleNear(workArea, qNew, denseDelta_);
+            } while ((!si_->isValid(workArea) || si_->distance(qNew, workArea) > denseDelta_ || !si_->checkMotion(qNew, workArea)) && ptc == false);
 
-        // if we were not successful at sampling a desirable state, we are out of time
-        if (ptc == true)
-            break;
+            // if we were not successful at sampling a desirable state, we are out of time
+            if (ptc == true)
+                break;
+        }
 
         // Compute who his graph neighbors are
-        Vertex representative = findGraphRepresentative(workArea);
+        Vertex representative = findGraphRepresentative(sample);
 
         // Assuming this sample is actually seen by somebody (which he should be in all likelihood)
         if (representative != boost::graph_traits<Graph>::null_vertex())
@@ -633,12 +825,12 @@ void ompl::geometric::SPARStwo::findCloseRepresentatives(base::State *workArea,
                 //And we haven't already tracked this representative
                 if (closeRepresentatives.find(representative) == closeRepresentatives.end())
                     //Track the representative
-                    closeRepresentatives[representative] = si_->cloneState(workArea);
+                    closeRepresentatives[representative] = si_->cloneState(sample);
         }
         else
         {
             //This guy can't be seen by anybody, so we should take this opportunity to add him
-            addGuard(si_->cloneState(workArea), COVERAGE);
+            addGuard(si_->cloneState(sample), COVERAGE);
 
             //We should also stop our efforts to add a dense path
             for (std::map<Vertex, base::State*>::iterator it = closeRepresentatives.begin(); it != closeRepresentatives.end(); ++it)
@@ -878,6 +1070,12 @@ void ompl::geometric::SPARStwo::getPlannerData(base::PlannerData &data) const
             data.addVertex(base::PlannerDataVertex(stateProperty_[n], (int)colorProperty_[n]));
 }
 
+ompl::geometric::CompactRoadmapPtr ompl::geometric::SPARStwo::getCompactRoadmap(unsigned int numLandmarks) const
+{
+    boost::mutex::scoped_lock _(graphMutex_);
+    return CompactRoadmapPtr(new CompactRoadmap(si_, opt_, g_, sparseDeltaFraction_ * si_->getMaximumExtent(), numLandmarks));
+}
+
 ompl::base::Cost ompl::geometric::SPARStwo::costHeuristic(Vertex u, Vertex v) const
 {
     return opt_->motionCostHeuristic(stateProperty_[u], stateProperty_[v]);
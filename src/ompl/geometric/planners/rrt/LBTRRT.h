@@ -40,8 +40,10 @@
 #include "ompl/geometric/planners/PlannerIncludes.h"
 #include "ompl/base/OptimizationObjective.h"
 #include "ompl/datastructures/NearestNeighbors.h"
+#include "ompl/datastructures/BinaryHeap.h"
 
 #include <fstream>
+#include <utility>
 
 namespace ompl
 {
@@ -153,20 +155,45 @@ namespace ompl
             /** \brief kRRG = 2e~5.5 is a valid choice for all problem instances */
             static const double kRRG; // = 5.5
 
+            class Motion;
+
+            /** \brief Orders motions by their lower bound cost, for the shortest path updates of the lower bound graph */
+            struct CostLbCompare
+            {
+                CostLbCompare() : opt_(NULL)
+                {
+                }
+
+                bool operator()(const Motion *motionA, const Motion *motionB) const
+                {
+                    return opt_->isCostBetterThan(motionA->costLb_, motionB->costLb_);
+                }
+
+                const base::OptimizationObjective *opt_;
+            };
+
+            /** \brief The priority queue used to propagate lower bound cost decreases */
+            typedef BinaryHeap<Motion*, CostLbCompare> LbQueue;
+
             /** \brief Representation of a motion
 
                 a motion is a simultunaeous represntation of the two trees used by LBT-RRT
-                a lower bound tree named Tlb and an approximaion tree named Tapx. */
+                a lower bound tree named Tlb and an approximaion tree named Tapx.
+                Only the edges that lowered the lower bound of their target when
+                they were considered are kept in the lower bound graph Glb, stored
+                with their source motion. Tlb is the shortest path tree of these
+                edges. Edges that did not improve a lower bound are dropped, so a
+                later decrease does not propagate through them. */
             class Motion
             {
             public:
 
-                Motion() : state(NULL), parentLb_(NULL), parentApx_(NULL), costLb_(0.0), costApx_(0.0)
+                Motion() : state(NULL), parentLb_(NULL), parentApx_(NULL), costLb_(0.0), costApx_(0.0), heapElementLb_(NULL)
                 {
                 }
 
                 /** \brief Constructor that allocates memory for the state */
-                Motion(const base::SpaceInformationPtr &si) : state(si->allocState()), parentLb_(NULL), parentApx_(NULL), costLb_(0.0), costApx_(0.0)
+                Motion(const base::SpaceInformationPtr &si) : state(si->allocState()), parentLb_(NULL), parentApx_(NULL), costLb_(0.0), costApx_(0.0), heapElementLb_(NULL)
                 {
                 }
 
@@ -187,11 +214,18 @@ namespace ompl
                 base::Cost         costLb_;
                 /** \brief Approximate cost on path from start to state */
                 base::Cost         costApx_;
-                /** \brief The incremental lower bound cost of this motion's parent to this motion (this is stored to save distance computations in the updateChildCosts() method) */
+                /** \brief The incremental lower bound cost of this motion's parent to this motion (this is stored to save distance computations in the updateLowerBounds() method) */
                 base::Cost        incCost_;
+                /** \brief The incremental cost of this motion's parent in the approximation tree to this motion */
+                base::Cost        incCostApx_;
 
-                std::vector<Motion*> childrenLb_;
+                /** \brief The outgoing edges of the lower bound graph (the edges from this motion that lowered the lower
+                    bound of their target when inserted), with their costs. The edges to the children in Tlb are among them. */
+                std::vector<std::pair<Motion*, base::Cost> > edgesLb_;
                 std::vector<Motion*> childrenApx_;
+
+                /** \brief The element of this motion in the lower bound queue, if it is queued */
+                LbQueue::Element  *heapElementLb_;
             };
 
             struct CostCompare
@@ -213,15 +247,18 @@ namespace ompl
             /** \brief attempt to rewire the trees */
             bool attemptNodeUpdate(Motion *potentialParent, Motion *child);
 
-            /** \brief update the child cost of the lower bound tree */
-            void updateChildCostsLb(Motion *m);
+            /** \brief insert the edge from \e parent to \e child into the lower bound graph; \e child becomes
+                a child of \e parent in the lower bound tree, with lower bound cost \e costLb */
+            void insertEdgeLb(Motion *parent, Motion *child, const base::Cost &incCost, const base::Cost &costLb);
+
+            /** \brief propagate a decrease of the lower bound cost of \e m through the edges kept in the lower bound
+                graph. Only the motions whose lower bound decreases are visited, in order of their new lower bound
+                (a dynamic single source shortest path update for edge insertions). */
+            void updateLowerBounds(Motion *m);
 
             /** \brief update the child cost of the approximation tree */
             void updateChildCostsApx(Motion *m);
 
-            /** \brief remove motion from its parent in the lower bound tree*/
-            void removeFromParentLb(Motion *m);
-
             /** \brief remove motion from its parent in the approximation tree*/
             void removeFromParentApx(Motion *m);
 
@@ -268,6 +305,9 @@ namespace ompl
             /** \brief A list of states in the tree that satisfy the goal condition */
             std::vector<Motion*>                           goalMotions_;
 
+            /** \brief The queue of motions whose lower bound decreased and whose outgoing edges are yet to be relaxed */
+            LbQueue                                        lbQueue_;
+
             //////////////////////////////
             // Planner progress properties
             /** \brief Number of iterations the algorithm performed */
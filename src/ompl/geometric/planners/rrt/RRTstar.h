@@ -88,6 +88,12 @@ namespace ompl
 
             virtual void clear();
 
+            /** \brief Clear the goal-dependent data of the previous query.
+                If the start state is unchanged, the tree is kept and its
+                vertices are checked against the new goal; otherwise this is
+                equivalent to clear(). */
+            virtual void clearQuery();
+
             /** \brief Set the goal bias
 
                 In the process of randomly selecting states in
@@ -178,6 +184,41 @@ namespace ompl
                 return prune_;
             }
 
+            /** \brief Controls whether pruned motions are removed from the nearest-neighbors datastructure one at a
+                time instead of rebuilding it from the remaining tree. As updating the nearest-neighbors datastructure
+                then costs in proportion to the number of pruned motions, the tree is pruned every time the solution
+                improves and the threshold set by setPruneStatesImprovementThreshold() is ignored. Finding the motions
+                to prune still visits every motion of the remaining tree. */
+            void setIncrementalPruning(const bool incrementalPruning)
+            {
+                incrementalPruning_ = incrementalPruning;
+            }
+
+            /** \brief Get the state of the incremental pruning option. */
+            bool getIncrementalPruning() const
+            {
+                return incrementalPruning_;
+            }
+
+            /** \brief Option to choose parents and rewire neighbors in the order of a lower bound on the cost through
+                each neighbor, computed with the objective's motion cost heuristic. The search for a parent stops at the
+                first neighbor whose lower bound is not better than the best valid connection found so far, and rewiring
+                stops as soon as no remaining neighbor can be improved. Motion costs are only computed for neighbors that
+                are not ruled out by their lower bound, and are reused between choosing a parent and rewiring when the
+                objective is symmetric. This is most useful when motion costs are expensive (e.g., integrals of state
+                costs) and the motion cost heuristic is tight. When enabled, the neighbors are always collision checked
+                in order of cost, i.e., this implies the behaviour of setDelayCC(). */
+            void setOrderedRewiring(const bool orderedRewiring)
+            {
+                orderedRewiring_ = orderedRewiring;
+            }
+
+            /** \brief Get the state of the ordered rewiring option. */
+            bool getOrderedRewiring() const
+            {
+                return orderedRewiring_;
+            }
+
             /** \brief Set the percentage threshold (between 0 and 1) for pruning the tree. If the new tree has removed
                 at least this percentage of states, the tree will be finally pruned. */
             void setPruneStatesImprovementThreshold(const double pp)
@@ -205,7 +246,7 @@ namespace ompl
 
             /** \brief Use \e Informed \e RRT*.
             This means that once a problem is found, the search is focused only to the subproblem that could contain a better solution.
-            Currently only implemented for problems with a single goal that are seeking to minimize path length in R^n (i.e., RealVectorStateSpace), SE(2) (i.e., SE2StateSpace), or SE(3) (i.e., SE3StateSpace).
+            Currently only implemented for problems with goals defined as states (i.e., GoalState or GoalStates) that are seeking to minimize path length in R^n (i.e., RealVectorStateSpace), SE(2) (i.e., SE2StateSpace), or SE(3) (i.e., SE3StateSpace).
             @par J D. Gammell, S. S. Srinivasa, T. D. Barfoot, "Informed RRT*: Optimal Sampling-based
             Path Planning Focused via Direct Sampling of an Admissible Ellipsoidal Heuristic."
             IROS 2014. DOI: <a href="http://dx.doi.org/10.1109/IROS.2014.6942976">10.1109/IROS.2014.6942976</a>.
@@ -311,6 +352,9 @@ namespace ompl
             /** \brief Gets the neighbours of a given motion, using either k-nearest of radius as appropriate. */
             void getNeighbors(Motion *motion, std::vector<Motion*> &nbh);
 
+            /** \brief Rewires \e nbh through \e motion if that lowers its cost, given the cost of the motion between them and whether that motion is known to be valid (1), invalid (-1) or unchecked (0). Returns true if \e nbh was rewired. */
+            bool rewireNeighbor(Motion *motion, Motion *nbh, const base::Cost &nbhIncCost, int validity);
+
             /** \brief Removes the given motion from the parent's child list */
             void removeFromParent(Motion *m);
 
@@ -321,8 +365,10 @@ namespace ompl
                 Returns the number of motions pruned. Depends on the parameter set by setPruneStatesImprovementThreshold() */
             int pruneTree(const base::Cost pruneTreeCost);
 
-            /** \brief Deletes (frees memory) the motion and its children motions. */
-            void deleteBranch(Motion *motion);
+            /** \brief Deletes (frees memory) the motion and its children motions. If \e removeFromNN is true, the
+                deleted motions are also removed from the nearest-neighbors datastructure; returns false if one of
+                them could not be found in it. */
+            bool deleteBranch(Motion *motion, bool removeFromNN = false);
 
             /** \brief Computes the solution cost heuristically as the cost to come from start to motion plus
                  the cost to go from motion to goal. If \e shortest is true, the estimated cost to come
@@ -376,13 +422,19 @@ namespace ompl
             /** \brief The tree is only pruned is the percentage of states to prune is above this threshold (between 0 and 1). */
             double                                         pruneStatesThreshold_;
 
+            /** \brief Option to remove pruned motions from nn_ individually instead of rebuilding it */
+            bool                                           incrementalPruning_;
+
+            /** \brief Option to choose parents and rewire in order of the lower bounds of the costs through neighbors */
+            bool                                           orderedRewiring_;
+
             /** \brief Option to use informed sampling */
             bool                                           useInformedSampling_;
 
             /** \brief The number of vertices in the graph that cannot improve the solution. This is used by Informed RRT* to calculate the number of samples in the sub planning problem.*/
             unsigned int                                   numVerticesWorseThanSoln_;
 
-            struct PruneScratchSpace { std::vector<Motion*> newTree, toBePruned, candidates; } pruneScratchSpace_;
+            struct PruneScratchSpace { std::vector<Motion*> newTree, toBePruned, candidates, deleted; } pruneScratchSpace_;
 
             /** \brief Stores the Motion containing the last added initial start state. */
             Motion *                                       startMotion_;
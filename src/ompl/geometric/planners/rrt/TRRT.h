@@ -40,6 +40,9 @@
 #include "ompl/geometric/planners/PlannerIncludes.h"
 #include "ompl/datastructures/NearestNeighbors.h"
 #include "ompl/base/OptimizationObjective.h"
+#include "ompl/base/goals/GoalSampleableRegion.h"
+#include <utility>
+#include <vector>
 
 /*
   NOTES:
@@ -213,6 +216,33 @@ namespace ompl
                 return kConstant_;
             }
 
+            /** \brief Set the number of candidate extensions evaluated at once. With more than one thread,
+                every iteration draws this many candidates from the current tree, checks their motions and
+                computes their state costs concurrently, then submits them to the transition test in order.
+                The state cost of the optimization objective must then be thread-safe. */
+            void setNumThreads(unsigned int numThreads);
+
+            /** \brief Get the number of candidate extensions evaluated at once */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
+            /** \brief When enabled, an accepted uphill transition lowers the temperature in proportion to
+                the cost increase, relative to the range of state costs in the tree, instead of by the constant
+                temperature change factor. Small climbs then barely cool the search down, and large ones cool it
+                down a lot. Disabled by default. */
+            void setAdaptiveTemperature(bool flag)
+            {
+                adaptiveTemperature_ = flag;
+            }
+
+            /** \brief Check whether the adaptive temperature decrease is enabled */
+            bool getAdaptiveTemperature() const
+            {
+                return adaptiveTemperature_;
+            }
+
             /** \brief Set a different nearest neighbors datastructure */
             template<template<typename T> class NN>
             void setNearestNeighbors()
@@ -257,9 +287,60 @@ namespace ompl
 
             };
 
+            /** \brief A candidate extension of the tree, evaluated concurrently with others */
+            struct Candidate
+            {
+                /** \brief The state to add */
+                base::State *state;
+
+                /** \brief The motion the state would be connected to */
+                Motion      *nearMotion;
+
+                /** \brief Distance from the near state to the sampled state */
+                double       randMotionDistance;
+
+                /** \brief Distance from the near state to \e state */
+                double       motionDistance;
+
+                /** \brief Flag indicating that \e state is a sampled goal state */
+                bool         goalSample;
+
+                /** \brief Flag indicating that the motion to \e state is valid */
+                bool         valid;
+
+                /** \brief The cost of \e state */
+                base::Cost   cost;
+            };
+
             /** \brief Free the memory allocated by this planner */
             void freeMemory();
 
+            /** \brief Draw and evaluate numThreads_ candidate extensions, and add the ones that pass the transition
+                test to the tree. Returns the motion that satisfies the goal, if one was added. */
+            Motion* extendBatch(base::Goal *goal, base::GoalSampleableRegion *goalRegion, Motion *&approxSolution, double &approxDifference);
+
+            /** \brief Check the motion and compute the state cost of the candidates assigned to thread \e tid. The
+                costs of sampled goal states are computed before, by the calling thread. */
+            void evaluateCandidates(unsigned int tid);
+
+            /** \brief Compute the cost of a new state. Goals made of states are sampled repeatedly, so the costs of
+                sampled goal states are remembered by value in goalStateCosts_. Only called by one thread at a time
+                for goal samples. */
+            base::Cost stateCost(const base::State *state, bool goalSample);
+
+            /** \brief Decide whether a valid motion of length \e motionDistance from \e parent to a state of cost
+                \e childCost is added to the tree, \e randMotionDistance being the distance to the sample it was
+                grown towards. Both the serial and the batch expansion call this for every motion that passed
+                checkMotion(), in the order the samples were drawn, so that they apply minExpansionControl() and
+                transitionTest() in the same order. */
+            bool acceptMotion(const Motion *parent, double randMotionDistance, double motionDistance, const base::Cost &childCost);
+
+            /** \brief Free the goal states whose costs were remembered */
+            void clearGoalStateCosts();
+
+            /** \brief Add \e motion to the tree and update the range of state costs */
+            void addMotion(Motion *motion);
+
             /** \brief Compute distance between motions (actually distance between contained states) */
             double distanceFunction(const Motion *a, const Motion *b) const
             {
@@ -341,6 +422,24 @@ namespace ompl
             /// Target ratio of nonfrontier nodes to frontier nodes. rho
             double                                          frontierNodeRatio_;
 
+            /// Whether accepted uphill transitions lower the temperature in proportion to the cost increase
+            bool                                            adaptiveTemperature_;
+
+            /// The smallest and largest state costs in the tree
+            double                                          minStateCost_;
+            double                                          maxStateCost_;
+
+            // Parallel Evaluation and Cost Caching ----------------------------------------------------
+
+            /// Number of candidate extensions evaluated at once
+            unsigned int                                    numThreads_;
+
+            /// The candidate extensions of the current iteration
+            std::vector<Candidate>                          candidates_;
+
+            /// Copies of the goal states sampled so far, with their costs, if the goal is made of states
+            std::vector<std::pair<base::State*, base::Cost> > goalStateCosts_;
+
             /// The optimization objective being optimized by TRRT
             ompl::base::OptimizationObjectivePtr            opt_;
         };
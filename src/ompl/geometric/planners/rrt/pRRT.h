@@ -122,6 +122,40 @@ namespace ompl
                 return threadCount_;
             }
 
+            /** \brief Enable or disable deterministic execution. In
+                deterministic mode every thread draws its random numbers
+                from streams derived from a seed of the planner and the
+                index of the thread, and the threads work in rounds: each
+                thread extends the tree towards one sample against the
+                tree built by the previous rounds, and the new motions
+                are then added to the tree in the order of the thread
+                indices. The termination condition is checked once per
+                round. Calling solve() on planners seeded identically (see
+                setLocalSeed()) then builds the same tree, independent of
+                how the threads are scheduled. */
+            void setDeterministic(bool deterministic)
+            {
+                deterministic_ = deterministic;
+            }
+
+            /** \brief Check whether deterministic execution is enabled */
+            bool getDeterministic() const
+            {
+                return deterministic_;
+            }
+
+            /** \brief Set the seed from which the random streams of the threads are derived in deterministic mode */
+            void setLocalSeed(boost::uint32_t localSeed)
+            {
+                rng_.setLocalSeed(localSeed);
+            }
+
+            /** \brief Get the seed from which the random streams of the threads are derived in deterministic mode */
+            boost::uint32_t getLocalSeed() const
+            {
+                return rng_.getLocalSeed();
+            }
+
             /** \brief Set a different nearest neighbors datastructure */
             template<template<typename T> class NN>
             void setNearestNeighbors()
@@ -162,7 +196,19 @@ namespace ompl
                 boost::mutex lock;
             };
 
+            /** \brief The data the threads exchange between rounds in deterministic mode */
+            struct RoundInfo;
+
             void threadSolve(unsigned int tid, const base::PlannerTerminationCondition &ptc, SolutionInfo *sol);
+
+            /** \brief The loop executed by every thread in deterministic mode */
+            void threadSolveDeterministic(unsigned int tid, boost::uint32_t seed, const base::PlannerTerminationCondition &ptc,
+                                          SolutionInfo *sol, RoundInfo *round);
+
+            /** \brief Add the motions of a round to the tree in thread order and prepare the next round. This is
+                executed by one thread while all the others wait. */
+            void finishRound(const base::PlannerTerminationCondition &ptc, SolutionInfo *sol, RoundInfo *round);
+
             void freeMemory();
 
             double distanceFunction(const Motion *a, const Motion *b) const
@@ -181,6 +227,12 @@ namespace ompl
 
             /** \brief The most recent goal motion.  Used for PlannerData computation */
             Motion                                              *lastGoalMotion_;
+
+            /** \brief Flag indicating whether deterministic execution is enabled */
+            bool                                                deterministic_;
+
+            /** \brief The random number generator that seeds the threads in deterministic mode */
+            RNG                                                 rng_;
         };
 
     }
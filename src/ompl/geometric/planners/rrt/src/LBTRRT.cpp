@@ -81,6 +81,7 @@ void ompl::geometric::LBTRRT::clear()
         nn_->clear();
     lastGoalMotion_ = NULL;
     goalMotions_.clear();
+    lbQueue_.clear();
 
     iterations_ = 0;
     bestCost_ = base::Cost(std::numeric_limits<double>::quiet_NaN());
@@ -111,6 +112,7 @@ void ompl::geometric::LBTRRT::setup()
         }
         else
             opt_.reset(new base::PathLengthOptimizationObjective(si_));
+        lbQueue_.getComparisonOperator().opt_ = opt_.get();
     }
     else
     {
@@ -207,10 +209,11 @@ ompl::base::PlannerStatus ompl::geometric::LBTRRT::solve(const base::PlannerTerm
             motion->parentLb_ = nmotion;
             motion->parentApx_ = nmotion;
             motion->incCost_ = costFunction(nmotion, motion);
+            motion->incCostApx_ = motion->incCost_;
             motion->costLb_ = opt_->combineCosts(nmotion->costLb_, motion->incCost_);
             motion->costApx_ = opt_->combineCosts(nmotion->costApx_, motion->incCost_);
 
-            nmotion->childrenLb_.push_back(motion);
+            nmotion->edgesLb_.push_back(std::make_pair(motion, motion->incCost_));
             nmotion->childrenApx_.push_back(motion);
 
             nn_->add(motion);
@@ -332,13 +335,7 @@ bool ompl::geometric::LBTRRT::attemptNodeUpdate(Motion *potentialParent, Motion
         if (si_->checkMotion(potentialParent->state, child->state) == false)
             return false;
 
-        removeFromParentLb(child);
-        child->parentLb_ = potentialParent;
-        potentialParent->childrenLb_.push_back(child);
-        child->costLb_ = potentialLb;
-        child->incCost_ = incCost;
-        updateChildCostsLb(child);
-
+        insertEdgeLb(potentialParent, child, incCost, potentialLb);
 
         if (!opt_->isCostBetterThan(potentialApx, child->costApx_))
             return false;
@@ -347,23 +344,26 @@ bool ompl::geometric::LBTRRT::attemptNodeUpdate(Motion *potentialParent, Motion
         child->parentApx_ = potentialParent;
         potentialParent->childrenApx_.push_back(child);
         child->costApx_ = potentialApx;
+        child->incCostApx_ = incCost;
         updateChildCostsApx(child);
 
         if (opt_->isCostBetterThan(potentialApx, bestCost_))
             return true;
     }
     else //(child->costApx_ <= (1 + epsilon_) *  potentialLb)
-    {
-        removeFromParentLb(child);
-        child->parentLb_ = potentialParent;
-        potentialParent->childrenLb_.push_back(child);
-        child->costLb_ = potentialLb;
-        child->incCost_ = incCost;
-        updateChildCostsLb(child);
-    }
+        insertEdgeLb(potentialParent, child, incCost, potentialLb);
     return false;
 }
 
+void ompl::geometric::LBTRRT::insertEdgeLb(Motion *parent, Motion *child, const base::Cost &incCost, const base::Cost &costLb)
+{
+    parent->edgesLb_.push_back(std::make_pair(child, incCost));
+    child->parentLb_ = parent;
+    child->costLb_ = costLb;
+    child->incCost_ = incCost;
+    updateLowerBounds(child);
+}
+
 void ompl::geometric::LBTRRT::getPlannerData(base::PlannerData &data) const
 {
     Planner::getPlannerData(data);
@@ -385,27 +385,47 @@ void ompl::geometric::LBTRRT::getPlannerData(base::PlannerData &data) const
     }
 }
 
-void ompl::geometric::LBTRRT::updateChildCostsLb(Motion *m)
+void ompl::geometric::LBTRRT::updateLowerBounds(Motion *m)
 {
-    for (std::size_t i = 0; i < m->childrenLb_.size(); ++i)
+    // Edges are only ever inserted, so lower bounds only decrease. A motion is queued when its lower
+    // bound decreases, and the children in Tlb are reached through the edges like any other neighbor.
+    // Most updates are for motions that were just added and have no outgoing edges yet.
+    if (m->edgesLb_.empty())
+        return;
+    m->heapElementLb_ = lbQueue_.insert(m);
+    while (!lbQueue_.empty())
     {
-        m->childrenLb_[i]->costLb_ = opt_->combineCosts(m->costLb_, m->childrenLb_[i]->incCost_);
-        updateChildCostsLb(m->childrenLb_[i]);
+        Motion *u = lbQueue_.top()->data;
+        lbQueue_.pop();
+        u->heapElementLb_ = NULL;
+
+        for (std::size_t i = 0; i < u->edgesLb_.size(); ++i)
+        {
+            Motion *v = u->edgesLb_[i].first;
+            base::Cost costLb = opt_->combineCosts(u->costLb_, u->edgesLb_[i].second);
+            if (!opt_->isCostBetterThan(costLb, v->costLb_))
+                continue;
+
+            v->parentLb_ = u;
+            v->costLb_ = costLb;
+            v->incCost_ = u->edgesLb_[i].second;
+            if (v->heapElementLb_)
+                lbQueue_.update(v->heapElementLb_);
+            else
+                v->heapElementLb_ = lbQueue_.insert(v);
+        }
     }
 }
+
 void ompl::geometric::LBTRRT::updateChildCostsApx(Motion *m)
 {
     for (std::size_t i = 0; i < m->childrenApx_.size(); ++i)
     {
-        m->childrenApx_[i]->costApx_ = opt_->combineCosts(m->costApx_, m->childrenApx_[i]->incCost_);
+        m->childrenApx_[i]->costApx_ = opt_->combineCosts(m->costApx_, m->childrenApx_[i]->incCostApx_);
         updateChildCostsApx(m->childrenApx_[i]);
     }
 }
 
-void ompl::geometric::LBTRRT::removeFromParentLb(Motion *m)
-{
-    return removeFromParent(m, m->parentLb_->childrenLb_);
-}
 void ompl::geometric::LBTRRT::removeFromParentApx(Motion *m)
 {
     return removeFromParent(m, m->parentApx_->childrenApx_);
@@ -60,8 +60,11 @@ ompl::geometric::RRTstar::RRTstar(const base::SpaceInformationPtr &si) :
     lastGoalMotion_(NULL),
     prune_(false),
     pruneStatesThreshold_(0.95),
+    incrementalPruning_(false),
+    orderedRewiring_(false),
     useInformedSampling_(false),
     numVerticesWorseThanSoln_(0u),
+    startMotion_(NULL),
     iterations_(0u),
     collisionChecks_(0u),
     bestCost_(std::numeric_limits<double>::quiet_NaN())
@@ -77,6 +80,8 @@ ompl::geometric::RRTstar::RRTstar(const base::SpaceInformationPtr &si) :
     Planner::declareParam<bool>("delay_collision_checking", this, &RRTstar::setDelayCC, &RRTstar::getDelayCC, "0,1");
     Planner::declareParam<bool>("prune", this, &RRTstar::setPrune, &RRTstar::getPrune, "0,1");
     Planner::declareParam<double>("prune_states_threshold", this, &RRTstar::setPruneStatesImprovementThreshold, &RRTstar::getPruneStatesImprovementThreshold, "0.:.01:1.");
+    Planner::declareParam<bool>("incremental_pruning", this, &RRTstar::setIncrementalPruning, &RRTstar::getIncrementalPruning, "0,1");
+    Planner::declareParam<bool>("ordered_rewiring", this, &RRTstar::setOrderedRewiring, &RRTstar::getOrderedRewiring, "0,1");
     Planner::declareParam<bool>("informed_rrtstar", this, &RRTstar::setInformedSampling, &RRTstar::getInformedSampling, "0,1");
 
     addPlannerProgressProperty("iterations INTEGER",
@@ -165,12 +170,59 @@ void ompl::geometric::RRTstar::clear()
 
     lastGoalMotion_ = NULL;
     goalMotions_.clear();
+    startMotion_ = NULL;
+    numVerticesWorseThanSoln_ = 0u;
 
     iterations_ = 0;
     collisionChecks_ = 0;
     bestCost_ = base::Cost(std::numeric_limits<double>::quiet_NaN());
 }
 
+void ompl::geometric::RRTstar::clearQuery()
+{
+    // The tree is rooted at the previous start, so it can only be reused if that start has not changed
+    if (!setup_ || !nn_ || !startMotion_ || !opt_ || !pdef_ || pdef_->getStartStateCount() != 1 ||
+        !si_->equalStates(startMotion_->state, pdef_->getStartState(0)))
+    {
+        clear();
+        return;
+    }
+
+    lastGoalMotion_ = NULL;
+    goalMotions_.clear();
+    numVerticesWorseThanSoln_ = 0u;
+    bestCost_ = opt_->infiniteCost();
+
+    // With informed sampling, solve() shrinks the rewiring radius to the measure of the informed set of the
+    // best solution. That solution was for the previous goal, so the radius for the whole space is restored, as in setup()
+    if (useInformedSampling_)
+    {
+        double dimDbl = (double)si_->getStateDimension();
+        r_rrg_ = rewireFactor_*2.0*std::pow((1.0 + 1.0/dimDbl)*(si_->getSpaceMeasure()/ProlateHyperspheroid::unitNBallMeasure(si_->getStateDimension())), 1.0/dimDbl);
+    }
+
+    // The informed sampler is built around the goal states
+    allocSampler();
+
+    // Vertices already in the tree may satisfy the new goal
+    const base::Goal *goal = pdef_->getGoal().get();
+    std::vector<Motion*> motions;
+    nn_->list(motions);
+    for (std::size_t i = 0 ; i < motions.size() ; ++i)
+        if (goal->isSatisfied(motions[i]->state))
+        {
+            goalMotions_.push_back(motions[i]);
+            if (opt_->isCostBetterThan(motions[i]->cost, bestCost_))
+            {
+                bestCost_ = motions[i]->cost;
+                lastGoalMotion_ = motions[i];
+            }
+        }
+
+    if (lastGoalMotion_ && useInformedSampling_)
+        countNumberOfVerticesWorseThanSoln();
+}
+
 ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTerminationCondition &ptc)
 {
     checkValidity();
@@ -219,6 +271,11 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
     std::vector<base::Cost>    incCosts;
     std::vector<std::size_t>   sortedCostIndices;
 
+    // only used with ordered rewiring
+    std::vector<base::Cost>    lowerBounds;
+    std::vector<base::Cost>    worstCosts;
+    std::vector<int>           incCostKnown;
+
     std::vector<int>           valid;
     unsigned int               rewireTest = 0;
     unsigned int               statesGenerated = 0;
@@ -233,6 +290,7 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
 
     // our functor for sorting nearest neighbors
     CostIndexCompare compareFn(costs, *opt_);
+    CostIndexCompare lowerBoundCompareFn(lowerBounds, *opt_);
 
     while (ptc == false)
     {
@@ -292,6 +350,12 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
                 costs.resize(nbh.size());
                 incCosts.resize(nbh.size());
                 sortedCostIndices.resize(nbh.size());
+                if (orderedRewiring_)
+                {
+                    lowerBounds.resize(nbh.size());
+                    worstCosts.resize(nbh.size());
+                    incCostKnown.resize(nbh.size());
+                }
             }
 
             // cache for motion validity (only useful in a symmetric space)
@@ -305,7 +369,61 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
             // Finding the nearest neighbor to connect to
             // By default, neighborhood states are sorted by cost, and collision checking
             // is performed in increasing order of cost
-            if (delayCC_)
+            if (orderedRewiring_)
+            {
+                // lower-bound the cost to come through every neighbor
+                // without computing the motion costs
+                for (std::size_t i = 0 ; i < nbh.size(); ++i)
+                {
+                    if (nbh[i] == nmotion)
+                    {
+                        // motion is already connected through nmotion
+                        incCosts[i] = motion->incCost;
+                        costs[i] = motion->cost;
+                        lowerBounds[i] = motion->cost;
+                        incCostKnown[i] = 1;
+                        valid[i] = 1;
+                    }
+                    else
+                    {
+                        lowerBounds[i] = opt_->combineCosts(nbh[i]->cost, opt_->motionCostHeuristic(nbh[i]->state, motion->state));
+                        incCostKnown[i] = 0;
+                    }
+                    sortedCostIndices[i] = i;
+                }
+                std::sort(sortedCostIndices.begin(), sortedCostIndices.begin() + nbh.size(),
+                          lowerBoundCompareFn);
+
+                // evaluate the neighbors in order of their lower bounds
+                // until none of the remaining ones can beat the
+                // current parent
+                for (std::vector<std::size_t>::const_iterator i = sortedCostIndices.begin();
+                     i != sortedCostIndices.begin() + nbh.size();
+                     ++i)
+                {
+                    if (nbh[*i] == nmotion)
+                        continue;
+                    if (!opt_->isCostBetterThan(lowerBounds[*i], motion->cost))
+                        break;
+
+                    incCosts[*i] = opt_->motionCost(nbh[*i]->state, motion->state);
+                    costs[*i] = opt_->combineCosts(nbh[*i]->cost, incCosts[*i]);
+                    incCostKnown[*i] = 1;
+                    if (opt_->isCostBetterThan(costs[*i], motion->cost))
+                    {
+                        ++collisionChecks_;
+                        if (si_->checkMotion(nbh[*i]->state, motion->state))
+                        {
+                            motion->incCost = incCosts[*i];
+                            motion->cost = costs[*i];
+                            motion->parent = nbh[*i];
+                            valid[*i] = 1;
+                        }
+                        else valid[*i] = -1;
+                    }
+                }
+            }
+            else if (delayCC_)
             {
                 // calculate all costs and distances
                 for (std::size_t i = 0 ; i < nbh.size(); ++i)
@@ -403,43 +521,66 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
             }
 
             bool checkForSolution = false;
-            for (std::size_t i = 0; i < nbh.size(); ++i)
+            if (orderedRewiring_)
             {
-                if (nbh[i] != motion->parent)
+                // lower-bound the cost to come of every neighbor through
+                // the new motion, reusing the motion costs that are known
+                for (std::size_t i = 0; i < nbh.size(); ++i)
                 {
-                    base::Cost nbhIncCost;
-                    if (symCost)
-                        nbhIncCost = incCosts[i];
+                    if (symCost && incCostKnown[i])
+                        lowerBounds[i] = opt_->combineCosts(motion->cost, incCosts[i]);
                     else
-                        nbhIncCost = opt_->motionCost(motion->state, nbh[i]->state);
-                    base::Cost nbhNewCost = opt_->combineCosts(motion->cost, nbhIncCost);
-                    if (opt_->isCostBetterThan(nbhNewCost, nbh[i]->cost))
-                    {
-                        bool motionValid;
-                            if (valid[i] == 0)
-                            {
-                                ++collisionChecks_;
-                                motionValid = si_->checkMotion(motion->state, nbh[i]->state);
-                            }
-                            else
-                                motionValid = (valid[i] == 1);
+                        lowerBounds[i] = opt_->combineCosts(motion->cost, opt_->motionCostHeuristic(motion->state, nbh[i]->state));
+                    sortedCostIndices[i] = i;
+                }
+                std::sort(sortedCostIndices.begin(), sortedCostIndices.begin() + nbh.size(),
+                          lowerBoundCompareFn);
 
-                        if (motionValid)
-                        {
-                            // Remove this node from its parent list
-                            removeFromParent (nbh[i]);
+                // the worst cost of the neighbors from each position
+                // onwards in the sorted list. Rewiring only decreases
+                // costs, so these stay valid bounds during the loop
+                for (std::size_t j = nbh.size(); j > 0; --j)
+                {
+                    const base::Cost &nbhCost = nbh[sortedCostIndices[j - 1]]->cost;
+                    if (j == nbh.size() || opt_->isCostBetterThan(worstCosts[j], nbhCost))
+                        worstCosts[j - 1] = nbhCost;
+                    else
+                        worstCosts[j - 1] = worstCosts[j];
+                }
 
-                            // Add this node to the new parent
-                            nbh[i]->parent = motion;
-                            nbh[i]->incCost = nbhIncCost;
-                            nbh[i]->cost = nbhNewCost;
-                            nbh[i]->parent->children.push_back(nbh[i]);
+                for (std::size_t j = 0; j < nbh.size(); ++j)
+                {
+                    std::size_t i = sortedCostIndices[j];
+
+                    // none of the remaining neighbors can be improved
+                    if (!opt_->isCostBetterThan(lowerBounds[i], worstCosts[j]))
+                        break;
 
-                            // Update the costs of the node's children
-                            updateChildCosts(nbh[i]);
+                    if (nbh[i] == motion->parent || !opt_->isCostBetterThan(lowerBounds[i], nbh[i]->cost))
+                        continue;
 
+                    base::Cost nbhIncCost;
+                    if (symCost && incCostKnown[i])
+                        nbhIncCost = incCosts[i];
+                    else
+                        nbhIncCost = opt_->motionCost(motion->state, nbh[i]->state);
+                    if (rewireNeighbor(motion, nbh[i], nbhIncCost, valid[i]))
+                        checkForSolution = true;
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < nbh.size(); ++i)
+                {
+                    if (nbh[i] != motion->parent)
+                    {
+                        base::Cost nbhIncCost;
+                        if (symCost)
+                            nbhIncCost = incCosts[i];
+                        else
+                            nbhIncCost = opt_->motionCost(motion->state, nbh[i]->state);
+                        if (rewireNeighbor(motion, nbh[i], nbhIncCost, valid[i]))
                             checkForSolution = true;
-                        }
                     }
                 }
             }
@@ -499,18 +640,22 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
                         statesGenerated -= n;
                     }
 
-                    if (intermediateSolutionCallback)
+                    if (intermediateSolutionCallback || hasImprovedSolutionCallback())
                     {
+                        // The states of the solution, from the goal to the start
                         std::vector<const base::State *> spath;
-                        Motion *intermediate_solution = solution->parent; // Do not include goal state to simplify code.
+                        for (Motion *m = solution; m != NULL; m = m->parent)
+                            spath.push_back(m->state);
 
-                        do
-                        {
-                            spath.push_back(intermediate_solution->state);
-                            intermediate_solution = intermediate_solution->parent;
-                        } while (intermediate_solution->parent != 0); // Do not include the start state.
+                        // Do not include the goal and start states.
+                        if (intermediateSolutionCallback && spath.size() > 2)
+                            intermediateSolutionCallback(this, std::vector<const base::State *>(spath.begin() + 1, spath.end() - 1), bestCost_);
 
-                        intermediateSolutionCallback(this, spath, bestCost_);
+                        if (hasImprovedSolutionCallback())
+                        {
+                            std::reverse(spath.begin(), spath.end());
+                            notifyImprovedSolution(spath, solution->cost);
+                        }
                     }
                 }
             }
@@ -590,6 +735,39 @@ void ompl::geometric::RRTstar::getNeighbors(Motion *motion, std::vector<Motion*>
 }
 
 
+bool ompl::geometric::RRTstar::rewireNeighbor(Motion *motion, Motion *nbh, const base::Cost &nbhIncCost, int validity)
+{
+    base::Cost nbhNewCost = opt_->combineCosts(motion->cost, nbhIncCost);
+    if (!opt_->isCostBetterThan(nbhNewCost, nbh->cost))
+        return false;
+
+    bool motionValid;
+    if (validity == 0)
+    {
+        ++collisionChecks_;
+        motionValid = si_->checkMotion(motion->state, nbh->state);
+    }
+    else
+        motionValid = (validity == 1);
+
+    if (!motionValid)
+        return false;
+
+    // Remove this node from its parent list
+    removeFromParent (nbh);
+
+    // Add this node to the new parent
+    nbh->parent = motion;
+    nbh->incCost = nbhIncCost;
+    nbh->cost = nbhNewCost;
+    nbh->parent->children.push_back(nbh);
+
+    // Update the costs of the node's children
+    updateChildCosts(nbh);
+
+    return true;
+}
+
 void ompl::geometric::RRTstar::removeFromParent(Motion *m)
 {
     for (std::vector<Motion*>::iterator it = m->parent->children.begin ();
@@ -674,23 +852,47 @@ int ompl::geometric::RRTstar::pruneTree(const base::Cost pruneTreeCost)
 
     // To create the new nn takes one order of magnitude in time more than just checking how many
     // states would be pruned. Therefore, only prune if it removes a significant amount of states.
-    if ((double)pruneScratchSpace_.newTree.size() / tree_size < pruneStatesThreshold_)
-{
+    // Removing the pruned states from nn one at a time has a cost proportional to their number, so
+    // incremental pruning always prunes.
+    if (incrementalPruning_ || (double)pruneScratchSpace_.newTree.size() / tree_size < pruneStatesThreshold_)
+    {
+        pruneScratchSpace_.deleted.clear();
+
+        // If a state can not be removed from nn, fall back to rebuilding it
+        bool rebuildNN = !incrementalPruning_;
         for (std::size_t i = 0; i < pruneScratchSpace_.toBePruned.size(); ++i)
-            deleteBranch(pruneScratchSpace_.toBePruned[i]);
+        {
+            if (!deleteBranch(pruneScratchSpace_.toBePruned[i], !rebuildNN))
+                rebuildNN = true;
+        }
 
-        nn_->clear();
-        nn_->add(pruneScratchSpace_.newTree);
+        if (rebuildNN)
+        {
+            nn_->clear();
+            nn_->add(pruneScratchSpace_.newTree);
+        }
 
-        return (tree_size - pruneScratchSpace_.newTree.size());
-}
+        // Forget the goal motions that were deleted
+        if (!pruneScratchSpace_.deleted.empty())
+        {
+            std::sort(pruneScratchSpace_.deleted.begin(), pruneScratchSpace_.deleted.end());
+            std::vector<Motion*>::iterator last = goalMotions_.begin();
+            for (std::vector<Motion*>::iterator it = goalMotions_.begin(); it != goalMotions_.end(); ++it)
+                if (!std::binary_search(pruneScratchSpace_.deleted.begin(), pruneScratchSpace_.deleted.end(), *it))
+                    *last++ = *it;
+            goalMotions_.erase(last, goalMotions_.end());
+        }
+
+        return (tree_size - nn_->size());
+    }
     return 0;
 }
 
-void ompl::geometric::RRTstar::deleteBranch(Motion *motion)
+bool ompl::geometric::RRTstar::deleteBranch(Motion *motion, bool removeFromNN)
 {
     removeFromParent(motion);
 
+    bool removed = true;
     std::vector<Motion *>& toDelete = pruneScratchSpace_.candidates;
     toDelete.clear();
     toDelete.push_back(motion);
@@ -703,9 +905,16 @@ void ompl::geometric::RRTstar::deleteBranch(Motion *motion)
         for(std::size_t i = 0; i < mto_delete->children.size(); ++i)
             toDelete.push_back(mto_delete->children[i]);
 
+        // Once a motion is left in nn with a freed state, nn can not be searched anymore
+        if (removeFromNN && removed)
+            removed = nn_->remove(mto_delete);
+
+        pruneScratchSpace_.deleted.push_back(mto_delete);
         si_->freeState(mto_delete->state);
         delete mto_delete;
     }
+
+    return removed;
 }
 
 ompl::base::Cost ompl::geometric::RRTstar::defaultCostToGoHeuristic(const base::State *state, const base::Goal *goal) const
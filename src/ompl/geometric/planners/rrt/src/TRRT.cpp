@@ -39,7 +39,10 @@
 #include "ompl/base/goals/GoalSampleableRegion.h"
 #include "ompl/tools/config/SelfConfig.h"
 #include "ompl/tools/config/MagicConstants.h"
+#include <boost/thread/thread.hpp>
 #include <limits>
+#include <algorithm>
+#include <cmath>
 
 ompl::geometric::TRRT::TRRT(const base::SpaceInformationPtr &si) : base::Planner(si, "TRRT")
 {
@@ -62,6 +65,10 @@ ompl::geometric::TRRT::TRRT(const base::SpaceInformationPtr &si) : base::Planner
     minTemperature_ = 10e-10; // lower limit of the temperature change
     initTemperature_ = 10e-6; // where the temperature starts out
     frontierNodeRatio_ = 0.1; // 1/10, or 1 nonfrontier for every 10 frontier
+    adaptiveTemperature_ = false;
+    minStateCost_ = std::numeric_limits<double>::infinity();
+    maxStateCost_ = -std::numeric_limits<double>::infinity();
+    numThreads_ = 1;
 
     Planner::declareParam<unsigned int>("max_states_failed", this, &TRRT::setMaxStatesFailed, &TRRT::getMaxStatesFailed, "1:1000");
     Planner::declareParam<double>("temp_change_factor", this, &TRRT::setTempChangeFactor, &TRRT::getTempChangeFactor,"0.:.1:10.");
@@ -70,6 +77,8 @@ ompl::geometric::TRRT::TRRT(const base::SpaceInformationPtr &si) : base::Planner
     Planner::declareParam<double>("frontier_threshold", this, &TRRT::setFrontierThreshold, &TRRT::getFrontierThreshold);
     Planner::declareParam<double>("frontierNodeRatio", this, &TRRT::setFrontierNodeRatio, &TRRT::getFrontierNodeRatio);
     Planner::declareParam<double>("k_constant", this, &TRRT::setKConstant, &TRRT::getKConstant);
+    Planner::declareParam<bool>("adaptive_temperature", this, &TRRT::setAdaptiveTemperature, &TRRT::getAdaptiveTemperature, "0,1");
+    Planner::declareParam<unsigned int>("num_threads", this, &TRRT::setNumThreads, &TRRT::getNumThreads, "1:1:64");
 }
 
 ompl::geometric::TRRT::~TRRT()
@@ -91,6 +100,8 @@ void ompl::geometric::TRRT::clear()
     temp_ = initTemperature_;
     nonfrontierCount_ = 1;
     frontierCount_ = 1; // init to 1 to prevent division by zero error
+    minStateCost_ = std::numeric_limits<double>::infinity();
+    maxStateCost_ = -std::numeric_limits<double>::infinity();
 }
 
 void ompl::geometric::TRRT::setup()
@@ -117,6 +128,9 @@ void ompl::geometric::TRRT::setup()
     else
         opt_ = pdef_->getOptimizationObjective();
 
+    // the remembered costs may have been computed by another objective
+    clearGoalStateCosts();
+
     // Set maximum distance a new node can be from its nearest neighbor
     if (maxDistance_ < std::numeric_limits<double>::epsilon())
     {
@@ -152,6 +166,8 @@ void ompl::geometric::TRRT::setup()
     temp_ = initTemperature_;
     nonfrontierCount_ = 1;
     frontierCount_ = 1; // init to 1 to prevent division by zero error
+    minStateCost_ = std::numeric_limits<double>::infinity();
+    maxStateCost_ = -std::numeric_limits<double>::infinity();
 }
 
 void ompl::geometric::TRRT::freeMemory()
@@ -168,6 +184,25 @@ void ompl::geometric::TRRT::freeMemory()
             delete motions[i];
         }
     }
+
+    for (std::size_t i = 0 ; i < candidates_.size() ; ++i)
+        si_->freeState(candidates_[i].state);
+    candidates_.clear();
+    clearGoalStateCosts();
+}
+
+void ompl::geometric::TRRT::clearGoalStateCosts()
+{
+    for (std::size_t i = 0 ; i < goalStateCosts_.size() ; ++i)
+        si_->freeState(goalStateCosts_[i].first);
+    goalStateCosts_.clear();
+}
+
+void ompl::geometric::TRRT::setNumThreads(unsigned int numThreads)
+{
+    if (numThreads == 0)
+        throw Exception(name_, "The number of threads must be at least 1");
+    numThreads_ = numThreads;
 }
 
 ompl::base::PlannerStatus
@@ -195,7 +230,7 @@ ompl::geometric::TRRT::solve(const base::PlannerTerminationCondition &plannerTer
         motion->cost = opt_->stateCost(motion->state);
 
         // Add start motion to the tree
-        nearestNeighbors_->add(motion);
+        addMotion(motion);
     }
 
     // Check that input states exist
@@ -237,14 +272,26 @@ ompl::geometric::TRRT::solve(const base::PlannerTerminationCondition &plannerTer
     base::State *interpolatedState = si_->allocState(); // Allocates "space information"-sized memory for a state
     // The chosen state btw rand_state and interpolated_state
     base::State *newState;
+    // Whether the random state was sampled from the goal
+    bool goalSample;
 
     // Begin sampling --------------------------------------------------------------------------------------
     while (plannerTerminationCondition() == false)
     {
+        // Evaluate several candidate extensions at once
+        if (numThreads_ > 1)
+        {
+            solution = extendBatch(goal, goalRegion, approxSolution, approxDifference);
+            if (solution)
+                break;
+            continue;
+        }
+
         // I.
 
         // Sample random state (with goal biasing probability)
-        if (goalRegion && rng_.uniform01() < goalBias_ && goalRegion->canSample())
+        goalSample = goalRegion && rng_.uniform01() < goalBias_ && goalRegion->canSample();
+        if (goalSample)
         {
             // Bias sample towards goal
             goalRegion->sampleGoal(randState);
@@ -278,6 +325,7 @@ ompl::geometric::TRRT::solve(const base::PlannerTerminationCondition &plannerTer
 
             // Use the interpolated state as the new state
             newState = interpolatedState;
+            goalSample = false;
         }
         else
         {
@@ -301,19 +349,10 @@ ompl::geometric::TRRT::solve(const base::PlannerTerminationCondition &plannerTer
         if (!si_->checkMotion(nearMotion->state, newState))
             continue; // try a new sample
 
+        base::Cost childCost = stateCost(newState, goalSample);
 
-        // Minimum Expansion Control
-        // A possible side effect may appear when the tree expansion toward unexplored regions remains slow, and the
-        // new nodes contribute only to refine already explored regions.
-        if (!minExpansionControl(randMotionDistance))
-        {
-            continue; // give up on this one and try a new sample
-        }
-
-        base::Cost childCost = opt_->stateCost(newState);
-
-        // Only add this motion to the tree if the tranistion test accepts it
-        if (!transitionTest(childCost.value(), nearMotion->cost.value(), motionDistance))
+        // Only add this motion to the tree if the minimum expansion control and the transition test accept it
+        if (!acceptMotion(nearMotion, randMotionDistance, motionDistance, childCost))
         {
             continue; // give up on this one and try a new sample
         }
@@ -327,7 +366,7 @@ ompl::geometric::TRRT::solve(const base::PlannerTerminationCondition &plannerTer
         motion->cost = childCost;
 
         // Add motion to data structure
-        nearestNeighbors_->add(motion);
+        addMotion(motion);
 
         // VI.
 
@@ -418,6 +457,136 @@ void ompl::geometric::TRRT::getPlannerData(base::PlannerData &data) const
     }
 }
 
+ompl::geometric::TRRT::Motion*
+ompl::geometric::TRRT::extendBatch(base::Goal *goal, base::GoalSampleableRegion *goalRegion,
+                                   Motion *&approxSolution, double &approxDifference)
+{
+    if (candidates_.size() != numThreads_)
+    {
+        for (std::size_t i = 0 ; i < candidates_.size() ; ++i)
+            si_->freeState(candidates_[i].state);
+        candidates_.resize(numThreads_);
+        for (std::size_t i = 0 ; i < candidates_.size() ; ++i)
+            candidates_[i].state = si_->allocState();
+    }
+
+    // Draw the candidates from the current tree. This part is serial so that the random number
+    // sequence does not depend on thread scheduling.
+    Motion randMotion;
+    for (std::size_t i = 0 ; i < candidates_.size() ; ++i)
+    {
+        Candidate &c = candidates_[i];
+        randMotion.state = c.state;
+
+        c.goalSample = goalRegion && rng_.uniform01() < goalBias_ && goalRegion->canSample();
+        if (c.goalSample)
+            goalRegion->sampleGoal(c.state);
+        else
+            sampler_->sampleUniform(c.state);
+
+        c.nearMotion = nearestNeighbors_->nearest(&randMotion);
+        c.randMotionDistance = si_->distance(c.nearMotion->state, c.state);
+        if (c.randMotionDistance > maxDistance_)
+        {
+            si_->getStateSpace()->interpolate(c.nearMotion->state, c.state,
+                                              maxDistance_ / c.randMotionDistance, c.state);
+            c.motionDistance = si_->distance(c.nearMotion->state, c.state);
+            c.goalSample = false;
+        }
+        else
+            c.motionDistance = c.randMotionDistance;
+
+        // the costs of goal samples are remembered by this thread only
+        if (c.goalSample)
+            c.cost = stateCost(c.state, true);
+    }
+    randMotion.state = NULL;
+
+    // Check the motions and compute the state costs concurrently
+    boost::thread_group threads;
+    for (unsigned int i = 1 ; i < numThreads_ ; ++i)
+        threads.create_thread(boost::bind(&TRRT::evaluateCandidates, this, i));
+    evaluateCandidates(0);
+    threads.join_all();
+
+    // Submit the candidates to the transition test in the order they were drawn
+    Motion *solution = NULL;
+    for (std::size_t i = 0 ; i < candidates_.size() && !solution ; ++i)
+    {
+        Candidate &c = candidates_[i];
+        if (!c.valid)
+            continue;
+
+        if (!acceptMotion(c.nearMotion, c.randMotionDistance, c.motionDistance, c.cost))
+            continue;
+
+        Motion *motion = new Motion(si_);
+        si_->copyState(motion->state, c.state);
+        motion->parent = c.nearMotion;
+        motion->cost = c.cost;
+        addMotion(motion);
+
+        double distToGoal = 0.0;
+        if (goal->isSatisfied(motion->state, &distToGoal))
+        {
+            approxDifference = distToGoal;
+            solution = motion;
+        }
+        else if (distToGoal < approxDifference)
+        {
+            approxDifference = distToGoal;
+            approxSolution = motion;
+        }
+    }
+
+    return solution;
+}
+
+void ompl::geometric::TRRT::evaluateCandidates(unsigned int tid)
+{
+    for (std::size_t i = tid ; i < candidates_.size() ; i += numThreads_)
+    {
+        Candidate &c = candidates_[i];
+        c.valid = si_->checkMotion(c.nearMotion->state, c.state);
+        if (c.valid && !c.goalSample)
+            c.cost = opt_->stateCost(c.state);
+    }
+}
+
+ompl::base::Cost ompl::geometric::TRRT::stateCost(const base::State *state, bool goalSample)
+{
+    const base::Goal *goal = pdef_->getGoal().get();
+    if (!goalSample || !(goal->hasType(base::GOAL_STATE) || goal->hasType(base::GOAL_STATES)))
+        return opt_->stateCost(state);
+
+    for (std::size_t i = 0 ; i < goalStateCosts_.size() ; ++i)
+        if (si_->equalStates(goalStateCosts_[i].first, state))
+            return goalStateCosts_[i].second;
+
+    base::Cost cost = opt_->stateCost(state);
+    goalStateCosts_.push_back(std::make_pair(si_->cloneState(state), cost));
+    return cost;
+}
+
+bool ompl::geometric::TRRT::acceptMotion(const Motion *parent, double randMotionDistance, double motionDistance,
+                                         const base::Cost &childCost)
+{
+    // Minimum Expansion Control
+    // A possible side effect may appear when the tree expansion toward unexplored regions remains slow, and the
+    // new nodes contribute only to refine already explored regions.
+    if (!minExpansionControl(randMotionDistance))
+        return false;
+
+    return transitionTest(childCost.value(), parent->cost.value(), motionDistance);
+}
+
+void ompl::geometric::TRRT::addMotion(Motion *motion)
+{
+    nearestNeighbors_->add(motion);
+    minStateCost_ = std::min(minStateCost_, motion->cost.value());
+    maxStateCost_ = std::max(maxStateCost_, motion->cost.value());
+}
+
 bool ompl::geometric::TRRT::transitionTest(double childCost, double parentCost, double distance)
 {
     // Always accept if new state has same or lower cost than old state
@@ -445,7 +614,13 @@ bool ompl::geometric::TRRT::transitionTest(double childCost, double parentCost,
     {
         if (temp_ > minTemperature_)
         {
-            temp_ /= tempChangeFactor_;
+            // Cool down in proportion to the climb, relative to the costs seen so far
+            double costRange = maxStateCost_ - minStateCost_;
+            if (adaptiveTemperature_ && costRange > 0.0)
+                temp_ /= pow(tempChangeFactor_, (childCost - parentCost) /
+                             (magic::TRRT_ADAPTIVE_TEMPERATURE_COST_FRACTION * costRange));
+            else
+                temp_ /= tempChangeFactor_;
 
             // Prevent temp_ from getting too small
             if (temp_ < minTemperature_)
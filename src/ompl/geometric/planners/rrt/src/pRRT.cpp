@@ -38,8 +38,33 @@
 #include "ompl/base/goals/GoalSampleableRegion.h"
 #include "ompl/tools/config/SelfConfig.h"
 #include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
 #include <limits>
 
+struct ompl::geometric::pRRT::RoundInfo
+{
+    RoundInfo(unsigned int threadCount) : barrier(threadCount), targets(threadCount, NULL),
+                                         goalTargets(threadCount, false), motions(threadCount, NULL), stop(false)
+    {
+    }
+
+    /** \brief Separates the parallel part of a round from finishRound() */
+    boost::barrier            barrier;
+
+    /** \brief The state each thread extends the tree towards in the next round */
+    std::vector<base::State*> targets;
+
+    /** \brief Flags indicating the threads that asked for a goal sample as their next target
+        (not std::vector<bool>, as the threads set their flags concurrently) */
+    std::vector<char>         goalTargets;
+
+    /** \brief The motion each thread computed in the current round (NULL if its extension failed) */
+    std::vector<Motion*>      motions;
+
+    /** \brief Flag set by finishRound() when the threads are to stop */
+    bool                      stop;
+};
+
 ompl::geometric::pRRT::pRRT(const base::SpaceInformationPtr &si) : base::Planner(si, "pRRT"),
                                                                   samplerArray_(si)
 {
@@ -51,10 +76,12 @@ ompl::geometric::pRRT::pRRT(const base::SpaceInformationPtr &si) : base::Planner
     goalBias_ = 0.05;
     maxDistance_ = 0.0;
     lastGoalMotion_ = NULL;
+    deterministic_ = false;
 
     Planner::declareParam<double>("range", this, &pRRT::setRange, &pRRT::getRange, "0.:1.:10000.");
     Planner::declareParam<double>("goal_bias", this, &pRRT::setGoalBias, &pRRT::getGoalBias, "0.:.05:1.");
     Planner::declareParam<unsigned int>("thread_count", this, &pRRT::setThreadCount, &pRRT::getThreadCount, "1:64");
+    Planner::declareParam<bool>("deterministic", this, &pRRT::setDeterministic, &pRRT::getDeterministic, "0,1");
 }
 
 ompl::geometric::pRRT::~pRRT()
@@ -170,6 +197,106 @@ void ompl::geometric::pRRT::threadSolve(unsigned int tid, const base::PlannerTer
     delete rmotion;
 }
 
+void ompl::geometric::pRRT::threadSolveDeterministic(unsigned int tid, boost::uint32_t seed, const base::PlannerTerminationCondition &ptc,
+                                                     SolutionInfo *sol, RoundInfo *round)
+{
+    // the sampler and the RNG of this thread are seeded from (seed, tid) only
+    RNG::ScopedSeed             scope(seed, tid);
+    base::StateSamplerPtr       sampler = si_->allocStateSampler();
+    RNG                         rng;
+    const bool                  goalBiased = dynamic_cast<base::GoalSampleableRegion*>(pdef_->getGoal().get()) != NULL;
+
+    Motion *rmotion   = new Motion(si_);
+    base::State *rstate = rmotion->state;
+    base::State *xstate = si_->allocState();
+    round->targets[tid] = rstate;
+
+    while (true)
+    {
+        /* sample random state, unless finishRound() put a goal sample in rstate */
+        if (!round->goalTargets[tid])
+            sampler->sampleUniform(rstate);
+
+        /* find closest state in the tree; the tree does not change during this part of the round */
+        nnLock_.lock();
+        Motion *nmotion = nn_->nearest(rmotion);
+        nnLock_.unlock();
+        base::State *dstate = rstate;
+
+        /* find state to add */
+        double d = si_->distance(nmotion->state, rstate);
+        if (d > maxDistance_)
+        {
+            si_->getStateSpace()->interpolate(nmotion->state, rstate, maxDistance_ / d, xstate);
+            dstate = xstate;
+        }
+
+        round->motions[tid] = NULL;
+        if (si_->checkMotion(nmotion->state, dstate))
+        {
+            /* create a motion; finishRound() adds it to the tree */
+            Motion *motion = new Motion(si_);
+            si_->copyState(motion->state, dstate);
+            motion->parent = nmotion;
+            round->motions[tid] = motion;
+        }
+
+        /* decide on the target of the next round (with goal biasing) */
+        round->goalTargets[tid] = goalBiased && rng.uniform01() < goalBias_;
+
+        if (round->barrier.wait())
+            finishRound(ptc, sol, round);
+        round->barrier.wait();
+        if (round->stop)
+            break;
+    }
+
+    si_->freeState(xstate);
+    if (rmotion->state)
+        si_->freeState(rmotion->state);
+    delete rmotion;
+}
+
+void ompl::geometric::pRRT::finishRound(const base::PlannerTerminationCondition &ptc, SolutionInfo *sol, RoundInfo *round)
+{
+    base::Goal                 *goal   = pdef_->getGoal().get();
+    base::GoalSampleableRegion *goal_s = dynamic_cast<base::GoalSampleableRegion*>(goal);
+
+    for (std::size_t i = 0 ; i < round->motions.size() ; ++i)
+    {
+        Motion *motion = round->motions[i];
+        if (!motion)
+            continue;
+        nn_->add(motion);
+
+        double dist = 0.0;
+        bool solved = goal->isSatisfied(motion->state, &dist);
+        if (solved && sol->solution == NULL)
+        {
+            sol->approxdif = dist;
+            sol->solution = motion;
+        }
+        if (dist < sol->approxdif)
+        {
+            sol->approxdif = dist;
+            sol->approxsol = motion;
+        }
+    }
+
+    round->stop = sol->solution != NULL || ptc;
+
+    /* goal samples are taken here, so they are drawn in thread order */
+    if (!round->stop)
+        for (std::size_t i = 0 ; i < round->goalTargets.size() ; ++i)
+            if (round->goalTargets[i])
+            {
+                if (goal_s->canSample())
+                    goal_s->sampleGoal(round->targets[i]);
+                else
+                    round->goalTargets[i] = false;
+            }
+}
+
 ompl::base::PlannerStatus ompl::geometric::pRRT::solve(const base::PlannerTerminationCondition &ptc)
 {
     checkValidity();
@@ -204,9 +331,21 @@ ompl::base::PlannerStatus ompl::geometric::pRRT::solve(const base::PlannerTermin
     sol.approxsol = NULL;
     sol.approxdif = std::numeric_limits<double>::infinity();
 
+    // in deterministic mode, the threads derive their random streams from this seed and work in rounds
+    RoundInfo round(threadCount_);
+    boost::uint32_t seed = 0;
+    if (deterministic_)
+    {
+        seed = rng_.uniformInt(1, std::numeric_limits<int>::max());
+        OMPL_DEBUG("%s: Deterministic execution with seed %u", getName().c_str(), seed);
+    }
+
     std::vector<boost::thread*> th(threadCount_);
     for (unsigned int i = 0 ; i < threadCount_ ; ++i)
-        th[i] = new boost::thread(boost::bind(&pRRT::threadSolve, this, i, ptc, &sol));
+        if (deterministic_)
+            th[i] = new boost::thread(boost::bind(&pRRT::threadSolveDeterministic, this, i, seed, ptc, &sol, &round));
+        else
+            th[i] = new boost::thread(boost::bind(&pRRT::threadSolve, this, i, ptc, &sol));
     for (unsigned int i = 0 ; i < threadCount_ ; ++i)
     {
         th[i]->join();
@@ -41,6 +41,8 @@
 #include "ompl/base/ProjectionEvaluator.h"
 #include "ompl/datastructures/Grid.h"
 #include "ompl/datastructures/PDF.h"
+#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/thread/mutex.hpp>
 #include <vector>
 
 namespace ompl
@@ -127,6 +129,25 @@ namespace ompl
                 return maxDistance_;
             }
 
+            /** \brief When enabled, the start tree and the goal tree are grown by two separate threads.
+                Each thread is the only one to modify its tree. The motions added to a tree are
+                handed to the other thread through a lock-free queue, and that thread looks for a
+                connection in the grid of its own tree. A candidate connection is validated lazily in
+                two halves: the thread that found it checks the path in its own tree and hands the
+                connection to the other thread, which checks the rest of the path. The state validity
+                checker must then be thread-safe. Disabled by default. */
+            void setParallelTrees(bool flag)
+            {
+                parallelTrees_ = flag;
+                specs_.multithreaded = flag;
+            }
+
+            /** \brief Check whether the trees are grown by separate threads */
+            bool getParallelTrees() const
+            {
+                return parallelTrees_;
+            }
+
             virtual void setup();
 
             virtual base::PlannerStatus solve(const base::PlannerTerminationCondition &ptc);
@@ -208,6 +229,16 @@ namespace ompl
                 CellPDF::Element    *elem_;
             };
 
+            /** \brief A connection of the two trees whose half in one tree is known to be valid */
+            struct Connection
+            {
+                /** \brief The motion whose path to the root is yet to be checked */
+                Motion *motion;
+
+                /** \brief The motion in the other tree whose path to the root is valid. It has the same state as \e motion. */
+                Motion *otherMotion;
+            };
+
             /** \brief Representation of a search tree. Two instances will be used. One for start and one for goal */
             struct TreeData
             {
@@ -223,6 +254,61 @@ namespace ompl
 
                 /** \brief The PDF used for selecting a cell from which to sample a motion */
                 CellPDF          pdf;
+
+                /** \brief When the trees are grown in parallel, the motions added to this tree that the
+                    thread growing the other tree has yet to try to connect to */
+                boost::lockfree::spsc_queue<Motion*, boost::lockfree::capacity<1024> > added;
+
+                /** \brief When the trees are grown in parallel, the connections whose half in this tree is yet to be checked */
+                boost::lockfree::spsc_queue<Connection, boost::lockfree::capacity<64> >  connections;
+
+                /** \brief When the trees are grown in parallel, the connections for the other tree that did not fit in its
+                    queue yet. Only the thread growing this tree accesses them. */
+                std::vector<Connection> pendingConnections;
+
+                /** \brief When the trees are grown in parallel, the motions removed from this tree. The other thread may
+                    still hold pointers to them, so they are only freed once both threads are done. */
+                std::vector<Motion*> removed;
+            };
+
+            /** \brief The outcome of growing the trees in parallel. The flags are shared by the two threads, so they are
+                only accessed under the lock. */
+            struct SolutionInfo
+            {
+                SolutionInfo() : found(false), stop(false)
+                {
+                }
+
+                /** \brief Check whether a solution was found */
+                bool isFound() const
+                {
+                    boost::mutex::scoped_lock slock(lock);
+                    return found;
+                }
+
+                /** \brief Check whether the threads should stop, either because a solution was found or because one of
+                    them cannot continue */
+                bool isDone() const
+                {
+                    boost::mutex::scoped_lock slock(lock);
+                    return found || stop;
+                }
+
+                /** \brief Ask the threads to stop */
+                void requestStop()
+                {
+                    boost::mutex::scoped_lock slock(lock);
+                    stop = true;
+                }
+
+                /** \brief Flag indicating that a solution was found */
+                bool                 found;
+
+                /** \brief Flag indicating that the threads should stop */
+                bool                 stop;
+
+                /** \brief Lock for the flags and for adding the solution path */
+                mutable boost::mutex lock;
             };
 
             /** \brief Free the memory allocated by the planner */
@@ -239,7 +325,32 @@ namespace ompl
             void addMotion(TreeData &tree, Motion *motion);
 
             /** \brief Select a motion from a tree */
-            Motion* selectMotion(TreeData &tree);
+            Motion* selectMotion(RNG &rng, TreeData &tree);
+
+            /** \brief Add a goal state to the goal tree, unless too many goal states were sampled already.
+                Returns false if the goal tree is still empty. */
+            bool addGoalMotion(const base::PlannerTerminationCondition &ptc);
+
+            /** \brief Grow the start tree (if \e start is true) or the goal tree in parallel with the other one */
+            void growTree(bool start, RNG *rng, const base::PlannerTerminationCondition &ptc, SolutionInfo *sol);
+
+            /** \brief Handle what the thread growing the other tree sent: finish the connections whose half in the other tree is
+                valid, and attempt to connect the motions recently added to the other tree */
+            void processOtherTree(bool start, RNG &rng, TreeData &tree, TreeData &otherTree, SolutionInfo *sol);
+
+            /** \brief Attempt to connect \e otherMotion, a motion added to the other tree, to this tree. If the path to the
+                connection is valid in this tree, the connection is handed to the thread growing the other tree (or kept in
+                the pending connections of this tree until there is room in the queue of the other tree). */
+            void connectTrees(RNG &rng, bool start, TreeData &tree, TreeData &otherTree, Motion *otherMotion);
+
+            /** \brief Finish a connection whose half in the other tree is valid. Returns true if the solution path was added. */
+            bool finishConnection(bool start, TreeData &tree, const Connection &connection, SolutionInfo *sol);
+
+            /** \brief Check whether a motion was removed from its tree, while the trees are grown in parallel */
+            bool isRemoved(const Motion *motion) const;
+
+            /** \brief Grow the two trees in parallel until a solution is found */
+            bool solveParallel(const base::PlannerTerminationCondition &ptc);
 
             /** \brief Remove a motion from a tree */
             void removeMotion(TreeData &tree, Motion *motion);
@@ -269,6 +380,9 @@ namespace ompl
             /** \brief The maximum length of a motion to be added in the tree */
             double                                     maxDistance_;
 
+            /** \brief Flag indicating whether the trees are grown by separate threads */
+            bool                                       parallelTrees_;
+
             /** \brief The random number generator to be used */
             RNG                                        rng_;
 
@@ -137,6 +137,41 @@ namespace ompl
                 return threadCount_;
             }
 
+            /** \brief Enable or disable deterministic execution. In
+                deterministic mode every thread draws its random numbers
+                from streams derived from a seed of the planner and the
+                index of the thread, and the threads work in rounds: each
+                thread samples one new state near a motion of the trees
+                built by the previous rounds, and the new states are then
+                added to the trees and connected in the order of the
+                thread indices. Motions found to be invalid are removed at
+                the end of the round, and the termination condition is
+                checked once per round. Calling solve() on planners seeded
+                identically (see setLocalSeed()) then builds the same
+                trees, independent of how the threads are scheduled. */
+            void setDeterministic(bool deterministic)
+            {
+                deterministic_ = deterministic;
+            }
+
+            /** \brief Check whether deterministic execution is enabled */
+            bool getDeterministic() const
+            {
+                return deterministic_;
+            }
+
+            /** \brief Set the seed from which the random streams of the threads are derived in deterministic mode */
+            void setLocalSeed(boost::uint32_t localSeed)
+            {
+                rng_.setLocalSeed(localSeed);
+            }
+
+            /** \brief Get the seed from which the random streams of the threads are derived in deterministic mode */
+            boost::uint32_t getLocalSeed() const
+            {
+                return rng_.getLocalSeed();
+            }
+
             virtual void setup();
 
             virtual base::PlannerStatus solve(const base::PlannerTerminationCondition &ptc);
@@ -242,8 +277,22 @@ namespace ompl
                 boost::mutex                     lock;
             };
 
+            /** \brief The data the threads exchange between rounds in deterministic mode */
+            struct RoundInfo;
+
             void threadSolve(unsigned int tid, const base::PlannerTerminationCondition &ptc, SolutionInfo *sol);
 
+            /** \brief The loop executed by every thread in deterministic mode */
+            void threadSolveDeterministic(unsigned int tid, boost::uint32_t seed, const base::PlannerTerminationCondition &ptc,
+                                          SolutionInfo *sol, RoundInfo *round);
+
+            /** \brief Add the motions of a round to the trees in thread order, look for a connection and remove
+                invalid motions. This is executed by one thread while all the others wait. */
+            void finishRound(const base::PlannerTerminationCondition &ptc, SolutionInfo *sol, RoundInfo *round);
+
+            /** \brief Remove the motions in removeList_ from their trees */
+            void removePendingMotions();
+
             void freeMemory()
             {
                 freeGridMotions(tStart_.grid);
@@ -276,6 +325,12 @@ namespace ompl
 
             /** \brief The pair of states in each tree connected during planning.  Used for PlannerData computation */
             std::pair<base::State*, base::State*>            connectionPoint_;
+
+            /** \brief Flag indicating whether deterministic execution is enabled */
+            bool                                             deterministic_;
+
+            /** \brief The random number generator that seeds the threads in deterministic mode */
+            RNG                                              rng_;
         };
 
     }
@@ -37,6 +37,7 @@
 #include "ompl/geometric/planners/sbl/SBL.h"
 #include "ompl/base/goals/GoalSampleableRegion.h"
 #include "ompl/tools/config/SelfConfig.h"
+#include <boost/thread/thread.hpp>
 #include <limits>
 #include <cassert>
 
@@ -44,9 +45,11 @@ ompl::geometric::SBL::SBL(const base::SpaceInformationPtr &si) : base::Planner(s
 {
     specs_.recognizedGoal = base::GOAL_SAMPLEABLE_REGION;
     maxDistance_ = 0.0;
+    parallelTrees_ = false;
     connectionPoint_ = std::make_pair<base::State*, base::State*>(NULL, NULL);
 
     Planner::declareParam<double>("range", this, &SBL::setRange, &SBL::getRange, "0.:1.:10000.");
+    Planner::declareParam<bool>("parallel_trees", this, &SBL::setParallelTrees, &SBL::getParallelTrees, "0,1");
 }
 
 ompl::geometric::SBL::~SBL()
@@ -115,64 +118,53 @@ ompl::base::PlannerStatus ompl::geometric::SBL::solve(const base::PlannerTermina
 
     OMPL_INFORM("%s: Starting planning with %d states already in datastructure", getName().c_str(), (int)(tStart_.size + tGoal_.size));
 
-    std::vector<Motion*> solution;
-    base::State *xstate = si_->allocState();
-
-    bool      startTree = true;
-    bool         solved = false;
-
-    while (ptc == false)
+    bool solved = false;
+    if (parallelTrees_)
+        solved = solveParallel(ptc);
+    else
     {
-        TreeData &tree      = startTree ? tStart_ : tGoal_;
-        startTree = !startTree;
-        TreeData &otherTree = startTree ? tStart_ : tGoal_;
+        std::vector<Motion*> solution;
+        base::State *xstate = si_->allocState();
 
-        // if we have not sampled too many goals already
-        if (tGoal_.size == 0 || pis_.getSampledGoalsCount() < tGoal_.size / 2)
+        bool      startTree = true;
+
+        while (ptc == false)
         {
-            const base::State *st = tGoal_.size == 0 ? pis_.nextGoal(ptc) : pis_.nextGoal();
-            if (st)
-            {
-                Motion *motion = new Motion(si_);
-                si_->copyState(motion->state, st);
-                motion->root = motion->state;
-                motion->valid = true;
-                addMotion(tGoal_, motion);
-            }
-            if (tGoal_.size == 0)
-            {
-                OMPL_ERROR("%s: Unable to sample any valid states for goal tree", getName().c_str());
+            TreeData &tree      = startTree ? tStart_ : tGoal_;
+            startTree = !startTree;
+            TreeData &otherTree = startTree ? tStart_ : tGoal_;
+
+            if (!addGoalMotion(ptc))
                 break;
-            }
-        }
 
-        Motion *existing = selectMotion(tree);
-        assert(existing);
-        if (!sampler_->sampleNear(xstate, existing->state, maxDistance_))
-            continue;
+            Motion *existing = selectMotion(rng_, tree);
+            assert(existing);
+            if (!sampler_->sampleNear(xstate, existing->state, maxDistance_))
+                continue;
 
-        /* create a motion */
-        Motion *motion = new Motion(si_);
-        si_->copyState(motion->state, xstate);
-        motion->parent = existing;
-        motion->root = existing->root;
-        existing->children.push_back(motion);
+            /* create a motion */
+            Motion *motion = new Motion(si_);
+            si_->copyState(motion->state, xstate);
+            motion->parent = existing;
+            motion->root = existing->root;
+            existing->children.push_back(motion);
 
-        addMotion(tree, motion);
+            addMotion(tree, motion);
 
-        if (checkSolution(!startTree, tree, otherTree, motion, solution))
-        {
-            PathGeometric *path = new PathGeometric(si_);
-            for (unsigned int i = 0 ; i < solution.size() ; ++i)
-                path->append(solution[i]->state);
+            if (checkSolution(!startTree, tree, otherTree, motion, solution))
+            {
+                PathGeometric *path = new PathGeometric(si_);
+                for (unsigned int i = 0 ; i < solution.size() ; ++i)
+                    path->append(solution[i]->state);
 
-            pdef_->addSolutionPath(base::PathPtr(path), false, 0.0, getName());
-            solved = true;
-            break;
+                pdef_->addSolutionPath(base::PathPtr(path), false, 0.0, getName());
+                solved = true;
+                break;
+            }
         }
-    }
 
-    si_->freeState(xstate);
+        si_->freeState(xstate);
+    }
 
     OMPL_INFORM("%s: Created %u (%u start + %u goal) states in %u cells (%u start + %u goal)",
                 getName().c_str(), tStart_.size + tGoal_.size, tStart_.size, tGoal_.size,
@@ -264,10 +256,196 @@ bool ompl::geometric::SBL::isPathValid(TreeData &tree, Motion *motion)
     return true;
 }
 
-ompl::geometric::SBL::Motion* ompl::geometric::SBL::selectMotion(TreeData &tree)
+ompl::geometric::SBL::Motion* ompl::geometric::SBL::selectMotion(RNG &rng, TreeData &tree)
 {
-    GridCell* cell = tree.pdf.sample(rng_.uniform01());
-    return cell && !cell->data.empty() ? cell->data[rng_.uniformInt(0, cell->data.size() - 1)] : NULL;
+    GridCell* cell = tree.pdf.sample(rng.uniform01());
+    return cell && !cell->data.empty() ? cell->data[rng.uniformInt(0, cell->data.size() - 1)] : NULL;
+}
+
+bool ompl::geometric::SBL::addGoalMotion(const base::PlannerTerminationCondition &ptc)
+{
+    // if we have not sampled too many goals already
+    if (tGoal_.size == 0 || pis_.getSampledGoalsCount() < tGoal_.size / 2)
+    {
+        const base::State *st = tGoal_.size == 0 ? pis_.nextGoal(ptc) : pis_.nextGoal();
+        if (st)
+        {
+            Motion *motion = new Motion(si_);
+            si_->copyState(motion->state, st);
+            motion->root = motion->state;
+            motion->valid = true;
+            addMotion(tGoal_, motion);
+        }
+        if (tGoal_.size == 0)
+        {
+            OMPL_ERROR("%s: Unable to sample any valid states for goal tree", getName().c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ompl::geometric::SBL::solveParallel(const base::PlannerTerminationCondition &ptc)
+{
+    SolutionInfo sol;
+
+    // the generators are seeded here so that their seeds do not depend on thread scheduling
+    RNG startRng, goalRng;
+    boost::thread goalThread(boost::bind(&SBL::growTree, this, false, &goalRng, ptc, &sol));
+    growTree(true, &startRng, ptc, &sol);
+    goalThread.join();
+
+    // the other thread is done, so the removed motions can be freed
+    TreeData *trees[2] = { &tStart_, &tGoal_ };
+    for (unsigned int t = 0 ; t < 2 ; ++t)
+    {
+        for (std::size_t i = 0 ; i < trees[t]->removed.size() ; ++i)
+        {
+            si_->freeState(trees[t]->removed[i]->state);
+            delete trees[t]->removed[i];
+        }
+        trees[t]->removed.clear();
+        trees[t]->added.reset();
+        trees[t]->connections.reset();
+        trees[t]->pendingConnections.clear();
+    }
+
+    return sol.isFound();
+}
+
+void ompl::geometric::SBL::growTree(bool start, RNG *rng, const base::PlannerTerminationCondition &ptc, SolutionInfo *sol)
+{
+    TreeData &tree      = start ? tStart_ : tGoal_;
+    TreeData &otherTree = start ? tGoal_ : tStart_;
+
+    base::ValidStateSamplerPtr sampler = start ? sampler_ : si_->allocValidStateSampler();
+    base::State *xstate = si_->allocState();
+
+    while (!sol->isDone() && ptc == false)
+    {
+        processOtherTree(start, *rng, tree, otherTree, sol);
+
+        if (!start && !addGoalMotion(ptc))
+        {
+            sol->requestStop();
+            break;
+        }
+
+        Motion *existing = selectMotion(*rng, tree);
+        assert(existing);
+        if (!sampler->sampleNear(xstate, existing->state, maxDistance_))
+            continue;
+
+        /* create a motion */
+        Motion *motion = new Motion(si_);
+        si_->copyState(motion->state, xstate);
+        motion->parent = existing;
+        motion->root = existing->root;
+        existing->children.push_back(motion);
+
+        addMotion(tree, motion);
+
+        // if the other thread falls behind, keep its queue moving instead of growing this tree further, unless it
+        // stopped and will never drain the queue
+        while (!tree.added.push(motion) && !sol->isDone() && ptc == false)
+        {
+            processOtherTree(start, *rng, tree, otherTree, sol);
+            boost::this_thread::yield();
+        }
+    }
+
+    si_->freeState(xstate);
+}
+
+void ompl::geometric::SBL::processOtherTree(bool start, RNG &rng, TreeData &tree, TreeData &otherTree, SolutionInfo *sol)
+{
+    // hand over the connections that did not fit in the queue of the other tree before
+    std::size_t sent = 0;
+    while (sent < tree.pendingConnections.size() && otherTree.connections.push(tree.pendingConnections[sent]))
+        ++sent;
+    tree.pendingConnections.erase(tree.pendingConnections.begin(), tree.pendingConnections.begin() + sent);
+
+    // finish the connections whose half in the other tree is valid
+    Connection connection;
+    while (!sol->isFound() && tree.connections.pop(connection))
+        finishConnection(start, tree, connection, sol);
+
+    // try to connect the motions recently added to the other tree
+    Motion *otherMotion;
+    while (!sol->isFound() && otherTree.added.pop(otherMotion))
+        connectTrees(rng, start, tree, otherTree, otherMotion);
+}
+
+void ompl::geometric::SBL::connectTrees(RNG &rng, bool start, TreeData &tree, TreeData &otherTree, Motion *otherMotion)
+{
+    // otherMotion may have been removed from the other tree since, but its memory is still valid and
+    // its state and root do not change
+    Grid<MotionInfo>::Coord coord;
+    projectionEvaluator_->computeCoordinates(otherMotion->state, coord);
+    Grid<MotionInfo>::Cell* cell = tree.grid.getCell(coord);
+    if (!cell || cell->data.empty())
+        return;
+
+    Motion *motion = cell->data[rng.uniformInt(0, cell->data.size() - 1)];
+    if (!pdef_->getGoal()->isStartGoalPairValid(start ? motion->root : otherMotion->root, start ? otherMotion->root : motion->root))
+        return;
+
+    Motion *connect = new Motion(si_);
+    si_->copyState(connect->state, otherMotion->state);
+    connect->parent = motion;
+    connect->root = motion->root;
+    motion->children.push_back(connect);
+    addMotion(tree, connect);
+
+    if (isPathValid(tree, connect))
+    {
+        Connection c;
+        c.motion = otherMotion;
+        c.otherMotion = connect;
+        // keep the order of the connections if some are already waiting for room in the queue
+        if (!tree.pendingConnections.empty() || !otherTree.connections.push(c))
+            tree.pendingConnections.push_back(c);
+    }
+}
+
+bool ompl::geometric::SBL::finishConnection(bool start, TreeData &tree, const Connection &connection, SolutionInfo *sol)
+{
+    if (isRemoved(connection.motion) || !isPathValid(tree, connection.motion))
+        return false;
+
+    // the motions on the valid half in the other tree are never removed, so they can be read here
+    std::vector<Motion*> mpath1;
+    for (Motion *m = connection.motion ; m != NULL ; m = m->parent)
+        mpath1.push_back(m);
+
+    std::vector<Motion*> mpath2;
+    for (Motion *m = connection.otherMotion->parent ; m != NULL ; m = m->parent)
+        mpath2.push_back(m);
+
+    if (!start)
+        mpath1.swap(mpath2);
+
+    boost::mutex::scoped_lock slock(sol->lock);
+    if (sol->found)
+        return false;
+    sol->found = true;
+    connectionPoint_ = std::make_pair(mpath1.front()->state, mpath2.front()->state);
+
+    PathGeometric *path = new PathGeometric(si_);
+    for (int i = mpath1.size() - 1 ; i >= 0 ; --i)
+        path->append(mpath1[i]->state);
+    for (std::size_t i = 0 ; i < mpath2.size() ; ++i)
+        path->append(mpath2[i]->state);
+    pdef_->addSolutionPath(base::PathPtr(path), false, 0.0, getName());
+    return true;
+}
+
+bool ompl::geometric::SBL::isRemoved(const Motion *motion) const
+{
+    // removed motions are detached from their parent, so they do not lead to a root
+    while (motion->parent)
+        motion = motion->parent;
+    return motion->state != motion->root;
 }
 
 void ompl::geometric::SBL::removeMotion(TreeData &tree, Motion *motion)
@@ -321,6 +499,14 @@ void ompl::geometric::SBL::removeMotion(TreeData &tree, Motion *motion)
         removeMotion(tree, motion->children[i]);
     }
 
+    if (parallelTrees_)
+    {
+        // the thread growing the other tree may still hold a pointer to this motion
+        motion->parent = NULL;
+        tree.removed.push_back(motion);
+        return;
+    }
+
     if (motion->state)
         si_->freeState(motion->state);
     delete motion;
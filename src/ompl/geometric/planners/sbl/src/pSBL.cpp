@@ -38,9 +38,34 @@
 #include "ompl/base/goals/GoalState.h"
 #include "ompl/tools/config/SelfConfig.h"
 #include <boost/thread.hpp>
+#include <boost/thread/barrier.hpp>
 #include <limits>
 #include <cassert>
 
+struct ompl::geometric::pSBL::RoundInfo
+{
+    RoundInfo(unsigned int threadCount) : barrier(threadCount), rngs(threadCount, NULL), motions(threadCount, NULL),
+                                         startTree(threadCount, false), stop(false)
+    {
+    }
+
+    /** \brief Separates the parallel part of a round from finishRound() */
+    boost::barrier       barrier;
+
+    /** \brief The random number generator of each thread, also used for the connection attempts in finishRound() */
+    std::vector<RNG*>    rngs;
+
+    /** \brief The motion each thread sampled in the current round (NULL if sampling failed) */
+    std::vector<Motion*> motions;
+
+    /** \brief Flags indicating whether the motion of each thread extends the start tree
+        (not std::vector<bool>, as the threads set their flags concurrently) */
+    std::vector<char>    startTree;
+
+    /** \brief Flag set by finishRound() when the threads are to stop */
+    bool                 stop;
+};
+
 ompl::geometric::pSBL::pSBL(const base::SpaceInformationPtr &si) : base::Planner(si, "pSBL"),
                                                                    samplerArray_(si)
 {
@@ -49,9 +74,11 @@ ompl::geometric::pSBL::pSBL(const base::SpaceInformationPtr &si) : base::Planner
     maxDistance_ = 0.0;
     setThreadCount(2);
     connectionPoint_ = std::make_pair<base::State*, base::State*>(NULL, NULL);
+    deterministic_ = false;
 
     Planner::declareParam<double>("range", this, &pSBL::setRange, &pSBL::getRange, "0.:1.:10000.");
     Planner::declareParam<unsigned int>("thread_count", this, &pSBL::setThreadCount, &pSBL::getThreadCount, "1:64");
+    Planner::declareParam<bool>("deterministic", this, &pSBL::setDeterministic, &pSBL::getDeterministic, "0,1");
 }
 
 ompl::geometric::pSBL::~pSBL()
@@ -122,11 +149,7 @@ void ompl::geometric::pSBL::threadSolve(unsigned int tid, const base::PlannerTer
                 if (loopLock_.try_lock())
                 {
                     retry = false;
-                    std::map<Motion*, bool> seen;
-                    for (unsigned int i = 0 ; i < removeList_.motions.size() ; ++i)
-                        if (seen.find(removeList_.motions[i].motion) == seen.end())
-                            removeMotion(*removeList_.motions[i].tree, removeList_.motions[i].motion, seen);
-                    removeList_.motions.clear();
+                    removePendingMotions();
                     loopLock_.unlock();
                 }
             }
@@ -190,6 +213,87 @@ void ompl::geometric::pSBL::threadSolve(unsigned int tid, const base::PlannerTer
     si_->freeState(xstate);
 }
 
+void ompl::geometric::pSBL::threadSolveDeterministic(unsigned int tid, boost::uint32_t seed, const base::PlannerTerminationCondition &ptc,
+                                                     SolutionInfo *sol, RoundInfo *round)
+{
+    // the sampler and the RNG of this thread are seeded from (seed, tid) only
+    RNG::ScopedSeed           scope(seed, tid);
+    base::ValidStateSamplerPtr sampler = si_->allocValidStateSampler();
+    RNG                       rng;
+    round->rngs[tid] = &rng;
+
+    base::State *xstate = si_->allocState();
+    bool      startTree = rng.uniformBool();
+
+    while (true)
+    {
+        /* the trees do not change during this part of the round */
+        TreeData &tree = startTree ? tStart_ : tGoal_;
+        round->startTree[tid] = startTree;
+        round->motions[tid] = NULL;
+        startTree = !startTree;
+
+        Motion *existing = selectMotion(rng, tree);
+        if (sampler->sampleNear(xstate, existing->state, maxDistance_))
+        {
+            /* create a motion; finishRound() adds it to the tree */
+            Motion *motion = new Motion(si_);
+            si_->copyState(motion->state, xstate);
+            motion->parent = existing;
+            motion->root = existing->root;
+            round->motions[tid] = motion;
+        }
+
+        if (round->barrier.wait())
+            finishRound(ptc, sol, round);
+        round->barrier.wait();
+        if (round->stop)
+            break;
+    }
+
+    si_->freeState(xstate);
+}
+
+void ompl::geometric::pSBL::finishRound(const base::PlannerTerminationCondition &ptc, SolutionInfo *sol, RoundInfo *round)
+{
+    std::vector<Motion*> solution;
+    for (std::size_t i = 0 ; i < round->motions.size() ; ++i)
+    {
+        Motion *motion = round->motions[i];
+        if (!motion)
+            continue;
+
+        TreeData &tree      = round->startTree[i] ? tStart_ : tGoal_;
+        TreeData &otherTree = round->startTree[i] ? tGoal_ : tStart_;
+
+        motion->parent->children.push_back(motion);
+        addMotion(tree, motion);
+
+        if (!sol->found && checkSolution(*round->rngs[i], round->startTree[i], tree, otherTree, motion, solution))
+        {
+            sol->found = true;
+            PathGeometric *path = new PathGeometric(si_);
+            for (unsigned int j = 0 ; j < solution.size() ; ++j)
+                path->append(solution[j]->state);
+            pdef_->addSolutionPath(base::PathPtr(path), false, 0.0, getName());
+        }
+    }
+
+    // motions are removed only now, as the parents of the motions above may be among them
+    removePendingMotions();
+
+    round->stop = sol->found || ptc;
+}
+
+void ompl::geometric::pSBL::removePendingMotions()
+{
+    std::map<Motion*, bool> seen;
+    for (unsigned int i = 0 ; i < removeList_.motions.size() ; ++i)
+        if (seen.find(removeList_.motions[i].motion) == seen.end())
+            removeMotion(*removeList_.motions[i].tree, removeList_.motions[i].motion, seen);
+    removeList_.motions.clear();
+}
+
 ompl::base::PlannerStatus ompl::geometric::pSBL::solve(const base::PlannerTerminationCondition &ptc)
 {
     checkValidity();
@@ -244,9 +348,21 @@ ompl::base::PlannerStatus ompl::geometric::pSBL::solve(const base::PlannerTermin
     sol.found = false;
     loopCounter_ = 0;
 
+    // in deterministic mode, the threads derive their random streams from this seed and work in rounds
+    RoundInfo round(threadCount_);
+    boost::uint32_t seed = 0;
+    if (deterministic_)
+    {
+        seed = rng_.uniformInt(1, std::numeric_limits<int>::max());
+        OMPL_DEBUG("%s: Deterministic execution with seed %u", getName().c_str(), seed);
+    }
+
     std::vector<boost::thread*> th(threadCount_);
     for (unsigned int i = 0 ; i < threadCount_ ; ++i)
-        th[i] = new boost::thread(boost::bind(&pSBL::threadSolve, this, i, ptc, &sol));
+        if (deterministic_)
+            th[i] = new boost::thread(boost::bind(&pSBL::threadSolveDeterministic, this, i, seed, ptc, &sol, &round));
+        else
+            th[i] = new boost::thread(boost::bind(&pSBL::threadSolve, this, i, ptc, &sol));
     for (unsigned int i = 0 ; i < threadCount_ ; ++i)
     {
         th[i]->join();
@@ -40,10 +40,13 @@
 #include "ompl/datastructures/Grid.h"
 #include "ompl/geometric/planners/PlannerIncludes.h"
 #include "ompl/base/ProjectionEvaluator.h"
+#include "ompl/base/MappedStateStorage.h"
 #include "ompl/datastructures/PDF.h"
 #include <boost/unordered_map.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <vector>
+#include <limits>
+#include <string>
 
 namespace ompl
 {
@@ -69,6 +72,12 @@ namespace ompl
           has the advantage over the EST implementation that no grid
           cell sizes have to be specified.
 
+          For very long runs, the states in the leaves of the GNAT that
+          were not used recently can be moved to a memory-mapped file (see
+          setMaxResidentLeaves()). The pivots of the GNAT and the statistics
+          used for density estimation stay in memory, so only the leaves
+          that are sampled from or visited by a query are read back.
+
           @par External documentation
           B. Gipson, M. Moll, and L.E. Kavraki, Resolution independent density
           estimation for motion planning in high-dimensional spaces, in
@@ -234,6 +243,39 @@ namespace ompl
                     return projectionEvaluator_;
                 }
 
+                /** \brief Keep the states of at most \e maxResidentLeaves leaves
+                  of the GNAT in memory; the states in the other leaves are
+                  moved to a memory-mapped file (see base::MappedStateStorage).
+                  The default, 0, keeps all states in memory. The state space
+                  must support serialization. getPlannerData() reads the
+                  states that are out of memory from the file and returns
+                  planner data that owns copies of all its states. This setting takes
+                  effect the next time the planner is set up or cleared. */
+                void setMaxResidentLeaves(unsigned int maxResidentLeaves)
+                {
+                    maxResidentLeaves_ = maxResidentLeaves;
+                }
+
+                /** \brief Get the maximum number of leaves of the GNAT whose states are kept in memory */
+                unsigned int getMaxResidentLeaves() const
+                {
+                    return maxResidentLeaves_;
+                }
+
+                /** \brief Set the file the states moved out of memory are written to
+                  (by default, a new file in the temporary directory of the system).
+                  The file is removed when the planner is cleared or destroyed. */
+                void setSpillFilename(const std::string &filename)
+                {
+                    spillFilename_ = filename;
+                }
+
+                /** \brief Get the file the states moved out of memory are written to */
+                const std::string& getSpillFilename() const
+                {
+                    return spillFilename_;
+                }
+
                 virtual void getPlannerData(base::PlannerData &data) const;
 
             protected:
@@ -242,12 +284,13 @@ namespace ompl
                 class Motion
                 {
                 public:
-                    Motion() : state(NULL), parent(NULL)
+                    Motion() : state(NULL), parent(NULL), storageIndex(std::numeric_limits<std::size_t>::max())
                     {
                     }
 
                     /** \brief Constructor that allocates memory for the state */
-                    Motion(const base::SpaceInformationPtr &si) : state(si->allocState()), parent(NULL)
+                    Motion(const base::SpaceInformationPtr &si) : state(si->allocState()), parent(NULL),
+                        storageIndex(std::numeric_limits<std::size_t>::max())
                     {
                     }
 
@@ -260,6 +303,10 @@ namespace ompl
 
                     /** \brief The parent motion in the exploration tree */
                     Motion            *parent;
+
+                    /** \brief The index of the state in the memory-mapped file, if it was ever written there.
+                      The state is NULL while it is out of memory. */
+                    std::size_t        storageIndex;
                 };
 
 
@@ -285,6 +332,15 @@ namespace ompl
                     return boost::numeric::ublas::norm_2(aproj - bproj);
                 }
 
+                /** \brief Move the states of the motions in a leaf of the GNAT to the memory-mapped file */
+                void spillMotions(const std::vector<Motion*> &motions);
+
+                /** \brief Bring the states of the motions in a spilled leaf of the GNAT back into memory */
+                void loadMotions(const std::vector<Motion*> &motions);
+
+                /** \brief Return the state of \e motion, reading it into \e scratch if it is out of memory */
+                const base::State* getMotionState(const Motion *motion, base::State *scratch) const;
+
                 /** \brief Add a motion to the exploration tree */
                 void addMotion(Motion *motion);
 
@@ -328,6 +384,16 @@ namespace ompl
 
                 /** \brief The random number generator */
                 RNG                          rng_;
+
+                /** \brief Maximum number of leaves of the GNAT whose states are kept in memory (0 means no limit) */
+                unsigned int                 maxResidentLeaves_;
+
+                /** \brief The file states are moved to (a temporary file if empty) */
+                std::string                  spillFilename_;
+
+                /** \brief The states moved out of memory */
+                boost::scoped_ptr<base::MappedStateStorage>
+                                             storage_;
         };
 
     }
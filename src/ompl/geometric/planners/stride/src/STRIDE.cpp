@@ -41,6 +41,7 @@
 #include "ompl/base/goals/GoalSampleableRegion.h"
 #include "ompl/tools/config/SelfConfig.h"
 #include <limits>
+#include <map>
 #include <cassert>
 
 ompl::geometric::STRIDE::STRIDE(const base::SpaceInformationPtr &si,
@@ -51,7 +52,7 @@ ompl::geometric::STRIDE::STRIDE(const base::SpaceInformationPtr &si,
     useProjectedDistance_(useProjectedDistance),
     degree_(degree), minDegree_(minDegree), maxDegree_(maxDegree),
     maxNumPtsPerLeaf_(maxNumPtsPerLeaf), estimatedDimension_(estimatedDimension),
-    minValidPathFraction_(0.2)
+    minValidPathFraction_(0.2), maxResidentLeaves_(0)
 {
     specs_.approximateSolutions = true;
 
@@ -67,6 +68,7 @@ ompl::geometric::STRIDE::STRIDE(const base::SpaceInformationPtr &si,
     Planner::declareParam<unsigned int>("max_pts_per_leaf", this, &STRIDE::setMaxNumPtsPerLeaf, &STRIDE::getMaxNumPtsPerLeaf, "1:200");
     Planner::declareParam<double>("estimated_dimension", this, &STRIDE::setEstimatedDimension, &STRIDE::getEstimatedDimension, "1.:30.");
     Planner::declareParam<double>("min_valid_path_fraction", this, &STRIDE::setMinValidPathFraction, &STRIDE::getMinValidPathFraction, "0.:.05:1.");
+    Planner::declareParam<unsigned int>("max_resident_leaves", this, &STRIDE::setMaxResidentLeaves, &STRIDE::getMaxResidentLeaves, "0:1000000");
 }
 
 ompl::geometric::STRIDE::~STRIDE()
@@ -90,6 +92,12 @@ void ompl::geometric::STRIDE::setupTree()
         tree_->setDistanceFunction(boost::bind(&STRIDE::projectedDistanceFunction, this, _1, _2));
     else
         tree_->setDistanceFunction(boost::bind(&STRIDE::distanceFunction, this, _1, _2));
+    if (maxResidentLeaves_)
+    {
+        storage_.reset(new base::MappedStateStorage(si_->getStateSpace(), spillFilename_));
+        tree_->setLeafSpilling(maxResidentLeaves_, boost::bind(&STRIDE::spillMotions, this, _1),
+                               boost::bind(&STRIDE::loadMotions, this, _1));
+    }
 }
 
 void ompl::geometric::STRIDE::clear()
@@ -114,6 +122,7 @@ void ompl::geometric::STRIDE::freeMemory()
         }
         tree_.reset();
     }
+    storage_.reset();
 }
 
 ompl::base::PlannerStatus ompl::geometric::STRIDE::solve(const base::PlannerTerminationCondition &ptc)
@@ -168,9 +177,10 @@ ompl::base::PlannerStatus ompl::geometric::STRIDE::solve(const base::PlannerTerm
             si_->copyState(motion->state, xstate);
             motion->parent = existing;
 
-            addMotion(motion);
+            // the state of the new motion may be spilled as soon as it is added
             double dist = 0.0;
             bool solved = goal->isSatisfied(motion->state, &dist);
+            addMotion(motion);
             if (solved)
             {
                 approxdif = dist;
@@ -206,7 +216,7 @@ ompl::base::PlannerStatus ompl::geometric::STRIDE::solve(const base::PlannerTerm
         /* set the solution path */
         PathGeometric *path = new PathGeometric(si_);
         for (int i = mpath.size() - 1 ; i >= 0 ; --i)
-            path->append(mpath[i]->state);
+            path->append(getMotionState(mpath[i], xstate));
         pdef_->addSolutionPath(base::PathPtr(path), approximate, approxdif, getName());
         solved = true;
     }
@@ -218,6 +228,41 @@ ompl::base::PlannerStatus ompl::geometric::STRIDE::solve(const base::PlannerTerm
     return base::PlannerStatus(solved, approximate);
 }
 
+void ompl::geometric::STRIDE::spillMotions(const std::vector<Motion*> &motions)
+{
+    for (std::size_t i = 0 ; i < motions.size() ; ++i)
+    {
+        Motion *motion = motions[i];
+        if (!motion->state)
+            continue;
+        // states never change, so each one is written only once
+        if (motion->storageIndex == std::numeric_limits<std::size_t>::max())
+            motion->storageIndex = storage_->store(motion->state);
+        si_->freeState(motion->state);
+        motion->state = NULL;
+    }
+}
+
+void ompl::geometric::STRIDE::loadMotions(const std::vector<Motion*> &motions)
+{
+    for (std::size_t i = 0 ; i < motions.size() ; ++i)
+    {
+        Motion *motion = motions[i];
+        if (motion->state)
+            continue;
+        motion->state = si_->allocState();
+        storage_->load(motion->storageIndex, motion->state);
+    }
+}
+
+const ompl::base::State* ompl::geometric::STRIDE::getMotionState(const Motion *motion, base::State *scratch) const
+{
+    if (motion->state)
+        return motion->state;
+    storage_->load(motion->storageIndex, scratch);
+    return scratch;
+}
+
 void ompl::geometric::STRIDE::addMotion(Motion *motion)
 {
     tree_->add(motion);
@@ -234,11 +279,36 @@ void ompl::geometric::STRIDE::getPlannerData(base::PlannerData &data) const
 
     std::vector<Motion*> motions;
     tree_->list(motions);
+
+    // read the states of spilled motions from the file instead of loading
+    // their leaves back into the tree; they only need to live until data
+    // has copied them
+    std::map<const Motion*, base::State*> spilledStates;
+    for (std::vector<Motion*>::iterator it=motions.begin(); it!=motions.end(); it++)
+        if (!(*it)->state)
+        {
+            base::State *state = si_->allocState();
+            storage_->load((*it)->storageIndex, state);
+            spilledStates[*it] = state;
+        }
+
     for (std::vector<Motion*>::iterator it=motions.begin(); it!=motions.end(); it++)
     {
+        const base::State *state = (*it)->state ? (*it)->state : spilledStates[*it];
         if((*it)->parent == NULL)
-            data.addStartVertex(base::PlannerDataVertex((*it)->state,1));
+            data.addStartVertex(base::PlannerDataVertex(state,1));
         else
-            data.addEdge(base::PlannerDataVertex((*it)->parent->state,1),base::PlannerDataVertex((*it)->state,1));
+        {
+            const Motion *parent = (*it)->parent;
+            const base::State *parentState = parent->state ? parent->state : spilledStates[parent];
+            data.addEdge(base::PlannerDataVertex(parentState,1),base::PlannerDataVertex(state,1));
+        }
     }
+
+    // resident states may be spilled and freed by the next call to solve(),
+    // so the data keeps its own copies whenever spilling is enabled
+    if (tree_->getMaxResidentLeaves())
+        data.decoupleFromPlanner();
+    for (std::map<const Motion*, base::State*>::iterator it = spilledStates.begin() ; it != spilledStates.end() ; ++it)
+        si_->freeState(it->second);
 }
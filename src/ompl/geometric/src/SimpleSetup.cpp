@@ -36,6 +36,8 @@
 
 #include "ompl/geometric/SimpleSetup.h"
 #include "ompl/tools/config/SelfConfig.h"
+#include "ompl/base/goals/GoalState.h"
+#include "ompl/base/goals/GoalStates.h"
 
 ompl::base::PlannerPtr ompl::geometric::getDefaultPlanner(const base::GoalPtr &goal)
 {
@@ -43,7 +45,8 @@ ompl::base::PlannerPtr ompl::geometric::getDefaultPlanner(const base::GoalPtr &g
 }
 
 ompl::geometric::SimpleSetup::SimpleSetup(const base::SpaceInformationPtr &si) :
-    configured_(false), planTime_(0.0), simplifyTime_(0.0), lastStatus_(base::PlannerStatus::UNKNOWN)
+    configured_(false), planTime_(0.0), simplifyTime_(0.0), lastStatus_(base::PlannerStatus::UNKNOWN),
+    warmStart_(false), lastGoalThreshold_(0.0)
 {
     si_ = si;
     pdef_.reset(new base::ProblemDefinition(si_));
@@ -51,13 +54,19 @@ ompl::geometric::SimpleSetup::SimpleSetup(const base::SpaceInformationPtr &si) :
 }
 
 ompl::geometric::SimpleSetup::SimpleSetup(const base::StateSpacePtr &space) :
-    configured_(false), planTime_(0.0), simplifyTime_(0.0), lastStatus_(base::PlannerStatus::UNKNOWN)
+    configured_(false), planTime_(0.0), simplifyTime_(0.0), lastStatus_(base::PlannerStatus::UNKNOWN),
+    warmStart_(false), lastGoalThreshold_(0.0)
 {
     si_.reset(new base::SpaceInformation(space));
     pdef_.reset(new base::ProblemDefinition(si_));
     psk_.reset(new PathSimplifier(si_));
 }
 
+ompl::geometric::SimpleSetup::~SimpleSetup()
+{
+    freeStoredQuery();
+}
+
 void ompl::geometric::SimpleSetup::setup()
 {
     if (!configured_ || !si_->isSetup() || !planner_->isSetup())
@@ -87,12 +96,93 @@ void ompl::geometric::SimpleSetup::clear()
         planner_->clear();
     if (pdef_)
         pdef_->clearSolutionPaths();
+    freeStoredQuery();
+}
+
+void ompl::geometric::SimpleSetup::environmentChanged()
+{
+    clear();
+    tools::SelfConfig::clearEstimateCache();
+}
+
+void ompl::geometric::SimpleSetup::prepareWarmStart()
+{
+    if (!warmStart_ || !lastGoal_ || !planner_->isSetup())
+        return;
+
+    bool changed = pdef_->getGoal() != lastGoal_ || pdef_->getStartStateCount() != lastStartStates_.size();
+    for (unsigned int i = 0 ; !changed && i < lastStartStates_.size() ; ++i)
+        changed = !si_->equalStates(pdef_->getStartState(i), lastStartStates_[i]);
+    if (!changed)
+    {
+        // the goal may have been changed in place
+        std::vector<const base::State*> goalStates;
+        double threshold;
+        getGoalSnapshot(goalStates, threshold);
+        changed = threshold != lastGoalThreshold_ || goalStates.size() != lastGoalStates_.size();
+        for (unsigned int i = 0 ; !changed && i < lastGoalStates_.size() ; ++i)
+            changed = !si_->equalStates(goalStates[i], lastGoalStates_[i]);
+    }
+
+    if (changed)
+    {
+        OMPL_INFORM("SimpleSetup: Planning query changed. Reusing planning data computed for previous queries.");
+        pdef_->clearSolutionPaths();
+        planner_->clearQuery();
+        if (!planner_->isSetup())
+            planner_->setup();
+    }
+}
+
+void ompl::geometric::SimpleSetup::storeQuery()
+{
+    freeStoredQuery();
+    for (unsigned int i = 0 ; i < pdef_->getStartStateCount() ; ++i)
+        lastStartStates_.push_back(si_->cloneState(pdef_->getStartState(i)));
+    lastGoal_ = pdef_->getGoal();
+    std::vector<const base::State*> goalStates;
+    getGoalSnapshot(goalStates, lastGoalThreshold_);
+    for (unsigned int i = 0 ; i < goalStates.size() ; ++i)
+        lastGoalStates_.push_back(si_->cloneState(goalStates[i]));
+}
+
+void ompl::geometric::SimpleSetup::getGoalSnapshot(std::vector<const base::State*> &states, double &threshold) const
+{
+    states.clear();
+    threshold = 0.0;
+    const base::GoalPtr &goal = pdef_->getGoal();
+    if (!goal)
+        return;
+    if (goal->hasType(base::GOAL_REGION))
+        threshold = goal->as<base::GoalRegion>()->getThreshold();
+    if (goal->hasType(base::GOAL_STATE))
+        states.push_back(goal->as<base::GoalState>()->getState());
+    // lazily sampled goal states are expected to change while planning
+    else if (goal->hasType(base::GOAL_STATES) && !goal->hasType(base::GOAL_LAZY_SAMPLES))
+    {
+        const base::GoalStates *goalStates = goal->as<base::GoalStates>();
+        for (unsigned int i = 0 ; i < goalStates->getStateCount() ; ++i)
+            states.push_back(goalStates->getState(i));
+    }
+}
+
+void ompl::geometric::SimpleSetup::freeStoredQuery()
+{
+    for (unsigned int i = 0 ; i < lastStartStates_.size() ; ++i)
+        si_->freeState(lastStartStates_[i]);
+    lastStartStates_.clear();
+    lastGoal_.reset();
+    for (unsigned int i = 0 ; i < lastGoalStates_.size() ; ++i)
+        si_->freeState(lastGoalStates_[i]);
+    lastGoalStates_.clear();
 }
 
 // we provide a duplicate implementation here to allow the planner to choose how the time is turned into a planner termination condition
 ompl::base::PlannerStatus ompl::geometric::SimpleSetup::solve(double time)
 {
     setup();
+    prepareWarmStart();
+    storeQuery();
     lastStatus_ = base::PlannerStatus::UNKNOWN;
     time::point start = time::now();
     lastStatus_ = planner_->solve(time);
@@ -107,6 +197,8 @@ ompl::base::PlannerStatus ompl::geometric::SimpleSetup::solve(double time)
 ompl::base::PlannerStatus ompl::geometric::SimpleSetup::solve(const base::PlannerTerminationCondition &ptc)
 {
     setup();
+    prepareWarmStart();
+    storeQuery();
     lastStatus_ = base::PlannerStatus::UNKNOWN;
     time::point start = time::now();
     lastStatus_ = planner_->solve(ptc);
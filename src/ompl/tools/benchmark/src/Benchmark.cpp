@@ -89,13 +89,7 @@ namespace ompl
                 boost::thread t(boost::bind(&RunPlanner::runThread, this, planner, memStart + maxMem, time::seconds(maxTime), time::seconds(timeBetweenUpdates)));
 
                 // allow 25% more time than originally specified, in order to detect planner termination
-#if BOOST_VERSION < 105000
-                // For older versions of boost, we have to use this
-                // deprecated form of the timed join
-                if (!t.timed_join(time::seconds(maxTime * 1.25)))
-#else
                 if (!t.try_join_for(boost::chrono::duration<double>(maxTime * 1.25)))
-#endif
                 {
                     status_ = base::PlannerStatus::CRASH;
 
@@ -643,6 +637,9 @@ void ompl::tools::Benchmark::benchmark(const Request &req)
                 planners_[i]->getPlannerData(pd);
                 run["graph states INTEGER"] = boost::lexical_cast<std::string>(pd.numVertices());
                 run["graph motions INTEGER"] = boost::lexical_cast<std::string>(pd.numEdges());
+                // the planner data has not been decoupled, so the states it refers to are added to the estimate
+                run["graph memory INTEGER"] = boost::lexical_cast<std::string>(pd.getMemoryUsage() +
+                    pd.numVertices() * pd.getSpaceInformation()->getStateSpace()->getStateMemoryUsage());
 
                 for (std::map<std::string, std::string>::const_iterator it = pd.properties.begin() ; it != pd.properties.end() ; ++it)
                     run[it->first] = it->second;
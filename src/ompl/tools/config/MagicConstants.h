@@ -108,6 +108,38 @@ namespace ompl
             samples are generated. */
         static const unsigned int TEST_STATE_COUNT = 1000;
 
+        /** \brief When informed samplers generate states in batches,
+            the number of candidates drawn is the number of states
+            still required divided by the acceptance rate measured on
+            the previous batch. The acceptance rate is clamped below by
+            this value to bound the size of a single draw. */
+        static const double MIN_BATCH_ACCEPTANCE_RATE = 0.1;
+
+        /** \brief When optimization objectives cache state costs,
+            the cache holds at most this many states. The least
+            recently used entries are evicted first, which bounds the
+            memory used by entries of states that have since been
+            freed. */
+        static const unsigned int MAX_STATE_COST_CACHE_SIZE = 100000;
+
+        /** \brief The number of independently locked shards the
+            state cost cache of an optimization objective is split
+            into. Each shard holds at most
+            MAX_STATE_COST_CACHE_SIZE / STATE_COST_CACHE_SHARDS
+            states. */
+        static const unsigned int STATE_COST_CACHE_SHARDS = 16;
+
+        /** \brief When sparse roadmaps are constructed with multiple
+            threads, each thread evaluates this many candidate samples
+            before the candidates are added to the roadmap in order. */
+        static const unsigned int SPARSE_ROADMAP_CANDIDATES_PER_THREAD = 8;
+
+        /** \brief When the temperature of TRRT is adapted to the
+            cost increase of an accepted transition, a cost increase
+            of this fraction of the range of state costs in the tree
+            lowers the temperature by the temperature change factor. */
+        static const double TRRT_ADAPTIVE_TEMPERATURE_COST_FRACTION = 0.1;
+
     }
 }
 
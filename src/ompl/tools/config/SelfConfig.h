@@ -54,7 +54,12 @@ namespace ompl
 
         /** \brief This class contains methods that automatically
             configure various parameters for motion planning. If expensive
-            computation is performed, the results are cached. */
+            computation is performed, the results are cached. Estimates
+            that require validity checking are computed over several
+            threads, and are shared by all the instances of
+            base::SpaceInformation with the same state space, state
+            validity checker and motion validator (which are assumed
+            to check against an unchanging scene). */
         class SelfConfig
         {
         public:
@@ -66,10 +71,10 @@ namespace ompl
 
             ~SelfConfig();
 
-            /** \brief Get the probability of a sampled state being valid (calls base::SpaceInformation::probabilityOfValidState())*/
+            /** \brief Get the probability of a sampled state being valid (computes base::SpaceInformation::probabilityOfValidState() in parallel)*/
             double getProbabilityOfValidState();
 
-            /** \brief Get the probability of a sampled state being valid (calls base::SpaceInformation::averageValidMotionLength())*/
+            /** \brief Get the average length of a valid motion (computes base::SpaceInformation::averageValidMotionLength() in parallel)*/
             double getAverageValidMotionLength();
 
             /** \brief Instances of base::ValidStateSampler need a number of attempts to be specified -- the maximum number of times
@@ -88,6 +93,15 @@ namespace ompl
             /** \brief Print the computed configuration parameters */
             void print(std::ostream &out = std::cout) const;
 
+            /** \brief Set the number of threads used to compute estimates for the space this instance configures. The setting is shared by all instances that configure the same space. The state validity checker and motion validator must be thread safe for more than one thread to be used. By default, and if \e nthreads is 0, estimates are computed on the calling thread only. */
+            void setEstimationThreadCount(unsigned int nthreads);
+
+            /** \brief Get the number of threads used to compute estimates */
+            unsigned int getEstimationThreadCount() const;
+
+            /** \brief Forget all computed estimates, e.g., after the scene a validity checker checks against has changed. Estimates are also computed again when the state validity checker or motion validator of a space is replaced. */
+            static void clearEstimateCache();
+
             /** \brief Select a default nearest neighbor datastructure for the given space */
             template<typename _T>
             static NearestNeighbors<_T>* getDefaultNearestNeighbors(const base::StateSpacePtr &space)
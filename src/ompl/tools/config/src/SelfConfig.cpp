@@ -42,8 +42,10 @@
 #include "ompl/geometric/planners/kpiece/KPIECE1.h"
 #include "ompl/control/planners/rrt/RRT.h"
 #include "ompl/control/planners/kpiece/KPIECE1.h"
+#include "ompl/base/samplers/UniformValidStateSampler.h"
 #include "ompl/util/Console.h"
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/weak_ptr.hpp>
 #include <algorithm>
@@ -63,9 +65,25 @@ namespace ompl
 
         public:
 
+            typedef std::map<base::SpaceInformation*, boost::shared_ptr<SelfConfigImpl> > ConfigMap;
+
             SelfConfigImpl(const base::SpaceInformationPtr &si) :
-                wsi_(si), probabilityOfValidState_(-1.0), averageValidMotionLength_(-1.0)
+                wsi_(si), probabilityOfValidState_(-1.0), averageValidMotionLength_(-1.0), estimationThreadCount_(1)
+            {
+            }
+
+            /** \brief The instances of SelfConfigImpl, one per instance of base::SpaceInformation */
+            static ConfigMap& getConfigMap()
+            {
+                static ConfigMap SMAP;
+                return SMAP;
+            }
+
+            /** \brief The lock protecting getConfigMap() */
+            static boost::mutex& getConfigMapLock()
             {
+                static boost::mutex LOCK;
+                return LOCK;
             }
 
             double getProbabilityOfValidState()
@@ -73,7 +91,14 @@ namespace ompl
                 base::SpaceInformationPtr si = wsi_.lock();
                 checkSetup(si);
                 if (si && probabilityOfValidState_ < 0.0)
-                    probabilityOfValidState_ = si->probabilityOfValidState(magic::TEST_STATE_COUNT);
+                {
+                    EstimateCache::getInstance().find(si, probabilityOfValidState_, averageValidMotionLength_);
+                    if (probabilityOfValidState_ < 0.0)
+                    {
+                        probabilityOfValidState_ = estimateProbabilityOfValidState(si, estimationThreadCount_);
+                        EstimateCache::getInstance().store(si, probabilityOfValidState_, averageValidMotionLength_);
+                    }
+                }
                 return probabilityOfValidState_;
             }
 
@@ -82,7 +107,14 @@ namespace ompl
                 base::SpaceInformationPtr si = wsi_.lock();
                 checkSetup(si);
                 if (si && averageValidMotionLength_ < 0.0)
-                    averageValidMotionLength_ = si->averageValidMotionLength(magic::TEST_STATE_COUNT);
+                {
+                    EstimateCache::getInstance().find(si, probabilityOfValidState_, averageValidMotionLength_);
+                    if (averageValidMotionLength_ < 0.0)
+                    {
+                        averageValidMotionLength_ = estimateAverageValidMotionLength(si, estimationThreadCount_);
+                        EstimateCache::getInstance().store(si, probabilityOfValidState_, averageValidMotionLength_);
+                    }
+                }
                 return averageValidMotionLength_;
             }
 
@@ -139,8 +171,241 @@ namespace ompl
                 return wsi_.expired();
             }
 
+            /** \brief Forget the estimates, so they are computed again when next requested */
+            void clearEstimates()
+            {
+                probabilityOfValidState_ = -1.0;
+                averageValidMotionLength_ = -1.0;
+            }
+
+            /** \brief The estimates computed for validity checkers, keyed on the state space they were computed
+                for and on the identity of the validity checker and motion validator. This lets instances of
+                SpaceInformation that share the same scene reuse each other's estimates. */
+            class EstimateCache
+            {
+            public:
+
+                static EstimateCache& getInstance()
+                {
+                    static EstimateCache CACHE;
+                    return CACHE;
+                }
+
+                /** \brief Fill in the estimates cached for \e si. Estimates that are not cached are left unchanged. */
+                void find(const base::SpaceInformationPtr &si, double &probabilityOfValidState, double &averageValidMotionLength)
+                {
+                    boost::mutex::scoped_lock slock(lock_);
+                    removeExpired();
+
+                    Map::const_iterator it = cache_.find(Key(si));
+                    if (it != cache_.end())
+                    {
+                        if (it->second.probabilityOfValidState >= 0.0)
+                            probabilityOfValidState = it->second.probabilityOfValidState;
+                        if (it->second.averageValidMotionLength >= 0.0)
+                            averageValidMotionLength = it->second.averageValidMotionLength;
+                    }
+                }
+
+                /** \brief Store the estimates computed for \e si. Negative values mark estimates that are unknown. */
+                void store(const base::SpaceInformationPtr &si, double probabilityOfValidState, double averageValidMotionLength)
+                {
+                    // without a validity checker, there is no identity to key on
+                    if (!si->getStateValidityChecker() || !si->getMotionValidator())
+                        return;
+
+                    boost::mutex::scoped_lock slock(lock_);
+                    Value &value = cache_[Key(si)];
+                    value.svc = si->getStateValidityChecker();
+                    value.mv = si->getMotionValidator();
+                    value.probabilityOfValidState = probabilityOfValidState;
+                    value.averageValidMotionLength = averageValidMotionLength;
+                }
+
+                void clear()
+                {
+                    boost::mutex::scoped_lock slock(lock_);
+                    cache_.clear();
+                }
+
+            private:
+
+                struct Key
+                {
+                    Key(const base::SpaceInformationPtr &si) :
+                        measure(si->getSpaceMeasure()),
+                        segment(si->getStateSpace()->getLongestValidSegmentLength()),
+                        svc(si->getStateValidityChecker().get()),
+                        mv(si->getMotionValidator().get())
+                    {
+                        si->getStateSpace()->computeSignature(signature);
+                    }
+
+                    bool operator<(const Key &other) const
+                    {
+                        if (svc != other.svc)
+                            return svc < other.svc;
+                        if (mv != other.mv)
+                            return mv < other.mv;
+                        if (measure != other.measure)
+                            return measure < other.measure;
+                        if (segment != other.segment)
+                            return segment < other.segment;
+                        return signature < other.signature;
+                    }
+
+                    /** \brief The signature of the state space (its type and dimension) */
+                    std::vector<int>                      signature;
+                    /** \brief The measure of the state space, which depends on its bounds */
+                    double                                measure;
+                    /** \brief The resolution at which motions are checked */
+                    double                                segment;
+                    const base::StateValidityChecker     *svc;
+                    const base::MotionValidator          *mv;
+                };
+
+                struct Value
+                {
+                    // weak pointers tell whether the keys still refer to the same instances
+                    boost::weak_ptr<base::StateValidityChecker> svc;
+                    boost::weak_ptr<base::MotionValidator>      mv;
+                    double                                      probabilityOfValidState;
+                    double                                      averageValidMotionLength;
+                };
+
+                typedef std::map<Key, Value> Map;
+
+                void removeExpired()
+                {
+                    Map::iterator it = cache_.begin();
+                    while (it != cache_.end())
+                    {
+                        if (it->second.svc.expired() || it->second.mv.expired())
+                            cache_.erase(it++);
+                        else
+                            ++it;
+                    }
+                }
+
+                Map          cache_;
+                boost::mutex lock_;
+            };
+
         private:
 
+            /** \brief The number of threads to estimate \e count samples with, given the requested number of threads (0 for a single thread) */
+            static unsigned int estimationThreadCount(unsigned int requested, unsigned int count)
+            {
+                return std::max(1u, std::min(requested, count));
+            }
+
+            /** \brief Count how many of \e attempts states sampled with \e ss are valid */
+            static void countValidStates(const base::SpaceInformation *si, const base::StateSamplerPtr &ss,
+                                         unsigned int attempts, unsigned int *valid)
+            {
+                base::State *s = si->allocState();
+                for (unsigned int i = 0 ; i < attempts ; ++i)
+                {
+                    ss->sampleUniform(s);
+                    if (si->isValid(s))
+                        ++(*valid);
+                }
+                si->freeState(s);
+            }
+
+            /** \brief Accumulate the valid length of \e attempts motions from valid states, as in
+                base::SpaceInformation::averageValidMotionLength() */
+            static void sumValidMotionLengths(const base::SpaceInformation *si, const base::StateSamplerPtr &ss,
+                                              const base::ValidStateSamplerPtr &vss, unsigned int attempts,
+                                              double *length, unsigned int *count)
+            {
+                base::State *s1 = si->allocState();
+                base::State *s2 = si->allocState();
+
+                std::pair<base::State*, double> lastValid;
+                lastValid.first = NULL;
+
+                for (unsigned int i = 0 ; i < attempts ; ++i)
+                    if (vss->sample(s1))
+                    {
+                        ++(*count);
+                        ss->sampleUniform(s2);
+                        if (si->checkMotion(s1, s2, lastValid))
+                            *length += si->distance(s1, s2);
+                        else
+                            *length += si->distance(s1, s2) * lastValid.second;
+                    }
+
+                si->freeState(s2);
+                si->freeState(s1);
+            }
+
+            /** \brief Compute base::SpaceInformation::probabilityOfValidState(magic::TEST_STATE_COUNT), splitting
+                the samples over threads. The samplers are allocated before the threads start, so the result only
+                depends on the seed and the number of threads. */
+            static double estimateProbabilityOfValidState(const base::SpaceInformationPtr &si, unsigned int requestedThreads)
+            {
+                const unsigned int attempts = magic::TEST_STATE_COUNT;
+                const unsigned int nthreads = estimationThreadCount(requestedThreads, attempts);
+
+                std::vector<base::StateSamplerPtr> samplers(nthreads);
+                for (unsigned int i = 0 ; i < nthreads ; ++i)
+                    samplers[i] = si->allocStateSampler();
+
+                std::vector<unsigned int> valid(nthreads, 0);
+                boost::thread_group threads;
+                for (unsigned int i = 0 ; i < nthreads ; ++i)
+                {
+                    unsigned int n = attempts / nthreads + (i < attempts % nthreads ? 1 : 0);
+                    threads.create_thread(boost::bind(&countValidStates, si.get(), samplers[i], n, &valid[i]));
+                }
+                threads.join_all();
+
+                unsigned int total = 0;
+                for (unsigned int i = 0 ; i < nthreads ; ++i)
+                    total += valid[i];
+                return (double)total / (double)attempts;
+            }
+
+            /** \brief Compute base::SpaceInformation::averageValidMotionLength(magic::TEST_STATE_COUNT), splitting
+                the motions over threads */
+            static double estimateAverageValidMotionLength(const base::SpaceInformationPtr &si, unsigned int requestedThreads)
+            {
+                // as in base::SpaceInformation::averageValidMotionLength(), a nested loop of #attempts steps each
+                const unsigned int attempts = std::max((unsigned int)floor(sqrt((double)magic::TEST_STATE_COUNT) + 0.5), 2u);
+                const unsigned int nthreads = estimationThreadCount(requestedThreads, attempts);
+
+                std::vector<base::StateSamplerPtr> samplers(nthreads);
+                std::vector<base::ValidStateSamplerPtr> validSamplers(nthreads);
+                for (unsigned int i = 0 ; i < nthreads ; ++i)
+                {
+                    samplers[i] = si->allocStateSampler();
+                    base::UniformValidStateSampler *uvss = new base::UniformValidStateSampler(si.get());
+                    uvss->setNrAttempts(attempts);
+                    validSamplers[i].reset(uvss);
+                }
+
+                std::vector<double> length(nthreads, 0.0);
+                std::vector<unsigned int> count(nthreads, 0);
+                boost::thread_group threads;
+                for (unsigned int i = 0 ; i < nthreads ; ++i)
+                {
+                    unsigned int n = attempts / nthreads + (i < attempts % nthreads ? 1 : 0);
+                    threads.create_thread(boost::bind(&sumValidMotionLengths, si.get(), samplers[i], validSamplers[i],
+                                                      n, &length[i], &count[i]));
+                }
+                threads.join_all();
+
+                double d = 0.0;
+                unsigned int c = 0;
+                for (unsigned int i = 0 ; i < nthreads ; ++i)
+                {
+                    d += length[i];
+                    c += count[i];
+                }
+                return c > 0 ? d / (double)c : 0.0;
+            }
+
             void checkSetup(const base::SpaceInformationPtr &si)
             {
                 if (si)
@@ -148,24 +413,35 @@ namespace ompl
                     if (!si->isSetup())
                     {
                         si->setup();
-                        probabilityOfValidState_ = -1.0;
-                        averageValidMotionLength_ = -1.0;
+                        clearEstimates();
+                    }
+
+                    // the estimates only hold for the validity checker and motion validator they were computed with
+                    if (svc_.lock() != si->getStateValidityChecker() || mv_.lock() != si->getMotionValidator())
+                    {
+                        clearEstimates();
+                        svc_ = si->getStateValidityChecker();
+                        mv_ = si->getMotionValidator();
                     }
                 }
                 else
-                {
-                    probabilityOfValidState_ = -1.0;
-                    averageValidMotionLength_ = -1.0;
-                }
+                    clearEstimates();
             }
 
             // we store weak pointers so that the SpaceInformation instances are not kept in
             // memory until termination of the program due to the use of a static ConfigMap below
             boost::weak_ptr<base::SpaceInformation> wsi_;
 
+            /** \brief The validity checker and motion validator the estimates were computed with */
+            boost::weak_ptr<base::StateValidityChecker> svc_;
+            boost::weak_ptr<base::MotionValidator>      mv_;
+
             double                                  probabilityOfValidState_;
             double                                  averageValidMotionLength_;
 
+            /** \brief The number of threads used for estimation, 0 for the number of hardware threads */
+            unsigned int                            estimationThreadCount_;
+
             boost::mutex                            lock_;
         };
 
@@ -177,12 +453,10 @@ namespace ompl
 ompl::tools::SelfConfig::SelfConfig(const base::SpaceInformationPtr &si, const std::string &context) :
     context_(context.empty() ? "" : context + ": ")
 {
-    typedef std::map<base::SpaceInformation*, boost::shared_ptr<SelfConfigImpl> > ConfigMap;
+    typedef SelfConfigImpl::ConfigMap ConfigMap;
 
-    static ConfigMap    SMAP;
-    static boost::mutex LOCK;
-
-    boost::mutex::scoped_lock smLock(LOCK);
+    ConfigMap &SMAP = SelfConfigImpl::getConfigMap();
+    boost::mutex::scoped_lock smLock(SelfConfigImpl::getConfigMapLock());
 
     // clean expired entries from the map
     ConfigMap::iterator dit = SMAP.begin();
@@ -241,6 +515,34 @@ void ompl::tools::SelfConfig::configureProjectionEvaluator(base::ProjectionEvalu
     return impl_->configureProjectionEvaluator(proj, context_);
 }
 
+void ompl::tools::SelfConfig::setEstimationThreadCount(unsigned int nthreads)
+{
+    boost::mutex::scoped_lock iLock(impl_->lock_);
+    impl_->estimationThreadCount_ = nthreads;
+}
+
+unsigned int ompl::tools::SelfConfig::getEstimationThreadCount() const
+{
+    boost::mutex::scoped_lock iLock(impl_->lock_);
+    return impl_->estimationThreadCount_;
+}
+
+void ompl::tools::SelfConfig::clearEstimateCache()
+{
+    boost::mutex::scoped_lock smLock(SelfConfigImpl::getConfigMapLock());
+
+    // the estimates kept for each instance of base::SpaceInformation are looked up before the shared ones
+    SelfConfigImpl::ConfigMap &SMAP = SelfConfigImpl::getConfigMap();
+    for (SelfConfigImpl::ConfigMap::iterator it = SMAP.begin() ; it != SMAP.end() ; ++it)
+    {
+        boost::mutex::scoped_lock iLock(it->second->lock_);
+        it->second->clearEstimates();
+    }
+
+    // cleared last, so estimates stored by computations that finished meanwhile are dropped too
+    SelfConfigImpl::EstimateCache::getInstance().clear();
+}
+
 void ompl::tools::SelfConfig::print(std::ostream &out) const
 {
     boost::mutex::scoped_lock iLock(impl_->lock_);
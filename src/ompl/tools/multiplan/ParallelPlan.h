@@ -84,6 +84,41 @@ namespace ompl
             /** \brief Clear the set of planners to be executed */
             void clearPlanners();
 
+            /** \brief Enable or disable deterministic execution. In
+                deterministic mode every planner draws the seeds of the
+                random number generators it creates during solve() from a
+                stream derived from a seed of this instance and the index
+                of the planner. Planners are not stopped when others find
+                solutions, and the solutions are hybridized once all
+                planners have finished, in a fixed order. Calling solve()
+                on instances seeded identically (see setLocalSeed()) then
+                gives the same result, independent of how the threads are
+                scheduled, as long as the planners terminate on their own
+                (e.g., when they find a solution) rather than on a time
+                limit. */
+            void setDeterministic(bool deterministic)
+            {
+                deterministic_ = deterministic;
+            }
+
+            /** \brief Check whether deterministic execution is enabled */
+            bool getDeterministic() const
+            {
+                return deterministic_;
+            }
+
+            /** \brief Set the seed from which the random streams of the planners are derived in deterministic mode */
+            void setLocalSeed(boost::uint32_t localSeed)
+            {
+                rng_.setLocalSeed(localSeed);
+            }
+
+            /** \brief Get the seed from which the random streams of the planners are derived in deterministic mode */
+            boost::uint32_t getLocalSeed() const
+            {
+                return rng_.getLocalSeed();
+            }
+
             /** \brief Get the problem definition used */
             const base::ProblemDefinitionPtr& getProblemDefinition() const
             {
@@ -120,6 +155,13 @@ namespace ompl
             /** \brief Run the planner and collect the solutions. This function is only called if hybridize_ is true. */
             void solveMore(base::Planner *planner, std::size_t minSolCount, std::size_t maxSolCount, const base::PlannerTerminationCondition *ptc);
 
+            /** \brief Run the planner with index \e index in deterministic mode, with the random streams derived from \e seed */
+            void solveDeterministic(std::size_t index, boost::uint32_t seed, const base::PlannerTerminationCondition *ptc);
+
+            /** \brief Record the solutions in the problem definition for hybridization in an order that does not depend
+                on the order in which they were found, and hybridize them if there are at least \e minSolCount */
+            void hybridizeDeterministic(std::size_t minSolCount);
+
             /** \brief The problem definition used */
             base::ProblemDefinitionPtr      pdef_;
 
@@ -132,6 +174,12 @@ namespace ompl
             /** \brief Lock for phybrid_ */
             boost::mutex                    phlock_;
 
+            /** \brief Flag indicating whether deterministic execution is enabled */
+            bool                            deterministic_;
+
+            /** \brief The random number generator that seeds the planners in deterministic mode */
+            RNG                             rng_;
+
         private:
 
             /** \brief Number of solutions found during a particular run */
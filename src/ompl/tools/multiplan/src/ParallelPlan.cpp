@@ -36,9 +36,30 @@
 
 #include "ompl/tools/multiplan/ParallelPlan.h"
 #include "ompl/geometric/PathHybridization.h"
+#include <algorithm>
+#include <limits>
+
+/// @cond IGNORE
+namespace
+{
+    // The order of the solutions of a ProblemDefinition, with ties
+    // broken by properties that do not depend on when the solutions
+    // were added
+    bool solutionOrder(const ompl::base::PlannerSolution &a, const ompl::base::PlannerSolution &b)
+    {
+        if (a < b)
+            return true;
+        if (b < a)
+            return false;
+        if (a.plannerName_ != b.plannerName_)
+            return a.plannerName_ < b.plannerName_;
+        return a.length_ < b.length_;
+    }
+}
+/// @endcond
 
 ompl::tools::ParallelPlan::ParallelPlan(const base::ProblemDefinitionPtr &pdef) :
-    pdef_(pdef), phybrid_(new geometric::PathHybridization(pdef->getSpaceInformation()))
+    pdef_(pdef), phybrid_(new geometric::PathHybridization(pdef->getSpaceInformation())), deterministic_(false)
 {
 }
 
@@ -98,8 +119,17 @@ ompl::base::PlannerStatus ompl::tools::ParallelPlan::solve(const base::PlannerTe
     time::point start = time::now();
     std::vector<boost::thread*> threads(planners_.size());
 
-    // Decide if we are combining solutions or just taking the first one
-    if (hybridize)
+    // In deterministic mode, the planners derive their random streams from this seed and run until
+    // they terminate on their own; solutions are combined only once all of them are done
+    if (deterministic_)
+    {
+        const boost::uint32_t seed = rng_.uniformInt(1, std::numeric_limits<int>::max());
+        OMPL_DEBUG("ParallelPlan::solve(): Deterministic execution with seed %u", seed);
+        for (std::size_t i = 0 ; i < threads.size() ; ++i)
+            threads[i] = new boost::thread(boost::bind(&ParallelPlan::solveDeterministic, this, i, seed, &ptc));
+    }
+    // Otherwise, decide if we are combining solutions or just taking the first one
+    else if (hybridize)
         for (std::size_t i = 0 ; i < threads.size() ; ++i)
             threads[i] = new boost::thread(boost::bind(&ParallelPlan::solveMore, this, planners_[i].get(), minSolCount, maxSolCount, &ptc));
     else
@@ -114,6 +144,8 @@ ompl::base::PlannerStatus ompl::tools::ParallelPlan::solve(const base::PlannerTe
 
     if (hybridize)
     {
+        if (deterministic_)
+            hybridizeDeterministic(minSolCount);
         if (phybrid_->pathCount() > 1)
             if (const base::PathPtr &hsol = phybrid_->getHybridPath())
             {
@@ -183,3 +215,38 @@ void ompl::tools::ParallelPlan::solveMore(base::Planner *planner, std::size_t mi
           (unsigned int)phybrid_->pathCount(), attempts);
     }
 }
+
+void ompl::tools::ParallelPlan::solveDeterministic(std::size_t index, boost::uint32_t seed, const base::PlannerTerminationCondition *ptc)
+{
+    base::Planner *planner = planners_[index].get();
+    OMPL_DEBUG("ParallelPlan.solveDeterministic: starting planner %s", planner->getName().c_str());
+
+    // the random number generators the planner creates are seeded from (seed, index) only
+    RNG::ScopedSeed scope(seed, index);
+    time::point start = time::now();
+    if (planner->solve(*ptc))
+    {
+        double duration = time::seconds(time::now() - start);
+        foundSolCountLock_.lock();
+        ++foundSolCount_;
+        foundSolCountLock_.unlock();
+        OMPL_DEBUG("ParallelPlan.solveDeterministic: Solution found by %s in %lf seconds", planner->getName().c_str(), duration);
+    }
+}
+
+void ompl::tools::ParallelPlan::hybridizeDeterministic(std::size_t minSolCount)
+{
+    std::vector<base::PlannerSolution> paths = pdef_->getSolutions();
+    std::stable_sort(paths.begin(), paths.end(), &solutionOrder);
+
+    time::point start = time::now();
+    unsigned int attempts = 0;
+    for (std::size_t i = 0 ; i < paths.size() ; ++i)
+        attempts += phybrid_->recordPath(paths[i].path_, false);
+
+    if (phybrid_->pathCount() >= minSolCount)
+        phybrid_->computeHybridPath();
+
+    OMPL_DEBUG("ParallelPlan.hybridizeDeterministic: Spent %f seconds hybridizing %u solution paths (attempted %u connections between paths)",
+               time::seconds(time::now() - start), (unsigned int)phybrid_->pathCount(), attempts);
+}
@@ -65,6 +65,32 @@ namespace ompl
     {
     public:
 
+        /** \brief While an instance of this class exists, the
+            RNG instances constructed by the calling thread take
+            their seeds from a stream determined only by \e seed and
+            \e index, instead of from the process-wide seed
+            generator. Threads of a parallel planner that each open a
+            scope with the same \e seed and their own thread index
+            obtain the same random streams in every execution,
+            regardless of the order in which the threads are
+            scheduled. Scopes can be nested; the innermost one is
+            used. */
+        class ScopedSeed
+        {
+        public:
+
+            /** \brief Open the seed stream identified by \e seed and \e index for the calling thread */
+            ScopedSeed(boost::uint32_t seed, boost::uint32_t index);
+
+            /** \brief Restore the seed stream that was in use when this scope was opened */
+            ~ScopedSeed();
+
+        private:
+
+            ScopedSeed(const ScopedSeed&);
+            ScopedSeed& operator=(const ScopedSeed&);
+        };
+
         /** \brief Constructor. Always sets a different random seed */
         RNG();
 
@@ -136,6 +162,10 @@ namespace ompl
             (repeatable) behaviour across multiple instances of RNG. Useful for debugging. */
         static boost::uint32_t getSeed();
 
+        /** \brief Derive the seed of the \e index-th stream of the family of streams identified by \e seed. The
+            result depends only on the two arguments, is never 0, and nearby arguments give unrelated seeds. */
+        static boost::uint32_t deriveSeed(boost::uint32_t seed, boost::uint32_t index);
+
         /** \brief Set the seed used for the instance of a RNG. Use this function to ensure that an instance of
             an RNG generates the same deterministic sequence of numbers. This function resets the member generators*/
         void setLocalSeed(boost::uint32_t localSeed);
@@ -155,6 +185,9 @@ namespace ompl
         /** \brief Uniform random sampling of the content of an n-ball, with a radius appropriately distributed between [0,r) so that the distribution is uniform in a Cartesian coordinate system. */
         void uniformInBall(double r, unsigned int n, double value[]);
 
+        /** \brief Uniform random sampling of \e numPoints points in the content of an n-ball. The points are stored contiguously in \e values, i.e., the i-th point starts at values[i*n]. Unlike calling uniformInBall() repeatedly, no temporary memory is allocated per point. */
+        void uniformInBall(double r, unsigned int n, unsigned int numPoints, double values[]);
+
         /** \brief Uniform random sampling of the surface of a prolate hyperspheroid, a special symmetric type of
         n-dimensional ellipse.
         @par J D. Gammell, S. S. Srinivasa, T. D. Barfoot, "Informed RRT*: Optimal Sampling-based
@@ -173,6 +206,9 @@ namespace ompl
         <a href="http://www.youtube.com/watch?v=nsl-5MZfwu4">Short description video</a>. */
         void uniformProlateHyperspheroid(ProlateHyperspheroidPtr phsPtr, unsigned int n, double value[]);
 
+        /** \brief Uniform random sampling of \e numPoints points in a prolate hyperspheroid. The points are stored contiguously in \e values, i.e., the i-th point starts at values[i*n], and are transformed from the unit n-ball with a single matrix-matrix product. */
+        void uniformProlateHyperspheroid(ProlateHyperspheroidPtr phsPtr, unsigned int n, unsigned int numPoints, double values[]);
+
     private:
 
         /** \brief The seed used for the instance of a RNG */
@@ -206,6 +242,9 @@ namespace ompl
         /** \brief Transform a point from a sphere to PHS */
         void transform(unsigned int n, const double sphere[], double phs[]);
 
+        /** \brief Transform \e numPoints points from a sphere to PHS. The points are stored contiguously, i.e., the i-th point starts at sphere[i*n] and phs[i*n]. */
+        void transform(unsigned int n, unsigned int numPoints, const double spheres[], double phss[]);
+
         /** \brief Check if the given point lies within the PHS */
         bool isInPhs(unsigned int n, const double point[]);
 
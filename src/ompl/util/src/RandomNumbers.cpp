@@ -41,6 +41,7 @@
 #include <boost/random/uniform_int.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/once.hpp>
+#include <boost/thread/tss.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/math/constants/constants.hpp>
@@ -60,6 +61,38 @@
 /// @cond IGNORE
 namespace
 {
+    /// The finalizer of MurmurHash3: flipping one input bit flips
+    /// about half of the output bits.
+    inline boost::uint32_t mixSeedBits(boost::uint32_t h)
+    {
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    }
+
+    /// The seed stream opened by an instance of RNG::ScopedSeed.
+    /// Seeds are drawn by counting through the stream, so the n-th
+    /// RNG constructed in the scope always gets the same seed.
+    struct ScopedSeedStream
+    {
+        ScopedSeedStream(boost::uint32_t seed, ScopedSeedStream *previous) :
+            seed_(seed), count_(0), previous_(previous)
+        {
+        }
+
+        boost::uint32_t next()
+        {
+            return ompl::RNG::deriveSeed(seed_, count_++);
+        }
+
+        boost::uint32_t   seed_;
+        boost::uint32_t   count_;
+        ScopedSeedStream *previous_;
+    };
+
     /// We use a different random number generator for the seeds of the
     /// other random generators. The root seed is from the number of
     /// nano-seconds in the current time, or given by the user.
@@ -115,11 +148,30 @@ namespace
 
         boost::uint32_t nextSeed()
         {
+            // seeds requested inside a RNG::ScopedSeed do not depend on other threads
+            if (ScopedSeedStream *stream = scopedStream_.get())
+                return stream->next();
+
             boost::mutex::scoped_lock slock(rngMutex_);
             someSeedsGenerated_ = true;
             return s_();
         }
 
+        void pushScopedStream(boost::uint32_t seed)
+        {
+            scopedStream_.reset(new ScopedSeedStream(seed, scopedStream_.release()));
+        }
+
+        void popScopedStream()
+        {
+            ScopedSeedStream *stream = scopedStream_.release();
+            if (stream)
+            {
+                scopedStream_.reset(stream->previous_);
+                delete stream;
+            }
+        }
+
     private:
         bool                       someSeedsGenerated_;
         boost::uint32_t            firstSeed_;
@@ -127,6 +179,7 @@ namespace
         boost::lagged_fibonacci607 sGen_;
         boost::uniform_int<>       sDist_;
         boost::variate_generator<boost::lagged_fibonacci607&, boost::uniform_int<> > s_;
+        boost::thread_specific_ptr<ScopedSeedStream> scopedStream_;
     };
 
     static boost::once_flag g_once = BOOST_ONCE_INIT;
@@ -155,6 +208,22 @@ void ompl::RNG::setSeed(boost::uint32_t seed)
     getRNGSeedGenerator().setSeed(seed);
 }
 
+boost::uint32_t ompl::RNG::deriveSeed(boost::uint32_t seed, boost::uint32_t index)
+{
+    boost::uint32_t h = mixSeedBits(mixSeedBits(seed) ^ ((index + 1u) * 0x9e3779b9u));
+    return h ? h : 1u;
+}
+
+ompl::RNG::ScopedSeed::ScopedSeed(boost::uint32_t seed, boost::uint32_t index)
+{
+    getRNGSeedGenerator().pushScopedStream(deriveSeed(seed, index));
+}
+
+ompl::RNG::ScopedSeed::~ScopedSeed()
+{
+    getRNGSeedGenerator().popScopedStream();
+}
+
 ompl::RNG::RNG() :
     localSeed_(getRNGSeedGenerator().nextSeed()),
     generator_(localSeed_),
@@ -263,6 +332,29 @@ void ompl::RNG::uniformInBall(double r, unsigned int n, double value[])
     }
 }
 
+void ompl::RNG::uniformInBall(double r, unsigned int n, unsigned int numPoints, double values[])
+{
+    //Draw each point on the unit sphere by normalizing a vector of standard normals, and then scale by a random radius
+    for (unsigned int i = 0u; i < numPoints; ++i)
+    {
+        //A view of the point
+        Eigen::Map<Eigen::VectorXd> point(&values[i*n], n);
+
+        //Draw a random direction, redrawing in the (practically impossible) case of a zero vector
+        do
+        {
+            for (unsigned int j = 0u; j < n; ++j)
+            {
+                point(j) = normal_();
+            }
+        }
+        while (point.squaredNorm() == 0.0);
+
+        //Scale the direction to a random radius
+        point *= r*std::pow(this->uniformReal(0.0, 1.0), 1.0/static_cast<double>(n))/point.norm();
+    }
+}
+
 void ompl::RNG::uniformProlateHyperspheroidSurface(ProlateHyperspheroidPtr phsPtr, unsigned int n, double value[])
 {
     //Variables
@@ -289,6 +381,19 @@ void ompl::RNG::uniformProlateHyperspheroid(ProlateHyperspheroidPtr phsPtr, unsi
     phsPtr->transform(n, &sphere[0], value);
 }
 
+void ompl::RNG::uniformProlateHyperspheroid(ProlateHyperspheroidPtr phsPtr, unsigned int n, unsigned int numPoints, double values[])
+{
+    //Variables
+    //The spherical points as a std::vector
+    std::vector<double> spheres(n*numPoints);
+
+    //Get the random points in the sphere
+    this->uniformInBall(1.0, n, numPoints, &spheres[0]);
+
+    //Transform them all to the PHS
+    phsPtr->transform(n, numPoints, &spheres[0], values);
+}
+
 
 
 
@@ -348,6 +453,17 @@ void ompl::ProlateHyperspheroid::transform(unsigned int n, const double sphere[]
     Eigen::Map<Eigen::VectorXd>(phs, n) = transformationWorldFromEllipse_*Eigen::Map<const Eigen::VectorXd>(sphere, n) + xCentre_;
 }
 
+void ompl::ProlateHyperspheroid::transform(unsigned int n, unsigned int numPoints, const double spheres[], double phss[])
+{
+    if (isTransformUpToDate_ == false)
+    {
+      throw Exception("The transformation is not up to date in the PHS class. Has the transverse diameter been set?");
+    }
+
+    //Calculate the tranformation of all the points as one matrix product and offset each column, using Eigen::Map views of the data
+    Eigen::Map<Eigen::MatrixXd>(phss, n, numPoints) = (transformationWorldFromEllipse_*Eigen::Map<const Eigen::MatrixXd>(spheres, n, numPoints)).colwise() + xCentre_;
+}
+
 bool ompl::ProlateHyperspheroid::isInPhs(unsigned int n, const double point[])
 {
     if (isTransformUpToDate_ == false)
@@ -0,0 +1,282 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2015, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#define BOOST_TEST_MODULE "InformedSampling"
+#include <boost/test/unit_test.hpp>
+
+#include "ompl/base/SpaceInformation.h"
+#include "ompl/base/ProblemDefinition.h"
+#include "ompl/base/StateValidityChecker.h"
+#include "ompl/base/ScopedState.h"
+#include "ompl/base/goals/GoalStates.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/base/objectives/PathLengthOptimizationObjective.h"
+#include "ompl/base/objectives/StateCostIntegralObjective.h"
+#include "ompl/base/samplers/informed/PathLengthDirectInfSampler.h"
+#include "ompl/base/samplers/informed/PathLengthBoundedInfSampler.h"
+#include "ompl/util/RandomNumbers.h"
+
+#include "../BoostTestTeamCityReporter.h"
+
+using namespace ompl;
+
+/** \brief A path length problem in a 2D box with one start and any number of goal states */
+struct PhsProblem
+{
+    PhsProblem(double low, double high) : space(new base::RealVectorStateSpace(2))
+    {
+        space->as<base::RealVectorStateSpace>()->setBounds(low, high);
+        si.reset(new base::SpaceInformation(space));
+        si->setStateValidityChecker(base::StateValidityCheckerPtr(new base::AllValidStateValidityChecker(si)));
+        si->setup();
+        pdef.reset(new base::ProblemDefinition(si));
+        pdef->setOptimizationObjective(base::OptimizationObjectivePtr(new base::PathLengthOptimizationObjective(si)));
+        goal.reset(new base::GoalStates(si));
+        pdef->setGoal(goal);
+    }
+
+    void setStart(double x, double y)
+    {
+        base::ScopedState<> s(space);
+        s[0] = x;
+        s[1] = y;
+        pdef->addStartState(s);
+        start.push_back(x);
+        start.push_back(y);
+    }
+
+    void addGoal(double x, double y)
+    {
+        base::ScopedState<> s(space);
+        s[0] = x;
+        s[1] = y;
+        goal->as<base::GoalStates>()->addState(s);
+        std::vector<double> g(2);
+        g[0] = x;
+        g[1] = y;
+        goals.push_back(g);
+    }
+
+    /** \brief Whether \e point lies in the PHS of the start and the goal with index \e goalIdx for paths of length \e cost */
+    bool isInPhs(std::size_t goalIdx, double cost, const double point[]) const
+    {
+        ProlateHyperspheroid phs(2, &start[0], &goals[goalIdx][0]);
+        phs.setTransverseDiameter(cost);
+        return phs.getPathLength(2, point) <= cost + 1e-9;
+    }
+
+    base::StateSpacePtr                 space;
+    base::SpaceInformationPtr           si;
+    base::ProblemDefinitionPtr          pdef;
+    base::GoalPtr                       goal;
+    std::vector<double>                 start;
+    std::vector< std::vector<double> >  goals;
+};
+
+/** \brief A state cost integral whose state costs grow from 2 along the x axis */
+class RisingStateCostObjective : public base::StateCostIntegralObjective
+{
+public:
+    RisingStateCostObjective(const base::SpaceInformationPtr &si) : base::StateCostIntegralObjective(si, true)
+    {
+        setStateCostLowerBound(base::Cost(2.0));
+        setCostToGoHeuristic(&base::goalRegionCostToGo);
+    }
+
+    virtual base::Cost stateCost(const base::State *s) const
+    {
+        return base::Cost(2.0 + 0.1 * s->as<base::RealVectorStateSpace::StateType>()->values[0]);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(DirectSamplingOfUnionOfPhs)
+{
+    // two PHSs with a common focus that overlap around it
+    PhsProblem problem(-10.0, 10.0);
+    problem.setStart(0.0, 0.0);
+    problem.addGoal(4.0, 0.0);
+    problem.addGoal(0.0, 4.0);
+    const double cost = 6.0;
+    const base::Cost bestCost(cost);
+    base::PathLengthDirectInfSampler sampler(problem.space.get(), problem.pdef, &bestCost);
+
+    // the fraction of the union covered by both PHSs, estimated by rejection
+    // from a box that contains both of them
+    RNG rng;
+    unsigned int inUnion = 0, inBoth = 0;
+    double point[2];
+    for (unsigned int i = 0 ; i < 400000 ; ++i)
+    {
+        point[0] = rng.uniformReal(-3.0, 6.0);
+        point[1] = rng.uniformReal(-3.0, 6.0);
+        bool in0 = problem.isInPhs(0, cost, point);
+        bool in1 = problem.isInPhs(1, cost, point);
+        if (in0 || in1)
+            ++inUnion;
+        if (in0 && in1)
+            ++inBoth;
+    }
+    double overlapFraction = (double)inBoth / (double)inUnion;
+
+    // every sample lies in the bounds and in at least one PHS, and the
+    // overlap is sampled in proportion to its share of the union. If the
+    // overlap was sampled once per PHS, its share would be about
+    // 2 * overlap / (measure of PHS 0 + measure of PHS 1) instead
+    const unsigned int N = 20000;
+    base::State *state = problem.space->allocState();
+    unsigned int sampledBoth = 0;
+    for (unsigned int i = 0 ; i < N ; ++i)
+    {
+        sampler.sampleUniform(state, bestCost);
+        const double *values = state->as<base::RealVectorStateSpace::StateType>()->values;
+        BOOST_REQUIRE(problem.space->satisfiesBounds(state));
+        bool in0 = problem.isInPhs(0, cost, values);
+        bool in1 = problem.isInPhs(1, cost, values);
+        BOOST_REQUIRE(in0 || in1);
+        if (in0 && in1)
+            ++sampledBoth;
+    }
+    problem.space->freeState(state);
+
+    double doubleCountedFraction = 2.0 * overlapFraction / (1.0 + overlapFraction);
+    BOOST_CHECK_GT(doubleCountedFraction - overlapFraction, 0.1);
+    BOOST_CHECK_SMALL((double)sampledBoth / (double)N - overlapFraction, 0.02);
+}
+
+BOOST_AUTO_TEST_CASE(DirectBatchSamplingAcceptanceRate)
+{
+    // a single PHS whose lower half and left tip lie outside the bounds
+    PhsProblem problem(0.0, 10.0);
+    problem.setStart(0.0, 0.0);
+    problem.addGoal(4.0, 0.0);
+    const double cost = 6.0;
+    const base::Cost bestCost(cost);
+    base::PathLengthDirectInfSampler sampler(problem.space.get(), problem.pdef, &bestCost);
+
+    // the fraction of the PHS inside the bounds, estimated by rejection
+    RNG rng;
+    ProlateHyperspheroid phs(2, &problem.start[0], &problem.goals[0][0]);
+    phs.setTransverseDiameter(cost);
+    unsigned int inPhs = 0, inPhsAndBounds = 0;
+    double point[2];
+    for (unsigned int i = 0 ; i < 400000 ; ++i)
+    {
+        point[0] = rng.uniformReal(-1.5, 5.5);
+        point[1] = rng.uniformReal(-2.5, 2.5);
+        if (phs.isInPhs(2, point))
+        {
+            ++inPhs;
+            if (point[0] >= 0.0 && point[1] >= 0.0)
+                ++inPhsAndBounds;
+        }
+    }
+    double inBoundsFraction = (double)inPhsAndBounds / (double)inPhs;
+
+    // every state of the batch (all of which start out of bounds) is filled
+    // in with a sample from the PHS that is inside the bounds
+    std::vector<base::State*> states(5000);
+    problem.si->allocStates(states);
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+        states[i]->as<base::RealVectorStateSpace::StateType>()->values[0] = -1.0;
+    sampler.sampleUniformBatch(states, bestCost);
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+    {
+        const double *values = states[i]->as<base::RealVectorStateSpace::StateType>()->values;
+        BOOST_REQUIRE(problem.space->satisfiesBounds(states[i]));
+        BOOST_REQUIRE(phs.isInPhs(2, values));
+    }
+    problem.si->freeStates(states);
+
+    // and the acceptance rate is the fraction of the PHS inside the bounds
+    BOOST_CHECK_GT(sampler.getAcceptanceRate(), 0.0);
+    BOOST_CHECK_LE(sampler.getAcceptanceRate(), 1.0);
+    BOOST_CHECK_SMALL(sampler.getAcceptanceRate() - inBoundsFraction, 0.03);
+}
+
+BOOST_AUTO_TEST_CASE(PathLengthBoundedSampling)
+{
+    PhsProblem problem(0.0, 10.0);
+    problem.setStart(1.0, 1.0);
+    problem.addGoal(5.0, 1.0);
+    base::OptimizationObjectivePtr opt(new RisingStateCostObjective(problem.si));
+    problem.pdef->setOptimizationObjective(opt);
+    const double costPerLength = opt->getCostPerLengthLowerBound();
+    BOOST_REQUIRE_EQUAL(costPerLength, 2.0);
+    // a solution that is 6 units long at best
+    const base::Cost bestCost(12.0);
+    base::PathLengthBoundedInfSampler sampler(problem.space.get(), problem.pdef, &bestCost);
+
+    // a state that may be on a better solution lies within the PHS of
+    // the paths that are short enough, and passes the heuristic test of the
+    // sampler; meanwhile, count how often plain rejection sampling (see
+    // RejectionInfSampler) from the whole space would accept a state
+    base::State *state = problem.space->allocState();
+    base::StateSamplerPtr uniform = problem.space->allocStateSampler();
+    const unsigned int N = 20000;
+    unsigned int numImproving = 0, numRejectionAccepted = 0;
+    for (unsigned int i = 0 ; i < N ; ++i)
+    {
+        uniform->sampleUniform(state);
+        const double *values = state->as<base::RealVectorStateSpace::StateType>()->values;
+        if (opt->isCostBetterThan(sampler.base::InformedStateSampler::heuristicSolnCost(state), bestCost))
+            ++numRejectionAccepted;
+        // every unit of length costs at least costPerLength, so this is the
+        // tightest admissible estimate that only depends on path length
+        ProlateHyperspheroid phs(2, &problem.start[0], &problem.goals[0][0]);
+        if (costPerLength * phs.getPathLength(2, values) < bestCost.value())
+        {
+            ++numImproving;
+            BOOST_REQUIRE(problem.isInPhs(0, bestCost.value() / costPerLength, values));
+            BOOST_REQUIRE(opt->isCostBetterThan(sampler.heuristicSolnCost(state), bestCost));
+        }
+    }
+    BOOST_CHECK_GT(numImproving, 0u);
+
+    // the samples can all improve on the solution, as far as the heuristic can tell
+    for (unsigned int i = 0 ; i < 1000 ; ++i)
+    {
+        sampler.sampleUniform(state, bestCost);
+        BOOST_REQUIRE(problem.space->satisfiesBounds(state));
+        BOOST_REQUIRE(!opt->isCostWorseThan(sampler.heuristicSolnCost(state), bestCost));
+    }
+    problem.space->freeState(state);
+
+    // and far fewer candidates are rejected than by plain rejection sampling
+    std::vector<base::State*> states(5000);
+    problem.si->allocStates(states);
+    sampler.sampleUniformBatch(states, bestCost);
+    problem.si->freeStates(states);
+    double rejectionRate = (double)numRejectionAccepted / (double)N;
+    BOOST_CHECK_GT(sampler.getAcceptanceRate(), 2.0 * rejectionRate);
+}
@@ -0,0 +1,201 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2015, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#define BOOST_TEST_MODULE "OptimizationObjectives"
+#include <boost/test/unit_test.hpp>
+
+#include "ompl/base/SpaceInformation.h"
+#include "ompl/base/StateValidityChecker.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/base/objectives/StateCostIntegralObjective.h"
+#include "ompl/base/objectives/MechanicalWorkOptimizationObjective.h"
+#include "ompl/base/objectives/MinimaxObjective.h"
+#include "ompl/tools/config/MagicConstants.h"
+
+#include "../BoostTestTeamCityReporter.h"
+
+using namespace ompl;
+
+/** \brief A state cost integral that counts how often state costs are computed */
+class CountingObjective : public base::StateCostIntegralObjective
+{
+public:
+    CountingObjective(const base::SpaceInformationPtr &si) : base::StateCostIntegralObjective(si, true), numStateCosts(0)
+    {
+    }
+
+    virtual base::Cost stateCost(const base::State *s) const
+    {
+        ++numStateCosts;
+        const double *values = s->as<base::RealVectorStateSpace::StateType>()->values;
+        return base::Cost(1.0 + values[0] * values[0] + values[1]);
+    }
+
+    mutable unsigned int numStateCosts;
+};
+
+static base::SpaceInformationPtr unitSquare()
+{
+    base::StateSpacePtr space(new base::RealVectorStateSpace(2));
+    space->as<base::RealVectorStateSpace>()->setBounds(0.0, 1.0);
+    base::SpaceInformationPtr si(new base::SpaceInformation(space));
+    si->setStateValidityChecker(base::StateValidityCheckerPtr(new base::AllValidStateValidityChecker(si)));
+    si->setup();
+    return si;
+}
+
+BOOST_AUTO_TEST_CASE(StateCostCache)
+{
+    base::SpaceInformationPtr si = unitSquare();
+    CountingObjective opt(si);
+    base::State *s = si->allocState();
+    base::StateSamplerPtr sampler = si->allocStateSampler();
+    sampler->sampleUniform(s);
+
+    // without caching, every call computes the cost
+    opt.cachedStateCost(s);
+    opt.cachedStateCost(s);
+    BOOST_CHECK_EQUAL(opt.numStateCosts, 2u);
+    BOOST_CHECK_EQUAL(opt.getStateCostCacheSize(), 0u);
+
+    // a hit does not compute the cost again
+    opt.setStateCostCaching(true);
+    base::Cost c = opt.cachedStateCost(s);
+    BOOST_CHECK_EQUAL(opt.numStateCosts, 3u);
+    BOOST_CHECK_EQUAL(opt.cachedStateCost(s).value(), c.value());
+    BOOST_CHECK_EQUAL(opt.numStateCosts, 3u);
+    BOOST_CHECK_EQUAL(opt.getStateCostCacheSize(), 1u);
+
+    // changing the state in place is a miss, and updates the entry
+    s->as<base::RealVectorStateSpace::StateType>()->values[0] = 0.5;
+    s->as<base::RealVectorStateSpace::StateType>()->values[1] = 0.25;
+    BOOST_CHECK_EQUAL(opt.cachedStateCost(s).value(), 1.5);
+    BOOST_CHECK_EQUAL(opt.numStateCosts, 4u);
+    BOOST_CHECK_EQUAL(opt.cachedStateCost(s).value(), 1.5);
+    BOOST_CHECK_EQUAL(opt.numStateCosts, 4u);
+    BOOST_CHECK_EQUAL(opt.getStateCostCacheSize(), 1u);
+
+    // an invalidated entry is computed again
+    opt.invalidateCachedStateCost(s);
+    BOOST_CHECK_EQUAL(opt.getStateCostCacheSize(), 0u);
+    opt.cachedStateCost(s);
+    BOOST_CHECK_EQUAL(opt.numStateCosts, 5u);
+
+    // clearing removes every entry
+    std::vector<base::State*> states(100);
+    si->allocStates(states);
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+    {
+        sampler->sampleUniform(states[i]);
+        opt.cachedStateCost(states[i]);
+    }
+    BOOST_CHECK_EQUAL(opt.getStateCostCacheSize(), states.size() + 1);
+    opt.clearStateCostCache();
+    BOOST_CHECK_EQUAL(opt.getStateCostCacheSize(), 0u);
+    unsigned int numStateCosts = opt.numStateCosts;
+    opt.cachedStateCost(s);
+    BOOST_CHECK_EQUAL(opt.numStateCosts, numStateCosts + 1);
+
+    // disabling caching empties the cache as well
+    opt.setStateCostCaching(false);
+    BOOST_CHECK_EQUAL(opt.getStateCostCacheSize(), 0u);
+
+    si->freeStates(states);
+    si->freeState(s);
+}
+
+BOOST_AUTO_TEST_CASE(StateCostCacheIsBounded)
+{
+    base::SpaceInformationPtr si = unitSquare();
+    CountingObjective opt(si);
+    opt.setStateCostCaching(true);
+
+    // the least recently used entries are evicted once the cache is full
+    base::StateSamplerPtr sampler = si->allocStateSampler();
+    std::vector<base::State*> states(2 * magic::MAX_STATE_COST_CACHE_SIZE);
+    si->allocStates(states);
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+    {
+        sampler->sampleUniform(states[i]);
+        opt.cachedStateCost(states[i]);
+    }
+    BOOST_CHECK_LE(opt.getStateCostCacheSize(), (std::size_t)magic::MAX_STATE_COST_CACHE_SIZE);
+    BOOST_CHECK_GT(opt.getStateCostCacheSize(), (std::size_t)magic::MAX_STATE_COST_CACHE_SIZE / 2);
+
+    // recently used entries stay in the cache
+    base::State *s = si->allocState();
+    sampler->sampleUniform(s);
+    opt.cachedStateCost(s);
+    unsigned int numStateCosts = opt.numStateCosts;
+    opt.cachedStateCost(s);
+    BOOST_CHECK_EQUAL(opt.numStateCosts, numStateCosts);
+    si->freeState(s);
+    si->freeStates(states);
+}
+
+BOOST_AUTO_TEST_CASE(BatchedStateCosts)
+{
+    base::SpaceInformationPtr si = unitSquare();
+    std::vector<base::OptimizationObjectivePtr> objectives;
+    objectives.push_back(base::OptimizationObjectivePtr(new CountingObjective(si)));
+    objectives.push_back(base::OptimizationObjectivePtr(new base::MechanicalWorkOptimizationObjective(si)));
+    objectives.push_back(base::OptimizationObjectivePtr(new base::MinimaxObjective(si)));
+
+    base::StateSamplerPtr sampler = si->allocStateSampler();
+    std::vector<base::State*> states(50);
+    si->allocStates(states);
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+        sampler->sampleUniform(states[i]);
+
+    for (std::size_t k = 0 ; k < objectives.size() ; ++k)
+    {
+        // the batch gives the same costs as one state at a time
+        std::vector<base::Cost> costs;
+        objectives[k]->stateCosts(states, costs);
+        BOOST_REQUIRE_EQUAL(costs.size(), states.size());
+        for (std::size_t i = 0 ; i < states.size() ; ++i)
+            BOOST_CHECK_EQUAL(costs[i].value(), objectives[k]->stateCost(states[i]).value());
+
+        // and caching does not change the motion costs
+        std::vector<double> motionCosts;
+        for (std::size_t i = 1 ; i < states.size() ; ++i)
+            motionCosts.push_back(objectives[k]->motionCost(states[i - 1], states[i]).value());
+        objectives[k]->setStateCostCaching(true);
+        for (int pass = 0 ; pass < 2 ; ++pass)
+            for (std::size_t i = 1 ; i < states.size() ; ++i)
+                BOOST_CHECK_EQUAL(objectives[k]->motionCost(states[i - 1], states[i]).value(), motionCosts[i - 1]);
+        objectives[k]->clearStateCostCache();
+    }
+    si->freeStates(states);
+}
@@ -76,6 +76,8 @@ BOOST_AUTO_TEST_CASE(SimpleConstruction)
     // We should have #states vertices and 0 edges
     BOOST_CHECK_EQUAL( data.numVertices(), states.size() );
     BOOST_CHECK_EQUAL( data.numEdges(), 0u );
+    std::size_t vertexMemory = data.getMemoryUsage();
+    BOOST_CHECK_GE( vertexMemory, states.size() * sizeof(base::PlannerDataVertex) );
 
     // Adding edges
     for (unsigned int i = 0; i < states.size()-1; ++i)
@@ -96,6 +98,8 @@ BOOST_AUTO_TEST_CASE(SimpleConstruction)
     // We should have #states vertices and #states-1 edges at this point
     BOOST_CHECK_EQUAL( data.numVertices(), states.size() );
     BOOST_CHECK_EQUAL( data.numEdges(), states.size()-1);
+    std::size_t graphMemory = data.getMemoryUsage();
+    BOOST_CHECK_GE( graphMemory, vertexMemory + (states.size()-1) * sizeof(base::PlannerDataEdge) );
 
     // Make sure our edges are where we think they are
     for (unsigned int i = 0; i < states.size()-1; ++i)
@@ -115,6 +119,10 @@ BOOST_AUTO_TEST_CASE(SimpleConstruction)
         BOOST_CHECK_EQUAL( data.getVertex(i).getTag(), (signed)i );
     }
 
+    // The states copied when decoupling are accounted for
+    data.decoupleFromPlanner();
+    BOOST_CHECK_GE( data.getMemoryUsage(), graphMemory + states.size() * space->getStateMemoryUsage() );
+
     for (size_t i = 0; i < states.size(); ++i)
         space->freeState(states[i]);
 }
@@ -37,10 +37,12 @@
 #define BOOST_TEST_MODULE "StateStorage"
 #include <boost/test/unit_test.hpp>
 #include "ompl/base/StateStorage.h"
+#include "ompl/base/MappedStateStorage.h"
 #include "ompl/base/ScopedState.h"
 #include "ompl/base/spaces/SE3StateSpace.h"
 #include "ompl/base/spaces/SE2StateSpace.h"
 #include "../BoostTestTeamCityReporter.h"
+#include <boost/filesystem/operations.hpp>
 
 using namespace ompl;
 
@@ -110,3 +112,41 @@ BOOST_AUTO_TEST_CASE(Load)
     BOOST_CHECK_EQUAL(ssm.getMetadata(0).tag1, 2);
     BOOST_OMPL_EXPECT_NEAR(ssm.getMetadata(1).tag2, 1.0, 1e-5);
 }
+
+BOOST_AUTO_TEST_CASE(MappedStore)
+{
+    base::StateSpacePtr space(new base::SE3StateSpace());
+    base::RealVectorBounds bounds(3);
+    bounds.setLow(-1);
+    bounds.setHigh(1);
+    space->as<base::SE3StateSpace>()->setBounds(bounds);
+    space->setup();
+
+    std::string filename;
+    {
+        base::MappedStateStorage ss(space);
+        filename = ss.getFilename();
+        BOOST_CHECK(boost::filesystem::exists(filename));
+
+        // enough states to grow the file a few times
+        std::vector<base::ScopedState<> > states;
+        for (int i = 0 ; i < 5000 ; ++i)
+        {
+            states.push_back(base::ScopedState<>(space));
+            states.back().random();
+            BOOST_CHECK_EQUAL(ss.store(states.back().get()), (std::size_t) i);
+        }
+        BOOST_CHECK_EQUAL(ss.size(), states.size());
+        BOOST_CHECK_GE(ss.getFileSize(), states.size() * space->getSerializationLength());
+
+        base::ScopedState<> s(space);
+        for (std::size_t i = 0 ; i < states.size() ; ++i)
+        {
+            ss.load(i, s.get());
+            BOOST_CHECK_EQUAL(s, states[i]);
+        }
+        BOOST_CHECK_THROW(ss.load(states.size(), s.get()), Exception);
+    }
+    // the file is removed with the storage
+    BOOST_CHECK(!boost::filesystem::exists(filename));
+}
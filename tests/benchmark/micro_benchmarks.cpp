@@ -0,0 +1,668 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2015, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Micro-benchmarks for the primitives the planners spend their time in:
+   state space operations, nearest neighbor data structures, the internal
+   data structures, samplers and motion validation. Every benchmark runs a
+   batch of operations that is large enough to take at least --min-time
+   seconds, a number of times (--repetitions), and the time per operation
+   is reported as comma-separated values, so that results of different
+   builds can be compared by a script. */
+
+#include "ompl/config.h"
+#include "ompl/base/SpaceInformation.h"
+#include "ompl/base/DiscreteMotionValidator.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/base/spaces/SO2StateSpace.h"
+#include "ompl/base/spaces/SO3StateSpace.h"
+#include "ompl/base/spaces/SE2StateSpace.h"
+#include "ompl/base/spaces/SE3StateSpace.h"
+#include "ompl/base/spaces/DubinsStateSpace.h"
+#include "ompl/base/samplers/UniformValidStateSampler.h"
+#include "ompl/base/samplers/GaussianValidStateSampler.h"
+#include "ompl/base/samplers/ObstacleBasedValidStateSampler.h"
+#include "ompl/datastructures/NearestNeighborsLinear.h"
+#include "ompl/datastructures/NearestNeighborsSqrtApprox.h"
+#include "ompl/datastructures/NearestNeighborsGNAT.h"
+#if OMPL_HAVE_FLANN
+#include "ompl/datastructures/NearestNeighborsFLANN.h"
+#endif
+#include "ompl/datastructures/BinaryHeap.h"
+#include "ompl/datastructures/PDF.h"
+#include "ompl/datastructures/Grid.h"
+#include "ompl/tools/benchmark/MachineSpecs.h"
+#include "ompl/util/RandomNumbers.h"
+#include "ompl/util/Time.h"
+#include <boost/program_options.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/function.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <cmath>
+
+namespace ob = ompl::base;
+namespace po = boost::program_options;
+using namespace ompl;
+
+/// @cond IGNORE
+namespace
+{
+    // results are accumulated here, so that the compiler cannot optimize the benchmarked calls away
+    volatile double sink = 0.;
+
+    // number of random states, queries, ... that the benchmarks cycle through
+    const std::size_t POOL_SIZE = 1024;
+
+    // A benchmarked operation: perform the operation n times.
+    typedef boost::function<void(std::size_t)> Operation;
+
+    class MicroBenchmark
+    {
+    public:
+
+        MicroBenchmark(double minTime, unsigned int repetitions, const std::string &filter) :
+            minTime_(minTime), repetitions_(std::max(1u, repetitions)), filter_(filter)
+        {
+        }
+
+        /* Time \e op; \e opsPerCall is the number of primitive operations performed by one call to op */
+        void run(const std::string &group, const std::string &name, const std::string &variant,
+                 const Operation &op, std::size_t opsPerCall = 1)
+        {
+            const std::string id = group + '/' + name + '/' + variant;
+            if (!filter_.empty() && id.find(filter_) == std::string::npos)
+                return;
+
+            // find a batch size that takes at least minTime_ seconds
+            std::size_t n = 1;
+            double elapsed;
+            while ((elapsed = timeBatch(op, n)) < minTime_ && n < (std::size_t(1) << 40))
+                n = elapsed > 0. ? std::max(2 * n, (std::size_t)(1.2 * n * minTime_ / elapsed)) : 2 * n;
+
+            std::vector<double> nsPerOp(repetitions_);
+            for (unsigned int i = 0 ; i < repetitions_ ; ++i)
+                nsPerOp[i] = 1e9 * timeBatch(op, n) / (double)(n * opsPerCall);
+            std::sort(nsPerOp.begin(), nsPerOp.end());
+
+            std::stringstream row;
+            double median = repetitions_ % 2 ? nsPerOp[repetitions_ / 2] :
+                .5 * (nsPerOp[repetitions_ / 2 - 1] + nsPerOp[repetitions_ / 2]);
+            row << group << ',' << name << ',' << variant << ',' << n * opsPerCall << ',' << repetitions_ << ','
+                << median << ',' << nsPerOp.front() << ',' << nsPerOp.back() << ','
+                << (median > 0. ? 1e9 / median : 0.);
+            rows_.push_back(row.str());
+            std::cerr << id << ": " << median << " ns" << std::endl;
+        }
+
+        void write(std::ostream &out) const
+        {
+            out << "# OMPL micro-benchmarks\n";
+            out << "# version," << OMPL_VERSION << '\n';
+            out << "# host," << machine::getHostname() << '\n';
+            out << "# date," << boost::posix_time::to_iso_extended_string(time::now()) << '\n';
+            out << "# min_time," << minTime_ << '\n';
+            out << "group,name,variant,operations,repetitions,median_ns,min_ns,max_ns,ops_per_second\n";
+            for (std::size_t i = 0 ; i < rows_.size() ; ++i)
+                out << rows_[i] << '\n';
+        }
+
+    private:
+
+        static double timeBatch(const Operation &op, std::size_t n)
+        {
+            time::point start = time::now();
+            op(n);
+            return time::seconds(time::now() - start);
+        }
+
+        double                   minTime_;
+        unsigned int             repetitions_;
+        std::string              filter_;
+        std::vector<std::string> rows_;
+    };
+
+    /* A pool of random states of a space */
+    class StatePool
+    {
+    public:
+        StatePool(const ob::StateSpacePtr &space, std::size_t size) : space_(space), states_(size)
+        {
+            ob::StateSamplerPtr sampler = space_->allocStateSampler();
+            for (std::size_t i = 0 ; i < size ; ++i)
+            {
+                states_[i] = space_->allocState();
+                sampler->sampleUniform(states_[i]);
+            }
+        }
+
+        ~StatePool()
+        {
+            for (std::size_t i = 0 ; i < states_.size() ; ++i)
+                space_->freeState(states_[i]);
+        }
+
+        ob::State* operator[](std::size_t i) const
+        {
+            return states_[i % states_.size()];
+        }
+
+        const std::vector<ob::State*>& states() const
+        {
+            return states_;
+        }
+
+    private:
+        ob::StateSpacePtr        space_;
+        std::vector<ob::State*>  states_;
+    };
+
+    // the unit square (or cube, ...) is covered by a grid of circular obstacles
+    bool isStateValid(unsigned int dim, const ob::State *state)
+    {
+        const double *values = state->as<ob::RealVectorStateSpace::StateType>()->values;
+        double d2 = 0.;
+        for (unsigned int i = 0 ; i < dim ; ++i)
+        {
+            double x = 4. * values[i];
+            x = std::abs(x - std::floor(x) - .5);
+            d2 += x * x;
+        }
+        return d2 > .09;
+    }
+
+    /***************************** state spaces *****************************/
+
+    struct StateSpaceOps
+    {
+        StateSpaceOps(const ob::StateSpacePtr &space) : space(space), pool(space, POOL_SIZE),
+            sampler(space->allocStateSampler()), out(space->allocState())
+        {
+        }
+
+        ~StateSpaceOps()
+        {
+            space->freeState(out);
+        }
+
+        void allocFree(std::size_t n)
+        {
+            for (std::size_t i = 0 ; i < n ; ++i)
+                space->freeState(space->allocState());
+        }
+
+        void copy(std::size_t n)
+        {
+            for (std::size_t i = 0 ; i < n ; ++i)
+                space->copyState(out, pool[i]);
+        }
+
+        void distance(std::size_t n)
+        {
+            double d = 0.;
+            for (std::size_t i = 0 ; i < n ; ++i)
+                d += space->distance(pool[i], pool[i + 1]);
+            sink = sink + d;
+        }
+
+        void interpolate(std::size_t n)
+        {
+            for (std::size_t i = 0 ; i < n ; ++i)
+                space->interpolate(pool[i], pool[i + 1], .37, out);
+        }
+
+        void equal(std::size_t n)
+        {
+            std::size_t k = 0;
+            for (std::size_t i = 0 ; i < n ; ++i)
+                k += space->equalStates(pool[i], pool[i]);
+            sink = sink + k;
+        }
+
+        void sampleUniform(std::size_t n)
+        {
+            for (std::size_t i = 0 ; i < n ; ++i)
+                sampler->sampleUniform(out);
+        }
+
+        ob::StateSpacePtr   space;
+        StatePool           pool;
+        ob::StateSamplerPtr sampler;
+        ob::State          *out;
+    };
+
+    ob::StateSpacePtr realVectorSpace(unsigned int dim)
+    {
+        ob::RealVectorStateSpace *space = new ob::RealVectorStateSpace(dim);
+        space->setBounds(0., 1.);
+        return ob::StateSpacePtr(space);
+    }
+
+    void benchmarkStateSpaces(MicroBenchmark &mb)
+    {
+        std::vector<ob::StateSpacePtr> spaces;
+        spaces.push_back(realVectorSpace(2));
+        spaces.push_back(realVectorSpace(7));
+        spaces.push_back(realVectorSpace(30));
+        spaces.push_back(ob::StateSpacePtr(new ob::SO2StateSpace()));
+        spaces.push_back(ob::StateSpacePtr(new ob::SO3StateSpace()));
+        ob::RealVectorBounds bounds2(2), bounds3(3);
+        bounds2.setLow(0.);
+        bounds2.setHigh(1.);
+        bounds3.setLow(0.);
+        bounds3.setHigh(1.);
+        spaces.push_back(ob::StateSpacePtr(new ob::SE2StateSpace()));
+        spaces.back()->as<ob::SE2StateSpace>()->setBounds(bounds2);
+        spaces.push_back(ob::StateSpacePtr(new ob::SE3StateSpace()));
+        spaces.back()->as<ob::SE3StateSpace>()->setBounds(bounds3);
+        spaces.push_back(ob::StateSpacePtr(new ob::DubinsStateSpace(.1)));
+        spaces.back()->as<ob::SE2StateSpace>()->setBounds(bounds2);
+
+        const char *names[] = { "R2", "R7", "R30", "SO2", "SO3", "SE2", "SE3", "Dubins" };
+        for (std::size_t i = 0 ; i < spaces.size() ; ++i)
+        {
+            spaces[i]->setup();
+            StateSpaceOps ops(spaces[i]);
+            const std::string name = names[i];
+            mb.run("state_space", name, "alloc_free", boost::bind(&StateSpaceOps::allocFree, &ops, _1));
+            mb.run("state_space", name, "copy", boost::bind(&StateSpaceOps::copy, &ops, _1));
+            mb.run("state_space", name, "distance", boost::bind(&StateSpaceOps::distance, &ops, _1));
+            mb.run("state_space", name, "interpolate", boost::bind(&StateSpaceOps::interpolate, &ops, _1));
+            mb.run("state_space", name, "equal", boost::bind(&StateSpaceOps::equal, &ops, _1));
+            mb.run("state_space", name, "sample_uniform", boost::bind(&StateSpaceOps::sampleUniform, &ops, _1));
+        }
+    }
+
+    /************************ nearest neighbors ************************/
+
+    struct NearestNeighborsOps
+    {
+        NearestNeighborsOps(NearestNeighbors<ob::State*> *nn, const ob::StateSpacePtr &space, std::size_t size) :
+            nn(nn), data(space, size), queries(space, POOL_SIZE), k(10), radius(0.)
+        {
+            nn->setDistanceFunction(boost::bind(&ob::StateSpace::distance, space.get(), _1, _2));
+        }
+
+        void build(std::size_t n)
+        {
+            for (std::size_t i = 0 ; i < n ; ++i)
+            {
+                nn->clear();
+                for (std::size_t j = 0 ; j < data.states().size() ; ++j)
+                    nn->add(data[j]);
+            }
+        }
+
+        void nearestK(std::size_t n)
+        {
+            std::size_t total = 0;
+            for (std::size_t i = 0 ; i < n ; ++i)
+            {
+                nn->nearestK(queries[i], k, nbh);
+                total += nbh.size();
+            }
+            sink = sink + total;
+        }
+
+        void nearestR(std::size_t n)
+        {
+            std::size_t total = 0;
+            for (std::size_t i = 0 ; i < n ; ++i)
+            {
+                nn->nearestR(queries[i], radius, nbh);
+                total += nbh.size();
+            }
+            sink = sink + total;
+        }
+
+        // remove an element and add it back, so that the size does not change
+        void removeAdd(std::size_t n)
+        {
+            for (std::size_t i = 0 ; i < n ; ++i)
+            {
+                ob::State *s = data[i * 7919];
+                nn->remove(s);
+                nn->add(s);
+            }
+        }
+
+        // a radius for which nearestR() returns about k neighbors
+        void computeRadius(const ob::StateSpacePtr &space)
+        {
+            std::vector<double> dists;
+            for (std::size_t i = 0 ; i < 100 ; ++i)
+            {
+                nn->nearestK(queries[i], k, nbh);
+                if (!nbh.empty())
+                    dists.push_back(space->distance(queries[i], nbh.back()));
+            }
+            std::sort(dists.begin(), dists.end());
+            radius = dists.empty() ? 0. : dists[dists.size() / 2];
+        }
+
+        boost::scoped_ptr<NearestNeighbors<ob::State*> > nn;
+        StatePool                  data;
+        StatePool                  queries;
+        std::size_t                k;
+        double                     radius;
+        std::vector<ob::State*>    nbh;
+    };
+
+    NearestNeighbors<ob::State*>* allocNearestNeighbors(const std::string &backend)
+    {
+        if (backend == "Linear")
+            return new NearestNeighborsLinear<ob::State*>();
+        if (backend == "SqrtApprox")
+            return new NearestNeighborsSqrtApprox<ob::State*>();
+        if (backend == "GNAT")
+            return new NearestNeighborsGNAT<ob::State*>();
+#if OMPL_HAVE_FLANN
+        if (backend == "FLANNHierarchicalClustering")
+            return new NearestNeighborsFLANNHierarchicalClustering<ob::State*>();
+#endif
+        return NULL;
+    }
+
+    void benchmarkNearestNeighbors(MicroBenchmark &mb, std::size_t size)
+    {
+        std::vector<std::string> backends;
+        backends.push_back("Linear");
+        backends.push_back("SqrtApprox");
+        backends.push_back("GNAT");
+#if OMPL_HAVE_FLANN
+        backends.push_back("FLANNHierarchicalClustering");
+#endif
+        const unsigned int dims[] = { 2, 8, 32 };
+
+        for (std::size_t b = 0 ; b < backends.size() ; ++b)
+            for (std::size_t d = 0 ; d < sizeof(dims) / sizeof(dims[0]) ; ++d)
+            {
+                ob::StateSpacePtr space = realVectorSpace(dims[d]);
+                space->setup();
+                NearestNeighborsOps ops(allocNearestNeighbors(backends[b]), space, size);
+                const std::string name = backends[b] + "_R" + boost::lexical_cast<std::string>(dims[d]);
+                mb.run("nearest_neighbors", name, "add", boost::bind(&NearestNeighborsOps::build, &ops, _1), size);
+                ops.computeRadius(space);
+                mb.run("nearest_neighbors", name, "nearest_k", boost::bind(&NearestNeighborsOps::nearestK, &ops, _1));
+                mb.run("nearest_neighbors", name, "nearest_r", boost::bind(&NearestNeighborsOps::nearestR, &ops, _1));
+                mb.run("nearest_neighbors", name, "remove_add", boost::bind(&NearestNeighborsOps::removeAdd, &ops, _1));
+            }
+    }
+
+    /************************* data structures *************************/
+
+    struct DataStructureOps
+    {
+        typedef BinaryHeap<double> Heap;
+        typedef Grid<int>          IntGrid;
+
+        DataStructureOps(std::size_t size) : values(POOL_SIZE), grid(3)
+        {
+            for (std::size_t i = 0 ; i < values.size() ; ++i)
+                values[i] = rng.uniform01();
+            for (std::size_t i = 0 ; i < size ; ++i)
+            {
+                heap.insert(rng.uniform01());
+                pdfElements.push_back(pdf.add((int)i, rng.uniform01()));
+            }
+            IntGrid::Coord coord(3);
+            for (int x = 0 ; x < 32 ; ++x)
+                for (int y = 0 ; y < 32 ; ++y)
+                    for (int z = 0 ; z < 8 ; ++z)
+                    {
+                        coord[0] = x;
+                        coord[1] = y;
+                        coord[2] = z;
+                        IntGrid::Cell *cell = grid.createCell(coord);
+                        cell->data = x + y + z;
+                        grid.add(cell);
+                    }
+            for (std::size_t i = 0 ; i < POOL_SIZE ; ++i)
+            {
+                coord[0] = rng.uniformInt(0, 31);
+                coord[1] = rng.uniformInt(0, 31);
+                coord[2] = rng.uniformInt(0, 7);
+                coords.push_back(coord);
+            }
+        }
+
+        void heapInsertPop(std::size_t n)
+        {
+            for (std::size_t i = 0 ; i < n ; ++i)
+            {
+                heap.insert(values[i % POOL_SIZE]);
+                heap.pop();
+            }
+        }
+
+        void heapUpdate(std::size_t n)
+        {
+            for (std::size_t i = 0 ; i < n ; ++i)
+            {
+                Heap::Element *element = heap.top();
+                element->data += values[i % POOL_SIZE];
+                heap.update(element);
+            }
+        }
+
+        void pdfSample(std::size_t n)
+        {
+            int total = 0;
+            for (std::size_t i = 0 ; i < n ; ++i)
+                total += pdf.sample(values[i % POOL_SIZE]);
+            sink = sink + total;
+        }
+
+        void pdfAddRemove(std::size_t n)
+        {
+            for (std::size_t i = 0 ; i < n ; ++i)
+            {
+                std::size_t k = (i * 7919) % pdfElements.size();
+                PDF<int>::Element *element = pdfElements[k];
+                int data = element->data_;
+                pdf.remove(element);
+                pdfElements[k] = pdf.add(data, values[i % POOL_SIZE]);
+            }
+        }
+
+        void pdfUpdate(std::size_t n)
+        {
+            for (std::size_t i = 0 ; i < n ; ++i)
+                pdf.update(pdfElements[(i * 7919) % pdfElements.size()], values[i % POOL_SIZE]);
+        }
+
+        void gridGetCell(std::size_t n)
+        {
+            int total = 0;
+            for (std::size_t i = 0 ; i < n ; ++i)
+                total += grid.getCell(coords[i % POOL_SIZE])->data;
+            sink = sink + total;
+        }
+
+        void gridNeighbors(std::size_t n)
+        {
+            std::size_t total = 0;
+            IntGrid::CellArray nbh;
+            for (std::size_t i = 0 ; i < n ; ++i)
+            {
+                nbh.clear();
+                grid.neighbors(coords[i % POOL_SIZE], nbh);
+                total += nbh.size();
+            }
+            sink = sink + total;
+        }
+
+        RNG                            rng;
+        std::vector<double>            values;
+        Heap                           heap;
+        PDF<int>                       pdf;
+        std::vector<PDF<int>::Element*> pdfElements;
+        IntGrid                        grid;
+        std::vector<IntGrid::Coord>    coords;
+    };
+
+    void benchmarkDataStructures(MicroBenchmark &mb, std::size_t size)
+    {
+        DataStructureOps ops(size);
+        const std::string name = boost::lexical_cast<std::string>(size);
+        mb.run("binary_heap", name, "insert_pop", boost::bind(&DataStructureOps::heapInsertPop, &ops, _1));
+        mb.run("binary_heap", name, "update", boost::bind(&DataStructureOps::heapUpdate, &ops, _1));
+        mb.run("pdf", name, "sample", boost::bind(&DataStructureOps::pdfSample, &ops, _1));
+        mb.run("pdf", name, "remove_add", boost::bind(&DataStructureOps::pdfAddRemove, &ops, _1));
+        mb.run("pdf", name, "update", boost::bind(&DataStructureOps::pdfUpdate, &ops, _1));
+        mb.run("grid", "8192", "get_cell", boost::bind(&DataStructureOps::gridGetCell, &ops, _1));
+        mb.run("grid", "8192", "neighbors", boost::bind(&DataStructureOps::gridNeighbors, &ops, _1));
+    }
+
+    /******************* samplers and motion validation *******************/
+
+    struct ValidityOps
+    {
+        ValidityOps(unsigned int dim) : space(realVectorSpace(dim)), si(new ob::SpaceInformation(space)),
+            pool(space, POOL_SIZE), out(NULL)
+        {
+            si->setStateValidityChecker(boost::bind(&isStateValid, dim, _1));
+            si->setStateValidityCheckingResolution(0.01);
+            si->setup();
+            out = si->allocState();
+            motionValidator.reset(new ob::DiscreteMotionValidator(si));
+        }
+
+        ~ValidityOps()
+        {
+            si->freeState(out);
+        }
+
+        void sample(const ob::ValidStateSamplerPtr &sampler, std::size_t n)
+        {
+            for (std::size_t i = 0 ; i < n ; ++i)
+                sampler->sample(out);
+        }
+
+        void isValid(std::size_t n)
+        {
+            std::size_t k = 0;
+            for (std::size_t i = 0 ; i < n ; ++i)
+                k += si->isValid(pool[i]);
+            sink = sink + k;
+        }
+
+        // motions of length at most 0.1 from the states in the pool
+        void checkMotion(std::size_t n)
+        {
+            std::size_t k = 0;
+            for (std::size_t i = 0 ; i < n ; ++i)
+            {
+                space->interpolate(pool[i], pool[i + 1], .1 / std::max(.1, space->distance(pool[i], pool[i + 1])), out);
+                k += motionValidator->checkMotion(pool[i], out);
+            }
+            sink = sink + k;
+        }
+
+        ob::StateSpacePtr         space;
+        ob::SpaceInformationPtr   si;
+        StatePool                 pool;
+        ob::State                *out;
+        ob::MotionValidatorPtr    motionValidator;
+    };
+
+    void benchmarkValidity(MicroBenchmark &mb)
+    {
+        const unsigned int dims[] = { 2, 6 };
+        for (std::size_t d = 0 ; d < sizeof(dims) / sizeof(dims[0]) ; ++d)
+        {
+            ValidityOps ops(dims[d]);
+            const std::string name = "R" + boost::lexical_cast<std::string>(dims[d]);
+            ob::ValidStateSamplerPtr uniform(new ob::UniformValidStateSampler(ops.si.get()));
+            ob::ValidStateSamplerPtr gaussian(new ob::GaussianValidStateSampler(ops.si.get()));
+            ob::ValidStateSamplerPtr obstacleBased(new ob::ObstacleBasedValidStateSampler(ops.si.get()));
+            mb.run("valid_state_sampler", name, "uniform", boost::bind(&ValidityOps::sample, &ops, uniform, _1));
+            mb.run("valid_state_sampler", name, "gaussian", boost::bind(&ValidityOps::sample, &ops, gaussian, _1));
+            mb.run("valid_state_sampler", name, "obstacle_based", boost::bind(&ValidityOps::sample, &ops, obstacleBased, _1));
+            mb.run("state_validity", name, "is_valid", boost::bind(&ValidityOps::isValid, &ops, _1));
+            mb.run("discrete_motion_validator", name, "check_motion", boost::bind(&ValidityOps::checkMotion, &ops, _1));
+        }
+    }
+}
+/// @endcond
+
+int main(int argc, char **argv)
+{
+    double minTime;
+    unsigned int repetitions, nnSize, dsSize, seed;
+    std::string filter, output;
+
+    po::options_description desc("Options");
+    desc.add_options()
+        ("help", "show help message")
+        ("min-time", po::value<double>(&minTime)->default_value(.05), "minimum duration of a timed batch of operations, in seconds")
+        ("repetitions", po::value<unsigned int>(&repetitions)->default_value(5), "number of timed batches per benchmark")
+        ("filter", po::value<std::string>(&filter)->default_value(""), "only run the benchmarks whose group/name/variant contains this string")
+        ("nn-size", po::value<unsigned int>(&nnSize)->default_value(10000), "number of elements in the nearest neighbor data structures")
+        ("ds-size", po::value<unsigned int>(&dsSize)->default_value(10000), "number of elements in the heap and the PDF")
+        ("seed", po::value<unsigned int>(&seed)->default_value(1), "random seed")
+        ("output", po::value<std::string>(&output)->default_value(""), "file to write the results to (standard output by default)")
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help"))
+    {
+        std::cout << desc << "\n";
+        return 1;
+    }
+
+    msg::setLogLevel(msg::LOG_WARN);
+    RNG::setSeed(seed);
+
+    MicroBenchmark mb(minTime, repetitions, filter);
+    benchmarkStateSpaces(mb);
+    benchmarkNearestNeighbors(mb, nnSize);
+    benchmarkDataStructures(mb, dsSize);
+    benchmarkValidity(mb);
+
+    if (output.empty())
+        mb.write(std::cout);
+    else
+    {
+        std::ofstream out(output.c_str());
+        mb.write(out);
+    }
+    return 0;
+}
@@ -39,6 +39,7 @@
 
 #include <algorithm>
 #include <boost/unordered_set.hpp>
+#include <boost/thread.hpp>
 
 #include "ompl/config.h"
 #include "ompl/datastructures/NearestNeighborsSqrtApprox.h"
@@ -96,6 +97,18 @@ public:
     }
 };
 
+// a GNAT that computes the distances for every node split in parallel
+template<typename _T>
+class NearestNeighborsGNATp : public NearestNeighborsGNAT<_T>
+{
+public:
+    NearestNeighborsGNATp() : NearestNeighborsGNAT<_T>(4,2,6,5,5)
+    {
+        this->setNumSplitThreads(3);
+        this->pivotSelector_.setMinParallelSize(0);
+    }
+};
+
 
 NearestNeighborConfig nnConfig;
 
@@ -128,6 +141,8 @@ void stateSpaceTest(base::StateSpace& space, NearestNeighbors<base::State*>& pro
     proximityLinear.add(states);
 
     BOOST_CHECK_EQUAL((int)proximity.size(), n);
+    std::size_t memory = proximity.getMemoryUsage();
+    BOOST_CHECK_GE(memory, n * sizeof(base::State*));
 
     proximity.list(nghbr);
     BOOST_CHECK_EQUAL(nghbr.size(),proximity.size());
@@ -180,6 +195,7 @@ void stateSpaceTest(base::StateSpace& space, NearestNeighbors<base::State*>& pro
         proximity.list(nghbr);
         BOOST_CHECK_EQUAL((int)nghbr.size(), i);
     }
+    BOOST_CHECK_LE(proximity.getMemoryUsage(), memory);
     try
     {
         s = proximity.nearest(states[0]);
@@ -268,6 +284,250 @@ void randomAccessPatternTest(base::StateSpace& space, NearestNeighbors<base::Sta
         space.freeState(*it);
 }
 
+bool isMarked(const boost::unordered_set<base::State*> *marked, base::State* const &s)
+{
+    return marked->find(s) != marked->end();
+}
+
+void removeIfTest(base::StateSpace& space, NearestNeighbors<base::State*>& proximity, bool approximate)
+{
+    RNG rng;
+    int i;
+    unsigned int p;
+    base::StateSamplerPtr sampler(space.allocStateSampler());
+    std::vector<base::State*> states(n), nghbr, nghbrGroundTruth;
+    NearestNeighborsLinear<base::State*> proximityLinear;
+    boost::unordered_set<base::State*> marked;
+    base::State* s = space.allocState();
+
+    proximity.setDistanceFunction(boost::bind(&base::StateSpace::distance, &space, _1, _2));
+    proximityLinear.setDistanceFunction(boost::bind(&base::StateSpace::distance, &space, _1, _2));
+
+    for (i=0; i<n; ++i)
+    {
+        states[i] = space.allocState();
+        sampler->sampleUniform(states[i]);
+        proximity.add(states[i]);
+        proximityLinear.add(states[i]);
+    }
+
+    // first remove a few elements, then most of the remaining ones
+    double fractions[2] = { .1, .8 };
+    for (unsigned int f=0; f<2; ++f)
+    {
+        marked.clear();
+        proximityLinear.list(nghbr);
+        for (p=0; p<nghbr.size(); ++p)
+            if (rng.uniform01() < fractions[f])
+                marked.insert(nghbr[p]);
+
+        std::size_t sz = proximity.size();
+        BOOST_CHECK_EQUAL(proximity.removeIf(boost::bind(&isMarked, &marked, _1)), marked.size());
+        proximityLinear.removeIf(boost::bind(&isMarked, &marked, _1));
+        BOOST_CHECK_EQUAL(proximity.size(), sz - marked.size());
+        BOOST_CHECK_EQUAL(proximity.size(), proximityLinear.size());
+        BOOST_CHECK_GE(proximity.getMemoryUsage(), proximity.size() * sizeof(base::State*));
+        proximity.list(nghbr);
+        BOOST_CHECK_EQUAL(nghbr.size(), proximity.size());
+        for (p=0; p<nghbr.size(); ++p)
+            BOOST_CHECK(!isMarked(&marked, nghbr[p]));
+
+        for (i=0; i<20 && !approximate; ++i)
+        {
+            sampler->sampleUniform(s);
+            proximityLinear.nearestK(s, maxk, nghbrGroundTruth);
+            proximity.nearestK(s, maxk, nghbr);
+            BOOST_CHECK_EQUAL(nghbr.size(), nghbrGroundTruth.size());
+            for (p=0; p<nghbr.size(); ++p)
+                BOOST_OMPL_EXPECT_NEAR(space.distance(s, nghbrGroundTruth[p]), space.distance(s, nghbr[p]), eps);
+        }
+    }
+
+    space.freeState(s);
+    for (i=0; i<n; ++i)
+        space.freeState(states[i]);
+}
+
+BOOST_AUTO_TEST_CASE(ApproximateGNAT)
+{
+    base::StateSpace& space = nnConfig.space1;
+    base::StateSamplerPtr sampler(space.allocStateSampler());
+    std::vector<base::State*> states(10*n), nghbr, nghbrExact;
+    NearestNeighborsGNAT<base::State*> proximity, proximityApprox;
+    const double epsilon = .5;
+    unsigned int i, p;
+
+    proximity.setDistanceFunction(boost::bind(&base::StateSpace::distance, &space, _1, _2));
+    proximityApprox.setDistanceFunction(boost::bind(&base::StateSpace::distance, &space, _1, _2));
+    proximityApprox.setApproximationFactor(epsilon);
+    BOOST_OMPL_EXPECT_NEAR(proximityApprox.getApproximationFactor(), epsilon, eps);
+    for (i=0; i<states.size(); ++i)
+    {
+        states[i] = space.allocState();
+        sampler->sampleUniform(states[i]);
+    }
+    proximity.add(states);
+    proximityApprox.add(states);
+
+    base::State* s = space.allocState();
+    for (i=0; i<100; ++i)
+    {
+        sampler->sampleUniform(s);
+        proximity.nearestK(s, maxk, nghbrExact);
+        proximityApprox.nearestK(s, maxk, nghbr);
+        BOOST_REQUIRE_EQUAL(nghbr.size(), nghbrExact.size());
+        // the i-th neighbor is at most (1+epsilon) times further away than the true i-th neighbor
+        for (p=0; p<nghbr.size(); ++p)
+            BOOST_CHECK_LE(space.distance(s, nghbr[p]), (1. + epsilon) * space.distance(s, nghbrExact[p]) + eps);
+    }
+    BOOST_CHECK_EQUAL(proximityApprox.getNumQueries(), 100u);
+    BOOST_CHECK_LE(proximityApprox.getNumDistanceEvaluations(), proximity.getNumDistanceEvaluations());
+
+    // a query limited to a single leaf still returns k neighbors
+    proximityApprox.setMaxVisitedLeaves(1);
+    proximityApprox.resetQueryStatistics();
+    proximityApprox.nearestK(s, maxk, nghbr);
+    BOOST_CHECK_EQUAL(nghbr.size(), (std::size_t) maxk);
+    BOOST_CHECK_EQUAL(proximityApprox.getNumQueries(), 1u);
+    BOOST_CHECK_LT(proximityApprox.getAverageDistanceEvaluations(), (double) states.size());
+
+    space.freeState(s);
+    for (i=0; i<states.size(); ++i)
+        space.freeState(states[i]);
+}
+
+static void queryGNAT(const NearestNeighborsGNAT<base::State*> *proximity, const std::vector<base::State*> *queries)
+{
+    std::vector<base::State*> nghbr;
+    for (unsigned int i=0; i<queries->size(); ++i)
+        proximity->nearestK((*queries)[i], maxk, nghbr);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentGNATQueryStatistics)
+{
+    base::StateSpace& space = nnConfig.space1;
+    base::StateSamplerPtr sampler(space.allocStateSampler());
+    std::vector<base::State*> states(n), queries(100);
+    NearestNeighborsGNAT<base::State*> proximity;
+    const unsigned int numThreads = 4;
+    unsigned int i;
+
+    proximity.setDistanceFunction(boost::bind(&base::StateSpace::distance, &space, _1, _2));
+    for (i=0; i<states.size(); ++i)
+    {
+        states[i] = space.allocState();
+        sampler->sampleUniform(states[i]);
+    }
+    for (i=0; i<queries.size(); ++i)
+    {
+        queries[i] = space.allocState();
+        sampler->sampleUniform(queries[i]);
+    }
+    proximity.add(states);
+
+    boost::thread_group threads;
+    for (i=0; i<numThreads; ++i)
+        threads.create_thread(boost::bind(&queryGNAT, &proximity, &queries));
+    threads.join_all();
+    BOOST_CHECK_EQUAL(proximity.getNumQueries(), numThreads * queries.size());
+    BOOST_CHECK_GE(proximity.getNumDistanceEvaluations(), proximity.getNumQueries());
+
+    for (i=0; i<states.size(); ++i)
+        space.freeState(states[i]);
+    for (i=0; i<queries.size(); ++i)
+        space.freeState(queries[i]);
+}
+
+// the leaves of a GNAT whose elements are "out of memory"
+struct SpilledStates
+{
+    SpilledStates(const base::StateSpace &space) : space(space), numViolations(0)
+    {
+    }
+
+    void spill(const std::vector<base::State*> &states)
+    {
+        spilled.insert(states.begin(), states.end());
+    }
+
+    void load(const std::vector<base::State*> &states)
+    {
+        for (std::size_t i=0; i<states.size(); ++i)
+            spilled.erase(states[i]);
+    }
+
+    double distance(const base::State *a, const base::State *b)
+    {
+        if (spilled.count(const_cast<base::State*>(a)) || spilled.count(const_cast<base::State*>(b)))
+            ++numViolations;
+        return space.distance(a, b);
+    }
+
+    const base::StateSpace&                space;
+    boost::unordered_set<base::State*>     spilled;
+    unsigned int                           numViolations;
+};
+
+BOOST_AUTO_TEST_CASE(SpilledGNAT)
+{
+    base::StateSpace& space = nnConfig.space1;
+    base::StateSamplerPtr sampler(space.allocStateSampler());
+    std::vector<base::State*> states(10*n), nghbr, nghbrGroundTruth;
+    NearestNeighborsGNAT<base::State*> proximity;
+    NearestNeighborsLinear<base::State*> proximityLinear;
+    SpilledStates spilled(space);
+    const unsigned int maxResidentLeaves = 4;
+    unsigned int i, p;
+
+    proximity.setDistanceFunction(boost::bind(&SpilledStates::distance, &spilled, _1, _2));
+    proximityLinear.setDistanceFunction(boost::bind(&base::StateSpace::distance, &space, _1, _2));
+    proximity.setLeafSpilling(maxResidentLeaves, boost::bind(&SpilledStates::spill, &spilled, _1),
+        boost::bind(&SpilledStates::load, &spilled, _1));
+    for (i=0; i<states.size(); ++i)
+    {
+        states[i] = space.allocState();
+        sampler->sampleUniform(states[i]);
+        proximity.add(states[i]);
+        proximityLinear.add(states[i]);
+    }
+    BOOST_CHECK_LE(proximity.getNumResidentLeaves(), (std::size_t) maxResidentLeaves);
+    BOOST_CHECK_GT(proximity.getNumSpilledLeaves(), 0u);
+    BOOST_CHECK_GT(spilled.spilled.size(), 0u);
+
+    base::State* s = space.allocState();
+    for (i=0; i<100; ++i)
+    {
+        sampler->sampleUniform(s);
+        proximityLinear.nearestK(s, maxk, nghbrGroundTruth);
+        proximity.nearestK(s, maxk, nghbr);
+        BOOST_REQUIRE_EQUAL(nghbr.size(), nghbrGroundTruth.size());
+        for (p=0; p<nghbr.size(); ++p)
+        {
+            BOOST_OMPL_EXPECT_NEAR(space.distance(s, nghbrGroundTruth[p]), space.distance(s, nghbr[p]), eps);
+            // query results stay in memory until the GNAT is modified
+            BOOST_CHECK(!spilled.spilled.count(nghbr[p]));
+        }
+        // removing an element spills leaves again
+        proximity.remove(nghbr[0]);
+        proximityLinear.remove(nghbr[0]);
+    }
+    BOOST_CHECK_GT(proximity.getNumLeafLoads(), 0u);
+    BOOST_CHECK_EQUAL(proximity.size(), proximityLinear.size());
+    // the distance function was never called with an element that was out of memory
+    BOOST_CHECK_EQUAL(spilled.numViolations, 0u);
+
+    // switching spilling off brings all elements back
+    proximity.setLeafSpilling(0, NearestNeighborsGNAT<base::State*>::LeafCallback(),
+        NearestNeighborsGNAT<base::State*>::LeafCallback());
+    BOOST_CHECK_EQUAL(proximity.getNumSpilledLeaves(), 0u);
+    BOOST_CHECK_EQUAL(proximity.getNumResidentLeaves(), 0u);
+    BOOST_CHECK(spilled.spilled.empty());
+
+    space.freeState(s);
+    for (i=0; i<states.size(); ++i)
+        space.freeState(states[i]);
+}
+
 #define NN_TEST_CASES(T,approx)                          \
 BOOST_AUTO_TEST_CASE(Int##T)                             \
 {                                                        \
@@ -288,11 +548,17 @@ BOOST_AUTO_TEST_CASE(RandomAccessPatternSE3##T)          \
 {                                                        \
     NearestNeighbors##T<base::State*> proximity;         \
     randomAccessPatternTest(nnConfig.space1, proximity); \
+}                                                        \
+BOOST_AUTO_TEST_CASE(RemoveIfSE3##T)                     \
+{                                                        \
+    NearestNeighbors##T<base::State*> proximity;         \
+    removeIfTest(nnConfig.space1, proximity, approx);    \
 }
 
 NN_TEST_CASES(Linear, false)
 NN_TEST_CASES(SqrtApprox, true)
 NN_TEST_CASES(GNATs, false)
+NN_TEST_CASES(GNATp, false)
 #if OMPL_HAVE_FLANN
 NN_TEST_CASES(FLANNLinear, false)
 NN_TEST_CASES(FLANNHierarchicalClustering, true)
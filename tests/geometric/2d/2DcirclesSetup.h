@@ -44,6 +44,8 @@
 
 #include "../../resources/config.h"
 #include "../../resources/circles2D.h"
+#include "2DmotionValidator.h"
+#include <boost/bind.hpp>
 
 namespace ompl
 {
@@ -66,6 +68,11 @@ namespace ompl
                 return circles_.noOverlap(xy[0], xy[1]);
             }
 
+            const Circles2D& getCircles() const
+            {
+                return circles_;
+            }
+
         private:
             const Circles2D circles_;
         };
@@ -78,6 +85,9 @@ namespace ompl
             base::SpaceInformationPtr si(new base::SpaceInformation(base::StateSpacePtr(space)));
             StateValidityChecker2DCircles *svc = new StateValidityChecker2DCircles(si, circles);
             si->setStateValidityChecker(base::StateValidityCheckerPtr(svc));
+            // the batch checker refers to the circles of the state validity checker, which lives as long as si
+            si->setMotionValidator(base::MotionValidatorPtr(new MotionValidator2D(si, svc,
+                boost::bind(&Circles2D::firstOverlap, boost::cref(svc->getCircles()), _1, _2))));
             si->setStateValidityCheckingResolution(0.002);
             si->setup();
             return si;
@@ -49,6 +49,8 @@
 
 #include "../../resources/config.h"
 #include "../../resources/environment2D.h"
+#include "2DmotionValidator.h"
+#include <boost/bind.hpp>
 
 namespace ompl
 {
@@ -82,24 +84,54 @@ namespace ompl
         public:
 
             StateValidityChecker2DMap(const base::SpaceInformationPtr &si, const std::vector< std::vector<int> > &grid) :
-                base::StateValidityChecker(si), grid_(grid)
+                base::StateValidityChecker(si), height_(grid.empty() ? 0 : grid[0].size())
             {
+                occupied_.resize(grid.size() * height_);
+                for (std::size_t x = 0 ; x < grid.size() ; ++x)
+                    for (std::size_t y = 0 ; y < height_ ; ++y)
+                        occupied_[x * height_ + y] = grid[x][y] != 0; // 0 means valid state
             }
 
             virtual bool isValid(const base::State *state) const
             {
-                /* planning is done in a continuous space, but our collision space representation is discrete */
-                int x = (int)(state->as<base::RealVectorStateSpace::StateType>()->values[0]);
-                int y = (int)(state->as<base::RealVectorStateSpace::StateType>()->values[1]);
-                return grid_[x][y] == 0; // 0 means valid state
+                const double *xy = state->as<base::RealVectorStateSpace::StateType>()->values;
+                return isValid(xy[0], xy[1]);
+            }
+
+            /** \brief Check \e count points, given as consecutive (x, y) pairs in \e xy. Return the
+                index of the first invalid point, or \e count if all points are valid. */
+            std::size_t firstInvalid(const double *xy, std::size_t count) const
+            {
+                for (std::size_t i = 0 ; i < count ; ++i)
+                    if (!isValid(xy[2 * i], xy[2 * i + 1]))
+                        return i;
+                return count;
             }
 
         protected:
 
-            /** \brief Map of environment */
-            std::vector< std::vector<int> > grid_;
+            bool isValid(double x, double y) const
+            {
+                /* planning is done in a continuous space, but our collision space representation is discrete */
+                return !occupied_[(std::size_t)(int)x * height_ + (std::size_t)(int)y];
+            }
+
+            /** \brief Number of cells along the y axis */
+            std::size_t       height_;
+
+            /** \brief Map of environment, one cell after the other along the y axis */
+            std::vector<char> occupied_;
         };
 
+        /** \brief Use a StateValidityChecker2DMap for both states and motions */
+        static void setValidityChecking2DMap(const base::SpaceInformationPtr &si, const std::vector< std::vector<int> > &grid)
+        {
+            boost::shared_ptr<StateValidityChecker2DMap> svc(new StateValidityChecker2DMap(si, grid));
+            si->setStateValidityChecker(base::StateValidityCheckerPtr(svc));
+            si->setMotionValidator(base::MotionValidatorPtr(new MotionValidator2D(si, svc.get(),
+                boost::bind(&StateValidityChecker2DMap::firstInvalid, svc, _1, _2))));
+        }
+
         /** \brief Given a description of the environment, construct a complete planning context */
         class SimpleSetup2DMap : public SimpleSetup
         {
@@ -145,7 +177,7 @@ namespace ompl
 
                 getStateSpace()->as<StateSpace2DMap>()->setBounds(sbounds);
                 getSpaceInformation()->setStateValidityCheckingResolution(0.016);
-                setStateValidityChecker(base::StateValidityCheckerPtr(new StateValidityChecker2DMap(getSpaceInformation(), env_.grid)));
+                setValidityChecking2DMap(getSpaceInformation(), env_.grid);
 
                 /* set the initial state; the memory for this is automatically cleaned by SpaceInformation */
                 base::ScopedState<base::RealVectorStateSpace> state(getStateSpace());
@@ -195,7 +227,7 @@ namespace ompl
             base::SpaceInformationPtr si(new base::SpaceInformation(sSpacePtr));
             si->setStateValidityCheckingResolution(0.016);
 
-            si->setStateValidityChecker(base::StateValidityCheckerPtr(new StateValidityChecker2DMap(si, env.grid)));
+            setValidityChecking2DMap(si, env.grid);
 
             si->setup();
 
@@ -0,0 +1,151 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2015, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_TEST_2D_MOTION_VALIDATOR_
+#define OMPL_TEST_2D_MOTION_VALIDATOR_
+
+#include "ompl/base/MotionValidator.h"
+#include "ompl/base/DiscreteMotionValidator.h"
+#include "ompl/base/SpaceInformation.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include <boost/function.hpp>
+#include <algorithm>
+
+namespace ompl
+{
+    namespace geometric
+    {
+
+        /** \brief Motion validator for the 2D test environments. It checks the same
+            states along a motion as base::DiscreteMotionValidator, but computes them
+            directly from the (x, y) coordinates and passes them to the environment
+            in batches, instead of allocating, interpolating and checking states one
+            by one. If the state validity checker is replaced, motions are checked
+            with base::DiscreteMotionValidator instead. */
+        class MotionValidator2D : public base::MotionValidator
+        {
+        public:
+
+            /** \brief Check \e count points, given as consecutive (x, y) pairs; return the
+                index of the first invalid point, or \e count if all points are valid */
+            typedef boost::function<std::size_t(const double*, std::size_t)> BatchValidityChecker;
+
+            /** \brief Constructor. The batch \e checker has to give the same results as \e svc. */
+            MotionValidator2D(const base::SpaceInformationPtr &si, const base::StateValidityChecker *svc,
+                              const BatchValidityChecker &checker) :
+                base::MotionValidator(si), svc_(svc), checker_(checker), fallback_(si)
+            {
+            }
+
+            virtual bool checkMotion(const base::State *s1, const base::State *s2) const
+            {
+                if (si_->getStateValidityChecker().get() != svc_)
+                    return count(fallback_.checkMotion(s1, s2));
+
+                // as in DiscreteMotionValidator, the end of the motion is checked first
+                const double *xy = s2->as<base::RealVectorStateSpace::StateType>()->values;
+                int nd = countSegments(s1, s2);
+                return count(checker_(xy, 1) == 1 && firstInvalid(s1, s2, nd) == nd);
+            }
+
+            virtual bool checkMotion(const base::State *s1, const base::State *s2, std::pair<base::State*, double> &lastValid) const
+            {
+                if (si_->getStateValidityChecker().get() != svc_)
+                    return count(fallback_.checkMotion(s1, s2, lastValid));
+
+                int nd = countSegments(s1, s2);
+                int j = firstInvalid(s1, s2, nd);
+                const double *xy = s2->as<base::RealVectorStateSpace::StateType>()->values;
+                bool result = j == nd && checker_(xy, 1) == 1;
+                if (!result)
+                {
+                    // j is the first invalid point, or nd if only the end of the motion is invalid
+                    lastValid.second = (double)(j - 1) / (double)nd;
+                    if (lastValid.first)
+                        si_->getStateSpace()->interpolate(s1, s2, lastValid.second, lastValid.first);
+                }
+                return count(result);
+            }
+
+        private:
+
+            bool count(bool valid) const
+            {
+                if (valid)
+                    valid_++;
+                else
+                    invalid_++;
+                return valid;
+            }
+
+            int countSegments(const base::State *s1, const base::State *s2) const
+            {
+                return std::max(1u, si_->getStateSpace()->validSegmentCount(s1, s2));
+            }
+
+            /* Return the smallest j in [1, nd) such that the point at j / nd along the motion
+               is invalid, or nd if all of these points are valid */
+            int firstInvalid(const base::State *s1, const base::State *s2, int nd) const
+            {
+                const double *from = s1->as<base::RealVectorStateSpace::StateType>()->values;
+                const double *to = s2->as<base::RealVectorStateSpace::StateType>()->values;
+                const int batch = 64;
+                double xy[2 * batch];
+
+                for (int j = 1 ; j < nd ; j += batch)
+                {
+                    int n = std::min(batch, nd - j);
+                    for (int k = 0 ; k < n ; ++k)
+                    {
+                        // the same computation as RealVectorStateSpace::interpolate()
+                        double t = (double)(j + k) / (double)nd;
+                        xy[2 * k] = from[0] + (to[0] - from[0]) * t;
+                        xy[2 * k + 1] = from[1] + (to[1] - from[1]) * t;
+                    }
+                    std::size_t invalid = checker_(xy, n);
+                    if (invalid < (std::size_t)n)
+                        return j + (int)invalid;
+                }
+                return nd;
+            }
+
+            const base::StateValidityChecker *svc_;
+            BatchValidityChecker              checker_;
+            base::DiscreteMotionValidator     fallback_;
+        };
+
+    }
+}
+
+#endif
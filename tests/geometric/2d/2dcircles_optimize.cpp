@@ -43,8 +43,13 @@
 #include "ompl/geometric/planners/prm/PRMstar.h"
 #include "ompl/geometric/planners/rrt/RRTstar.h"
 #include "ompl/geometric/planners/cforest/CForest.h"
+#include "ompl/geometric/planners/bitstar/BITstar.h"
+#include "ompl/geometric/planners/AnytimePathShortening.h"
+#include "ompl/geometric/SimpleSetup.h"
+#include "ompl/tools/config/SelfConfig.h"
 #include "ompl/base/objectives/PathLengthOptimizationObjective.h"
 #include "ompl/base/goals/GoalState.h"
+#include "ompl/base/goals/GoalStates.h"
 #include "ompl/util/RandomNumbers.h"
 
 #include "../../BoostTestTeamCityReporter.h"
@@ -289,6 +294,32 @@ protected:
     }
 };
 
+class RRTstarOrderedRewiringTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        geometric::RRTstar *rrt = new geometric::RRTstar(si);
+        rrt->setOrderedRewiring(true);
+        rrt->setPrune(true);
+        rrt->setIncrementalPruning(true);
+        return base::PlannerPtr(rrt);
+    }
+};
+
+class BITstarParallelSamplingTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        geometric::BITstar *bit = new geometric::BITstar(si);
+        bit->setNumSamplingThreads(4);
+        return base::PlannerPtr(bit);
+    }
+};
+
 class PRMstarTest : public TestPlanner
 {
 protected:
@@ -332,6 +363,11 @@ struct InitializeRandomSeed
 };
 static const InitializeRandomSeed seed_initializer;
 
+static void countImprovedSolutions(unsigned int *calls, const base::ImprovedSolutionEvent&)
+{
+    ++*calls;
+}
+
 class PlanTest
 {
 public:
@@ -349,8 +385,196 @@ public:
         delete p;
     }
 
+    /* solve consecutive queries that share the start state with warm starting enabled */
+    void runWarmStartTest(const base::PlannerPtr &planner, bool keepsVertices)
+    {
+        geometric::SimpleSetup ss(planner->getSpaceInformation());
+        ss.setPlanner(planner);
+        ss.setWarmStart(true);
+
+        std::size_t nt = std::min<std::size_t>(3, circles_.getQueryCount());
+        unsigned int lastVertexCount = 0;
+        for (std::size_t i = 0 ; i < nt ; ++i)
+        {
+            const Circles2D::Query &q0 = circles_.getQuery(0);
+            const Circles2D::Query &q = circles_.getQuery(i);
+            base::ScopedState<> start(ss.getSpaceInformation()), goal(ss.getSpaceInformation());
+            start[0] = q0.startX_;
+            start[1] = q0.startY_;
+            goal[0] = q.goalX_;
+            goal[1] = q.goalY_;
+            ss.setStartAndGoalStates(start, goal, 1e-3);
+
+            BOOST_CHECK(ss.solve(0.5));
+            BOOST_CHECK(ss.haveExactSolutionPath());
+            if (ss.haveSolutionPath())
+            {
+                geometric::PathGeometric &path = ss.getSolutionPath();
+                BOOST_CHECK(path.check());
+                BOOST_CHECK(ss.getSpaceInformation()->equalStates(path.getState(0), start.get()));
+                BOOST_CHECK(ss.getGoal()->isSatisfied(path.getState(path.getStateCount() - 1)));
+            }
+
+            base::PlannerData pd(ss.getSpaceInformation());
+            ss.getPlannerData(pd);
+            if (keepsVertices)
+                BOOST_CHECK(pd.numVertices() >= lastVertexCount);
+            lastVertexCount = pd.numVertices();
+        }
+
+        // the planning data is discarded once the environment changed
+        ss.environmentChanged();
+        BOOST_CHECK(!ss.haveSolutionPath());
+        BOOST_CHECK(ss.solve(0.5));
+    }
+
+    /* grow the same RRT* tree while pruning it by rebuilding the nearest neighbors and by removing pruned motions
+       from them one at a time, and check that both give the same tree */
+    void runIncrementalPruningTest()
+    {
+        std::vector<std::vector<double> > edges[2];
+        for (int run = 0 ; run < 2 ; ++run)
+        {
+            RNG::ScopedSeed scope(1, 0);
+
+            base::SpaceInformationPtr si = geometric::spaceInformation2DCircles(circles_);
+            geometric::RRTstar *rrt = new geometric::RRTstar(si);
+            rrt->setPrune(true);
+            // prune whenever a state can be pruned, as incremental pruning does
+            rrt->setPruneStatesImprovementThreshold(1.0);
+            rrt->setIncrementalPruning(run == 1);
+
+            geometric::SimpleSetup ss(si);
+            ss.setPlanner(base::PlannerPtr(rrt));
+            base::OptimizationObjectivePtr opt(new base::PathLengthOptimizationObjective(si));
+            opt->setCostThreshold(opt->infiniteCost());
+            ss.setOptimizationObjective(opt);
+
+            const Circles2D::Query &q = circles_.getQuery(0);
+            base::ScopedState<> start(si), goal(si);
+            start[0] = q.startX_;
+            start[1] = q.startY_;
+            goal[0] = q.goalX_;
+            goal[1] = q.goalY_;
+            ss.setStartAndGoalStates(start, goal, 1e-3);
+            ss.setup();
+            BOOST_REQUIRE(ss.solve(base::IterationTerminationCondition(5000)));
+
+            base::PlannerData data(si);
+            ss.getPlannerData(data);
+            for (unsigned int i = 0 ; i < data.numVertices() ; ++i)
+            {
+                std::vector<unsigned int> children;
+                data.getEdges(i, children);
+                const double *from = data.getVertex(i).getState()->as<base::RealVectorStateSpace::StateType>()->values;
+                for (std::size_t j = 0 ; j < children.size() ; ++j)
+                {
+                    const double *to = data.getVertex(children[j]).getState()->as<base::RealVectorStateSpace::StateType>()->values;
+                    std::vector<double> edge(4);
+                    edge[0] = from[0];
+                    edge[1] = from[1];
+                    edge[2] = to[0];
+                    edge[3] = to[1];
+                    edges[run].push_back(edge);
+                }
+            }
+            std::sort(edges[run].begin(), edges[run].end());
+        }
+        BOOST_CHECK(!edges[0].empty());
+        BOOST_CHECK(edges[0] == edges[1]);
+    }
+
+    /* check the solutions reported through the improved solution callback */
+    void runImprovedSolutionCallbackTest(const base::PlannerPtr &planner)
+    {
+        geometric::SimpleSetup ss(planner->getSpaceInformation());
+        ss.setPlanner(planner);
+        events_.clear();
+        planner->setImprovedSolutionCallback(boost::bind(&PlanTest::recordImprovedSolution, this, _1));
+
+        const Circles2D::Query &q = circles_.getQuery(0);
+        base::ScopedState<> start(ss.getSpaceInformation()), goal(ss.getSpaceInformation());
+        start[0] = q.startX_;
+        start[1] = q.startY_;
+        goal[0] = q.goalX_;
+        goal[1] = q.goalY_;
+        ss.setStartAndGoalStates(start, goal, 1e-3);
+
+        BOOST_CHECK(ss.solve(0.5));
+        BOOST_REQUIRE(!events_.empty());
+        for (std::size_t i = 0 ; i < events_.size() ; ++i)
+        {
+            BOOST_CHECK(events_[i].planner == planner.get());
+            BOOST_CHECK(events_[i].valid);
+            if (i > 0)
+            {
+                BOOST_CHECK(events_[i].cost < events_[i - 1].cost);
+                BOOST_CHECK(events_[i].timestamp >= events_[i - 1].timestamp);
+            }
+        }
+        // the last reported solution is the best one
+        base::OptimizationObjectivePtr opt = ss.getOptimizationObjective();
+        BOOST_CHECK_CLOSE(events_.back().cost, ss.getSolutionPath().cost(opt).value(), 1e-6);
+    }
+
+    /* check the memory accounting of a planner that reports its memory usage */
+    void runMemoryUsageTest(const base::PlannerPtr &planner)
+    {
+        geometric::SimpleSetup ss(planner->getSpaceInformation());
+        ss.setPlanner(planner);
+
+        const base::Planner::PlannerProgressProperties &props = planner->getPlannerProgressProperties();
+        BOOST_CHECK(props.find("memory usage INTEGER") != props.end());
+        BOOST_CHECK(props.find("peak memory usage INTEGER") != props.end());
+
+        const Circles2D::Query &q = circles_.getQuery(0);
+        base::ScopedState<> start(ss.getSpaceInformation()), goal(ss.getSpaceInformation());
+        start[0] = q.startX_;
+        start[1] = q.startY_;
+        goal[0] = q.goalX_;
+        goal[1] = q.goalY_;
+        ss.setStartAndGoalStates(start, goal, 1e-3);
+
+        BOOST_CHECK(ss.solve(0.5));
+        std::size_t usage = planner->getMemoryUsage();
+        base::PlannerData pd(ss.getSpaceInformation());
+        ss.getPlannerData(pd);
+        // the planner stores at least the states of its graph
+        BOOST_CHECK_GE(usage, pd.numVertices() * ss.getStateSpace()->getStateMemoryUsage());
+        BOOST_CHECK_GE(planner->getPeakMemoryUsage(), usage);
+        BOOST_CHECK(pd.properties.find("peak memory usage INTEGER") != pd.properties.end());
+
+        // clearing the planner releases its memory and resets the peak
+        ss.clear();
+        BOOST_CHECK_LT(planner->getMemoryUsage(), usage);
+        BOOST_CHECK_EQUAL(planner->getPeakMemoryUsage(), planner->getMemoryUsage());
+    }
+
 protected:
 
+    struct RecordedEvent
+    {
+        const base::Planner *planner;
+        double               cost;
+        time::point          timestamp;
+        bool                 valid;
+    };
+
+    void recordImprovedSolution(const base::ImprovedSolutionEvent &event)
+    {
+        // the states are only valid during the callback, so they are checked here
+        const base::SpaceInformationPtr &si = event.planner->getSpaceInformation();
+        const base::ProblemDefinitionPtr &pdef = event.planner->getProblemDefinition();
+        RecordedEvent e;
+        e.planner = event.planner;
+        e.cost = event.cost.value();
+        e.timestamp = event.timestamp;
+        e.valid = event.states.size() >= 2 &&
+            si->equalStates(event.states.front(), pdef->getStartState(0)) &&
+            pdef->getGoal()->isSatisfied(event.states.back());
+        events_.push_back(e);
+    }
+
     PlanTest(void)
     {
         verbose_ = VERBOSE;
@@ -361,8 +585,33 @@ protected:
 
     Circles2D     circles_;
     bool          verbose_;
+    std::vector<RecordedEvent> events_;
+};
+
+/* a strip along the left side of the unit square is free, or all of it once allFree_ is set */
+class StripFreeValidityChecker : public base::StateValidityChecker
+{
+public:
+
+    StripFreeValidityChecker(const base::SpaceInformationPtr &si) : base::StateValidityChecker(si), allFree_(false)
+    {
+    }
+
+    virtual bool isValid(const base::State *state) const
+    {
+        return allFree_ || state->as<base::RealVectorStateSpace::StateType>()->values[0] < 0.1;
+    }
+
+    bool allFree_;
 };
 
+/* only thin strips at either end of the unit square are free, so most batches of samples cannot be connected to the graph */
+static bool isInEndStrip(const base::State *state)
+{
+    double x = state->as<base::RealVectorStateSpace::StateType>()->values[0];
+    return x < 0.01 || x > 0.99;
+}
+
 BOOST_FIXTURE_TEST_SUITE(MyPlanTestFixture, PlanTest)
 
 // define boost tests for a planner assuming the naming convention is followed
@@ -379,6 +628,173 @@ BOOST_FIXTURE_TEST_SUITE(MyPlanTestFixture, PlanTest)
 OMPL_PLANNER_TEST(PRMstar)
 OMPL_PLANNER_TEST(PRM)
 OMPL_PLANNER_TEST(RRTstar)
+OMPL_PLANNER_TEST(RRTstarOrderedRewiring)
 OMPL_PLANNER_TEST(CForest)
+OMPL_PLANNER_TEST(BITstarParallelSampling)
+
+BOOST_AUTO_TEST_CASE(geometric_BITstarUnconnectedBatch)
+{
+    base::RealVectorStateSpace *space = new base::RealVectorStateSpace(2);
+    space->setBounds(0.0, 1.0);
+    geometric::SimpleSetup ss((base::StateSpacePtr(space)));
+    ss.setStateValidityChecker(&isInEndStrip);
+
+    base::ScopedState<> start(ss.getSpaceInformation()), goal(ss.getSpaceInformation());
+    start[0] = 0.0;
+    start[1] = 0.5;
+    goal[0] = 1.0;
+    goal[1] = 0.5;
+    ss.setStartAndGoalStates(start, goal);
+    ss.setOptimizationObjective(base::OptimizationObjectivePtr(new base::PathLengthOptimizationObjective(ss.getSpaceInformation())));
+
+    geometric::BITstar *bit = new geometric::BITstar(ss.getSpaceInformation());
+    bit->setSamplesPerBatch(10);
+    ss.setPlanner(base::PlannerPtr(bit));
+
+    // the problem has no solution, so BIT* has to keep drawing new batches until it runs out of time
+    BOOST_CHECK_NO_THROW(ss.solve(0.2));
+    BOOST_CHECK(!ss.haveExactSolutionPath());
+}
+
+BOOST_AUTO_TEST_CASE(geometric_SelfConfigValidityCheckerChange)
+{
+    base::RealVectorStateSpace *space = new base::RealVectorStateSpace(2);
+    space->setBounds(0.0, 1.0);
+    base::SpaceInformationPtr si(new base::SpaceInformation(base::StateSpacePtr(space)));
+    si->setStateValidityChecker(base::StateValidityCheckerPtr(new StripFreeValidityChecker(si)));
+    si->setup();
+
+    tools::SelfConfig sc(si);
+    // parallel estimation is opt-in, as validity checkers are not necessarily thread safe
+    BOOST_CHECK_EQUAL(sc.getEstimationThreadCount(), 1u);
+    sc.setEstimationThreadCount(2);
+    BOOST_CHECK_EQUAL(tools::SelfConfig(si).getEstimationThreadCount(), 2u);
+    double p = sc.getProbabilityOfValidState();
+    BOOST_CHECK(p > 0.0 && p < 0.25);
+
+    // the estimates are not reused for another validity checker, even if the space is set up again before they are requested
+    si->setStateValidityChecker(base::StateValidityCheckerPtr(new base::AllValidStateValidityChecker(si)));
+    si->setup();
+    BOOST_CHECK_EQUAL(sc.getProbabilityOfValidState(), 1.0);
+    BOOST_CHECK_EQUAL(tools::SelfConfig(si).getProbabilityOfValidState(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(geometric_EnvironmentChangedEstimates)
+{
+    base::RealVectorStateSpace *space = new base::RealVectorStateSpace(2);
+    space->setBounds(0.0, 1.0);
+    geometric::SimpleSetup ss((base::StateSpacePtr(space)));
+    StripFreeValidityChecker *svc = new StripFreeValidityChecker(ss.getSpaceInformation());
+    ss.setStateValidityChecker(base::StateValidityCheckerPtr(svc));
+    ss.getSpaceInformation()->setup();
+
+    tools::SelfConfig sc(ss.getSpaceInformation());
+    double p = sc.getProbabilityOfValidState();
+    double d = sc.getAverageValidMotionLength();
+    BOOST_CHECK(p > 0.0 && p < 0.25);
+
+    // the same validity checker now checks against another scene, which the estimates do not notice by themselves
+    svc->allFree_ = true;
+    BOOST_CHECK_EQUAL(sc.getProbabilityOfValidState(), p);
+
+    // once notified, the next requests estimate again
+    ss.environmentChanged();
+    BOOST_CHECK_EQUAL(sc.getProbabilityOfValidState(), 1.0);
+    BOOST_CHECK_GT(sc.getAverageValidMotionLength(), 2.0 * d);
+}
+
+BOOST_AUTO_TEST_CASE(geometric_WarmStart)
+{
+    base::SpaceInformationPtr si = geometric::spaceInformation2DCircles(circles_);
+    runWarmStartTest(base::PlannerPtr(new geometric::RRTstar(si)), true);
+    runWarmStartTest(base::PlannerPtr(new geometric::PRM(si)), true);
+    runWarmStartTest(base::PlannerPtr(new geometric::BITstar(si)), false);
+}
+
+BOOST_AUTO_TEST_CASE(geometric_WarmStartGoalChangedInPlace)
+{
+    base::SpaceInformationPtr si = geometric::spaceInformation2DCircles(circles_);
+    geometric::SimpleSetup ss(si);
+    ss.setPlanner(base::PlannerPtr(new geometric::RRTstar(si)));
+    ss.setWarmStart(true);
+
+    const Circles2D::Query &q0 = circles_.getQuery(0);
+    const Circles2D::Query &q1 = circles_.getQuery(1);
+    base::ScopedState<> start(si), goal(si);
+    start[0] = q0.startX_;
+    start[1] = q0.startY_;
+    goal[0] = q0.goalX_;
+    goal[1] = q0.goalY_;
+    ss.setStartState(start);
+    base::GoalStates *goalStates = new base::GoalStates(si);
+    goalStates->addState(goal);
+    goalStates->setThreshold(1e-3);
+    ss.setGoal(base::GoalPtr(goalStates));
+    BOOST_CHECK(ss.solve(0.5));
+    BOOST_CHECK(ss.haveExactSolutionPath());
+
+    // the goal is the same object, but now holds another state
+    goal[0] = q1.goalX_;
+    goal[1] = q1.goalY_;
+    goalStates->clear();
+    goalStates->addState(goal);
+    BOOST_CHECK(ss.solve(0.5));
+    BOOST_REQUIRE(ss.haveExactSolutionPath());
+    geometric::PathGeometric &path = ss.getSolutionPath();
+    BOOST_CHECK(ss.getGoal()->isSatisfied(path.getState(path.getStateCount() - 1)));
+}
+
+BOOST_AUTO_TEST_CASE(geometric_RRTstarIncrementalPruning)
+{
+    runIncrementalPruningTest();
+}
+
+BOOST_AUTO_TEST_CASE(geometric_ImprovedSolutionCallback)
+{
+    base::SpaceInformationPtr si = geometric::spaceInformation2DCircles(circles_);
+    runImprovedSolutionCallbackTest(base::PlannerPtr(new geometric::RRTstar(si)));
+    runImprovedSolutionCallbackTest(base::PlannerPtr(new geometric::BITstar(si)));
+    runImprovedSolutionCallbackTest(base::PlannerPtr(new geometric::CForest(si)));
+    runImprovedSolutionCallbackTest(base::PlannerPtr(new geometric::AnytimePathShortening(si)));
+}
+
+BOOST_AUTO_TEST_CASE(geometric_CForestRestoresCallbacks)
+{
+    base::SpaceInformationPtr si = geometric::spaceInformation2DCircles(circles_);
+    geometric::CForest *cforest = new geometric::CForest(si);
+    cforest->setNumThreads(2);
+    geometric::SimpleSetup ss(si);
+    ss.setPlanner(base::PlannerPtr(cforest));
+    const Circles2D::Query &q = circles_.getQuery(0);
+    base::ScopedState<> start(si), goal(si);
+    start[0] = q.startX_;
+    start[1] = q.startY_;
+    goal[0] = q.goalX_;
+    goal[1] = q.goalY_;
+    ss.setStartAndGoalStates(start, goal, 1e-3);
+    ss.setup();
+
+    unsigned int calls = 0, reported = 0;
+    cforest->getPlannerInstance(0)->setImprovedSolutionCallback(boost::bind(&countImprovedSolutions, &calls, _1));
+    cforest->setImprovedSolutionCallback(boost::bind(&countImprovedSolutions, &reported, _1));
+
+    // the callbacks of the planner instances are replaced while CForest reports its own improvements
+    BOOST_CHECK(ss.solve(0.5));
+    BOOST_CHECK_GT(reported, 0u);
+    BOOST_CHECK_EQUAL(calls, 0u);
+
+    const base::ImprovedSolutionCallback &callback = cforest->getPlannerInstance(0)->getImprovedSolutionCallback();
+    BOOST_REQUIRE(callback);
+    callback(base::ImprovedSolutionEvent(NULL, std::vector<const base::State*>(), base::Cost(0.0)));
+    BOOST_CHECK_EQUAL(calls, 1u);
+    BOOST_CHECK(!cforest->getPlannerInstance(1)->getImprovedSolutionCallback());
+}
+
+BOOST_AUTO_TEST_CASE(geometric_MemoryUsage)
+{
+    base::SpaceInformationPtr si = geometric::spaceInformation2DCircles(circles_);
+    runMemoryUsageTest(base::PlannerPtr(new geometric::PRM(si)));
+    runMemoryUsageTest(base::PlannerPtr(new geometric::BITstar(si)));
+}
 
 BOOST_AUTO_TEST_SUITE_END()
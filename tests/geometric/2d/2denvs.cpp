@@ -53,6 +53,7 @@
 #include "ompl/geometric/planners/rrt/pRRT.h"
 #include "ompl/geometric/planners/rrt/TRRT.h"
 #include "ompl/geometric/planners/rrt/LazyRRT.h"
+#include "ompl/geometric/planners/rrt/LBTRRT.h"
 #include "ompl/geometric/planners/pdst/PDST.h"
 #include "ompl/geometric/planners/est/EST.h"
 #include "ompl/geometric/planners/stride/STRIDE.h"
@@ -62,7 +63,13 @@
 #include "ompl/geometric/planners/prm/LazyPRMstar.h"
 #include "ompl/geometric/planners/prm/SPARS.h"
 #include "ompl/geometric/planners/prm/SPARStwo.h"
+#include "ompl/geometric/planners/prm/CompactRoadmap.h"
+#include "ompl/geometric/planners/cforest/CForest.h"
+#include "ompl/geometric/planners/AnytimePathShortening.h"
+#include "ompl/tools/multiplan/ParallelPlan.h"
 #include "ompl/base/objectives/PathLengthOptimizationObjective.h"
+#include "ompl/base/DiscreteMotionValidator.h"
+#include <boost/math/constants/constants.hpp>
 
 #include "../../BoostTestTeamCityReporter.h"
 #include "../../base/PlannerTest.h"
@@ -278,6 +285,18 @@ protected:
     }
 };
 
+class pRRTDeterministicTest : public pRRTTest
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        base::PlannerPtr planner = pRRTTest::newPlanner(si);
+        planner->params().setParam("deterministic", "1");
+        return planner;
+    }
+};
+
 class TRRTTest : public TestPlanner
 {
 protected:
@@ -290,6 +309,33 @@ protected:
     }
 };
 
+class TRRTParallelTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        geometric::TRRT *rrt = new geometric::TRRT(si);
+        rrt->setRange(10.0);
+        rrt->setNumThreads(4);
+        rrt->setAdaptiveTemperature(true);
+        return base::PlannerPtr(rrt);
+    }
+};
+
+class LBTRRTTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        geometric::LBTRRT *rrt = new geometric::LBTRRT(si);
+        rrt->setRange(10.0);
+        rrt->setApproximationFactor(0.1);
+        return base::PlannerPtr(rrt);
+    }
+};
+
 class LazyRRTTest : public TestPlanner
 {
 protected:
@@ -326,6 +372,31 @@ protected:
     }
 };
 
+class SBLParallelTest : public TestPlanner
+{
+
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        geometric::SBL *sbl = new geometric::SBL(si);
+        sbl->setRange(10.0);
+        sbl->setParallelTrees(true);
+
+        std::vector<unsigned int> projection;
+        projection.push_back(0);
+        projection.push_back(1);
+
+        std::vector<double> cdim;
+        cdim.push_back(1);
+        cdim.push_back(1);
+
+        sbl->setProjectionEvaluator(base::ProjectionEvaluatorPtr(new base::RealVectorOrthogonalProjectionEvaluator(si->getStateSpace(), cdim, projection)));
+
+        return base::PlannerPtr(sbl);
+    }
+};
+
 
 class pSBLTest : public TestPlanner
 {
@@ -353,6 +424,18 @@ protected:
 
 };
 
+class pSBLDeterministicTest : public pSBLTest
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        base::PlannerPtr planner = pSBLTest::newPlanner(si);
+        planner->params().setParam("deterministic", "1");
+        return planner;
+    }
+};
+
 class KPIECE1Test : public TestPlanner
 {
 protected:
@@ -461,6 +544,37 @@ protected:
 
 };
 
+class STRIDEOutOfCoreTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        geometric::STRIDE *stride = new geometric::STRIDE(si);
+        stride->setRange(10.0);
+        stride->setMaxResidentLeaves(8);
+        return base::PlannerPtr(stride);
+    }
+
+};
+
+class APSTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        geometric::AnytimePathShortening *aps = new geometric::AnytimePathShortening(si);
+        for (unsigned int i = 0 ; i < 2 ; ++i)
+        {
+            base::PlannerPtr planner(new geometric::RRTConnect(si));
+            aps->addPlanner(planner);
+        }
+        return base::PlannerPtr(aps);
+    }
+
+};
+
 class PDSTTest : public TestPlanner
 {
 protected:
@@ -494,6 +608,18 @@ protected:
     }
 };
 
+class PRMDeterministicTest : public PRMTest
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        base::PlannerPtr planner = PRMTest::newPlanner(si);
+        planner->params().setParam("deterministic", "1");
+        return planner;
+    }
+};
+
 class PRMstarTest : public TestPlanner
 {
 protected:
@@ -551,6 +677,56 @@ protected:
     }
 };
 
+class SPARSParallelTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        geometric::SPARS *spars = new geometric::SPARS(si);
+        spars->setNumThreads(4);
+        return base::PlannerPtr(spars);
+    }
+};
+
+class SPARStwoParallelTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        geometric::SPARStwo *sparstwo = new geometric::SPARStwo(si);
+        sparstwo->setNumThreads(4);
+        return base::PlannerPtr(sparstwo);
+    }
+};
+
+class CForestDeterministicTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si)
+    {
+        geometric::CForest *cforest = new geometric::CForest(si);
+        cforest->setNumThreads(4);
+        cforest->setDeterministic(true);
+        return base::PlannerPtr(cforest);
+    }
+};
+
+/* Answer the queries (starts[i], goals[i]) with a compact roadmap; the length of each path (or -1) is stored in lengths */
+static void solveCompactRoadmapQueries(const geometric::CompactRoadmap *roadmap, const std::vector<base::State*> *starts,
+                                       const std::vector<base::State*> *goals, std::vector<double> *lengths)
+{
+    lengths->assign(starts->size(), -1.0);
+    for (std::size_t i = 0 ; i < starts->size() ; ++i)
+    {
+        geometric::PathGeometric path(roadmap->getSpaceInformation());
+        if (roadmap->solve((*starts)[i], (*goals)[i], path))
+            (*lengths)[i] = path.length();
+    }
+}
+
 class PlanTest
 {
 public:
@@ -613,6 +789,211 @@ public:
             printf("Terminated! Seeing this message means the test has passed!\n");
     }
 
+    /* solve the same problem twice, with all random number generators seeded identically, and check that the planner
+       built the same data structure and found the same path both times */
+    void deterministicTest(TestPlanner *p)
+    {
+        std::size_t vertices[2];
+        std::vector<double> paths[2];
+        for (int run = 0 ; run < 2 ; ++run)
+        {
+            RNG::ScopedSeed scope(1, 0);
+
+            geometric::SimpleSetup2DMap s(env_);
+            s.setPlanner(p->newPlanner(s.getSpaceInformation()));
+            base::OptimizationObjectivePtr opt(new base::PathLengthOptimizationObjective(s.getSpaceInformation()));
+            opt->setCostThreshold(opt->infiniteCost());
+            s.setOptimizationObjective(opt);
+            s.setup();
+            BOOST_REQUIRE(s.solve(10.0 * SOLUTION_TIME) == base::PlannerStatus::EXACT_SOLUTION);
+
+            base::PlannerData data(s.getSpaceInformation());
+            s.getPlannerData(data);
+            vertices[run] = data.numVertices();
+
+            const geometric::PathGeometric &path = s.getSolutionPath();
+            for (std::size_t i = 0 ; i < path.getStateCount() ; ++i)
+                for (unsigned int j = 0 ; j < 2 ; ++j)
+                    paths[run].push_back(path.getState(i)->as<base::RealVectorStateSpace::StateType>()->values[j]);
+        }
+        BOOST_CHECK_EQUAL(vertices[0], vertices[1]);
+        BOOST_CHECK(paths[0] == paths[1]);
+    }
+
+    /* check the grid lookup of Circles2D::noOverlap() against checking every circle, for random points, points on
+       the boundaries of the circles and points on the edges of the bounding box of the circles */
+    void circlesGridTest(const Circles2D &circles)
+    {
+        RNG rng;
+        std::vector<std::pair<double, double> > points;
+        double w = circles.maxX_ - circles.minX_, h = circles.maxY_ - circles.minY_;
+        for (unsigned int i = 0 ; i < 10000 ; ++i)
+            points.push_back(std::make_pair(rng.uniformReal(circles.minX_ - 0.1 * w, circles.maxX_ + 0.1 * w),
+                                            rng.uniformReal(circles.minY_ - 0.1 * h, circles.maxY_ + 0.1 * h)));
+        for (std::size_t i = 0 ; i < circles.circles_.size() ; ++i)
+        {
+            const Circles2D::Circle &c = circles.circles_[i];
+            for (unsigned int k = 0 ; k < 16 ; ++k)
+            {
+                double a = rng.uniformReal(0.0, 2.0 * boost::math::constants::pi<double>());
+                points.push_back(std::make_pair(c.x_ + c.r_ * cos(a), c.y_ + c.r_ * sin(a)));
+            }
+        }
+        for (unsigned int i = 0 ; i < 1000 ; ++i)
+        {
+            double x = rng.uniformReal(circles.minX_, circles.maxX_), y = rng.uniformReal(circles.minY_, circles.maxY_);
+            points.push_back(std::make_pair(x, circles.minY_));
+            points.push_back(std::make_pair(x, circles.maxY_));
+            points.push_back(std::make_pair(circles.minX_, y));
+            points.push_back(std::make_pair(circles.maxX_, y));
+        }
+        points.push_back(std::make_pair(circles.minX_, circles.minY_));
+        points.push_back(std::make_pair(circles.maxX_, circles.maxY_));
+
+        unsigned int overlapping = 0;
+        for (std::size_t i = 0 ; i < points.size() ; ++i)
+        {
+            double x = points[i].first, y = points[i].second;
+            bool noOverlap = true;
+            for (std::size_t j = 0 ; j < circles.circles_.size() && noOverlap ; ++j)
+            {
+                const Circles2D::Circle &c = circles.circles_[j];
+                noOverlap = (c.x_ - x) * (c.x_ - x) + (c.y_ - y) * (c.y_ - y) >= c.r2_;
+            }
+            BOOST_CHECK_EQUAL(circles.noOverlap(x, y), noOverlap);
+            if (!noOverlap)
+                ++overlapping;
+        }
+        BOOST_CHECK_GT(overlapping, 0u);
+    }
+
+    /* check that the motion validator of si gives the same results as base::DiscreteMotionValidator, including the
+       last valid state, for random motions of all lengths */
+    void motionValidatorTest(const base::SpaceInformationPtr &si)
+    {
+        base::DiscreteMotionValidator discrete(si);
+        const base::MotionValidatorPtr &mv = si->getMotionValidator();
+        base::StateSamplerPtr sampler = si->allocStateSampler();
+        base::State *s1 = si->allocState(), *s2 = si->allocState();
+        base::State *last1 = si->allocState(), *last2 = si->allocState();
+        unsigned int valid = 0, invalid = 0;
+        for (unsigned int i = 0 ; i < 10000 ; ++i)
+        {
+            sampler->sampleUniform(s1);
+            // half of the motions are short, so that many of them are valid
+            if (i % 2)
+                sampler->sampleUniformNear(s2, s1, 0.05 * si->getMaximumExtent());
+            else
+                sampler->sampleUniform(s2);
+
+            bool result = mv->checkMotion(s1, s2);
+            BOOST_CHECK_EQUAL(result, discrete.checkMotion(s1, s2));
+            result ? ++valid : ++invalid;
+
+            std::pair<base::State*, double> lastValid1(last1, -1.0), lastValid2(last2, -1.0);
+            bool result1 = mv->checkMotion(s1, s2, lastValid1);
+            BOOST_CHECK_EQUAL(result1, discrete.checkMotion(s1, s2, lastValid2));
+            BOOST_CHECK_EQUAL(result1, result);
+            if (!result1)
+            {
+                BOOST_CHECK_EQUAL(lastValid1.second, lastValid2.second);
+                BOOST_CHECK(si->equalStates(last1, last2));
+            }
+        }
+        BOOST_CHECK_GT(valid, 0u);
+        BOOST_CHECK_GT(invalid, 0u);
+        si->freeState(s1);
+        si->freeState(s2);
+        si->freeState(last1);
+        si->freeState(last2);
+    }
+
+    /* run the same planners twice with tools::ParallelPlan in deterministic mode, and check that the solutions
+       found and their hybridization are the same both times */
+    void parallelPlanDeterministicTest()
+    {
+        std::size_t solutions[2];
+        std::vector<double> paths[2];
+        for (int run = 0 ; run < 2 ; ++run)
+        {
+            RNG::ScopedSeed scope(1, 0);
+
+            geometric::SimpleSetup2DMap s(env_);
+            s.setup();
+            tools::ParallelPlan pp(s.getProblemDefinition());
+            for (unsigned int i = 0 ; i < 3 ; ++i)
+                pp.addPlanner(base::PlannerPtr(new geometric::RRTConnect(s.getSpaceInformation())));
+            pp.setDeterministic(true);
+            pp.setLocalSeed(7);
+            BOOST_REQUIRE(pp.solve(10.0 * SOLUTION_TIME, true) == base::PlannerStatus::EXACT_SOLUTION);
+
+            solutions[run] = s.getProblemDefinition()->getSolutionCount();
+            const geometric::PathGeometric &path = s.getSolutionPath();
+            for (std::size_t i = 0 ; i < path.getStateCount() ; ++i)
+                for (unsigned int j = 0 ; j < 2 ; ++j)
+                    paths[run].push_back(path.getState(i)->as<base::RealVectorStateSpace::StateType>()->values[j]);
+        }
+        BOOST_CHECK_EQUAL(solutions[0], solutions[1]);
+        BOOST_CHECK(paths[0] == paths[1]);
+    }
+
+    void compactRoadmapTest()
+    {
+        geometric::SimpleSetup2DMap s(env_);
+        base::SpaceInformationPtr si = s.getSpaceInformation();
+        geometric::SPARStwo *sparstwo = new geometric::SPARStwo(si);
+        s.setPlanner(base::PlannerPtr(sparstwo));
+        s.setup();
+        sparstwo->constructRoadmap(base::timedPlannerTerminationCondition(1.0), true);
+
+        geometric::CompactRoadmapPtr roadmap = sparstwo->getCompactRoadmap();
+        // SPARStwo keeps one vertex for its own queries
+        BOOST_CHECK_EQUAL(roadmap->numVertices(), sparstwo->milestoneCount() - 1);
+        BOOST_CHECK_EQUAL(roadmap->numEdges(), boost::num_edges(sparstwo->getRoadmap()));
+
+        const std::size_t N = 50;
+        base::ValidStateSamplerPtr sampler = si->allocValidStateSampler();
+        std::vector<base::State*> starts(N), goals(N);
+        si->allocStates(starts);
+        si->allocStates(goals);
+        for (std::size_t i = 0 ; i < N ; ++i)
+        {
+            BOOST_REQUIRE(sampler->sample(starts[i]));
+            BOOST_REQUIRE(sampler->sample(goals[i]));
+        }
+
+        std::size_t solved = 0;
+        std::vector<double> lengths(N, -1.0);
+        for (std::size_t i = 0 ; i < N ; ++i)
+        {
+            geometric::PathGeometric path(si);
+            if (roadmap->solve(starts[i], goals[i], path))
+            {
+                ++solved;
+                lengths[i] = path.length();
+                BOOST_CHECK(path.check());
+                BOOST_CHECK(si->equalStates(path.getState(0), starts[i]));
+                BOOST_CHECK(si->equalStates(path.getStates().back(), goals[i]));
+                BOOST_CHECK(lengths[i] >= si->distance(starts[i], goals[i]) - 1e-9);
+            }
+        }
+        BOOST_CHECK(solved > N / 2);
+
+        // concurrent queries give the same answers
+        const unsigned int numThreads = 4;
+        std::vector< std::vector<double> > threadLengths(numThreads);
+        boost::thread_group threads;
+        for (unsigned int t = 0 ; t < numThreads ; ++t)
+            threads.create_thread(boost::bind(&solveCompactRoadmapQueries, roadmap.get(), &starts, &goals, &threadLengths[t]));
+        threads.join_all();
+        for (unsigned int t = 0 ; t < numThreads ; ++t)
+            for (std::size_t i = 0 ; i < N ; ++i)
+                BOOST_CHECK_EQUAL(threadLengths[t][i], lengths[i]);
+
+        si->freeStates(starts);
+        si->freeStates(goals);
+    }
+
     void run2DMapTest(TestPlanner *p, double *success, double *avgruntime, double *avglength)
     {
         double time   = 0.0;
@@ -732,16 +1113,23 @@ BOOST_FIXTURE_TEST_SUITE(MyPlanTestFixture, PlanTest)
 OMPL_PLANNER_TEST(RRT, 99.0, 0.01)
 OMPL_PLANNER_TEST(RRTConnect, 99.0, 0.01)
 OMPL_PLANNER_TEST(pRRT, 99.0, 0.02)
+OMPL_PLANNER_TEST(pRRTDeterministic, 99.0, 0.02)
 
 // LazyRRT is a not so great, so we use more relaxed bounds
 OMPL_PLANNER_TEST(LazyRRT, 80.0, 0.3)
+// Near-optimal paths pass close to obstacle corners, which the grid check
+// occasionally finds cut between validity checks.
+OMPL_PLANNER_TEST(LBTRRT, 97.0, 0.02)
 
 OMPL_PLANNER_TEST(TRRT, 99.0, 0.01)
+OMPL_PLANNER_TEST(TRRTParallel, 99.0, 0.02)
 
 OMPL_PLANNER_TEST(PDST, 99.0, 0.03)
 
 OMPL_PLANNER_TEST(pSBL, 99.0, 0.02)
+OMPL_PLANNER_TEST(pSBLDeterministic, 99.0, 0.02)
 OMPL_PLANNER_TEST(SBL, 99.0, 0.02)
+OMPL_PLANNER_TEST(SBLParallel, 99.0, 0.02)
 
 OMPL_PLANNER_TEST(KPIECE1, 99.0, 0.01)
 OMPL_PLANNER_TEST(LBKPIECE1, 99.0, 0.02)
@@ -749,12 +1137,47 @@ OMPL_PLANNER_TEST(BKPIECE1, 99.0, 0.01)
 
 OMPL_PLANNER_TEST(EST, 99.0, 0.02)
 OMPL_PLANNER_TEST(STRIDE, 99.0, 0.02)
+OMPL_PLANNER_TEST(STRIDEOutOfCore, 99.0, 0.02)
+
+// Shortcut and hybrid paths have long segments that the grid check
+// occasionally finds cutting an obstacle corner between validity checks.
+OMPL_PLANNER_TEST(APS, 95.0, 0.02)
 
 OMPL_PLANNER_TEST(PRM, 98.0, 0.04)
+OMPL_PLANNER_TEST(PRMDeterministic, 98.0, 0.04)
 OMPL_PLANNER_TEST(PRMstar, 98.0, 0.04)
 OMPL_PLANNER_TEST(LazyPRM, 98.0, 0.04)
 OMPL_PLANNER_TEST(LazyPRMstar, 98.0, 0.04)
 OMPL_PLANNER_TEST(SPARS, 95.0, 0.04)
 OMPL_PLANNER_TEST(SPARStwo, 99.0, 0.04)
+OMPL_PLANNER_TEST(SPARSParallel, 95.0, 0.04)
+OMPL_PLANNER_TEST(SPARStwoParallel, 99.0, 0.04)
+
+BOOST_AUTO_TEST_CASE(geometric_DeterministicReplay)
+{
+    pRRTDeterministicTest prrt;
+    deterministicTest(&prrt);
+    pSBLDeterministicTest psbl;
+    deterministicTest(&psbl);
+    PRMDeterministicTest prm;
+    deterministicTest(&prm);
+    CForestDeterministicTest cforest;
+    deterministicTest(&cforest);
+    parallelPlanDeterministicTest();
+}
+
+BOOST_AUTO_TEST_CASE(geometric_EnvironmentValidityChecking)
+{
+    circlesGridTest(circles_);
+    motionValidatorTest(geometric::spaceInformation2DCircles(circles_));
+    geometric::SimpleSetup2DMap s(env_);
+    s.getSpaceInformation()->setup();
+    motionValidatorTest(s.getSpaceInformation());
+}
+
+BOOST_AUTO_TEST_CASE(geometric_SPARStwoCompactRoadmap)
+{
+    compactRoadmapTest();
+}
 
 BOOST_AUTO_TEST_SUITE_END()
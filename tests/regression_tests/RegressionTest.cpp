@@ -44,10 +44,14 @@
 
 // This is copied from the latest version.
 #include "../geometric/2d/2DcirclesSetup.h"
+#include "../geometric/2d/2DmapSetup.h"
 
 #include "ompl/tools/benchmark/Benchmark.h"
 
 #include "ompl/base/spaces/RealVectorStateProjections.h"
+#include "ompl/base/spaces/SO2StateSpace.h"
+#include "ompl/base/spaces/SE3StateSpace.h"
+#include "ompl/util/RandomNumbers.h"
 
 #include "ompl/geometric/planners/kpiece/LBKPIECE1.h"
 #include "ompl/geometric/planners/kpiece/BKPIECE1.h"
@@ -74,8 +78,18 @@
 
 #if OMPL_VERSION_VALUE >= 14000
 #include "ompl/geometric/planners/stride/STRIDE.h"
+#include "ompl/geometric/planners/rrt/RRTstar.h"
+#include "ompl/base/objectives/PathLengthOptimizationObjective.h"
 #endif
 
+#if OMPL_VERSION_VALUE >= 1000000
+#include "ompl/geometric/planners/bitstar/BITstar.h"
+#endif
+
+#include <boost/math/constants/constants.hpp>
+#include <boost/lexical_cast.hpp>
+#include <limits>
+
 using namespace ompl;
 
 #if OMPL_VERSION_VALUE > 9000
@@ -92,6 +106,40 @@ void addPlanner(Benchmark &benchmark, const base::SpaceInformationPtr &si)
 }
 
 #include "RegressionTestCirclesProblem.inl.h"
+#include "RegressionTest2DMapProblem.inl.h"
+#include "RegressionTestKinematicChainProblem.inl.h"
+#include "RegressionTestHypercubeProblem.inl.h"
+#include "RegressionTestSE3Problem.inl.h"
+
+// Settings shared by all experiments
+struct RegressionSettings
+{
+    RegressionSettings() : runtimeLimit(1.), memoryLimit(4096.), runCount(1000),
+        optimizationRunCount(100), seed(1)
+    {
+    }
+
+    double       runtimeLimit;
+    double       memoryLimit;
+    unsigned int runCount;
+    unsigned int optimizationRunCount;
+    unsigned int seed;
+    std::vector<std::string> problems;
+};
+
+template<unsigned int PROBLEM>
+void addAllOptimizingPlanners(Benchmark &b, geometric::SimpleSetup &ss)
+{
+#if OMPL_VERSION_VALUE >= 14000
+    // RRT*
+    addPlanner<geometric::RRTstar, PROBLEM>(b, ss.getSpaceInformation());
+#endif
+
+#if OMPL_VERSION_VALUE >= 1000000
+    // BIT*
+    addPlanner<geometric::BITstar, PROBLEM>(b, ss.getSpaceInformation());
+#endif
+}
 
 template<unsigned int PROBLEM>
 void addAllPlanners(Benchmark &b, geometric::SimpleSetup &ss)
@@ -117,6 +165,9 @@ void addAllPlanners(Benchmark &b, geometric::SimpleSetup &ss)
 #if OMPL_VERSION_VALUE >= 13000
     addPlanner<geometric::PDST, PROBLEM>(b, ss.getSpaceInformation());
 #endif
+
+    // the asymptotically optimal planners stop at their first solution here
+    addAllOptimizingPlanners<PROBLEM>(b, ss);
 }
 
 // Setup a problem from the known set of problems included with the regression tests.
@@ -125,28 +176,73 @@ boost::shared_ptr<geometric::SimpleSetup> setupProblem()
 {
     if (PROBLEM == CIRCLES_ID)
         return setupCirclesProblem(0);
+    if (PROBLEM == MAP2D_ID)
+        return setup2DMapProblem();
+    if (PROBLEM == KINEMATIC_CHAIN_ID)
+        return setupKinematicChainProblem();
+    if (PROBLEM == HYPERCUBE_ID)
+        return setupHypercubeProblem();
+    if (PROBLEM == SE3_ID)
+        return setupSE3Problem();
     fprintf(stderr, "Unknown problem '%d'", PROBLEM);
     return boost::shared_ptr<geometric::SimpleSetup>();
 }
 
+#if OMPL_VERSION_VALUE >= 14000
+// Minimize path length. With an infinite cost threshold, any solution is good enough.
+static void setPathLengthObjective(geometric::SimpleSetup &ss, double threshold)
+{
+    base::OptimizationObjectivePtr objective(new base::PathLengthOptimizationObjective(ss.getSpaceInformation()));
+    objective->setCostThreshold(base::Cost(threshold));
+    ss.setOptimizationObjective(objective);
+}
+#endif
+
+static void runBenchmark(Benchmark &b, double runtime_limit, double memory_limit, int run_count,
+    const std::string &exp_name)
+{
+#if OMPL_VERSION_VALUE > 9000
+    Benchmark::Request request(runtime_limit, memory_limit, run_count);
+    b.benchmark(request);
+#else
+    b.benchmark(runtime_limit, memory_limit, run_count);
+#endif
+
+    b.saveResultsToFile((exp_name + OMPL_VERSION + ".log").c_str());
+}
+
+// Every problem is used for two experiments: the time to the first solution is
+// measured for all planners, and the cost of the solution over time is recorded
+// for the asymptotically optimal planners, which then use all of the time they get.
 template<unsigned int PROBLEM>
-void runProblem(double runtime_limit, double memory_limit, int run_count)
+void runProblem(const RegressionSettings &settings)
 {
+    const std::string exp_name = problemName<PROBLEM>();
+    if (!settings.problems.empty() &&
+        std::find(settings.problems.begin(), settings.problems.end(), exp_name) == settings.problems.end())
+        return;
+
     boost::shared_ptr<geometric::SimpleSetup> ss = setupProblem<PROBLEM>();
     if (ss)
     {
-        const std::string exp_name = problemName<PROBLEM>();
+#if OMPL_VERSION_VALUE >= 14000
+        setPathLengthObjective(*ss, std::numeric_limits<double>::infinity());
+#endif
         Benchmark b(*ss, exp_name);
         addAllPlanners<PROBLEM>(b, *ss);
+        runBenchmark(b, settings.runtimeLimit, settings.memoryLimit, settings.runCount, exp_name);
 
-#if OMPL_VERSION_VALUE > 9000
-        Benchmark::Request request(runtime_limit, memory_limit, run_count);
-        b.benchmark(request);
-#else
-        b.benchmark(runtime_limit, memory_limit, run_count);
+#if OMPL_VERSION_VALUE >= 14000
+        if (settings.optimizationRunCount > 0)
+        {
+            ss = setupProblem<PROBLEM>();
+            setPathLengthObjective(*ss, 0.);
+            const std::string opt_exp_name = exp_name + "_optimal";
+            Benchmark bo(*ss, opt_exp_name);
+            addAllOptimizingPlanners<PROBLEM>(bo, *ss);
+            runBenchmark(bo, settings.runtimeLimit, settings.memoryLimit, settings.optimizationRunCount, opt_exp_name);
+        }
 #endif
-
-        b.saveResultsToFile((exp_name + OMPL_VERSION + ".log").c_str());
     }
     else
     {
@@ -154,11 +250,61 @@ void runProblem(double runtime_limit, double memory_limit, int run_count)
     }
 }
 
+static void printUsage(const char *program)
+{
+    fprintf(stderr,
+        "Usage: %s [options] [problem ...]\n"
+        "Problems: circles 2dmap kinematic_chain hypercube se3 (all by default)\n"
+        "Options:\n"
+        "  --time <seconds>       time limit per run (default 1)\n"
+        "  --memory <MB>          memory limit per run (default 4096)\n"
+        "  --runs <count>         runs per planner, time to first solution (default 1000)\n"
+        "  --optimal-runs <count> runs per planner, cost over time; 0 disables (default 100)\n"
+        "  --seed <seed>          random seed (default 1)\n", program);
+}
+
 int main(int argc, char **argv)
 {
-    double runtime_limit = 1, memory_limit = 4096;
-    int run_count = 1000;
-    runProblem<CIRCLES_ID>(runtime_limit, memory_limit, run_count);
+    RegressionSettings settings;
+    try
+    {
+        for (int i = 1 ; i < argc ; ++i)
+        {
+            std::string arg(argv[i]);
+            if (arg.size() > 2 && arg.substr(0, 2) == "--" && i + 1 >= argc)
+                throw boost::bad_lexical_cast();
+            if (arg == "--time")
+                settings.runtimeLimit = boost::lexical_cast<double>(argv[++i]);
+            else if (arg == "--memory")
+                settings.memoryLimit = boost::lexical_cast<double>(argv[++i]);
+            else if (arg == "--runs")
+                settings.runCount = boost::lexical_cast<unsigned int>(argv[++i]);
+            else if (arg == "--optimal-runs")
+                settings.optimizationRunCount = boost::lexical_cast<unsigned int>(argv[++i]);
+            else if (arg == "--seed")
+                settings.seed = boost::lexical_cast<unsigned int>(argv[++i]);
+            else if (arg.substr(0, 1) == "-")
+                throw boost::bad_lexical_cast();
+            else
+                settings.problems.push_back(arg);
+        }
+    }
+    catch (boost::bad_lexical_cast &)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+#if OMPL_VERSION_VALUE >= 10000
+    // with a fixed seed, every planner sees the same sequence of random numbers in every version
+    RNG::setSeed(settings.seed);
+#endif
+
+    runProblem<CIRCLES_ID>(settings);
+    runProblem<MAP2D_ID>(settings);
+    runProblem<KINEMATIC_CHAIN_ID>(settings);
+    runProblem<HYPERCUBE_ID>(settings);
+    runProblem<SE3_ID>(settings);
 
     return 0;
 }
@@ -0,0 +1,10 @@
+static const unsigned int MAP2D_ID = 2;
+
+template<>
+std::string problemName<MAP2D_ID>() { return "2dmap"; }
+
+// Setup for the first 2D map of the OMPL test suite.
+static boost::shared_ptr<geometric::SimpleSetup> setup2DMapProblem()
+{
+    return boost::shared_ptr<geometric::SimpleSetup>(new geometric::SimpleSetup2DMap("env1.txt"));
+}
@@ -0,0 +1,80 @@
+static const unsigned int HYPERCUBE_ID = 4;
+
+template<>
+std::string problemName<HYPERCUBE_ID>() { return "hypercube"; }
+
+static const unsigned int HYPERCUBE_DIMENSION = 4;
+static const double HYPERCUBE_EDGE_WIDTH = 0.1;
+
+// Only states near some edges of the unit hypercube are valid. The valid edges form a
+// narrow passage from (0,...,0) to (1,...,1). This is the problem of HypercubeBenchmark.cpp.
+static bool isHypercubeStateValid(const base::State *state)
+{
+    const base::RealVectorStateSpace::StateType *s = state->as<base::RealVectorStateSpace::StateType>();
+    bool foundMaxDim = false;
+
+    for (int i = HYPERCUBE_DIMENSION - 1; i >= 0; i--)
+        if (!foundMaxDim)
+        {
+            if ((*s)[i] > HYPERCUBE_EDGE_WIDTH)
+                foundMaxDim = true;
+        }
+        else if ((*s)[i] < (1. - HYPERCUBE_EDGE_WIDTH))
+            return false;
+    return true;
+}
+
+static boost::shared_ptr<geometric::SimpleSetup> setupHypercubeProblem()
+{
+    base::StateSpacePtr space(new base::RealVectorStateSpace(HYPERCUBE_DIMENSION));
+    base::RealVectorBounds bounds(HYPERCUBE_DIMENSION);
+    bounds.setLow(0.);
+    bounds.setHigh(1.);
+    space->as<base::RealVectorStateSpace>()->setBounds(bounds);
+
+    boost::shared_ptr<geometric::SimpleSetup> ss(new geometric::SimpleSetup(space));
+    ss->setStateValidityChecker(&isHypercubeStateValid);
+    ss->getSpaceInformation()->setStateValidityCheckingResolution(0.001);
+
+    base::ScopedState<> start(space), goal(space);
+    for (unsigned int i = 0; i < HYPERCUBE_DIMENSION; ++i)
+    {
+        start[i] = 0.;
+        goal[i] = 1.;
+    }
+    ss->setStartAndGoalStates(start, goal);
+    return ss;
+}
+
+template<typename T>
+static void addHypercubePlanner(Benchmark &benchmark, const base::SpaceInformationPtr &si)
+{
+    base::PlannerPtr planner(new T(si));
+    if (planner->params().hasParam("range"))
+        planner->params().setParam("range", boost::lexical_cast<std::string>(HYPERCUBE_EDGE_WIDTH * 0.5));
+    benchmark.addPlanner(planner);
+}
+
+template<>
+void addPlanner<geometric::EST, HYPERCUBE_ID>(Benchmark &benchmark, const base::SpaceInformationPtr &si)
+{
+    addHypercubePlanner<geometric::EST>(benchmark, si);
+}
+
+template<>
+void addPlanner<geometric::RRT, HYPERCUBE_ID>(Benchmark &benchmark, const base::SpaceInformationPtr &si)
+{
+    addHypercubePlanner<geometric::RRT>(benchmark, si);
+}
+
+template<>
+void addPlanner<geometric::KPIECE1, HYPERCUBE_ID>(Benchmark &benchmark, const base::SpaceInformationPtr &si)
+{
+    addHypercubePlanner<geometric::KPIECE1>(benchmark, si);
+}
+
+template<>
+void addPlanner<geometric::PRM, HYPERCUBE_ID>(Benchmark &benchmark, const base::SpaceInformationPtr &si)
+{
+    addHypercubePlanner<geometric::PRM>(benchmark, si);
+}
@@ -0,0 +1,234 @@
+static const unsigned int KINEMATIC_CHAIN_ID = 3;
+
+template<>
+std::string problemName<KINEMATIC_CHAIN_ID>() { return "kinematic_chain"; }
+
+static const unsigned int KINEMATIC_CHAIN_LINKS = 10;
+
+// This is the problem of KinematicChainBenchmark.cpp: a planar chain has to be
+// moved out of a horn-shaped environment.
+
+// a 2D line segment
+struct ChainSegment
+{
+    ChainSegment(double p0_x, double p0_y, double p1_x, double p1_y)
+        : x0(p0_x), y0(p0_y), x1(p1_x), y1(p1_y)
+    {
+    }
+    double x0, y0, x1, y1;
+};
+
+// the robot and environment are modeled both as a vector of segments.
+typedef std::vector<ChainSegment> ChainEnvironment;
+
+// simply use a random projection
+class KinematicChainProjector : public base::ProjectionEvaluator
+{
+public:
+    KinematicChainProjector(const base::StateSpace *space) : base::ProjectionEvaluator(space)
+    {
+        int dimension = std::max(2, (int)ceil(log((double) space->getDimension())));
+        projectionMatrix_.computeRandom(space->getDimension(), dimension);
+    }
+    virtual unsigned int getDimension(void) const
+    {
+        return projectionMatrix_.mat.size1();
+    }
+    virtual void project(const base::State *state, base::EuclideanProjection &projection) const
+    {
+        std::vector<double> v(space_->getDimension());
+        space_->copyToReals(v, state);
+        projectionMatrix_.project(&v[0], projection);
+    }
+protected:
+    base::ProjectionMatrix projectionMatrix_;
+};
+
+class KinematicChainSpace : public base::CompoundStateSpace
+{
+public:
+    KinematicChainSpace(unsigned int numLinks, double linkLength, const ChainEnvironment &env)
+        : base::CompoundStateSpace(), linkLength_(linkLength), environment_(env)
+    {
+        for (unsigned int i = 0; i < numLinks; ++i)
+            addSubspace(base::StateSpacePtr(new base::SO2StateSpace()), 1.);
+        lock();
+    }
+
+    virtual void registerProjections()
+    {
+        registerDefaultProjection(base::ProjectionEvaluatorPtr(new KinematicChainProjector(this)));
+    }
+
+    virtual double distance(const base::State *state1, const base::State *state2) const
+    {
+        const StateType *cstate1 = state1->as<StateType>();
+        const StateType *cstate2 = state2->as<StateType>();
+        double theta1 = 0., theta2 = 0., dx = 0., dy = 0., dist = 0.;
+
+        for (unsigned int i = 0; i < getSubspaceCount(); ++i)
+        {
+            theta1 += cstate1->as<base::SO2StateSpace::StateType>(i)->value;
+            theta2 += cstate2->as<base::SO2StateSpace::StateType>(i)->value;
+            dx += cos(theta1) - cos(theta2);
+            dy += sin(theta1) - sin(theta2);
+            dist += sqrt(dx * dx + dy * dy);
+        }
+        return dist * linkLength_;
+    }
+
+    double linkLength() const
+    {
+        return linkLength_;
+    }
+
+    const ChainEnvironment& environment() const
+    {
+        return environment_;
+    }
+
+protected:
+    double           linkLength_;
+    ChainEnvironment environment_;
+};
+
+class KinematicChainValidityChecker : public base::StateValidityChecker
+{
+public:
+    KinematicChainValidityChecker(const base::SpaceInformationPtr &si) : base::StateValidityChecker(si)
+    {
+    }
+
+    virtual bool isValid(const base::State *state) const
+    {
+        const KinematicChainSpace* space = si_->getStateSpace()->as<KinematicChainSpace>();
+        const KinematicChainSpace::StateType *s = state->as<KinematicChainSpace::StateType>();
+        unsigned int n = si_->getStateDimension();
+        ChainEnvironment segments;
+        double linkLength = space->linkLength();
+        double theta = 0., x = 0., y = 0., xN, yN;
+
+        segments.reserve(n + 1);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            theta += s->as<base::SO2StateSpace::StateType>(i)->value;
+            xN = x + cos(theta) * linkLength;
+            yN = y + sin(theta) * linkLength;
+            segments.push_back(ChainSegment(x, y, xN, yN));
+            x = xN;
+            y = yN;
+        }
+        xN = x + cos(theta) * 0.001;
+        yN = y + sin(theta) * 0.001;
+        segments.push_back(ChainSegment(x, y, xN, yN));
+        return selfIntersectionTest(segments) && environmentIntersectionTest(segments, space->environment());
+    }
+
+protected:
+    // return true iff env does *not* include a pair of intersecting segments
+    bool selfIntersectionTest(const ChainEnvironment& env) const
+    {
+        for (unsigned int i = 0; i < env.size(); ++i)
+            for (unsigned int j = i + 1; j < env.size(); ++j)
+                if (intersectionTest(env[i], env[j]))
+                    return false;
+        return true;
+    }
+    // return true iff no segment in env0 intersects any segment in env1
+    bool environmentIntersectionTest(const ChainEnvironment& env0, const ChainEnvironment& env1) const
+    {
+        for (unsigned int i = 0; i < env0.size(); ++i)
+            for (unsigned int j = 0; j < env1.size(); ++j)
+                if (intersectionTest(env0[i], env1[j]))
+                    return false;
+        return true;
+    }
+    // return true iff segment s0 intersects segment s1
+    bool intersectionTest(const ChainSegment& s0, const ChainSegment& s1) const
+    {
+        double s10_x = s0.x1 - s0.x0;
+        double s10_y = s0.y1 - s0.y0;
+        double s32_x = s1.x1 - s1.x0;
+        double s32_y = s1.y1 - s1.y0;
+        double denom = s10_x * s32_y - s32_x * s10_y;
+        if (fabs(denom) < std::numeric_limits<double>::epsilon())
+            return false; // Collinear
+        bool denomPositive = denom > 0;
+
+        double s02_x = s0.x0 - s1.x0;
+        double s02_y = s0.y0 - s1.y0;
+        double s_numer = s10_x * s02_y - s10_y * s02_x;
+        if ((s_numer < std::numeric_limits<float>::epsilon()) == denomPositive)
+            return false; // No collision
+        double t_numer = s32_x * s02_y - s32_y * s02_x;
+        if ((t_numer < std::numeric_limits<float>::epsilon()) == denomPositive)
+            return false; // No collision
+        if (((s_numer - denom > -std::numeric_limits<float>::epsilon()) == denomPositive)
+            || ((t_numer - denom > std::numeric_limits<float>::epsilon()) == denomPositive))
+            return false; // No collision
+        return true;
+    }
+};
+
+static ChainEnvironment createHornEnvironment(unsigned int d, double eps)
+{
+    const double pi = boost::math::constants::pi<double>();
+    ChainEnvironment env;
+    double w = 1. / (double)d, x = w, y = -eps, xN, yN, theta = 0., scale = w * (1. + pi * eps);
+
+    for (unsigned int i = 0; i < d - 1; ++i)
+    {
+        theta += pi / (double) d;
+        xN = x + cos(theta) * scale;
+        yN = y + sin(theta) * scale;
+        env.push_back(ChainSegment(x, y, xN, yN));
+        x = xN;
+        y = yN;
+    }
+
+    theta = 0.;
+    x = w;
+    y = eps;
+    scale = w * (1.0 - pi * eps);
+    for (unsigned int i = 0; i < d - 1; ++i)
+    {
+        theta += pi / d;
+        xN = x + cos(theta) * scale;
+        yN = y + sin(theta) * scale;
+        env.push_back(ChainSegment(x, y, xN, yN));
+        x = xN;
+        y = yN;
+    }
+    return env;
+}
+
+static boost::shared_ptr<geometric::SimpleSetup> setupKinematicChainProblem()
+{
+    const unsigned int numLinks = KINEMATIC_CHAIN_LINKS;
+    ChainEnvironment env = createHornEnvironment(numLinks, log((double)numLinks) / (double)numLinks);
+    base::StateSpacePtr chain(new KinematicChainSpace(numLinks, 1. / (double)numLinks, env));
+    boost::shared_ptr<geometric::SimpleSetup> ss(new geometric::SimpleSetup(chain));
+
+    ss->setStateValidityChecker(base::StateValidityCheckerPtr(
+        new KinematicChainValidityChecker(ss->getSpaceInformation())));
+
+    base::ScopedState<> start(chain), goal(chain);
+    std::vector<double> startVec(numLinks, boost::math::constants::pi<double>() / (double)numLinks);
+    std::vector<double> goalVec(numLinks, 0.);
+
+    startVec[0] = 0.;
+    goalVec[0] = boost::math::constants::pi<double>() - .001;
+    chain->setup();
+    chain->copyFromReals(start.get(), startVec);
+    chain->copyFromReals(goal.get(), goalVec);
+    ss->setStartAndGoalStates(start, goal);
+    return ss;
+}
+
+#if OMPL_VERSION_VALUE >= 1000000
+// BIT* needs an informed sampler, which is not available for this state space.
+template<>
+void addPlanner<geometric::BITstar, KINEMATIC_CHAIN_ID>(Benchmark &, const base::SpaceInformationPtr &)
+{
+}
+#endif
@@ -0,0 +1,55 @@
+static const unsigned int SE3_ID = 5;
+
+template<>
+std::string problemName<SE3_ID>() { return "se3"; }
+
+// A rod has to pass through a square window in a wall. The rod is longer than the
+// window is wide, so it has to be turned to point through the window first.
+static const double SE3_ROD_LENGTH = 0.4;
+static const double SE3_WALL_THICKNESS = 0.1;
+static const double SE3_WINDOW_SIZE = 0.3;
+
+static bool isSE3StateValid(const base::State *state)
+{
+    const base::SE3StateSpace::StateType *s = state->as<base::SE3StateSpace::StateType>();
+    const base::SO3StateSpace::StateType &q = s->rotation();
+
+    // direction of the rod: the body x axis
+    double dx = 1. - 2. * (q.y * q.y + q.z * q.z);
+    double dy = 2. * (q.x * q.y + q.w * q.z);
+    double dz = 2. * (q.x * q.z - q.w * q.y);
+
+    // check points along the rod, closer to each other than the wall is thick
+    const int n = 9;
+    for (int i = 0 ; i < n ; ++i)
+    {
+        double t = SE3_ROD_LENGTH * ((double)i / (double)(n - 1) - 0.5);
+        double x = s->getX() + t * dx, y = s->getY() + t * dy, z = s->getZ() + t * dz;
+        if (std::abs(x) < 0.5 * SE3_WALL_THICKNESS &&
+            (std::abs(y) > 0.5 * SE3_WINDOW_SIZE || std::abs(z) > 0.5 * SE3_WINDOW_SIZE))
+            return false;
+    }
+    return true;
+}
+
+static boost::shared_ptr<geometric::SimpleSetup> setupSE3Problem()
+{
+    base::StateSpacePtr space(new base::SE3StateSpace());
+    base::RealVectorBounds bounds(3);
+    bounds.setLow(-1.);
+    bounds.setHigh(1.);
+    space->as<base::SE3StateSpace>()->setBounds(bounds);
+
+    boost::shared_ptr<geometric::SimpleSetup> ss(new geometric::SimpleSetup(space));
+    ss->setStateValidityChecker(&isSE3StateValid);
+    ss->getSpaceInformation()->setStateValidityCheckingResolution(0.005);
+
+    // the rod starts and ends parallel to the wall
+    base::ScopedState<base::SE3StateSpace> start(space), goal(space);
+    start->setXYZ(-0.7, 0., 0.);
+    start->rotation().setAxisAngle(0., 0., 1., boost::math::constants::pi<double>() / 2.);
+    goal->setXYZ(0.7, 0., 0.);
+    goal->rotation().setAxisAngle(0., 1., 0., boost::math::constants::pi<double>() / 2.);
+    ss->setStartAndGoalStates(start, goal);
+    return ss;
+}
@@ -0,0 +1,296 @@
+#!/usr/bin/env python
+
+######################################################################
+# Software License Agreement (BSD License)
+#
+#  Copyright (c) 2015, Rice University
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions
+#  are met:
+#
+#   * Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#   * Redistributions in binary form must reproduce the above
+#     copyright notice, this list of conditions and the following
+#     disclaimer in the documentation and/or other materials provided
+#     with the distribution.
+#   * Neither the name of the Rice University nor the names of its
+#     contributors may be used to endorse or promote products derived
+#     from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+#  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+#  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+#  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+#  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+#  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+#  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+#  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+#  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+#  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+#  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#  POSSIBILITY OF SUCH DAMAGE.
+######################################################################
+
+# Compare the benchmark logs written by regression_test against a stored
+# baseline. For every experiment and planner, the candidate is checked for
+#  - a lower success rate,
+#  - a longer run time (the time to the first solution, unless the planner
+#    optimizes the solution until the time limit),
+#  - for planners that optimize until the time limit and report the "best cost"
+#    progress property, a longer time to the first solution and a higher
+#    solution cost at a number of points in time.
+# A difference is only reported as a regression if it exceeds a threshold and
+# is statistically significant according to a one-sided Mann-Whitney U test
+# (or a two-proportion z-test for success rates). The exit status is 1 if any
+# regression was found.
+
+from __future__ import print_function
+from sys import exit
+from os import listdir
+from os.path import isdir, join
+from math import sqrt, erfc, isinf
+from optparse import OptionParser
+
+class Experiment(object):
+    def __init__(self):
+        self.version = None
+        self.name = None
+        self.timelimit = None
+        # planner name -> list of runs, each a dict from property name to value
+        self.runs = {}
+        # planner name -> list of runs, each a list of (time, best cost) samples
+        self.progress = {}
+
+def parseVersion(version):
+    try:
+        return tuple(int(x) for x in version.split('.'))
+    except (AttributeError, ValueError):
+        return ()
+
+def propertyName(field):
+    """Strip the type from a property description, e.g., 'best cost REAL' -> 'best cost'"""
+    return ' '.join(field.split()[:-1])
+
+def toFloat(value):
+    if len(value) == 0 or value == 'nan':
+        return None
+    return float(value)
+
+def readBenchmarkLog(filename):
+    """Read a log file written by ompl::tools::Benchmark"""
+    exp = Experiment()
+    lines = iter([line.rstrip('\n') for line in open(filename)])
+    line = next(lines)
+    # older versions of the regression test prepend another version line
+    while 'version' in line.split()[:2]:
+        exp.version = line.split()[-1]
+        line = next(lines)
+    exp.name = line.split()[-1]
+    for line in lines:
+        if line.startswith('<<<|'):
+            while not line.endswith('|>>>'):
+                line = next(lines)
+        elif line.endswith('seconds per run'):
+            exp.timelimit = float(line.split()[0])
+        elif line.endswith('enum type') or line.endswith('enum types'):
+            for i in range(int(line.split()[0])):
+                next(lines)
+        elif line.endswith(' planners'):
+            break
+    for i in range(int(line.split()[0])):
+        planner = next(lines)
+        for j in range(int(next(lines).split()[0])):
+            next(lines)
+        properties = [propertyName(next(lines)) for j in range(int(next(lines).split()[0]))]
+        runs = []
+        for j in range(int(next(lines).split()[0])):
+            runs.append(dict(zip(properties, [toFloat(x) for x in next(lines).split('; ')[:-1]])))
+        exp.runs[planner] = runs
+        line = next(lines).strip()
+        if line != '.':
+            properties = [propertyName(next(lines)) for j in range(int(line.split()[0]))]
+            progress = []
+            for j in range(int(next(lines).split()[0])):
+                samples = []
+                for sample in next(lines).split(';')[:-1]:
+                    values = dict(zip(properties, sample.split(',')[:-1]))
+                    if 'time' in values and 'best cost' in values:
+                        samples.append((float(values['time']), toFloat(values['best cost'])))
+                progress.append(samples)
+            if any(len(samples) > 0 for samples in progress):
+                exp.progress[planner] = progress
+            next(lines)
+    return exp
+
+def readExperiments(path):
+    """Read all logs in a file or directory. If there is more than one log for
+    an experiment, the one of the most recent OMPL version is used."""
+    filenames = [join(path, f) for f in sorted(listdir(path)) if f.endswith('.log')] \
+        if isdir(path) else [path]
+    experiments = {}
+    for filename in filenames:
+        exp = readBenchmarkLog(filename)
+        if exp.name not in experiments or \
+            parseVersion(exp.version) >= parseVersion(experiments[exp.name].version):
+            experiments[exp.name] = exp
+    return experiments
+
+def median(values):
+    values = sorted(values)
+    n = len(values)
+    if n == 0:
+        return float('nan')
+    return values[n // 2] if n % 2 else .5 * (values[n // 2 - 1] + values[n // 2])
+
+def mannWhitneyGreater(baseline, candidate):
+    """p-value of the hypothesis that candidate values tend to be larger than
+    baseline values (normal approximation with tie correction)"""
+    n1, n2 = len(candidate), len(baseline)
+    if n1 == 0 or n2 == 0:
+        return 1.
+    values = sorted([(v, 0) for v in candidate] + [(v, 1) for v in baseline], key=lambda x: x[0])
+    n = n1 + n2
+    rankSum = 0.
+    tieCorrection = 0.
+    i = 0
+    while i < n:
+        j = i
+        while j + 1 < n and values[j + 1][0] == values[i][0]:
+            j = j + 1
+        rank = .5 * (i + j) + 1.
+        rankSum = rankSum + rank * sum(1 for k in range(i, j + 1) if values[k][1] == 0)
+        t = j - i + 1
+        tieCorrection = tieCorrection + t * t * t - t
+        i = j + 1
+    u = rankSum - .5 * n1 * (n1 + 1)
+    variance = n1 * n2 / 12. * ((n + 1) - tieCorrection / (n * (n - 1.))) if n > 1 else 0.
+    if variance <= 0.:
+        return 1.
+    z = (u - .5 * n1 * n2 - .5) / sqrt(variance)
+    return .5 * erfc(z / sqrt(2.))
+
+def proportionLower(baselineSuccesses, baselineCount, candidateSuccesses, candidateCount):
+    """p-value of the hypothesis that the candidate success rate is lower"""
+    if baselineCount == 0 or candidateCount == 0:
+        return 1.
+    p = float(baselineSuccesses + candidateSuccesses) / (baselineCount + candidateCount)
+    variance = p * (1. - p) * (1. / baselineCount + 1. / candidateCount)
+    if variance <= 0.:
+        return 1.
+    z = (float(baselineSuccesses) / baselineCount - float(candidateSuccesses) / candidateCount) / sqrt(variance)
+    return .5 * erfc(z / sqrt(2.))
+
+def relativeIncrease(baseline, candidate):
+    if baseline == candidate:
+        return 0.
+    if isinf(candidate) or baseline <= 0.:
+        return float('inf')
+    if isinf(baseline):
+        return -1.
+    return candidate / baseline - 1.
+
+class Comparison(object):
+    def __init__(self, options):
+        self.options = options
+        self.regressions = 0
+
+    def report(self, experiment, planner, measure, baseline, candidate, change, p, threshold, minDifference = 0.):
+        regression = change > threshold and p < self.options.alpha and candidate - baseline > minDifference
+        if regression:
+            self.regressions = self.regressions + 1
+        print('%-20s %-28s %-24s %12.5g %12.5g %+8.1f%% %9.3g  %s' % (experiment, planner, measure,
+            baseline, candidate, 100. * change, p, 'REGRESSION' if regression else 'ok'))
+
+    def compareValues(self, experiment, planner, measure, baseline, candidate, threshold, minDifference = 0.):
+        """Compare two samples in which smaller values are better"""
+        if len(baseline) == 0 or len(candidate) == 0:
+            return
+        mb, mc = median(baseline), median(candidate)
+        self.report(experiment, planner, measure, mb, mc, relativeIncrease(mb, mc),
+            mannWhitneyGreater(baseline, candidate), threshold, minDifference)
+
+    def compareSuccess(self, experiment, planner, baseline, candidate):
+        bs = [run.get('solved') for run in baseline if run.get('solved') is not None]
+        cs = [run.get('solved') for run in candidate if run.get('solved') is not None]
+        if len(bs) == 0 or len(cs) == 0:
+            return
+        rb, rc = sum(bs) / len(bs), sum(cs) / len(cs)
+        self.report(experiment, planner, 'success rate', rb, rc, rb - rc,
+            proportionLower(sum(bs), len(bs), sum(cs), len(cs)), self.options.solvedThreshold)
+
+    def compareProgress(self, experiment, planner, timelimit, baseline, candidate):
+        def firstSolution(samples):
+            for (time, cost) in samples:
+                if cost is not None and not isinf(cost):
+                    return time
+            return float('inf')
+        def costAt(samples, time):
+            cost = float('inf')
+            for (t, c) in samples:
+                if t > time:
+                    break
+                if c is not None:
+                    cost = c
+            return cost
+        self.compareValues(experiment, planner, 'first solution time',
+            [firstSolution(s) for s in baseline], [firstSolution(s) for s in candidate],
+            self.options.timeThreshold, self.options.minTimeDifference)
+        for fraction in self.options.checkpoints:
+            time = fraction * timelimit
+            self.compareValues(experiment, planner, 'cost at %gs' % time,
+                [costAt(s, time) for s in baseline], [costAt(s, time) for s in candidate],
+                self.options.costThreshold)
+
+    def compare(self, baseline, candidate):
+        print('%-20s %-28s %-24s %12s %12s %9s %9s' % ('experiment', 'planner', 'measure',
+            'baseline', 'candidate', 'change', 'p-value'))
+        for name in sorted(baseline.keys()):
+            if name not in candidate:
+                print('Warning: experiment %s is missing from the candidate results' % name)
+                continue
+            b, c = baseline[name], candidate[name]
+            for planner in sorted(b.runs.keys()):
+                if planner not in c.runs:
+                    print('Warning: planner %s is missing from the candidate results of %s' % (planner, name))
+                    continue
+                bt = [run['time'] for run in b.runs[planner] if run.get('time') is not None]
+                ct = [run['time'] for run in c.runs[planner] if run.get('time') is not None]
+                self.compareSuccess(name, planner, b.runs[planner], c.runs[planner])
+                self.compareValues(name, planner, 'time', bt, ct, self.options.timeThreshold,
+                    self.options.minTimeDifference)
+                # cost over time is only meaningful if the planner used all of its time
+                timelimit = min(b.timelimit, c.timelimit)
+                if planner in b.progress and planner in c.progress and \
+                    median(bt) > .9 * timelimit and median(ct) > .9 * timelimit:
+                    self.compareProgress(name, planner, timelimit, b.progress[planner], c.progress[planner])
+        return self.regressions
+
+if __name__ == "__main__":
+    usage = """%prog [options] <baseline log or directory> <candidate log or directory>"""
+    parser = OptionParser(usage)
+    parser.add_option("-t", "--time-threshold", dest="timeThreshold", type="float", default=0.1,
+        help="Largest acceptable relative increase of the median time to a solution [default: %default]")
+    parser.add_option("-m", "--min-time-difference", dest="minTimeDifference", type="float", default=0.001,
+        help="Smallest increase of the median time, in seconds, that can be a regression; "
+        "differences below the timer and scheduling noise are ignored [default: %default]")
+    parser.add_option("-c", "--cost-threshold", dest="costThreshold", type="float", default=0.05,
+        help="Largest acceptable relative increase of the median solution cost [default: %default]")
+    parser.add_option("-s", "--solved-threshold", dest="solvedThreshold", type="float", default=0.05,
+        help="Largest acceptable decrease of the success rate [default: %default]")
+    parser.add_option("-a", "--alpha", dest="alpha", type="float", default=0.01,
+        help="Significance level of the statistical tests [default: %default]")
+    parser.add_option("--checkpoints", dest="checkpoints", default="0.1,0.25,0.5,1",
+        help="Fractions of the time limit at which solution costs are compared [default: %default]")
+    (options, args) = parser.parse_args()
+    if len(args) != 2:
+        parser.error("expected a baseline and a candidate")
+    options.checkpoints = [float(x) for x in options.checkpoints.split(',')]
+
+    regressions = Comparison(options).compare(readExperiments(args[0]), readExperiments(args[1]))
+    if regressions > 0:
+        print('%d regression(s) found' % regressions)
+        exit(1)
+    print('No regressions found')
@@ -1,10 +1,23 @@
 #!/bin/bash
 
+# Usage: tests/regression_tests/regression_test.sh [baseline results directory]
+#
+# Builds and runs regression_test for every version in tests/regression_tests/VERSIONS.
+# If a directory with the results of an earlier run is given, the results of the most
+# recent version are compared against it with compare_results.py, and the exit status
+# is nonzero if there are performance regressions. Options for regression_test (e.g.,
+# "--runs 100 hypercube") can be passed in the REGRESSION_TEST_OPTIONS variable.
+
 if [ ! -e tests/regression_tests/ ] ; then
     echo "Need to run this from the OMPL root source dir."
     exit
 fi
 
+BASELINE=$1
+if [ -n "$BASELINE" ] ; then
+    BASELINE=`cd "$BASELINE" && pwd` || exit
+fi
+
 ompl_major_version() {
     grep "set(OMPL_MAJOR_VERSION" CMakeModules/OMPLVersion.cmake | sed 's/[^0-9]//g'
 }
@@ -58,7 +71,7 @@ do
     cmake -DCMAKE_BUILD_TYPE=Release -DOMPL_REGISTRATION=OFF -DPYTHON_EXEC=/usr/bin/python2.7 ..
     make -j$NPROC regression_test
     echo "Running $tag ..."
-    ./bin/regression_test
+    ./bin/regression_test $REGRESSION_TEST_OPTIONS
 
     # add OMPL version number to top of the log file
     if [ $OMPL_MAJOR_VERSION -lt 1 ] ; then
@@ -77,3 +90,8 @@ do
 done
 
 echo "Done. Results are in $LOG_RESULTS/"
+
+if [ -n "$BASELINE" ] ; then
+    echo "Comparing the results to $BASELINE ..."
+    python "$CURRENT_DIR/tests/regression_tests/compare_results.py" "$BASELINE" "$LOG_RESULTS" || exit 1
+fi
@@ -39,6 +39,8 @@
 
 #include <fstream>
 #include <vector>
+#include <limits>
+#include <cmath>
 
 struct Circles2D
 {
@@ -60,6 +62,8 @@ struct Circles2D
     {
         minX_ = minY_ = 0.0;
         maxX_ = maxY_ = 0.0;
+        cellSize_ = 1.0;
+        cellsX_ = cellsY_ = 0;
     }
 
     void loadCircles(const std::string &filename)
@@ -105,6 +109,7 @@ struct Circles2D
             }
         }
         //    std::cout << "Bounding box is [" << minX_ << ", " << minY_ << "] x [" << maxX_ << ", " << maxY_ << "]" << std::endl;
+        buildGrid();
     }
 
     void loadQueries(const std::string &filename)
@@ -134,22 +139,82 @@ struct Circles2D
 
     bool noOverlap(double x, double y) const
     {
-        for (std::size_t i = 0 ; i < circles_.size() ; ++i)
+        // points outside the bounding box of the circles cannot overlap any of them
+        if (!(x >= minX_ && x <= maxX_ && y >= minY_ && y <= maxY_) || cells_.empty())
+            return true;
+        const std::vector<unsigned int> &cell = cells_[cellIndex(x, minX_, cellsX_) * cellsY_ + cellIndex(y, minY_, cellsY_)];
+        for (std::size_t i = 0 ; i < cell.size() ; ++i)
         {
-            double dx = circles_[i].x_ - x;
-            double dy = circles_[i].y_ - y;
-            if (dx * dx + dy * dy < circles_[i].r2_)
+            const Circle &c = circles_[cell[i]];
+            double dx = c.x_ - x;
+            double dy = c.y_ - y;
+            if (dx * dx + dy * dy < c.r2_)
                 return false;
         }
         return true;
     }
 
+    /* Check \e count points, given as consecutive (x, y) pairs in \e xy. Return the index of the
+       first point that overlaps a circle, or \e count if none of them does. */
+    std::size_t firstOverlap(const double *xy, std::size_t count) const
+    {
+        for (std::size_t i = 0 ; i < count ; ++i)
+            if (!noOverlap(xy[2 * i], xy[2 * i + 1]))
+                return i;
+        return count;
+    }
+
     std::vector<Circle> circles_;
     std::vector<Query> queries_;
     double minX_;
     double maxX_;
     double minY_;
     double maxY_;
+
+private:
+
+    std::size_t cellIndex(double v, double min, std::size_t cells) const
+    {
+        std::size_t i = (std::size_t)std::floor((v - min) / cellSize_);
+        return i < cells ? i : cells - 1;
+    }
+
+    // Bucket the circles in a uniform grid over their bounding box, so that a point
+    // only needs to be checked against the circles that overlap the cell it falls in.
+    // A circle is added to all cells its bounding square overlaps; since cellIndex()
+    // is monotonic, every point inside a circle maps to one of these cells.
+    void buildGrid(void)
+    {
+        cells_.clear();
+        if (circles_.empty())
+            return;
+
+        // aim for about one circle per cell, but do not make cells smaller than the circles
+        double maxR = 0.0;
+        for (std::size_t i = 0 ; i < circles_.size() ; ++i)
+            maxR = std::max(maxR, circles_[i].r_);
+        cellSize_ = std::max(maxR, std::sqrt((maxX_ - minX_) * (maxY_ - minY_) / (double)circles_.size()));
+        if (!(cellSize_ > 0.0))
+            cellSize_ = 1.0;
+        cellsX_ = (std::size_t)std::floor((maxX_ - minX_) / cellSize_) + 1;
+        cellsY_ = (std::size_t)std::floor((maxY_ - minY_) / cellSize_) + 1;
+        cells_.resize(cellsX_ * cellsY_);
+
+        for (std::size_t i = 0 ; i < circles_.size() ; ++i)
+        {
+            const Circle &c = circles_[i];
+            std::size_t x0 = cellIndex(c.x_ - c.r_, minX_, cellsX_), x1 = cellIndex(c.x_ + c.r_, minX_, cellsX_);
+            std::size_t y0 = cellIndex(c.y_ - c.r_, minY_, cellsY_), y1 = cellIndex(c.y_ + c.r_, minY_, cellsY_);
+            for (std::size_t x = x0 ; x <= x1 ; ++x)
+                for (std::size_t y = y0 ; y <= y1 ; ++y)
+                    cells_[x * cellsY_ + y].push_back(i);
+        }
+    }
+
+    double cellSize_;
+    std::size_t cellsX_;
+    std::size_t cellsY_;
+    std::vector< std::vector<unsigned int> > cells_;
 };
 
 #endif
@@ -90,6 +90,46 @@ BOOST_AUTO_TEST_CASE(DifferentSeeds)
     BOOST_CHECK(same < 2 * N);
 }
 
+/* Seeds derived from a (seed, index) pair do not depend on the global seed generator */
+BOOST_AUTO_TEST_CASE(ScopedSeeds)
+{
+    BOOST_CHECK_EQUAL(RNG::deriveSeed(7, 3), RNG::deriveSeed(7, 3));
+    BOOST_CHECK(RNG::deriveSeed(7, 3) != RNG::deriveSeed(7, 4));
+    BOOST_CHECK(RNG::deriveSeed(7, 3) != RNG::deriveSeed(8, 3));
+
+    std::vector<boost::uint32_t> seeds;
+    {
+        RNG::ScopedSeed scope(7, 3);
+        RNG r1, r2;
+        seeds.push_back(r1.getLocalSeed());
+        seeds.push_back(r2.getLocalSeed());
+        {
+            RNG::ScopedSeed inner(7, 4);
+            RNG r3;
+            seeds.push_back(r3.getLocalSeed());
+        }
+        RNG r4;
+        seeds.push_back(r4.getLocalSeed());
+    }
+    // random numbers drawn outside a scope do not affect the streams
+    RNG outside;
+    outside.uniform01();
+    {
+        RNG::ScopedSeed scope(7, 3);
+        RNG r1, r2;
+        BOOST_CHECK_EQUAL(r1.getLocalSeed(), seeds[0]);
+        BOOST_CHECK_EQUAL(r2.getLocalSeed(), seeds[1]);
+        BOOST_CHECK(seeds[0] != seeds[1]);
+        RNG r4;
+        BOOST_CHECK_EQUAL(r4.getLocalSeed(), seeds[3]);
+    }
+    {
+        RNG::ScopedSeed scope(7, 4);
+        RNG r3;
+        BOOST_CHECK_EQUAL(r3.getLocalSeed(), seeds[2]);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(ValidRangeInts)
 {
     RNG r;